@@ -3,10 +3,10 @@
 	$Id: analyze.c,v 1.12 2022/11/19 13:45:49 warme Exp $
 
 	File:	analyze.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
-	Copyright (c) 1995, 2022 by David M. Warme.  This work is
+	Copyright (c) 1995, 2026 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
 	4.0 International License.
 
@@ -31,6 +31,9 @@
 	e-4:	11/18/2022	warme
 		: Change calling convention.
 		: Fix -Wall issue.
+	e-5:	10/18/2026	warme
+		: Use the auxiliary LP solver, which is lp_solve
+		:  when the main LP uses HiGHS.
 
 ************************************************************************/
 
@@ -99,10 +102,10 @@ struct clist {
 static void		build_constraints (struct ainfo *	aip,
 					   int			numS,
 					   struct clist *	clist);
-static LP_t *		build_lp (struct ainfo *	aip,
+static AUX_LP_t *	build_lp (struct ainfo *	aip,
 				  struct clist *	clist,
 				  struct lpmem *	lpmem);
-static void		destroy_lp (LP_t *, struct lpmem *);
+static void		destroy_lp (AUX_LP_t *, struct lpmem *);
 /* static void		process_ge (struct ainfo *); */
 static void		process_le (struct ainfo *, int *, int *);
 static void		use_lp (struct ainfo *, int *, int, int *);
@@ -772,7 +775,7 @@ int *			lp_counter
 int			i;
 int			j;
 int			status;
-LP_t *			lp;
+AUX_LP_t *		lp;
 double *		x;
 struct clist		clist;
 struct lpmem		lpmem;
@@ -799,7 +802,7 @@ struct lpmem		lpmem;
 	}
 #endif
 
-#if LPSOLVE
+#if AUX_LPSOLVE
 	status = solve (lp);
 	if (status NE OPTIMAL) {
 		printf ("solve: status = %d\n", status);
@@ -1099,7 +1102,7 @@ int			zedge_nz;
 #if CPLEX
 
 	static
-	LP_t *
+	AUX_LP_t *
 build_lp (
 
 struct ainfo *		aip,
@@ -1125,7 +1128,7 @@ double *		matval;
 int *			ip1;
 int *			ip2;
 int *			tmp;
-LP_t *			lp;
+AUX_LP_t *		lp;
 
 	nrows	= clist -> nrows;
 	ncols	= clist -> ncols;
@@ -1258,7 +1261,7 @@ LP_t *			lp;
 	void
 destroy_lp (
 
-LP_t *			lp,
+AUX_LP_t *		lp,
 struct lpmem *		lpmem
 )
 {
@@ -1286,10 +1289,10 @@ struct lpmem *		lpmem
  * The lp_solve version of build_lp.
  */
 
-#if LPSOLVE
+#if AUX_LPSOLVE
 
 	static
-	LP_t *
+	AUX_LP_t *
 build_lp (
 
 struct ainfo *		aip,
@@ -1309,7 +1312,7 @@ int *			matind;
 double *		matval;
 int *			ip1;
 int *			ip2;
-LP_t *			lp;
+AUX_LP_t *		lp;
 
 	nrows	= clist -> nrows;
 	ncols	= clist -> ncols;
@@ -1381,13 +1384,13 @@ LP_t *			lp;
  * The lp_solve version of the routine to free up the LP.
  */
 
-#if LPSOLVE
+#if AUX_LPSOLVE
 
 	static
 	void
 destroy_lp (
 
-LP_t *			lp,
+AUX_LP_t *		lp,
 struct lpmem *		lpmem
 )
 {
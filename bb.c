@@ -3,8 +3,8 @@
 	$Id: bb.c,v 1.63 2023/04/03 17:53:03 warme Exp $
 
 	File:	bb.c
-	Rev:	e-6
-	Date:	04/03/2023
+	Rev:	e-14
+	Date:	10/18/2026
 
 	Copyright (c) 1995, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -64,6 +64,32 @@
 		: Fix memory leak in cut_off_existing_nodes().
 		: Print number of fractional variables on all
 		:  feasible LP solutions, even if cutoff.
+	e-7:	10/18/2026	warme
+		: Record CPU time, violations found and share of
+		:  bound improvement for each separation routine.
+		: Adaptively skip the heuristic separators and
+		:  local cuts when they are unproductive.
+	e-8:	10/18/2026	warme
+		: Separate the congested components on several
+		:  threads.
+	e-9:	10/18/2026	warme
+		: Perform all operations on the LP through the
+		:  table of LP solver operations.
+	e-10:	10/18/2026	warme
+		: Presolve the initial formulation.
+	e-11:	10/18/2026	warme
+		: Screen new nodes with a Lagrangian bound before
+		:  solving their LP.
+	e-12:	10/18/2026	warme
+		: Print separation statistics only with detailed
+		:  timings.
+	e-13:	10/18/2026	warme
+		: Size the strong branching solution, and the LP
+		:  solution of each node, by the number of LP columns.
+	e-14:	10/18/2026	warme
+		: Scale the size limits of the small subtour and
+		:  local cut separators by their share of the cuts
+		:  relative to their share of the separation time.
 
 ************************************************************************/
 
@@ -83,8 +109,10 @@
 #include "genps.h"
 #include "incompat.h"
 #include "io.h"
+#include "lagrange.h"
 #include "localcut.h"
 #include "logic.h"
+#include "lppresolve.h"
 #include <math.h>
 #include "memory.h"
 #include "parmblk.h"
@@ -110,6 +138,9 @@ bool			_gst_check_for_better_IFS (double *	x,
 					      double *		true_z);
 struct bbinfo *		_gst_create_bbinfo (gst_solver_ptr	solver);
 void			_gst_new_upper_bound (double ub, struct bbinfo * bbip);
+int			_gst_separator_limit (struct bbinfo *	bbip,
+					      int		id,
+					      int		limit);
 
 
 /*
@@ -132,6 +163,13 @@ void			_gst_new_upper_bound (double ub, struct bbinfo * bbip);
 
 #define	UP_FIRST	TRUE
 
+	/* Separation scheduling... */
+#define	SEP_MAX_INTERVAL	16	/* Max calls between attempts */
+#define	SEP_GAIN_TOL		1.0e-6	/* Relative bound gain that */
+					/*  counts as no gain at all */
+#define	SEP_MIN_SCALE		0.125	/* Min fraction of size limits */
+#define	SEP_MIN_LIMIT		4	/* Min scaled size limit */
+
 
 /*
  * Local Types
@@ -144,14 +182,6 @@ struct bvar {			/* Info about best branch var seen */
 	double	test_2nd_val;	/* Only check 2nd branch if 1st > this. */
 };
 
-#ifdef CPLEX
-
-struct basis_save {	/* Structure to save basis state for CPLEX */
-	int *		cstat;
-	int *		rstat;
-};
-
-#endif
 
 
 /*
@@ -170,39 +200,49 @@ static bool		compare_branch_vars (struct bbinfo *,
 					     int,
 					     struct bvar *);
 static int		compute_good_lower_bound (struct bbinfo *);
+static int		count_comp_constraints (struct comp *);
+static int		count_constraints (struct constraint *,
+					   struct constraint *);
+static void		credit_separators (struct bbinfo *, double);
 static void		cut_off_existing_nodes (double		best_z,
 						struct bbinfo *	bbip);
 static struct constraint * do_separations (struct bbinfo *,
 					   cpu_time_t **);
+static struct constraint * enumerate_small_component (struct comp *,
+						      double *,
+						      struct bbinfo *,
+						      struct constraint *);
 static bool		eval_branch_var (struct bbinfo *,
 					 int,
 					 int,
-					 struct basis_save *,
+					 struct lpbasis *,
 					 double);
+static struct constraint * find_small_subtours (struct comp *,
+						double *,
+						struct bbinfo *,
+						struct constraint *);
 static int		fix_variables (struct bbinfo *,
 				       int *, int,
 				       int *, int);
 static bool		integer_feasible_solution (double *		x,
 						   struct bbinfo *	bbip);
+static int		lagrangian_screen (struct bbinfo *);
 static void		new_lower_bound (double, struct bbinfo *);
 static int		num_fractional_vars (double * x, struct bbinfo * bbip);
+static void		print_separation_stats (struct bbinfo *);
+static void		record_separator (struct bbinfo *,
+					  int,
+					  cpu_time_t,
+					  cpu_time_t,
+					  int);
+static void		rescale_separator (struct bbinfo *, int, bool);
+static bool		run_separator (struct bbinfo *, int);
+static void		schedule_separator (struct bbinfo *, int, bool);
 static int		reduced_cost_var_fixing (struct bbinfo *);
 static struct bbnode *	select_next_node (struct bbtree *);
 static void		sort_branching_vars (int *, int, double *);
 static void		trace_node (struct bbinfo *, char, char *);
 static void		update_node_preempt_value (struct bbinfo *);
-
-#ifdef CPLEX
-static void		destroy_LP_basis (struct basis_save *);
-static double		try_branch (LP_t *,
-				    int,
-				    int,
-				    double *,
-				    double,
-				    struct basis_save *,
-				    struct bbinfo *);
-static void		save_LP_basis (LP_t *, struct basis_save *);
-#endif
 
 /*
  * Set up the initial branch-and-bound problem, including the root
@@ -256,19 +296,6 @@ gst_param_ptr		params;
 	cpool = NEW (struct cpool);
 	_gst_initialize_constraint_pool (cpool, vert_mask, edge_mask, cip, params);
 
-	/* Build initial formulation. */
-	lpmem = NEW (struct lpmem);
-	lp = _gst_build_initial_formulation (cpool,
-					     vert_mask,
-					     edge_mask,
-					     cip,
-					     lpmem,
-					     params);
-	UNINDENT (params -> print_solve_trace);
-
-	/* Initialize the branch-and-bound tree... */
-	bbtree = _gst_create_bbtree (nmasks);
-
 	/* Create vectors to describe the current problem... */
 	fixed	= NEWA (nmasks, bitmap_t);
 	value	= NEWA (nmasks, bitmap_t);
@@ -282,15 +309,41 @@ gst_param_ptr		params;
 			/* variables that are outside of the problem */
 			/* are fixed at zero... */
 			SETBIT (fixed, i);
-			change_var_bounds (lp, i, 0.0, 0.0);
 		}
 		else if (BITON (req_edges, i)) {
 			/* Front-end has determined that this hyperedge	*/
 			/* MUST be present in an optimal solution!	*/
 			SETBIT (fixed, i);
 			SETBIT (value, i);
+		}
+	}
+
+	/* Presolve the initial formulation, fixing any further	*/
+	/* variables that the initial rows imply.			*/
+	_gst_presolve_initial_formulation (cpool, cip, fixed, value, params);
+
+	/* Build initial formulation. */
+	lpmem = NEW (struct lpmem);
+	lp = _gst_build_initial_formulation (cpool,
+					     vert_mask,
+					     edge_mask,
+					     cip,
+					     lpmem,
+					     params);
+	UNINDENT (params -> print_solve_trace);
+
+	/* Initialize the branch-and-bound tree... */
+	bbtree = _gst_create_bbtree (nmasks);
+
+	/* Impose the fixed variables upon the LP... */
+	for (i = 0; i < nedges; i++) {
+		if (NOT BITON (fixed, i)) continue;
+		if (BITON (value, i)) {
 			change_var_bounds (lp, i, 1.0, 1.0);
 		}
+		else {
+			change_var_bounds (lp, i, 0.0, 0.0);
+		}
 	}
 
 	/* Create the root node... */
@@ -336,6 +389,10 @@ gst_param_ptr		params;
 			total_vars += num_y_vars_estimate;  /* Add space for y_ij variables */
 		}
 	}
+	/* The LP always has a coverage variable for each terminal. */
+	if (total_vars < GET_LP_NUM_COLS (lp)) {
+		total_vars = GET_LP_NUM_COLS (lp);
+	}
 	root -> x	= NEWA (total_vars, double);
 	root -> cpiter	= -1;		/* x is not current. */
 	/* PSW: zlb and bheur must accommodate all variables (FST + not_covered + y_ij), not just FST edges */
@@ -367,6 +424,10 @@ gst_param_ptr		params;
 	statp -> num_nodes	= 0;
 	statp -> num_lps	= 0;
 
+	for (i = 0; i < NUM_SEPARATORS; i++) {
+		statp -> sep [i].limit_scale = 1.0;
+	}
+
 	statp -> cs_init.num_prows	= cpool -> nrows;
 	statp -> cs_init.num_lprows	= GET_LP_NUM_ROWS (lp);
 	statp -> cs_init.num_pnz	= cpool -> num_nz;
@@ -403,6 +464,9 @@ gst_param_ptr		params;
 		}
 	}
 	int total_vars_dj = nedges + num_not_covered_dj;
+	if (total_vars_dj < GET_LP_NUM_COLS (lp)) {
+		total_vars_dj = GET_LP_NUM_COLS (lp);
+	}
 	bbip -> dj		= NEWA (total_vars_dj, double);
 	bbip -> fixed		= NULL;
 	bbip -> value		= NULL;
@@ -411,6 +475,8 @@ gst_param_ptr		params;
 	bbip -> ubip		= NULL;
 	bbip -> rcfile		= NULL;
 	bbip -> failed_fcomps	= NULL;
+	bbip -> lccache		= NULL;
+	bbip -> suppconn	= NULL;
 	bbip -> next_ckpt_time	= 0;
 
 	/* Make the root node inactive by putting it in the bbtree... */
@@ -487,10 +553,11 @@ struct bbnode *		node2;
 gst_param_ptr		params;
 gst_channel_ptr		trace;
 
-#ifdef CPLEX
 int *			b_index;
-char *			b_lu;
-double *		b_bd;
+double *		b_lb;
+double *		b_ub;
+
+#ifdef CPLEX
 double			objlim;
 double			save_objlim;
 #endif
@@ -573,18 +640,10 @@ double			save_objlim;
 	bbip -> fixed = fixed;
 	bbip -> value = value;
 
-#ifdef CPLEX
 	/* Create arrays for changing variable bounds... */
-	/* PSW: In budget mode, account for additional variables (not_covered + y_ij) */
-	int total_bound_vars = nedges;
-	if (getenv("GEOSTEINER_BUDGET") != NULL) {
-		/* Estimate total variables: FSTs + terminals + y_ij (3 per 3-terminal FST) */
-		total_bound_vars = nedges + cip -> num_verts + (nedges / 2);
-	}
-	b_index	= NEWA (2 * total_bound_vars, int);
-	b_lu	= NEWA (2 * total_bound_vars, char);
-	b_bd	= NEWA (2 * total_bound_vars, double);
-#endif
+	b_index	= NEWA (nedges, int);
+	b_lb	= NEWA (nedges, double);
+	b_ub	= NEWA (nedges, double);
 
 #if 0
 	/* Build cutset separation formulation.  This is not checkpointed. */
@@ -679,69 +738,35 @@ double			save_objlim;
 			delta [i] =   (fixed [i] ^ node -> fixed [i])
 				    | (value [i] ^ node -> value [i]);
 		}
-#ifdef CPLEX
 		j = 0;
 		for (i = 0; i < nedges; i++) {
 			if (NOT BITON (delta, i)) continue;
 			/* Force bounds for variable 'i' to be correct... */
-			b_index [j]	= i;	/* variable i, */
-			b_lu [j]	= 'L';	/*	lower bound */
-			b_index [j+1]	= i;	/* variable i, */
-			b_lu [j+1]	= 'U';	/*	upper bound */
+			b_index [j] = i;
 			if (NOT BITON (node -> fixed, i)) {
 				/* new variable is NOT fixed... */
-				b_bd [j]	= 0.0;
-				b_bd [j+1]	= 1.0;
+				b_lb [j] = 0.0;
+				b_ub [j] = 1.0;
 			}
 			else if (NOT BITON (node -> value, i)) {
 				/* new variable is fixed to 0 */
-				b_bd [j]	= 0.0;
-				b_bd [j+1]	= 0.0;
+				b_lb [j] = 0.0;
+				b_ub [j] = 0.0;
 			}
 			else {
 				/* new variable is fixed to 1 */
-				b_bd [j]	= 1.0;
-				b_bd [j+1]	= 1.0;
+				b_lb [j] = 1.0;
+				b_ub [j] = 1.0;
 			}
-			j += 2;
-		}
-		if (j > 0) {
-			if (_MYCPX_chgbds (lp, j, b_index, b_lu, b_bd) NE 0) {
-				FATAL_ERROR;
-			}
-#if 0
-			++(bbip -> cpool -> uid);
-#endif
-		}
-#endif
-
-#ifdef LPSOLVE
-		j = 0;
-		for (i = 0; i < nedges; i++) {
-			if (NOT BITON (delta, i)) continue;
 			++j;
-			/* Force bounds on variable 'i' to be correct... */
-			if (NOT BITON (node -> fixed, i)) {
-				/* variable is NOT fixed... */
-				set_bounds (lp, i + 1, 0.0, 1.0);
-			}
-			else if (NOT BITON (node -> value, i)) {
-				/* variable is fixed to 0 */
-				set_bounds (lp, i + 1, 0.0, 0.0);
-			}
-			else {
-				/* variable is fixed to 1 -- must set	*/
-				/* bounds in this order to avoid	*/
-				/* lb > ub condition between calls...	*/
-				set_bounds (lp, i + 1, 1.0, 1.0);
-			}
 		}
 		if (j > 0) {
-#if 0
-			++(bbip -> cpool -> uid);
-#endif
+			(*_gst_lpops.change_bounds) (bbip -> lp,
+						     j,
+						     b_index,
+						     b_lb,
+						     b_ub);
 		}
-#endif
 
 		for (i = 0; i < nmasks; i++) {
 			fixed [i] = node -> fixed [i];
@@ -1044,6 +1069,8 @@ suspend:
 	statp -> cs_final.num_pnz	= cpool -> num_nz;
 	statp -> cs_final.num_lpnz	= GET_LP_NUM_NZ (lp);
 
+	print_separation_stats (bbip);
+
 	if (bbip -> best_z < params -> initial_upper_bound) {
 		/* Feasible solution found */
 		if (solver -> preempt EQ 0) { /* If no preemption occured */
@@ -1061,11 +1088,9 @@ suspend:
 
 	solver -> lowerbound = bbip -> prevlb;
 
-#if CPLEX
-	free ((char *) b_bd);
-	free ((char *) b_lu);
+	free ((char *) b_ub);
+	free ((char *) b_lb);
 	free ((char *) b_index);
-#endif
 
 	free ((char *) delta);
 	free ((char *) value);
@@ -1344,7 +1369,7 @@ double			test_2nd_val;
 double			num;
 double			den;
 struct bvar		best;
-struct basis_save	bsave;
+struct lpbasis		bsave;
 gst_channel_ptr		param_print_solve_trace;
 
 	param_print_solve_trace = bbip -> params -> print_solve_trace;
@@ -1451,7 +1476,7 @@ gst_channel_ptr		param_print_solve_trace;
 
 	/* Snapshot the current basis so that we can quickly	*/
 	/* get back to it each time...				*/
-	save_LP_basis (bbip -> lp, &bsave);
+	(*_gst_lpops.save_branch_basis) (bbip -> lp, &bsave);
 
 	/* Compute the non-improvement limit.  When we have tested this	*/
 	/* many consecutive variables without finding a better choice,	*/
@@ -1564,7 +1589,7 @@ again:
 #if 1
 			/* Special return code that says to try */
 			/* re-solving the LP again.		*/
-			destroy_LP_basis (&bsave);
+			(*_gst_lpops.free_branch_basis) (&bsave);
 			free ((char *) fvars);
 			return (-1);
 #elif 0
@@ -1640,7 +1665,7 @@ get_out:
 		best.var, best.z0, best.z1);
 #endif
 
-	destroy_LP_basis (&bsave);
+	(*_gst_lpops.free_branch_basis) (&bsave);
 
 	free ((char *) fvars);
 
@@ -1753,14 +1778,12 @@ eval_branch_var (
 struct bbinfo *		bbip,		/* IN - branch-and-bound info */
 int			var,		/* IN - variable to branch */
 int			dir1,		/* IN - first branch direction */
-struct basis_save *	basp,		/* IN - basis to restore when done */
+struct lpbasis *	basp,		/* IN - basis to restore when done */
 double			test_2nd_val	/* IN - test 2nd if 1st is > this */
 )
 {
 int			i;
-int			nedges;
 int			dir2;
-struct gst_hypergraph *	cip;
 LP_t *			lp;
 struct bbnode *		nodep;
 bool			found;
@@ -1768,26 +1791,12 @@ bool			fixed;
 double *		x;
 double			z;
 
-	cip	= bbip -> cip;
 	lp	= bbip -> lp;
 	nodep	= bbip -> node;
 
-	nedges = cip -> num_edges;
-
-	/* PSW: In multi-objective mode, we need space for FST + not_covered variables */
-	int num_not_covered_vars = 0;
-	char* budget_env_check = getenv("GEOSTEINER_BUDGET");
-	if (budget_env_check != NULL) {
-		bitmap_t* vert_mask_local = cip -> initial_vert_mask;
-		/* Count terminals for not_covered variables */
-		for (int i = 0; i < cip -> num_verts; i++) {
-			if (BITON (vert_mask_local, i) && cip -> tflag[i]) {
-				num_not_covered_vars++;
-			}
-		}
-	}
-	int total_vars_local = nedges + num_not_covered_vars;
-	x = NEWA (total_vars_local, double);
+	/* The trial solution has a value for every LP column -- the	*/
+	/* FSTs and also the terminal coverage variables.		*/
+	x = NEWA (GET_LP_NUM_COLS (lp), double);
 
 	dir2 = 1 - dir1;
 
@@ -1797,17 +1806,13 @@ double			z;
 	/* DISABLED: Too verbose
 // 	fprintf(stderr, "DEBUG EVAL: Testing var %d = %d, best_z=%.6f\n", var, dir1, bbip -> best_z);
  Testing var %d = %d, best_z=%.6f\n", var, dir1, bbip -> best_z);*/
-#if CPLEX
-	/* DISABLED: Too verbose
-// 	fprintf(stderr, "DEBUG EVAL: About to call try_branch(lp, %d, %d, x, DBL_MAX, basp, bbip)\n", var + 1, dir1);
- About to call try_branch(lp, %d, %d, x, DBL_MAX, basp, bbip)\n", var + 1, dir1);*/
-	z = try_branch (lp, var + 1, dir1, x, DBL_MAX, basp, bbip);
-	/* DISABLED: Too verbose
-// 	fprintf(stderr, "DEBUG EVAL: try_branch returned z=%.6f\n", z);
- try_branch returned z=%.6f\n", z);*/
-#else
-	z = try_branch (lp, var + 1, dir1, x, DBL_MAX, basp);
-#endif
+	z = (*_gst_lpops.try_branch) (lp,
+				      bbip -> lpmem,
+				      var,
+				      dir1,
+				      x,
+				      DBL_MAX,
+				      basp);
 	/* DISABLED: Too verbose
 // 	fprintf(stderr, "DEBUG EVAL: Branch var %d = %d gives z=%.6f\n", var, dir1, z);
  Branch var %d = %d gives z=%.6f\n", var, dir1, z);*/
@@ -1884,8 +1889,8 @@ double			z;
 		/* handling the CPLEX "unscaled infeasibility" issue.	*/
 		lp = bbip -> lp;
 
-		destroy_LP_basis (basp);
-		save_LP_basis (lp, basp);
+		(*_gst_lpops.free_branch_basis) (basp);
+		(*_gst_lpops.save_branch_basis) (lp, basp);
 
 		/* Try finding a good heuristic solution on the	*/
 		/* new fixed solution...			*/
@@ -1912,17 +1917,13 @@ double			z;
 	/* DISABLED: Too verbose
 // 	fprintf(stderr, "DEBUG EVAL: About to test second branch var %d = %d\n", var, dir2);
  About to test second branch var %d = %d\n", var, dir2);*/
-#if CPLEX
-	/* DISABLED: Too verbose
-// 	fprintf(stderr, "DEBUG EVAL: Calling try_branch(lp, %d, %d, x, DBL_MAX, basp, bbip)\n", var + 1, dir2);
- Calling try_branch(lp, %d, %d, x, DBL_MAX, basp, bbip)\n", var + 1, dir2);*/
-	z = try_branch (lp, var + 1, dir2, x, DBL_MAX, basp, bbip);
-	/* DISABLED: Too verbose
-// 	fprintf(stderr, "DEBUG EVAL: Second branch returned z=%.6f\n", z);
- Second branch returned z=%.6f\n", z);*/
-#else
-	z = try_branch (lp, var + 1, dir2, x, DBL_MAX, basp);
-#endif
+	z = (*_gst_lpops.try_branch) (lp,
+				      bbip -> lpmem,
+				      var,
+				      dir2,
+				      x,
+				      DBL_MAX,
+				      basp);
 
 	/* Check for better integer feasible solution... */
 	/* Skip IFS check in multi-objective mode to avoid incompatible comparisons */
@@ -1996,8 +1997,8 @@ double			z;
 		/* handling the CPLEX "unscaled infeasibility" issue.	*/
 		lp = bbip -> lp;
 
-		destroy_LP_basis (basp);
-		save_LP_basis (lp, basp);
+		(*_gst_lpops.free_branch_basis) (basp);
+		(*_gst_lpops.save_branch_basis) (lp, basp);
 
 		/* Try finding a good heuristic solution on the	*/
 		/* new fixed solution...			*/
@@ -2323,153 +2324,6 @@ double			z;
 	return (FALSE);
 }
 
-/*
- * This routine saves the current basis of the given LP.
- */
-
-#ifdef CPLEX
-
-	static
-	void
-save_LP_basis (
-
-LP_t *			lp,		/* IN - LP to save basis for */
-struct basis_save *	basp		/* OUT - saved basis info */
-)
-{
-int		rows;
-int		cols;
-
-	rows = _MYCPX_getnumrows (lp);
-	cols = _MYCPX_getnumcols (lp);
-
-	basp -> cstat = NEWA (cols, int);
-	basp -> rstat = NEWA (rows, int);
-
-	if (_MYCPX_getbase (lp, basp -> cstat, basp -> rstat) NE 0) {
-		FATAL_ERROR;
-	}
-}
-
-/*
- * Destroy the saved basis info...
- */
-
-	static
-	void
-destroy_LP_basis (
-
-struct basis_save *	basp		/* IN - basis info to free up */
-)
-{
-#if CPLEX >= 40
-	free ((char *) (basp -> rstat));
-	free ((char *) (basp -> cstat));
-#endif
-}
-
-#endif
-
-/*
- * This routine tries the given branch by solving the LP.  It
- * returns the resulting objective value, or INF_DISTANCE if something
- * goes wrong (like infeasible).
- */
-
-#ifdef CPLEX
-
-	static
-	double
-try_branch (
-
-LP_t *			lp,		/* IN - LP to re-optimize */
-int			var,		/* IN - variable to try branching */
-int			dir,		/* IN - branch direction, 0 or 1 */
-double *		x,		/* OUT - LP solution obtained */
-double			ival,		/* IN - value to give if infeasible */
-struct basis_save *	basp,		/* IN - basis to restore when done */
-struct bbinfo *		bbip		/* IN - branch and bound info */
-)
-{
-int		status;
-gst_param_ptr	params;
-double		z;
-int		b_index [2];
-char		b_lu [2];
-double		b_bd [2];
-
-	params = bbip -> params;
-
-// 	fprintf(stderr, "DEBUG TRY_BRANCH: Called with var=%d, dir=%d\n", var, dir);
-	--var;		/* vars are zero-origined in CPLEX... */
-// 	fprintf(stderr, "DEBUG TRY_BRANCH: After decrement, var=%d\n", var);
-
-	b_index [0] = var;	b_lu [0] = 'L';
-	b_index [1] = var;	b_lu [1] = 'U';
-	if (dir EQ 0) {
-		b_bd [0] = 0.0;
-		b_bd [1] = 0.0;
-	}
-	else {
-		b_bd [0] = 1.0;
-		b_bd [1] = 1.0;
-	}
-	if (_MYCPX_chgbds (lp, 2, b_index, b_lu, b_bd) NE 0) {
-		FATAL_ERROR;
-	}
-
-	/* Solve the current LP instance... */
-	status = _MYCPX_dualopt (lp);
-	if (status NE 0) {
-		gst_channel_printf (params -> print_solve_trace,
-			" WARNING dualopt: status = %d\n", status);
-	}
-
-	/* Get current LP solution... */
-	if (_MYCPX_solution (lp, &status, &z, x, NULL, NULL, NULL) NE 0) {
-		FATAL_ERROR;
-	}
-
-	/* Determine type of LP result... */
-	switch (status) {
-	case _MYCPX_STAT_OPTIMAL:
-	case _MYCPX_STAT_OPTIMAL_INFEAS:
-		/* Unscale the objective value. */
-		z = ldexp (z, bbip -> lpmem -> obj_scale);
-		break;
-
-	case _MYCPX_STAT_INFEASIBLE:
-	case _MYCPX_STAT_UNBOUNDED:
-			/* (CPLEX 3.0 sometimes gives us infeasible!) */
-	case _MYCPX_STAT_ABORT_OBJ_LIM:	/* Objective limit exceeded. */
-		z = ival;
-		break;
-
-	default:
-		gst_channel_printf (params -> print_solve_trace, "Status = %d\n", status);
-		_MYCPX_lpwrite (lp, "core.lp");
-		FATAL_ERROR;
-		break;
-	}
-
-	b_bd [0] = 0.0;
-	b_bd [1] = 1.0;
-	if (_MYCPX_chgbds (lp, 2, b_index, b_lu, b_bd) NE 0) {
-		FATAL_ERROR;
-	}
-
-	/* Restore the basis... */
-	status = _MYCPX_copybase (lp, basp -> cstat, basp -> rstat);
-	if (status NE 0) {
-		fprintf (stderr, "try_branch: status = %d\n", status);
-		FATAL_ERROR;
-	}
-
-	return (z);
-}
-
-#endif
-
 /*
  * This routine computes the lower-bound for the current node, which
  * consists of solving the LP and generating violated constraints
@@ -2495,6 +2349,7 @@ struct gst_hypergraph *	cip;
 struct bbnode *		nodep;
 double *		x;
 double			z;
+double			sep_z;
 struct constraint *	cp;
 struct constraint *	tmp;
 int			iteration;
@@ -2524,6 +2379,18 @@ gst_channel_ptr		param_print_solve_trace;
 
 	iteration = 1;
 	num_const = 0;
+	sep_z = -DBL_MAX;
+
+	if ((nodep -> iter EQ 0) AND
+	    (nodep -> depth > 0) AND
+	    params -> lagrangian_bound) {
+		/* New node -- try to cut it off, or at least fix some	*/
+		/* variables, before solving any LP.			*/
+		status = lagrangian_screen (bbip);
+		if (status NE LB_FRACTIONAL) {
+			return (status);
+		}
+	}
 
 	for (;;) {
 		status = _gst_solve_LP_over_constraint_pool (bbip);
@@ -2625,6 +2492,15 @@ gst_channel_ptr		param_print_solve_trace;
 #endif
 #endif
 
+		if (sep_z > -DBL_MAX) {
+			/* Credit the separation routines with the bound */
+			/* improvement due to the cuts they found.	 */
+			if (status EQ BBLP_OPTIMAL) {
+				credit_separators (bbip, z - sep_z);
+			}
+			sep_z = -DBL_MAX;
+		}
+
 		if (status NE BBLP_INFEASIBLE) {
 			/* Have a feasible LP.  Display number of	*/
 			/* fractional variables.			*/
@@ -2659,13 +2535,13 @@ gst_channel_ptr		param_print_solve_trace;
 			FATAL_ERROR;
 		}
 
-#ifdef CPLEX
-		/* Now get rid of any rows that have become	*/
-		/* slack.  (We don't lose these constraints:	*/
-		/* they're still sitting around in the		*/
-		/* constraint pool.)				*/
-		_gst_delete_slack_rows_from_LP (bbip);
-#endif
+		if (_gst_lpops.keeps_basis) {
+			/* Now get rid of any rows that have become	*/
+			/* slack.  (We don't lose these constraints:	*/
+			/* they're still sitting around in the		*/
+			/* constraint pool.)				*/
+			_gst_delete_slack_rows_from_LP (bbip);
+		}
 
 		/* Solution is feasible, check for integer-feasible... */
 		is_int = integer_feasible_solution (x, bbip);
@@ -2813,16 +2689,17 @@ gst_channel_ptr		param_print_solve_trace;
 			break;
 		}
 
-#ifdef LPSOLVE
-		/* Now get rid of any rows that have become	*/
-		/* slack.  (We don't lose these constraints:	*/
-		/* they're still sitting around in the		*/
-		/* constraint pool.)				*/
-		_gst_delete_slack_rows_from_LP (bbip);
-#endif
+		if (NOT _gst_lpops.keeps_basis) {
+			/* Now get rid of any rows that have become	*/
+			/* slack.  Deleting rows invalidates the basis,	*/
+			/* so we wait until there are new constraints	*/
+			/* to add.					*/
+			_gst_delete_slack_rows_from_LP (bbip);
+		}
 
 		/* Add new contraints to the constraint pool. */
 		num_const = _gst_add_constraints (bbip, cp);
+		sep_z = z;
 
 		if (num_const <= 0) {
 			/* Separation routines found violations, but	*/
@@ -2965,21 +2842,8 @@ gst_param_ptr		params;
 	/* We HAVE a new best solution! */
 	bbip -> best_z = ub;
 
-#if CPLEX
-	{ double toobig, toosmall, ulim;
-	  /* Set new cutoff value for future LPs... */
-	  ulim = ldexp (ub, -(bbip -> lpmem -> obj_scale));
-	  if (_MYCPX_setobjulim (ulim, &toosmall, &toobig) NE 0) {
-		FATAL_ERROR;
-	  }
-	}
-#endif
-
-#if LPSOLVE
 	/* Set new cutoff value for future LPs... */
-	/* (This may not really work in lp_solve.) */
-	bbip -> lp -> obj_bound = ub;
-#endif
+	(*_gst_lpops.set_cutoff) (bbip -> lp, bbip -> lpmem, ub);
 
 	cut_off_existing_nodes (ub, bbip);
 
@@ -3110,6 +2974,17 @@ struct bbnode *		node2;
 
 /*
  * This routine performs most of the separations -- in the proper order.
+ *
+ * The CPU time and number of violations found by each separation
+ * routine are recorded.  The exact separators (zero-weight cutsets,
+ * integer cycles, enumeration of small components and the flow
+ * formulation of sec2.c) are always run, since we can only declare
+ * the LP relaxation to have no violations once they have all failed.
+ * The heuristic SEC separators and local cuts are skipped for a while
+ * whenever they turn out to be unproductive (see run_separator()).
+ * The small subtour and local cut separators also use smaller size
+ * limits while they cost more than they yield (see
+ * credit_separators()).
  */
 
 	static
@@ -3120,6 +2995,8 @@ struct bbinfo *		bbip,		/* IN - branch-and-bound info */
 cpu_time_t **		Tpp		/* IN/OUT - CPU time vector */
 )
 {
+int			i;
+int			n;
 double *		x;
 struct comp *		comp;
 struct comp *		p;
@@ -3127,6 +3004,7 @@ struct comp **		hookp;
 struct comp *		p2;
 cpu_time_t *		Tp;
 struct constraint *	cp;
+struct constraint *	cp1;
 struct constraint *	cp2;
 struct constraint *	tmp;
 bool			print_flag;
@@ -3135,15 +3013,24 @@ bool			try_localcuts;
 
 	x		= bbip -> node -> x;
 
+	for (i = 0; i < NUM_SEPARATORS; i++) {
+		bbip -> statp -> sep [i].last_cuts = -1;
+	}
+
 	Tp = *Tpp;
 
 	/* Find all zero-weight cutsets... */
 	cp = _gst_find_zero_weight_cutsets (x, bbip);
 	*Tp++ = _gst_get_cpu_time ();
+	record_separator (bbip, SEP_ZERO_WEIGHT_CUTSETS, Tp [-2], Tp [-1],
+			  count_constraints (cp, NULL));
 
 	/* Find solid integer cycles... */
+	cp1 = cp;
 	cp = _gst_find_integer_cycles (x, cp, bbip);
 	*Tp++ = _gst_get_cpu_time ();
+	record_separator (bbip, SEP_INTEGER_CYCLES, Tp [-2], Tp [-1],
+			  count_constraints (cp, cp1));
 
 #if 0
 	cp = _gst_find_weak_connectivity (x, cp, bbip);
@@ -3161,14 +3048,15 @@ bool			try_localcuts;
 
 	/* Exhaustively enumerate all components that are sufficiently	*/
 	/* small...  Delete them from the list when done.		*/
-	hookp = &comp;
+	cp1 = cp;
 	fprintf(stderr, "DEBUG: About to enumerate components\n");
+	_gst_separate_each_component (comp, enumerate_small_component, x, bbip);
+	hookp = &comp;
 	while ((p = *hookp) NE NULL) {
 		fprintf(stderr, "DEBUG: Processing component with %d verts\n", p -> num_verts);
 		if (p -> num_verts <= bbip -> params -> sec_enum_limit) {
-			fprintf(stderr, "DEBUG: Calling enumerate_all_subtours\n");
-			cp2 = _gst_enumerate_all_subtours (p, NULL, bbip);
-			fprintf(stderr, "DEBUG: Returned from enumerate_all_subtours\n");
+			cp2 = p -> cp;
+			p -> cp = NULL;
 			if (cp2 EQ NULL) {
 #if 0
 				/* Try finding a local cut for component. */
@@ -3204,23 +3092,42 @@ bool			try_localcuts;
 		}
 	}
 	*Tp++ = _gst_get_cpu_time ();
+	record_separator (bbip, SEP_ENUM_SUBTOURS, Tp [-2], Tp [-1],
+			  count_constraints (cp, cp1));
 
 	/* Find violated SEC's using a heuristic flow	*/
 	/* formulation.					*/
-	for (p = comp; p NE NULL; p = p -> next) {
-		p -> cp = _gst_sec_flow_heuristic (p,
-						   x,
-						   bbip,
-						   p -> cp);
+	if (run_separator (bbip, SEP_FLOW_HEURISTIC)) {
+		n = count_comp_constraints (comp);
+		_gst_separate_each_component (comp,
+					      _gst_sec_flow_heuristic,
+					      x,
+					      bbip);
+		*Tp++ = _gst_get_cpu_time ();
+		n = count_comp_constraints (comp) - n;
+		record_separator (bbip, SEP_FLOW_HEURISTIC, Tp [-2], Tp [-1], n);
+		schedule_separator (bbip, SEP_FLOW_HEURISTIC, n > 0);
+	}
+	else {
+		*Tp++ = _gst_get_cpu_time ();
 	}
-	*Tp++ = _gst_get_cpu_time ();
 
 	/* Find small-cardinality subtour violations	*/
 	/* by partial enumeration...			*/
-	for (p = comp; p NE NULL; p = p -> next) {
-		p -> cp = _gst_find_small_subtours (p, p -> cp, bbip);
+	if (run_separator (bbip, SEP_SMALL_SUBTOURS)) {
+		n = count_comp_constraints (comp);
+		_gst_separate_each_component (comp,
+					      find_small_subtours,
+					      x,
+					      bbip);
+		*Tp++ = _gst_get_cpu_time ();
+		n = count_comp_constraints (comp) - n;
+		record_separator (bbip, SEP_SMALL_SUBTOURS, Tp [-2], Tp [-1], n);
+		schedule_separator (bbip, SEP_SMALL_SUBTOURS, n > 0);
+	}
+	else {
+		*Tp++ = _gst_get_cpu_time ();
 	}
-	*Tp++ = _gst_get_cpu_time ();
 
 	/* Discard each component for which we have found at least one	*/
 	/* violation.  Gather all constraints onto the main list...	*/
@@ -3261,6 +3168,7 @@ bool			try_localcuts;
 	/* Time to use the new-fangled SEC separator... */
 	/* Do it one component at a time, so that we can see if */
 	/* there are any components for which no violations were found. */
+	cp1 = cp;
 	while (comp NE NULL) {
 		p2 = comp;
 		comp = comp -> next;
@@ -3283,6 +3191,8 @@ bool			try_localcuts;
 		}
 	}
 	*Tp++ = _gst_get_cpu_time ();
+	record_separator (bbip, SEP_SEC_FLOW, Tp [-2], Tp [-1],
+			  count_constraints (cp, cp1));
 
 	if (((cp EQ NULL) AND
 	     ((bbip -> params -> local_cuts_mode EQ
@@ -3291,10 +3201,24 @@ bool			try_localcuts;
 	      GST_PVAL_LOCAL_CUTS_MODE_BOTH))) OR
 	    try_localcuts) {
 		/* Try new-fangled separator that crushes	*/
-		/* small patches of fractional stuff.		*/
-
-		cp = _gst_find_local_cuts (x, bbip, cp);
-		*Tp++ = _gst_get_cpu_time ();
+		/* small patches of fractional stuff.  We never	*/
+		/* skip these when nothing else has been found.	*/
+
+		if ((cp EQ NULL) OR run_separator (bbip, SEP_LOCAL_CUTS)) {
+			cp1 = cp;
+			cp = _gst_find_local_cuts (x, bbip, cp);
+			*Tp++ = _gst_get_cpu_time ();
+			n = count_constraints (cp, cp1);
+			record_separator (bbip, SEP_LOCAL_CUTS,
+					  Tp [-2], Tp [-1], n);
+			if (n <= 0) {
+				/* Whether local cuts are productive	*/
+				/* otherwise depends upon their share	*/
+				/* of the bound improvement.  See	*/
+				/* credit_separators().			*/
+				schedule_separator (bbip, SEP_LOCAL_CUTS, FALSE);
+			}
+		}
 	}
 #endif
 
@@ -3323,6 +3247,381 @@ bool			try_localcuts;
 	return (cp);
 }
 
+/*
+ * Count the constraints in the given list, up to (but not including)
+ * the given end of list.
+ */
+
+	static
+	int
+count_constraints (
+
+struct constraint *	cp,		/* IN - list of constraints */
+struct constraint *	endp		/* IN - end of list, or NULL */
+)
+{
+int		n;
+
+	n = 0;
+	while (cp NE endp) {
+		++n;
+		cp = cp -> next;
+	}
+
+	return (n);
+}
+
+/*
+ * Exhaustively enumerate the subtours of a single congested component,
+ * provided it is small enough.  Adapts _gst_enumerate_all_subtours()
+ * for use with _gst_separate_each_component().  The violations found
+ * (if any) are returned as a new list -- the caller distinguishes an
+ * empty result on a small component from a component that was never
+ * enumerated by checking the size of the component.
+ */
+
+	static
+	struct constraint *
+enumerate_small_component (
+
+struct comp *		comp,		/* IN - congested component */
+double *		x,		/* IN - LP solution (unused) */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+struct constraint *	cp		/* IN - existing constraints */
+)
+{
+	(void) x;
+
+	if (comp -> num_verts > bbip -> params -> sec_enum_limit) {
+		return (cp);
+	}
+
+	return (_gst_enumerate_all_subtours (comp, NULL, bbip));
+}
+
+/*
+ * Find small subtours within a single congested component.  Adapts
+ * _gst_find_small_subtours() for use with
+ * _gst_separate_each_component().
+ */
+
+	static
+	struct constraint *
+find_small_subtours (
+
+struct comp *		comp,		/* IN - congested component */
+double *		x,		/* IN - LP solution (unused) */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+struct constraint *	cp		/* IN - existing constraints */
+)
+{
+	(void) x;
+
+	return (_gst_find_small_subtours (comp, cp, bbip));
+}
+
+/*
+ * Count the constraints accumulated on a list of congested components.
+ */
+
+	static
+	int
+count_comp_constraints (
+
+struct comp *		comp		/* IN - list of congested components */
+)
+{
+int		n;
+
+	n = 0;
+	while (comp NE NULL) {
+		n += count_constraints (comp -> cp, NULL);
+		comp = comp -> next;
+	}
+
+	return (n);
+}
+
+/*
+ * Record the outcome of one call to the given separation routine.
+ */
+
+	static
+	void
+record_separator (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+int			id,		/* IN - separation routine */
+cpu_time_t		t0,		/* IN - CPU time before call */
+cpu_time_t		t1,		/* IN - CPU time after call */
+int			ncuts		/* IN - number of violations found */
+)
+{
+struct sepstats *	sp;
+
+	sp = &(bbip -> statp -> sep [id]);
+
+	++(sp -> num_calls);
+	if (ncuts > 0) {
+		++(sp -> num_success);
+		sp -> num_cuts += ncuts;
+	}
+	sp -> time	+= (t1 - t0);
+	sp -> last_cuts	= ncuts;
+	sp -> last_time	= t1 - t0;
+}
+
+/*
+ * Decide whether the given (optional) separation routine should be
+ * called this time around.  We skip it if it is currently backed off.
+ */
+
+	static
+	bool
+run_separator (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+int			id		/* IN - separation routine */
+)
+{
+struct sepstats *	sp;
+
+	if (bbip -> params -> separation_schedule EQ
+	    GST_PVAL_SEPARATION_SCHEDULE_FIXED) {
+		return (TRUE);
+	}
+
+	sp = &(bbip -> statp -> sep [id]);
+	if (sp -> skip_left > 0) {
+		--(sp -> skip_left);
+		++(sp -> num_skips);
+		return (FALSE);
+	}
+
+	return (TRUE);
+}
+
+/*
+ * Update the schedule of the given separation routine after it has
+ * been called.  A productive call resets the back-off.  An unproductive
+ * call doubles the number of calls that we skip before trying again --
+ * but only if the call actually consumed some measurable CPU time.
+ * Cheap separators cost nothing to retry.
+ */
+
+	static
+	void
+schedule_separator (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+int			id,		/* IN - separation routine */
+bool			productive	/* IN - was last call productive? */
+)
+{
+struct sepstats *	sp;
+
+	sp = &(bbip -> statp -> sep [id]);
+
+	if (productive OR (sp -> last_time <= 0)) {
+		sp -> interval	= 1;
+		sp -> skip_left	= 0;
+		return;
+	}
+
+	if (sp -> interval < 1) {
+		sp -> interval = 1;
+	}
+	sp -> interval *= 2;
+	if (sp -> interval > SEP_MAX_INTERVAL) {
+		sp -> interval = SEP_MAX_INTERVAL;
+	}
+	sp -> skip_left = sp -> interval - 1;
+}
+
+/*
+ * Distribute the improvement in the LP objective resulting from the
+ * most recent round of separation among the separation routines, in
+ * proportion to the number of violations each contributed.  Local cuts
+ * are only considered productive if they actually help move the bound.
+ *
+ * The separators having size limits (small subtours and local cuts)
+ * also get their limits rescaled:  up if their share of the bound
+ * improvement is at least their share of the round's separation time,
+ * and down otherwise.
+ */
+
+	static
+	void
+credit_separators (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+double			gain		/* IN - improvement in LP objective */
+)
+{
+int			i;
+int			total;
+double			share;
+double			tol;
+double			total_time;
+bool			productive;
+struct sepstats *	sp;
+
+	if (gain < 0.0) {
+		gain = 0.0;
+	}
+
+	total = 0;
+	total_time = 0.0;
+	for (i = 0; i < NUM_SEPARATORS; i++) {
+		sp = &(bbip -> statp -> sep [i]);
+		if (sp -> last_cuts > 0) {
+			total += sp -> last_cuts;
+		}
+		if (sp -> last_cuts >= 0) {
+			total_time += (double) (sp -> last_time);
+		}
+	}
+	if (total <= 0) return;
+
+	tol = SEP_GAIN_TOL * (1.0 + fabs (bbip -> node -> z));
+
+	for (i = 0; i < NUM_SEPARATORS; i++) {
+		sp = &(bbip -> statp -> sep [i]);
+		if (sp -> last_cuts <= 0) continue;
+		share = gain * ((double) (sp -> last_cuts)) / ((double) total);
+		sp -> gain += share;
+		productive = (share > tol);
+		if (i EQ SEP_LOCAL_CUTS) {
+			schedule_separator (bbip, i, productive);
+		}
+		if ((i EQ SEP_SMALL_SUBTOURS) OR (i EQ SEP_LOCAL_CUTS)) {
+			rescale_separator (bbip,
+					   i,
+					   productive AND
+					   (share * total_time >=
+					    gain * ((double) (sp -> last_time))));
+		}
+		sp -> last_cuts = -1;
+	}
+}
+
+/*
+ * Double the size limit scale of the given separation routine if it
+ * was worth its CPU time, and halve it otherwise.  The scale stays
+ * between SEP_MIN_SCALE and 1.
+ */
+
+	static
+	void
+rescale_separator (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+int			id,		/* IN - separation routine */
+bool			productive	/* IN - was last call worth its time? */
+)
+{
+struct sepstats *	sp;
+
+	sp = &(bbip -> statp -> sep [id]);
+
+	if (productive) {
+		sp -> limit_scale *= 2.0;
+		if (sp -> limit_scale > 1.0) {
+			sp -> limit_scale = 1.0;
+		}
+	}
+	else {
+		sp -> limit_scale *= 0.5;
+		if (sp -> limit_scale < SEP_MIN_SCALE) {
+			sp -> limit_scale = SEP_MIN_SCALE;
+		}
+	}
+}
+
+/*
+ * Return the size limit that the given separation routine should use
+ * at present:  the given limit (a parameter value) scaled by the
+ * routine's current limit scale, but never below SEP_MIN_LIMIT.  With
+ * the fixed separation schedule the limit is returned unchanged.
+ */
+
+	int
+_gst_separator_limit (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+int			id,		/* IN - separation routine */
+int			limit		/* IN - size limit parameter */
+)
+{
+double			scaled;
+
+	if (bbip -> params -> separation_schedule EQ
+	    GST_PVAL_SEPARATION_SCHEDULE_FIXED) {
+		return (limit);
+	}
+
+	scaled = bbip -> statp -> sep [id].limit_scale * ((double) limit);
+	if (scaled >= (double) limit) {
+		return (limit);
+	}
+	if (scaled < (double) SEP_MIN_LIMIT) {
+		return ((limit < SEP_MIN_LIMIT) ? limit : SEP_MIN_LIMIT);
+	}
+
+	return ((int) scaled);
+}
+
+/*
+ * Print the accumulated separation statistics, if detailed timings
+ * have been requested.
+ */
+
+	static
+	void
+print_separation_stats (
+
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
+)
+{
+int			i;
+struct sepstats *	sp;
+gst_channel_ptr		timing;
+char			buf [32];
+
+static const char *	names [NUM_SEPARATORS] = {
+	"Zero-weight cutsets",
+	"Integer cycles",
+	"Enumerate subtours",
+	"Flow heuristic",
+	"Small subtours",
+	"SEC flow",
+	"Local cuts",
+};
+
+	timing = bbip -> params -> detailed_timings_channel;
+	if (timing EQ NULL) return;
+
+	gst_channel_printf (timing, "Separation statistics:\n");
+	gst_channel_printf (timing,
+		"  %-20s %8s %8s %8s %8s %10s %14s %6s\n",
+		"Separator", "Calls", "Skips", "Success", "Cuts",
+		"CPU", "Gain", "Scale");
+	for (i = 0; i < NUM_SEPARATORS; i++) {
+		sp = &(bbip -> statp -> sep [i]);
+		_gst_convert_cpu_time (sp -> time, buf);
+		gst_channel_printf (timing,
+			"  %-20s %8d %8d %8d %8d %10s %14g %6.3f\n",
+			names [i],
+			sp -> num_calls,
+			sp -> num_skips,
+			sp -> num_success,
+			sp -> num_cuts,
+			buf,
+			UNSCALE (sp -> gain, bbip -> cip -> scale),
+			sp -> limit_scale);
+	}
+}
+
 /*
  * This routine attempts to use LP reduced costs to fix variables.  Any
  * variable whose reduced cost exceeds the current LP/IP gap can be
@@ -3399,6 +3698,98 @@ struct bbnode *		nodep;
 	return (status);
 }
 
+/*
+ * Compute a Lagrangian lower bound for a new node, using the LP dual
+ * values of its parent as the starting multipliers.  The node is cut
+ * off if this bound reaches the upper bound.  Otherwise, variables
+ * whose Lagrangian reduced cost exceeds the gap are fixed, just as
+ * with LP reduced costs.  Returns LB_FRACTIONAL if the node's LP must
+ * still be solved.
+ */
+
+	static
+	int
+lagrangian_screen (
+
+struct bbinfo *		bbip	/* IN - branch-and-bound info */
+)
+{
+int			i;
+int			nedges;
+int			niter;
+int			nfix0;
+int			nfix1;
+int			status;
+double			L;
+double			gap;
+double *		rc;
+int *			newfix0;
+int *			newfix1;
+struct bbnode *		nodep;
+
+	nodep	= bbip -> node;
+	nedges	= bbip -> cip -> num_edges;
+
+	rc = NEWA (nedges, double);
+
+	L = _gst_lagrangian_bound (bbip, rc, &niter);
+
+	if (L <= -DBL_MAX) {
+		free ((char *) rc);
+		return (LB_FRACTIONAL);
+	}
+
+	gst_channel_printf (bbip -> params -> print_solve_trace,
+		"Lagrangian bound %f after %d iterations\n",
+		UNSCALE (L, bbip -> cip -> scale), niter);
+
+	if (L >= bbip -> best_z + FUZZ * fabs (bbip -> best_z)) {
+		free ((char *) rc);
+		nodep -> z = bbip -> best_z;
+		return (LB_CUTOFF);
+	}
+
+	if (L > nodep -> z) {
+		nodep -> z = L;
+	}
+
+	/* Only fix if we significantly exceed the gap... */
+	gap = (bbip -> best_z - L) * (1.0 + FUZZ);
+
+	newfix0 = NEWA (2 * nedges, int);
+	newfix1 = newfix0 + nedges;
+
+	nfix0	= 0;
+	nfix1	= 0;
+	for (i = 0; i < nedges; i++) {
+		if (BITON (bbip -> fixed, i)) continue;
+		if (rc [i] > gap) {
+			newfix0 [nfix0++] = i;
+		}
+		else if (- rc [i] > gap) {
+			newfix1 [nfix1++] = i;
+		}
+	}
+
+	status = LB_FRACTIONAL;
+
+	if ((nfix0 > 0) OR (nfix1 > 0)) {
+		gst_channel_printf (bbip -> params -> print_solve_trace,
+			"Lagrangian reduced costs fix %d to 0, %d to 1\n",
+			nfix0, nfix1);
+		if (fix_variables (bbip, newfix0, nfix0, newfix1, nfix1)
+		    EQ VFIX_INFEASIBLE) {
+			nodep -> z = bbip -> best_z;
+			status = LB_INFEASIBLE;
+		}
+	}
+
+	free ((char *) newfix0);
+	free ((char *) rc);
+
+	return (status);
+}
+
 /*
  * This routine fixes variables to zero and/or one.  We are given two
  * lists of variables to fixed, those to be fixed to zero, and those
@@ -3690,21 +4081,7 @@ double			lower,		/* IN - lower bound */
 double			upper		/* IN - upper bound */
 )
 {
-#if CPLEX
-int			b_index [2];
-char			b_lu [2];
-double			b_bd [2];
-
-	b_index [0] = var;	b_lu [0] = 'L';		b_bd [0] = lower;
-	b_index [1] = var;	b_lu [1] = 'U';		b_bd [1] = upper;
-	if (_MYCPX_chgbds (lp, 2, b_index, b_lu, b_bd) NE 0) {
-		FATAL_ERROR;
-	}
-#endif
-
-#if LPSOLVE
-	set_bounds (lp, var + 1, lower, upper);
-#endif
+	(*_gst_lpops.change_bounds) (lp, 1, &var, &lower, &upper);
 }
 
 /*
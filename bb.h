@@ -3,8 +3,8 @@
 	$Id: bb.h,v 1.28 2022/11/19 13:45:49 warme Exp $
 
 	File:	bb.h
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-8
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -34,6 +34,15 @@
 	e-4:	11/18/2022	warme
 		: Added owner, delrow_z and lb_status to bbnode.
 		: Added _gst_get_lb_status().
+	e-5:	10/18/2026	warme
+		: Added separation statistics to bbstats.
+	e-6:	10/18/2026	warme
+		: Added local cut cache to bbinfo.
+	e-7:	10/18/2026	warme
+		: Added support connectivity to bbinfo.
+	e-8:	10/18/2026	warme
+		: Added size limit scale to sepstats, and
+		:  _gst_separator_limit().
 
 ************************************************************************/
 
@@ -47,7 +56,9 @@
 #include "polltime.h"
 
 struct gst_hypergraph;
+struct lccache;
 struct gst_param;
+struct suppconn;
 struct gst_solver;
 
 /*
@@ -65,6 +76,17 @@ struct gst_solver;
 #define	BEST_NODE_HEAP	0
 #define	WORST_NODE_HEAP	1
 
+	/* The separation routines, for separation statistics... */
+
+#define	SEP_ZERO_WEIGHT_CUTSETS	0
+#define	SEP_INTEGER_CYCLES	1
+#define	SEP_ENUM_SUBTOURS	2
+#define	SEP_FLOW_HEURISTIC	3
+#define	SEP_SMALL_SUBTOURS	4
+#define	SEP_SEC_FLOW		5
+#define	SEP_LOCAL_CUTS		6
+#define	NUM_SEPARATORS		7
+
 
 /*
  * LP result status codes that are independent of the particular
@@ -222,6 +244,10 @@ struct bbinfo {
 
 	struct comp *	failed_fcomps; /* components that have been tried as a
 					  local cut before, with no success */
+	struct lccache * lccache; /* local cuts found for previously seen
+				     components */
+	struct suppconn * suppconn; /* connected components of the
+				       support of the LP solution */
 	cpu_time_t	next_ckpt_time; /* next checkpoint time */
 	volatile bool	force_branch_flag;
 	struct cpu_poll	mainpoll;
@@ -239,6 +265,22 @@ struct cstats {			/* Constraint statistics... */
 	int	num_lpnz;	/* Number of non-zeros in LP */
 };
 
+struct sepstats {		/* Separation statistics... */
+	int		num_calls;	/* Number of times invoked */
+	int		num_skips;	/* Number of times skipped */
+	int		num_success;	/* Invocations finding violations */
+	int		num_cuts;	/* Number of violations found */
+	cpu_time_t	time;		/* Total CPU time used */
+	double		gain;		/* Share of LP bound improvement */
+	/* Scheduling state */
+	int		last_cuts;	/* Violations found by last call, */
+					/*  or -1 if not called */
+	cpu_time_t	last_time;	/* CPU time used by last call */
+	int		interval;	/* Current back-off interval */
+	int		skip_left;	/* Remaining calls to skip */
+	double		limit_scale;	/* Fraction of size limits used */
+};
+
 struct bbstats {
 	int		num_nodes;	/* Number of b&b nodes */
 	int		num_lps;	/* Number of LP's solved */
@@ -250,6 +292,7 @@ struct bbstats {
 	bool		root_opt;	/* Is root_z optimal? */
 	int		root_lps;	/* Number of LP's solved at root */
 	cpu_time_t	root_time;	/* CPU time to finish root node */
+	struct sepstats	sep [NUM_SEPARATORS]; /* Separation statistics */
 };
 
 /*
@@ -263,6 +306,9 @@ extern bool		_gst_check_for_better_IFS (double *		x,
 extern struct bbinfo *	_gst_create_bbinfo (struct gst_solver *	solver);
 extern int		_gst_get_lb_status (struct bbnode * node);
 extern void		_gst_new_upper_bound (double ub, struct bbinfo * bbip);
+extern int		_gst_separator_limit (struct bbinfo *	bbip,
+					      int		id,
+					      int		limit);
 extern struct constraint * _gst_check_integer_solution_for_cycles (double * x,
 								     struct bbinfo * bbip);
 
@@ -3,8 +3,8 @@
 	$Id: bbmain.c,v 1.71 2022/11/19 13:45:49 warme Exp $
 
 	File:	bbmain.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-6
+	Date:	10/18/2026
 
 	Copyright (c) 1995, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -42,6 +42,11 @@
 		: Implement Print_Root_LP functionality using
 		:  official callback APIs.
 		: Fixed -Wall issues.
+	e-5:	10/18/2026	warme
+		: Report the FST size up to which the solution
+		:  is optimal, when the FSTs are incomplete.
+	e-6:	10/18/2026	warme
+		: Handle FSTs not known complete for any size.
 
 ************************************************************************/
 
@@ -121,6 +126,7 @@ int			nsmtfsts;
 int			reason;
 int			soln_status;
 int			slen;
+int			complete_size;
 int *			fsts;
 bool			is_embedded;
 double *		terms;
@@ -249,6 +255,29 @@ gst_scale_info_ptr	sip;
 		exit (1);
 	}
 
+	/* The FST generator may have run out of time, leaving out	*/
+	/* some of the larger FSTs.  The solution is then optimal for	*/
+	/* the FSTs at hand, but not known to be an SMT.		*/
+	if ((gst_get_int_property (hgprop,
+				   GST_PROP_HG_COMPLETE_FST_SIZE,
+				   &complete_size) EQ 0) AND
+	    (soln_status EQ GST_STATUS_OPTIMAL)) {
+		if (NOT Print_FSTs_Only) {
+			if (complete_size > 0) {
+				gst_channel_printf (chan,
+					"Optimal with respect to FSTs of up to"
+					" %d terminals.\n", complete_size);
+			}
+			else {
+				/* No FST size is known to be complete. */
+				gst_channel_printf (chan,
+					"Optimal with respect to the FSTs"
+					" given.\n");
+			}
+		}
+		soln_status = GST_STATUS_FEASIBLE;
+	}
+
 	if (gst_get_str_property (hgprop, GST_PROP_HG_NAME, &slen, NULL)) {
 		descr = NULL;
 	}
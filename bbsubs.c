@@ -3,8 +3,8 @@
 	$Id: bbsubs.c,v 1.26 2022/11/19 13:45:49 warme Exp $
 
 	File:	bbsubs.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-7
+	Date:	10/18/2026
 
 	Copyright (c) 1995, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -34,6 +34,13 @@
 	e-4:	11/18/2022	warme
 		: Initialize bbnode owner and delrow_z fields.
 		: Use function to free list of components.
+	e-5:	10/18/2026	warme
+		: Free the local cut cache.
+	e-6:	10/18/2026	warme
+		: Free the support connectivity.
+	e-7:	10/18/2026	warme
+		: Size the LP solution of each node by the number
+		:  of LP columns.
 
 ************************************************************************/
 
@@ -44,11 +51,13 @@
 #include "cutset.h"
 #include "fatal.h"
 #include "geosteiner.h"
+#include "localcut.h"
 #include "logic.h"
 #include "memory.h"
 #include "parmblk.h"
 #include "sec_comp.h"
 #include "steiner.h"
+#include "suppconn.h"
 #include <string.h>
 #include "ub.h"
 
@@ -153,6 +162,10 @@ struct bbnode *		p1;
 				total_vars += num_y_vars_estimate;  /* Add space for y_ij variables */
 			}
 		}
+		/* The LP always has a coverage variable for each terminal. */
+		if (total_vars < GET_LP_NUM_COLS (bbip -> lp)) {
+			total_vars = GET_LP_NUM_COLS (bbip -> lp);
+		}
 		p -> x	   = NEWA (total_vars, double);
 		/* PSW: zlb and bheur must accommodate all variables, not just FST edges */
 		p -> zlb   = NEWA (2 * total_vars, double);
@@ -634,6 +647,12 @@ struct bbnode *		p2;
 	/* Free failed components */
 	_gst_free_congested_component_list (bbip -> failed_fcomps);
 
+	/* Free the local cut cache */
+	_gst_free_local_cut_cache (bbip -> lccache);
+
+	/* Free the support connectivity */
+	_gst_free_support_conn (bbip -> suppconn);
+
 	free ((char *) bbip);
 }
 
@@ -3,8 +3,8 @@
 	$Id: ckpt.c,v 1.18 2023/04/03 17:49:27 warme Exp $
 
 	File:	ckpt.c
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-6
+	Date:	10/18/2026
 
 	Copyright (c) 1999, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -36,6 +36,8 @@
 		: Fix -Wall issue.
 	e-5:	04/03/2023	warme
 		: Fix -Wall issue.
+	e-6:	10/18/2026	warme
+		: Version 2 checkpoints include separation statistics.
 
 ************************************************************************/
 
@@ -55,6 +57,7 @@
 #include "memory.h"
 #include "parmblk.h"
 #include "solver.h"
+#include <stddef.h>
 #include "steiner.h"
 #include <string.h>
 #include <unistd.h>
@@ -78,7 +81,7 @@ void		_gst_write_upper_bound_checkpoint (struct bbinfo * bbip);
 
 #define	MAGIC_NUMBER	0xC3CBD0D4	/* 'CKPT' with top bits on... */
 
-#define	LATEST_CHECKPOINT_VERSION	1
+#define	LATEST_CHECKPOINT_VERSION	2
 
 
 /*
@@ -637,6 +640,8 @@ struct bbinfo *		bbip;
 	bbip -> params		= NULL;
 	bbip -> rcfile		= NULL;
 	bbip -> failed_fcomps	= NULL;
+	bbip -> lccache		= NULL;
+	bbip -> suppconn	= NULL;
 	bbip -> next_ckpt_time	= 0;
 	bbip -> force_branch_flag = FALSE;
 
@@ -679,15 +684,23 @@ int		version		/* IN - version of data to write */
 )
 {
 int			n;
+size_t			size;
 struct bbstats *	statp;
 
 	statp = NEW (struct bbstats);
+	memset (statp, 0, sizeof (*statp));
 
 	bbip -> statp = statp;
 
-	n = fread (statp, 1, sizeof (*statp), fp);
+	/* Versions prior to 2 have no separation statistics. */
+	size = sizeof (*statp);
+	if (version < 2) {
+		size = offsetof (struct bbstats, sep);
+	}
+
+	n = fread (statp, 1, size, fp);
 
-	return (n EQ sizeof (*statp));
+	return (n EQ ((int) size));
 }
 
 /*
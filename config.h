@@ -50,6 +50,9 @@
 #define CPLEX 2211
 #define CPLEX_VERSION_STRING "22.1.1"
 
+/* Define if using HiGHS for the main LP (lp_solve for the rest). */
+/* #undef HIGHS */
+
 /* Define if using lp_solve instead of cplex. */
 /* #undef LPSOLVE */
 
@@ -115,6 +118,9 @@
 /* Define if we have sigaction() and "struct sigaction". */
 #define HAVE_SIGACTION 1
 
+/* Define if POSIX threads are available. */
+#define HAVE_PTHREADS 1
+
 /* Define the directories where package is installed */
 #define INSTALLDIR_PREFIX "/usr/local"
 #define INSTALLDIR_EXEC_PREFIX "/usr/local"
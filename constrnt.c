@@ -3,8 +3,8 @@
 	$Id: constrnt.c,v 1.25 2023/04/03 17:47:41 warme Exp $
 
 	File:	constrnt.c
-	Rev:	e-6
-	Date:	04/03/2023
+	Rev:	e-10
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -48,6 +48,17 @@
 		:  basis upon return.
 		: Fix mis-spelled function name.
 		: Added comment.
+	e-7:	10/18/2026	warme
+		: Fix out-of-bounds read of row flags when restoring
+		:  a node's LP under lp_solve.
+	e-8:	10/18/2026	warme
+		: Perform all operations on the LP through the
+		:  table of LP solver operations.
+	e-9:	10/18/2026	warme
+		: Add only the most efficacious of the violated
+		:  rows found by each round of separation.
+	e-10:	10/18/2026	warme
+		: Save the LP dual values for Lagrangian bounding.
 
 ************************************************************************/
 
@@ -59,12 +70,14 @@
 #include "expand.h"
 #include "fatal.h"
 #include <float.h>
+#include "lagrange.h"
 #include <limits.h>
 #include "logic.h"
 #include <math.h>
 #include "memory.h"
 #include "parmblk.h"
 #include "point.h"
+#include "sortfuncs.h"
 #include <stdlib.h>
 #include "steiner.h"
 #include <string.h>
@@ -134,12 +147,15 @@ int		_gst_solve_LP_over_constraint_pool (struct bbinfo * bbip);
  * Local Routines
  */
 
+static int		compare_efficacy (int, int, void *);
 static double		compute_slack_value (struct rcoef *, double *);
 static void		garbage_collect_pool (struct cpool *, int, int, gst_param_ptr);
 static void		print_pool_memory_usage (struct cpool *,
 						 gst_channel_ptr);
 static void		prune_pending_rows (struct bbinfo *, bool);
 static void		reduce_constraint (struct rcoef *);
+static void		reload_LP (struct bbinfo *);
+static void		select_pending_rows (struct bbinfo *);
 static struct rblk *	reverse_rblks (struct rblk *);
 static int		solve_single_LP (struct bbinfo *,
 					 double *,
@@ -156,15 +172,6 @@ static struct mst_correction_info *
 					    bitmap_t * edge_mask,
 					    int nedges);
 static void		free_mst_correction_info (struct mst_correction_info * info);
-
-#if CPLEX
-static void		reload_cplex_problem (struct bbinfo *);
-#endif
-
-#if LPSOLVE
-static void		get_current_basis (LP_t *, int *, int *);
-static void		set_current_basis (LP_t *, int *, int *);
-#endif
 
 
 /*
@@ -1274,6 +1281,7 @@ size_t		nbytes;
 	rcp -> flags	= 0;
 	rcp -> uid	= (pool -> uid)++;
 	rcp -> refc	= 0;		/* no OTHER node references it! */
+	rcp -> dual	= 0.0;
 	*hookp = row;
 
 	if (add_to_lp) {
@@ -1798,10 +1806,11 @@ char			tbuf [32];
 
 /*
  * This routine sets up the LP problem instance for the initial
- * constraints of the LP relaxation.
+ * constraints of the LP relaxation.  The LP itself is created by
+ * the load operation of the LP solver.
  */
 
-#if LPSOLVE
+#ifndef CPLEX
 
 	LP_t *
 _gst_build_initial_formulation (
@@ -1825,9 +1834,11 @@ int			var;
 struct rcon *		rcp;
 struct rcoef *		cp;
 LP_t *			lp;
-double *		rowvec;
+double *		objx;
+double *		bdl;
+double *		bdu;
 double *		rhs;
-short *			ctype;
+char *			senx;
 int *			matbeg;
 int *			matind;
 double *		matval;
@@ -1870,29 +1881,18 @@ char			tbuf [32];
 			nterms, ncoeff);
 	}
 
-	/* Make the initial LP... */
-	lp = make_lp (0, ncols);
-
-	/* Set MIP gap tolerance (epsilon) - controls integrality tolerance */
-	lp->epsilon = 0.00001;  /* 0.001% tolerance for MIP gap */
-	fprintf(stderr, "DEBUG LP_SETUP: Created LP with 0 rows, %d columns (nedges=%d + nterms=%d), epsilon=%.6f\n",
-		ncols, nedges, nterms, lp->epsilon);
-
 	/* All variables are 0-1 variables... */
-	/* PSW: FST selection variables x_i */
-	for (i = 1; i <= nedges; i++) {
-		set_bounds (lp, i, 0.0, 1.0);
-	}
-	/* PSW: Terminal coverage variables not_covered_t */
-	for (i = nedges + 1; i <= nedges + nterms; i++) {
-		set_bounds (lp, i, 0.0, 1.0);
+	/* PSW: FST selection variables x_i, followed by the	*/
+	/* terminal coverage variables not_covered_t.		*/
+	bdl = NEWA (ncols, double);
+	bdu = NEWA (ncols, double);
+	for (i = 0; i < ncols; i++) {
+		bdl [i] = 0.0;
+		bdu [i] = 1.0;
 	}
 	fprintf(stderr, "DEBUG SOFT: Set bounds for %d FST vars [1-%d] and %d coverage vars [%d-%d]\n",
 		nedges, nedges, nterms, nedges+1, nedges+nterms);
 
-	/* Minimize */
-	set_minim (lp);
-
 	/* Build the objective function... */
 	/* PSW: Multi-objective: minimize (normalized_tree_length + alpha * normalized_battery_score + beta * uncovered_terminals) */
 
@@ -1910,18 +1910,17 @@ char			tbuf [32];
 
 	fprintf(stderr, "DEBUG OBJ: Using normalized costs - alpha=%.1f (battery switching), beta=%.0f (coverage penalty)\n", alpha, beta);
 
-	rowvec = NEWA (ncols + 1, double);
-	fprintf(stderr, "DEBUG OBJ: Allocated rowvec[0-%d] for ncols=%d LP variables\n", ncols, ncols);
-	for (i = 0; i <= ncols; i++) {
-		rowvec [i] = 0.0;
+	objx = NEWA (ncols, double);
+	for (i = 0; i < ncols; i++) {
+		objx [i] = 0.0;
 	}
 
 	/* PSW: Use GLOBAL normalization constants computed during hypergraph initialization */
 	double max_fst_cost = cip -> max_fst_cost;
 	double max_battery_cost = cip -> max_battery_cost;
 
-	fprintf(stderr, "USING GLOBAL NORMALIZATION (lp_solve): max_fst_cost=%.6f, max_battery_cost=%.6f\n",
-		max_fst_cost, max_battery_cost);
+	fprintf(stderr, "USING GLOBAL NORMALIZATION (%s): max_fst_cost=%.6f, max_battery_cost=%.6f\n",
+		_gst_lpops.name, max_fst_cost, max_battery_cost);
 
 	/* PSW: Compute FST selection terms with globally normalized costs */
 	for (i = 0; i < nedges; i++) {
@@ -1963,29 +1962,17 @@ char			tbuf [32];
 		 * This provides ~10-20% battery impact for switching behavior */
 		double battery_cost_term = battery_cost_sum;
 
-		rowvec [i + 1] = scaled_tree_cost + battery_cost_term;
+		objx [i] = scaled_tree_cost + battery_cost_term;
 		fprintf(stderr, "DEBUG OBJ: FST %d: tree=%.3f (scaled=%.3f), battery_sum=%.6f, combined=%.3f (covers %d terminals)\n",
-				i, tree_cost, scaled_tree_cost, battery_cost_term, rowvec[i + 1], num_terminals_lp);
+				i, tree_cost, scaled_tree_cost, battery_cost_term, objx[i], num_terminals_lp);
 	}
 
 	/* PSW: Terminal coverage penalty terms: beta * not_covered_t */
 	for (i = 0; i < nterms; i++) {
-		rowvec[nedges + 1 + i] = beta;  /* Penalty for each uncovered terminal (1-based for objective) */
+		objx[nedges + i] = beta;  /* Penalty for each uncovered terminal */
 	}
 	fprintf(stderr, "DEBUG OBJ: Added penalty terms beta=%.0f for %d not_covered variables [%d-%d]\n",
 		beta, nterms, nedges+1, nedges+nterms);
-#if 1
-	inc_mat_space (lp, ncols + 1);
-#endif
-	set_obj_fn (lp, rowvec);
-
-	/* PSW: Debug LP matrix structure */
-	if (getenv("GEOSTEINER_BUDGET") != NULL) {
-		fprintf(stderr, "DEBUG LP_MATRIX: LP has %d rows, %d columns after setup\n",
-			lp->rows, lp->columns);
-	}
-
-	free ((char *) rowvec);
 
 	int extra_rows = 0;
 	int extra_coeff = 0;
@@ -2026,12 +2013,12 @@ char			tbuf [32];
 
 	/* Allocate arrays for setting the rows... */
 	rhs	= NEWA (nrows + extra_rows, double);
-	ctype	= NEWA (nrows + extra_rows, short);
+	senx	= NEWA (nrows + extra_rows, char);
 	matbeg	= NEWA (nrows + extra_rows + 1, int);
 	matind	= NEWA (ncoeff + extra_coeff, int);
 	matval	= NEWA (ncoeff + extra_coeff, double);
 
-	/* Put the rows into the format that LP-solve wants them in...	*/
+	/* Put the rows into the format that the LP solver wants...	*/
 	/* PSW: Track terminal index for adding not_covered variables to soft coverage constraints */
 	int terminal_idx = 0;
 
@@ -2078,9 +2065,9 @@ char			tbuf [32];
 
 		rhs [i] = cp -> val;
 		switch (var) {
-		case RC_OP_LE:	ctype [i] = REL_LE;	break;
-		case RC_OP_EQ:	ctype [i] = REL_EQ;	break;
-		case RC_OP_GE:	ctype [i] = REL_GE;	break;
+		case RC_OP_LE:	senx [i] = 'L';	break;
+		case RC_OP_EQ:	senx [i] = 'E';	break;
+		case RC_OP_GE:	senx [i] = 'G';	break;
 		default:
 			FATAL_ERROR;
 			break;
@@ -2116,21 +2103,23 @@ char			tbuf [32];
 	fprintf(stderr, "DEBUG MATRIX: matbeg[%d] = %d (should equal nzi)\n", nrows + extra_rows, matbeg[nrows + extra_rows]);
 
 
-	/* Call add_rows and trace what happens */
-	fprintf(stderr, "DEBUG LP: Calling add_rows with %d rows\n", nrows + extra_rows);
-	fprintf(stderr, "DEBUG LP: Before add_rows: LP has %d rows, %d cols, %d nonzeros\n",
-		GET_LP_NUM_ROWS(lp), GET_LP_NUM_COLS(lp), GET_LP_NUM_NZ(lp));
-
-	add_rows (lp, 0, nrows + extra_rows, rhs, ctype, matbeg, matind, matval);
+	/* Make the initial LP... */
+	lp = (*_gst_lpops.load) (ncols, objx, bdl, bdu,
+				 nrows + extra_rows, rhs, senx,
+				 matbeg, matind, matval,
+				 lpmem, params);
 
-	fprintf(stderr, "DEBUG LP: After add_rows: LP has %d rows, %d cols, %d nonzeros\n",
+	fprintf(stderr, "DEBUG LP: Created LP with %d rows, %d cols, %d nonzeros\n",
 		GET_LP_NUM_ROWS(lp), GET_LP_NUM_COLS(lp), GET_LP_NUM_NZ(lp));
 
 	free ((char *) matval);
 	free ((char *) matind);
 	free ((char *) matbeg);
-	free ((char *) ctype);
+	free ((char *) senx);
 	free ((char *) rhs);
+	free ((char *) objx);
+	free ((char *) bdu);
+	free ((char *) bdl);
 
 	/* PSW: Debug nlprows calculation */
 	fprintf(stderr, "DEBUG NLPROWS: nrows=%d, extra_rows=%d, setting nlprows=%d\n",
@@ -2141,24 +2130,6 @@ char			tbuf [32];
 
 	verify_pool (pool);
 
-#if 0
-	{ FILE *	fp;
-		fp = fopen ("main.lp", "w");
-		FATAL_ERROR_IF (fp EQ NULL);
-		write_LP (lp, fp);
-		fclose (fp);
-	}
-#endif
-
-	if (params -> lp_solve_perturb) {
-		/* Turn on perturbations to deal with degeneracy... */
-		lp -> anti_degen = TRUE;
-	}
-	if (params -> lp_solve_scale) {
-		/* Turn on auto-scaling of the matrix... */
-		auto_scale (lp);
-	}
-
 	T1 = _gst_get_cpu_time ();
 	_gst_convert_cpu_time (T1 - T0, tbuf);
 	gst_channel_printf (params -> print_solve_trace, "_gst_build_initial_formulation: %s seconds.\n", tbuf);
@@ -2456,11 +2427,9 @@ double			z;
 }
 
 /*
- * This routine solves a single LP tableaux using LP_SOLVE.
+ * This routine solves a single LP tableaux.
  */
 
-#ifdef LPSOLVE
-
 	static
 	int
 solve_single_LP (
@@ -2476,9 +2445,17 @@ int			status;
 double			z;
 LP_t *			lp;
 double *		slack;
-int			nslack;
+double *		xbuf;
 double *		djbuf;
+int			nrows;
+int			ncols;
+int			nx;
+int			nslack;
+bool			scaling_disabled;
 struct gst_hypergraph *	cip;
+gst_channel_ptr		print_solve_trace;
+
+	print_solve_trace = bbip -> params -> print_solve_trace;
 
 	(void) pool_iteration;
 
@@ -2489,99 +2466,119 @@ struct gst_hypergraph *	cip;
 	restore_call_count++;
 	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
 
-#if 0
-	/* Debug code to dump each LP instance attempted... */
-	{ char		buf [64];
-		sprintf (buf,
-			 "Node.%03d.%03d.%03d.lp",
-			 bbip -> node -> num,
-			 bbip -> node -> iter + 1,
-			 pool_iteration);
-		dump_lp (lp, buf);
+	/* PSW: Caller's x and dj hold the FST variables, followed by	*/
+	/* the not_covered variables if in multi-objective mode.	*/
+	nx = cip -> num_edges;
+	if (getenv("GEOSTEINER_BUDGET") != NULL) {
+		/* Count terminals for not_covered variables - must match other logic */
+		bitmap_t* vert_mask = cip -> initial_vert_mask;
+		for (i = 0; i < cip -> num_verts; i++) {
+			if (BITON (vert_mask, i) && cip -> tflag[i]) {
+				nx++;
+			}
+		}
 	}
-#endif
 
+	scaling_disabled = FALSE;
+
+retry_lp:
 	/* Solve the current LP instance... */
-	status = solve (lp);
+	ncols = GET_LP_NUM_COLS (lp);
+	xbuf	= NEWA (ncols, double);
+	djbuf	= NEWA (ncols, double);
 
-	/* Get current LP solution... */
-	z = lp -> best_solution [0];
+	status = (*_gst_lpops.solve) (lp,
+				      bbip -> lpmem,
+				      &z,
+				      xbuf,
+				      djbuf,
+				      bbip -> slack);
 
-	/* PSW: Read FST variables */
-	for (i = 0; i < cip -> num_edges; i++) {
-		x [i] = lp -> best_solution [lp -> rows + i + 1];
+	if ((status EQ LPS_OPTIMAL) AND bbip -> params -> lagrangian_bound) {
+		_gst_save_lp_duals (bbip);
 	}
 
-	/* PSW: Read not_covered variables if in multi-objective mode */
-	if (getenv("GEOSTEINER_BUDGET") != NULL) {
-		/* Count terminals for not_covered variables - must match other logic */
-		bitmap_t* vert_mask = cip -> initial_vert_mask;
-		int nterms = 0;
-		for (int j = 0; j < cip -> num_verts; j++) {
-			if (BITON (vert_mask, j) && cip -> tflag[j]) {
-				nterms++;
-			}
-		}
-		for (i = 0; i < nterms; i++) {
-			x [cip -> num_edges + i] = lp -> best_solution [lp -> rows + cip -> num_edges + i + 1];
-		}
-		fprintf(stderr, "DEBUG SOLUTION: Read %d FST + %d not_covered variables from LP solution (lp->rows=%d)\n",
-			cip -> num_edges, nterms, lp -> rows);
-		fprintf(stderr, "DEBUG SOLUTION: LP solution array indices: FST[%d-%d], not_covered[%d-%d]\n",
-			lp -> rows + 1, lp -> rows + cip -> num_edges,
-			lp -> rows + cip -> num_edges + 1, lp -> rows + cip -> num_edges + nterms);
-		/* Debug: Show some raw LP solution values */
-		for (i = 0; i < 15 && i < lp->columns + lp->rows + 1; i++) {
-			fprintf(stderr, "DEBUG SOLUTION: lp->best_solution[%d] = %.6f\n", i, lp -> best_solution[i]);
-		}
+	if (nx > ncols) {
+		nx = ncols;
 	}
+	memcpy (x, xbuf, nx * sizeof (double));
+	memcpy (dj, djbuf, nx * sizeof (double));
+	free ((char *) djbuf);
+	free ((char *) xbuf);
 
 	bbip -> node -> z	= z;
 
 	/* Get solution status into solver-independent form... */
 	switch (status) {
-	case OPTIMAL:		status = BBLP_OPTIMAL;		break;
-	case MILP_FAIL:		status = BBLP_CUTOFF;		break;
-	case INFEASIBLE:	status = BBLP_INFEASIBLE;	break;
-	case UNBOUNDED:
-		gst_channel_printf (bbip -> params -> print_solve_trace, "WARNING: LP is unbounded, treating as infeasible\n");
+	case LPS_OPTIMAL:	status = BBLP_OPTIMAL;		break;
+	case LPS_CUTOFF:	status = BBLP_CUTOFF;		break;
+	case LPS_INFEASIBLE:	status = BBLP_INFEASIBLE;	break;
+	case LPS_UNBOUNDED:
+		gst_channel_printf (print_solve_trace, "WARNING: LP is unbounded, treating as infeasible\n");
 		status = BBLP_INFEASIBLE;	break;
+
+	case LPS_UNSCALED_INFEAS:
+		/* The LP solver scaled the problem, found an optimal	*/
+		/* solution, unscaled the solution, but the unscaled	*/
+		/* solution no longer satisfied all of the bound or row	*/
+		/* feasibility tolerances.  We fix this by turning off	*/
+		/* scaling and trying again.  Note that this happens	*/
+		/* very rarely, but that the solver runs much slower	*/
+		/* with scaling turned off, so we don't want to leave	*/
+		/* scaling off if we can help it...			*/
+		if (scaling_disabled) {
+			/* Never supposed to happen when scaling is	*/
+			/* disabled!					*/
+			FATAL_ERROR;
+		}
+
+		gst_channel_printf (print_solve_trace, "TURNING OFF SCALING...\n");
+
+		(*_gst_lpops.set_scaling) (FALSE);
+
+		/* Must reload the entire problem for this to take effect! */
+		reload_LP (bbip);
+		lp = bbip -> lp;
+	restore_call_count++;
+	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
+
+		scaling_disabled = TRUE;
+
+		goto retry_lp;
+
 	default:
-		gst_channel_printf (bbip -> params -> print_solve_trace, "solve status = %d\n", status);
 		FATAL_ERROR;
+		break;
 	}
 
-	/* Grab the reduced costs, for future reference. */
-	djbuf = NEWA (lp -> sum + 1, double);
-	get_reduced_costs (lp, djbuf);
-	memcpy (dj,
-		&djbuf [lp -> rows + 1],
-		lp -> columns * sizeof (double));
-	free ((char *) djbuf);
+	if (scaling_disabled) {
+		/* Must re-enable scaling, or we'll be really slow! */
+		gst_channel_printf (print_solve_trace, "TURNING ON SCALING...\n");
+		(*_gst_lpops.set_scaling) (TRUE);
 
-	/* Grab the values of the slack variables, for future reference. */
-	slack = NEWA (lp -> rows + 1, double);
-	get_slack_vars (lp, slack);
-	memcpy (bbip -> slack, &slack [1], lp -> rows * sizeof (double));
-	free ((char *) slack);
+		/* Must reload entire problem for this to take affect! */
+		reload_LP (bbip);
+		lp = bbip -> lp;
+	restore_call_count++;
+	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
+	}
 
 	/* Print info about the LP tableaux we just solved... */
+	nrows	= GET_LP_NUM_ROWS (lp);
 	slack = bbip -> slack;
 	nslack = 0;
-	for (i = 0; i < lp -> rows; i++) {
+	for (i = 0; i < nrows; i++) {
 		if (slack [i] > FUZZ) {
 			++nslack;
 		}
 	}
-	(void) gst_channel_printf (bbip -> params -> print_solve_trace, "@PL %d rows, %d cols, %d nonzeros,"
+	(void) gst_channel_printf (print_solve_trace, "@PL %d rows, %d cols, %d nonzeros,"
 		       " %d slack, %d tight.\n",
-		       lp -> rows, lp -> columns, lp -> non_zeros,
-		       nslack, lp -> rows - nslack);
+		       nrows, GET_LP_NUM_COLS (lp), GET_LP_NUM_NZ (lp),
+		       nslack, nrows - nslack);
 
 	return (status);
 }
-
-#endif
 
 /*
  * This routine appends "pool -> npend" new rows onto the end of the
@@ -2592,8 +2589,6 @@ struct gst_hypergraph *	cip;
  * must record which row of the LP tableaux it now resides in.
  */
 
-#ifdef LPSOLVE
-
 	void
 _gst_add_pending_rows_to_LP (
 
@@ -2609,12 +2604,13 @@ int			ncoeff;
 int			nzi;
 int			row;
 int			var;
+int			num_nz;
 struct rcon *		rcp;
 struct rcoef *		cp;
 LP_t *			lp;
 struct cpool *		pool;
 double *		rhs;
-short *			ctype;
+char *			sense;
 int *			matbeg;
 int *			matind;
 double *		matval;
@@ -2626,7 +2622,7 @@ double *		matval;
 	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
 	pool	= bbip -> cpool;
 
-	if (lp -> rows NE pool -> nlprows) {
+	if (GET_LP_NUM_ROWS (lp) NE pool -> nlprows) {
 		/* LP is out of sync with the pool... */
 		FATAL_ERROR;
 	}
@@ -2648,25 +2644,29 @@ double *		matval;
 		rcp = &(pool -> rows [row]);
 		/* Constraint not pending? */
 		FATAL_ERROR_IF (rcp -> lprow NE -2);
-		rcp -> lprow = i;
 		ncoeff += rcp -> len;
 	}
 
+	gst_channel_printf (bbip -> params -> print_solve_trace, "@PAP adding %d rows, %d nz to LP\n", newrows, ncoeff);
+
+	num_nz	= GET_LP_NUM_NZ (lp);
+
+	/* Update high-water marks... */
 	if (i2 > pool -> hwmrow) {
 		pool -> hwmrow = i2;
 	}
-	if (lp -> non_zeros + ncoeff > pool -> hwmnz) {
-		pool -> hwmnz = lp -> non_zeros + ncoeff;
+	if (num_nz + ncoeff > pool -> hwmnz) {
+		pool -> hwmnz = num_nz + ncoeff;
 	}
 
 	/* Allocate arrays for setting the rows... */
 	rhs	= NEWA (newrows, double);
-	ctype	= NEWA (newrows, short);
+	sense	= NEWA (newrows, char);
 	matbeg	= NEWA (newrows + 1, int);
 	matind	= NEWA (ncoeff, int);
 	matval	= NEWA (ncoeff, double);
 
-	/* Put the rows into the format that LP-solve wants them in... */
+	/* Put the rows into the format that the LP solver wants... */
 	nzi = 0;
 	j = 0;
 	for (i = i1; i < i2; i++, j++) {
@@ -2682,9 +2682,9 @@ double *		matval;
 		}
 		rhs [j] = cp -> val;
 		switch (var) {
-		case RC_OP_LE:	ctype [j] = REL_LE;	break;
-		case RC_OP_EQ:	ctype [j] = REL_EQ;	break;
-		case RC_OP_GE:	ctype [j] = REL_GE;	break;
+		case RC_OP_LE:	sense [j] = 'L';	break;
+		case RC_OP_EQ:	sense [j] = 'E';	break;
+		case RC_OP_GE:	sense [j] = 'G';	break;
 		default:
 			FATAL_ERROR;
 			break;
@@ -2693,9 +2693,33 @@ double *		matval;
 	matbeg [j] = nzi;
 	FATAL_ERROR_IF (nzi NE ncoeff);
 
-	gst_channel_printf (bbip -> params -> print_solve_trace, "@PAP adding %d rows, %d nz to LP\n", newrows, ncoeff);
+	if (NOT (*_gst_lpops.add_rows) (lp,
+					newrows,
+					rhs,
+					sense,
+					matbeg,
+					matind,
+					matval)) {
+		/* The LP solver has no room for these rows.  We	*/
+		/* throw away the old LP completely and build it	*/
+		/* again from scratch using only the info available	*/
+		/* in the constraint pool.  Hopefully this way we	*/
+		/* avoid poor memory utilization due to fragmentation.	*/
+		free ((char *) matval);
+		free ((char *) matind);
+		free ((char *) matbeg);
+		free ((char *) sense);
+		free ((char *) rhs);
+
+		reload_LP (bbip);
 
-	add_rows (lp, 0, newrows, rhs, ctype, matbeg, matind, matval);
+		return;
+	}
+
+	for (i = i1; i < i2; i++) {
+		row = pool -> lprows [i];
+		pool -> rows [row].lprow = i;
+	}
 
 	pool -> nlprows = i2;
 	pool -> npend	= 0;
@@ -2705,521 +2729,154 @@ double *		matval;
 	free ((char *) matval);
 	free ((char *) matind);
 	free ((char *) matbeg);
-	free ((char *) ctype);
+	free ((char *) sense);
 	free ((char *) rhs);
 }
-
-#endif
 
 /*
- * This routine solves a single LP tableaux using CPLEX.
+ * This routine frees the current LP, and reallocates/rebuilds it from
+ * the current constraint pool.  This routine works even if there are
+ * constraints pending addition to the LP tableaux.  The basis of the
+ * rows already in the LP is preserved, and the pending rows are then
+ * appended with their slack variables basic.
  */
 
-#ifdef CPLEX
-
 	static
-	int
-solve_single_LP (
+	void
+reload_LP (
 
-struct bbinfo *		bbip,		/* IN - branch and bound info */
-double *		x,		/* OUT - LP solution variables */
-double *		dj,		/* OUT - LP reduced costs */
-int			pool_iteration	/* IN - pool iteration number */
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
 )
 {
 int			i;
-int			status;
-double			z;
+int			j;
+int			i1;
+int			newrows;
+int			row;
+int			nedges;
+struct rcon *		rcp;
 LP_t *			lp;
-double *		slack;
-int			nrows;
-int			ncols;
-int			non_zeros;
-int			nslack;
-bool			scaling_disabled;
-int			small;
-int			big;
-int			obj_scale;
-gst_channel_ptr		print_solve_trace;
-
-	print_solve_trace = bbip -> params -> print_solve_trace;
-
-	(void) pool_iteration;
+struct cpool *		pool;
+int *			cstat;
+int *			rstat;
+int *			b_index;
+double *		b_lb;
+double *		b_ub;
 
 	lp	= bbip -> lp;
 	restore_call_count++;
 	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
+	pool	= bbip -> cpool;
 
-	scaling_disabled = FALSE;
+	newrows	= pool -> npend;
+	i1	= pool -> nlprows;
 
-retry_lp:
-	/* Solve the current LP instance... */
-	status = _MYCPX_dualopt (lp);
-	if (status NE 0) {
-		gst_channel_printf (print_solve_trace, " WARNING dualopt: status = %d\n", status);
-	}
-
-	/* Get current LP solution... */
-	i = _MYCPX_solution (lp,
-			     &status,		/* solution status */
-			     &z,		/* objective value */
-			     x,			/* solution variables */
-			     NULL,		/* IGNORE dual values */
-			     bbip -> slack,	/* slack variables */
-			     dj);		/* reduced costs */
-	if (i NE 0) {
-		fprintf (stderr, "err_code = %d\n", i);
-		FATAL_ERROR;
-	}
+	gst_channel_printf (bbip -> params -> print_solve_trace, "REALLOCATING %s PROBLEM...\n", _gst_lpops.name);
+
+	/* Save off the current basis... */
+	/* PSW: cstat must accommodate all LP columns (FST + not_covered + y_ij), not just FST edges */
+	cstat = NEWA (GET_LP_NUM_COLS (lp), int);
+	rstat = NEWA (i1 + 1, int);
+	(*_gst_lpops.get_basis) (lp, cstat, rstat);
 
-	obj_scale = bbip -> lpmem -> obj_scale;
-	ncols	  = _MYCPX_getnumcols (lp);
+	/* Free up the current LP... */
+	_gst_destroy_initial_formulation (bbip);
 
-	if (obj_scale NE 0) {
-		/* Unscale CPLEX results. */
-		z = ldexp (z, obj_scale);
-		for (i = 0; i < ncols; i++) {
-			dj [i] = ldexp (dj [i], obj_scale);
+	/* Make all LP rows be pending again, ahead of those	*/
+	/* that were already pending...				*/
+	for (i = 0; i < i1; i++) {
+		row = pool -> lprows [i];
+		rcp = &(pool -> rows [row]);
+		if (rcp -> lprow < 0) {
+			/* Not currently in LP? */
+			FATAL_ERROR;
 		}
+		rcp -> lprow = -2;	/* is now pending... */
 	}
+	pool -> npend	= i1;
+	pool -> nlprows = 0;
 
-	bbip -> node -> z	= z;
-
-	/* Get solution status into solver-independent form... */
-	switch (status) {
-	case _MYCPX_STAT_OPTIMAL:
-		status = BBLP_OPTIMAL;
-		break;
+	/* Build the initial formulation from scratch again... */
+	lp = _gst_build_initial_formulation (pool,
+					     bbip -> vert_mask,
+					     bbip -> edge_mask,
+					     bbip -> cip,
+					     bbip -> lpmem,
+					     bbip -> params);
+	bbip -> lp = lp;
 
-	case _MYCPX_STAT_INFEASIBLE:
-	case _MYCPX_STAT_UNBOUNDED:	/* (CPLEX sometimes gives this for an	*/
-				/* infeasible problem.)			*/
-		status = BBLP_INFEASIBLE;
-		break;
+	pool -> npend = newrows;
 
-	case _MYCPX_STAT_ABORT_OBJ_LIM:	/* Objective limit exceeded... */
-		status = BBLP_CUTOFF;
-		break;
+	/* The initial formulation bounds all variables	*/
+	/* from 0 to 1.  We must restore the proper	*/
+	/* bounds for all variables that have been	*/
+	/* fixed to 0 or 1...				*/
 
-	case _MYCPX_STAT_OPTIMAL_INFEAS:
-		/* This means that CPLEX scaled the problem, found an	*/
-		/* optimal solution, unscaled the solution, but that	*/
-		/* the unscaled solution no longer satisfied all of the	*/
-		/* bound or row feasibility tolerances (i.e. the the	*/
-		/* unscaled solution is no longer feasible).  We fix	*/
-		/* This by turning off scaling and trying again.  Note	*/
-		/* that this happens very rarely, but that CPLEX runs	*/
-		/* much slower with scaling turned off, so we don't	*/
-		/* want to leave scaling off if we can help it...	*/
-		if (scaling_disabled) {
-			/* CPLEX is never supposed to return this code	*/
-			/* when scaling is diabled!			*/
-			FATAL_ERROR;
+	nedges = bbip -> cip -> num_edges;
+	b_index = NEWA (nedges, int);
+	b_lb	= NEWA (nedges, double);
+	b_ub	= NEWA (nedges, double);
+	j = 0;
+	for (i = 0; i < nedges; i++) {
+		if (NOT BITON (bbip -> fixed, i)) continue;
+		b_index [j] = i;
+		if (NOT BITON (bbip -> value, i)) {
+			b_lb [j] = 0.0;
+			b_ub [j] = 0.0;
+		}
+		else {
+			b_lb [j] = 1.0;
+			b_ub [j] = 1.0;
 		}
+		++j;
+	}
 
-		gst_channel_printf (print_solve_trace, "TURNING OFF SCALING...\n");
+	if (j > 0) {
+		(*_gst_lpops.change_bounds) (lp, j, b_index, b_lb, b_ub);
+	}
 
-		if (_MYCPX_setscaind (-1, &small, &big) NE 0) {
-			FATAL_ERROR;
-		}
+	free ((char *) b_ub);
+	free ((char *) b_lb);
+	free ((char *) b_index);
 
-		/* Must reload the entire problem for this to take effect! */
-		reload_cplex_problem (bbip);
-		lp = bbip -> lp;
-	restore_call_count++;
-	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
+	/* Restore the basis... */
+	(*_gst_lpops.set_basis) (lp, cstat, rstat);
+	free ((char *) rstat);
+	free ((char *) cstat);
 
-		scaling_disabled = TRUE;
+	/* Now append the rows that were pending... */
+	_gst_add_pending_rows_to_LP (bbip);
+}
+
+/*
+ * This routine marks a single row as "pending addition to the LP tableaux,"
+ * assuming it is not already pending or in the LP.
+ */
 
-		goto retry_lp;
+	void
+_gst_mark_row_pending_to_LP (
 
-	default:
-		fprintf (stderr, "Unexpected status = %d\n", status);
-		_MYCPX_lpwrite (lp, "core.lp");
+struct cpool *		pool,		/* IN - constraint pool */
+int			row		/* IN - row to mark pending */
+)
+{
+int			i;
+struct rcon *		rcp;
+
+	FATAL_ERROR_IF ((row < 0) OR (row >= pool -> nrows));
+	rcp = &(pool -> rows [row]);
+	if ((rcp -> lprow >= 0) OR (rcp -> lprow EQ -2)) {
+		/* Row is already in the LP, or was previously	*/
+		/* made pending...				*/
+		return;
+	}
+	if (rcp -> lprow NE -1) {
+		/* Pool constraint has bad state... */
 		FATAL_ERROR;
-		break;
 	}
 
-	if (scaling_disabled) {
-		/* Must re-enable scaling, or we'll be really slow! */
-		gst_channel_printf (print_solve_trace, "TURNING ON SCALING...\n");
-		if (_MYCPX_setscaind (0, &small, &big) NE 0) {
-			FATAL_ERROR;
-		}
-
-		/* Must reload entire problem for this to take affect! */
-		reload_cplex_problem (bbip);
-		lp = bbip -> lp;
-	restore_call_count++;
-	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
-	}
-
-	/* Print info about the LP tableaux we just solved... */
-	nrows	  = _MYCPX_getnumrows (lp);
-	ncols	  = _MYCPX_getnumcols (lp);
-	non_zeros = _MYCPX_getnumnz (lp);
-	slack = bbip -> slack;
-	nslack = 0;
-	for (i = 0; i < nrows; i++) {
-		if (slack [i] > FUZZ) {
-			++nslack;
-		}
-	}
-	(void) gst_channel_printf (print_solve_trace, "@PL %d rows, %d cols, %d nonzeros,"
-		       " %d slack, %d tight.\n",
-		       nrows, ncols, non_zeros,
-		       nslack, nrows - nslack);
-
-	return (status);
-}
-
-#endif
-
-/*
- * This routine appends "pool -> npend" new rows onto the end of the
- * LP tableaux from the constraint pool.  The constraint numbers of
- * the actual pool constraints to add reside at the end of the
- * "pool -> lprows []" array (starting with element pool -> nlprows).
- * An additional detail is that for each pool constraint we add, we
- * must record which row of the LP tableaux it now resides in.
- */
-
-#ifdef CPLEX
-
-	void
-_gst_add_pending_rows_to_LP (
-
-struct bbinfo *		bbip		/* IN - branch and bound info */
-)
-{
-int			i;
-int			j;
-int			i1;
-int			i2;
-int			newrows;
-int			ncoeff;
-int			row;
-int			nzi;
-int			var;
-int			num_nz;
-struct rcon *		rcp;
-struct rcoef *		cp;
-LP_t *			lp;
-struct cpool *		pool;
-double *		rhs;
-char *			sense;
-int *			matbeg;
-int *			matind;
-double *		matval;
-
-	verify_pool (bbip -> cpool);
-
-	lp	= bbip -> lp;
-	restore_call_count++;
-	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
-	pool	= bbip -> cpool;
-
-	if (_MYCPX_getnumrows (lp) NE pool -> nlprows) {
-		/* LP is out of sync with the pool... */
-		FATAL_ERROR;
-	}
-
-	/* Get number of rows and non-zeros to add to LP... */
-	newrows = pool -> npend;
-
-	FATAL_ERROR_IF (newrows < 0);
-
-	if (newrows EQ 0) return;
-
-	i1	= pool -> nlprows;
-	i2	= i1 + newrows;
-
-	/* Get number of rows and non-zeros to add to LP... */
-	ncoeff = 0;
-	for (i = i1; i < i2; i++) {
-		row = pool -> lprows [i];
-		rcp = &(pool -> rows [row]);
-		if (rcp -> lprow NE -2) {
-			/* Constraint not pending? */
-			FATAL_ERROR;
-		}
-		rcp -> lprow = i;
-		ncoeff += rcp -> len;
-	}
-
-
-	gst_channel_printf (bbip -> params -> print_solve_trace, "@PAP adding %d rows, %d nz to LP\n", newrows, ncoeff);
-
-	num_nz	  = _MYCPX_getnumnz (lp);
-
-	/* Update high-water marks... */
-	if (i2 > pool -> hwmrow) {
-		pool -> hwmrow = i2;
-	}
-	if (num_nz + ncoeff > pool -> hwmnz) {
-		pool -> hwmnz = num_nz + ncoeff;
-	}
-
-#ifndef CPLEX_HAS_CREATEPROB
-	/* Check to see if the current CPLEX allocations are	*/
-	/* sufficient.  If not, we must reallocate...		*/
-	{ int row_space;
-	  int nz_space;
-	  row_space = _MYCPX_getrowspace (lp);
-	  nz_space  = _MYCPX_getnzspace (lp);
-	  if ((i2 > row_space) OR (num_nz + ncoeff > nz_space)) {
-		/* We must reallocate!  We do this by throwing away the */
-		/* old LP completely and building it again from scratch	*/
-		/* using only the info available in the constraint	*/
-		/* pool.  Hopefully this way we avoid poor memory	*/
-		/* utilization due to fragmentation...			*/
-
-		reload_cplex_problem (bbip);
-
-		return;
-	  }
-	}
-#endif
-
-	/* Allocate arrays for setting the rows... */
-	rhs	= NEWA (newrows, double);
-	sense	= NEWA (newrows, char);
-	matbeg	= NEWA (newrows + 1, int);
-	matind	= NEWA (ncoeff, int);
-	matval	= NEWA (ncoeff, double);
-
-	/* Put the rows into the format that CPLEX wants them in... */
-	int ncols_lp = _MYCPX_getnumcols (lp);
-	fprintf(stderr, "DEBUG ADDROWS: LP has %d columns, adding %d rows with %d coeffs\n", ncols_lp, newrows, ncoeff);
-	nzi = 0;
-	j = 0;
-	for (i = i1; i < i2; i++, j++) {
-		row = pool -> lprows [i];
-		rcp = &(pool -> rows [row]);
-		matbeg [j] = nzi;
-		fprintf(stderr, "DEBUG ADDROWS: Row %d (pool row %d): ", j, row);
-		for (cp = rcp -> coefs; ; cp++) {
-			var = cp -> var;
-			if (var < RC_VAR_BASE) break;
-			int col_idx = var - RC_VAR_BASE;
-			if (col_idx >= ncols_lp) {
-				fprintf(stderr, "ERROR ADDROWS: Column index %d >= LP columns %d!\n", col_idx, ncols_lp);
-				fprintf(stderr, "ERROR ADDROWS: var=%d, RC_VAR_BASE=%d, coefficient=%f\n", var, RC_VAR_BASE, (double)(cp -> val));
-				FATAL_ERROR;
-			}
-			matind [nzi] = col_idx;
-			matval [nzi] = cp -> val;
-			fprintf(stderr, "x[%d]*%f ", col_idx, (double)(cp -> val));
-			++nzi;
-		}
-		rhs [j] = cp -> val;
-		char sense_char = '?';
-		switch (var) {
-		case RC_OP_LE:	sense [j] = 'L';	sense_char = '<'; break;
-		case RC_OP_EQ:	sense [j] = 'E';	sense_char = '='; break;
-		case RC_OP_GE:	sense [j] = 'G';	sense_char = '>'; break;
-		default:
-			FATAL_ERROR;
-			break;
-		}
-		fprintf(stderr, "%c= %f\n", sense_char, (double)(rhs[j]));
-	}
-	matbeg [j] = nzi;
-	FATAL_ERROR_IF (nzi NE ncoeff);
-
-	fprintf(stderr, "DEBUG ADDROWS: About to call _MYCPX_addrows with ncols=%d, nrows_before=%d\n",
-		_MYCPX_getnumcols(lp), _MYCPX_getnumrows(lp));
-	fprintf(stderr, "DEBUG ADDROWS: matbeg array: ");
-	for (int k = 0; k <= newrows; k++) {
-		fprintf(stderr, "%d ", matbeg[k]);
-	}
-	fprintf(stderr, "\n");
-	i = _MYCPX_addrows (lp,
-			    0,
-			    newrows,
-			    ncoeff,
-			    rhs,
-			    sense,
-			    matbeg,
-			    matind,
-			    matval,
-			    NULL,
-			    NULL);
-	fprintf(stderr, "DEBUG ADDROWS: _MYCPX_addrows returned %d, nrows_after=%d\n", i, _MYCPX_getnumrows(lp));
-
-	FATAL_ERROR_IF (i NE 0);
-
-	pool -> nlprows = i2;
-	pool -> npend	= 0;
-
-	verify_pool (bbip -> cpool);
-
-	free ((char *) matval);
-	free ((char *) matind);
-	free ((char *) matbeg);
-	free ((char *) sense);
-	free ((char *) rhs);
-}
-
-#endif
-
-/*
- * This routine frees the current CPLEX problem, and reallocates/rebuilds
- * it from the current constraint pool.  This routine works even if
- * there are constraints pending addition to the LP tableaux.
- */
-
-#if CPLEX
-
-	static
-	void
-reload_cplex_problem (
-
-struct bbinfo *		bbip		/* IN - branch-and-bound info */
-)
-{
-int			i;
-int			j;
-int			i1;
-int			i2;
-int			newrows;
-int			row;
-int			nedges;
-struct rcon *		rcp;
-LP_t *			lp;
-struct cpool *		pool;
-int *			cstat;
-int *			rstat;
-int *			b_index;
-char *			b_lu;
-double *		b_bd;
-
-	lp	= bbip -> lp;
-	restore_call_count++;
-	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
-	pool	= bbip -> cpool;
-
-	newrows	= pool -> npend;
-	i1	= pool -> nlprows;
-	i2	= i1 + newrows;
-
-	gst_channel_printf (bbip -> params -> print_solve_trace, "REALLOCATING CPLEX PROBLEM...\n");
-
-	/* Save off the current basis, setting the new	*/
-	/* rows to be basic...				*/
-	/* PSW: cstat must accommodate all LP columns (FST + not_covered + y_ij), not just FST edges */
-	int num_lp_cols = _MYCPX_getnumcols (lp);
-	cstat = NEWA (num_lp_cols, int);
-	rstat = NEWA (i2, int);
-	if (_MYCPX_getbase (lp, cstat, rstat) NE 0) {
-		FATAL_ERROR;
-	}
-	for (i = i1; i < i2; i++) {
-		/* Set slack variables for new rows to be basic... */
-		rstat [i] = 1;
-	}
-
-	/* Free up the current LP... */
-	_gst_destroy_initial_formulation (bbip);
-
-	/* Make all LP rows be pending again... */
-	for (i = 0; i < pool -> nlprows; i++) {
-		row = pool -> lprows [i];
-		rcp = &(pool -> rows [row]);
-		if (rcp -> lprow < 0) {
-			/* Not currently in LP? */
-			FATAL_ERROR;
-		}
-		rcp -> lprow = -2;	/* is now pending... */
-	}
-	pool -> npend += pool -> nlprows;
-	pool -> nlprows = 0;
-
-	/* Build the initial formulation from scratch again... */
-	lp = _gst_build_initial_formulation (pool,
-					     bbip -> vert_mask,
-					     bbip -> edge_mask,
-					     bbip -> cip,
-					     bbip -> lpmem,
-					     bbip -> params);
-	bbip -> lp = lp;
-
-	/* The initial formulation bounds all variables	*/
-	/* from 0 to 1.  We must restore the proper	*/
-	/* bounds for all variables that have been	*/
-	/* fixed to 0 or 1...				*/
-
-	nedges = bbip -> cip -> num_edges;
-	b_index = NEWA (2 * nedges, int);
-	b_lu	= NEWA (2 * nedges, char);
-	b_bd	= NEWA (2 * nedges, double);
-	j = 0;
-	for (i = 0; i < nedges; i++) {
-		if (NOT BITON (bbip -> fixed, i)) continue;
-		b_index [j]	= i;
-		b_lu [j]	= 'L';
-		b_index [j+1]	= i;
-		b_lu [j+1]	= 'U';
-		if (NOT BITON (bbip -> value, i)) {
-			b_bd [j]	= 0.0;
-			b_bd [j+1]	= 0.0;
-		}
-		else {
-			b_bd [j]	= 1.0;
-			b_bd [j+1]	= 1.0;
-		}
-		j += 2;
-	}
-
-	if (j > 0) {
-		if (_MYCPX_chgbds (lp, j, b_index, b_lu, b_bd) NE 0) {
-			FATAL_ERROR;
-		}
-	}
-
-	free ((char *) b_bd);
-	free ((char *) b_lu);
-	free ((char *) b_index);
-
-	/* Restore augmented basis... */
-	if (_MYCPX_copybase (lp, cstat, rstat) NE 0) {
-		FATAL_ERROR;
-	}
-	free ((char *) rstat);
-	free ((char *) cstat);
-}
-
-#endif
-
-/*
- * This routine marks a single row as "pending addition to the LP tableaux,"
- * assuming it is not already pending or in the LP.
- */
-
-	void
-_gst_mark_row_pending_to_LP (
-
-struct cpool *		pool,		/* IN - constraint pool */
-int			row		/* IN - row to mark pending */
-)
-{
-int			i;
-struct rcon *		rcp;
-
-	FATAL_ERROR_IF ((row < 0) OR (row >= pool -> nrows));
-	rcp = &(pool -> rows [row]);
-	if ((rcp -> lprow >= 0) OR (rcp -> lprow EQ -2)) {
-		/* Row is already in the LP, or was previously	*/
-		/* made pending...				*/
-		return;
-	}
-	if (rcp -> lprow NE -1) {
-		/* Pool constraint has bad state... */
-		FATAL_ERROR;
-	}
-
-	/* row is now pending... */
-	rcp -> lprow = -2;
+	/* row is now pending... */
+	rcp -> lprow = -2;
 
 	i = pool -> nlprows + (pool -> npend)++;
 	pool -> lprows [i] = row;
@@ -3298,30 +2955,154 @@ int			num_con;
 		lcp = lcp -> next;
 	}
 
-	if (any_violations) {
-		/* Prune back the pending rows so that only the	*/
-		/* smallest constraints are added to the LP	*/
-		/* the first time around.  The hope is that	*/
-		/* this gives a more sparse LP that can be	*/
-		/* solved more quickly, and that many of the	*/
-		/* larger constraints (that we didn't add in)	*/
-		/* will no longer be violated by the new	*/
-		/* solution.  In other words, why bog down the	*/
-		/* LP solver with lots of dense rows that will	*/
-		/* become slack with the slightest perturbation	*/
-		/* of the solution?				*/
+	if (any_violations) {
+		/* Prune back the pending rows so that only the	*/
+		/* smallest constraints are added to the LP	*/
+		/* the first time around.  The hope is that	*/
+		/* this gives a more sparse LP that can be	*/
+		/* solved more quickly, and that many of the	*/
+		/* larger constraints (that we didn't add in)	*/
+		/* will no longer be violated by the new	*/
+		/* solution.  In other words, why bog down the	*/
+		/* LP solver with lots of dense rows that will	*/
+		/* become slack with the slightest perturbation	*/
+		/* of the solution?				*/
+
+#if 1
+		select_pending_rows (bbip);
+		prune_pending_rows (bbip, FALSE);
+#endif
+
+		/* Add the new violations to the LP tableaux... */
+		_gst_add_pending_rows_to_LP (bbip);
+	}
+
+	print_pool_memory_usage (pool, bbip -> params -> print_solve_trace);
+
+	return (num_con);
+}
+
+/*
+ * Limit the rows added to the LP by one round of separation to the K
+ * pending rows of greatest efficacy, where the efficacy of a row is
+ * the amount by which the LP solution violates it, divided by the
+ * Euclidean norm of its coefficients (i.e., the distance from the LP
+ * solution to the hyperplane of the row).  K grows with the size of
+ * the LP.  Separation often finds more violations than the LP has
+ * rows, and most of the weaker ones become slack as soon as the
+ * stronger ones are added.  The rows not chosen stay in the pool, so
+ * that any of them still violated after the next LP solve are added
+ * by the scan over the pool.
+ */
+
+	static
+	void
+select_pending_rows (
+
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
+)
+{
+int		i;
+int		n;
+int		k;
+int		row;
+int		var;
+int *		parray;
+int *		order;
+double		sum;
+double		norm;
+double		slack;
+double *	efficacy;
+double *	x;
+struct cpool *	pool;
+struct rcoef *	cp;
+
+#define	MIN_BATCH	100
+#define	BATCH_DIVISOR	2
+
+	pool	= bbip -> cpool;
+	x	= bbip -> node -> x;
+
+	n = pool -> npend;
+	k = pool -> nlprows / BATCH_DIVISOR;
+	if (k < MIN_BATCH) {
+		k = MIN_BATCH;
+	}
+	if (n <= k) {
+		/* Few enough to add them all... */
+		return;
+	}
+
+	parray = &(pool -> lprows [pool -> nlprows]);
+
+	efficacy = NEWA (n, double);
+	for (i = 0; i < n; i++) {
+		cp = pool -> rows [parray [i]].coefs;
+		sum = 0.0;
+		for (;;) {
+			var = cp -> var;
+			if (var < RC_VAR_BASE) break;
+			sum += ((double) (cp -> val)) * ((double) (cp -> val));
+			++cp;
+		}
+		norm = sqrt (sum);
+		slack = compute_slack_value (pool -> rows [parray [i]].coefs, x);
+		efficacy [i] = (norm > 0.0) ? (- slack / norm) : 0.0;
+	}
+
+	/* Sort by decreasing efficacy, and keep the first K... */
+	order = _gst_heapsort (n, efficacy, compare_efficacy);
+
+	for (i = k; i < n; i++) {
+		row = parray [order [i]];
+		FATAL_ERROR_IF (pool -> rows [row].lprow NE -2);
+		pool -> rows [row].lprow = -1;
+	}
+
+	/* Compact the chosen rows, retaining their original order.	*/
+	/* Since order [i] >= i once sorted, this can be done in place.	*/
+	_gst_sort_ints (order, k);
+	for (i = 0; i < k; i++) {
+		parray [i] = parray [order [i]];
+	}
+	pool -> npend = k;
+
+	gst_channel_printf (bbip -> params -> print_solve_trace,
+		"@SPR kept %d of %d violated rows\n", k, n);
 
-#if 1
-		prune_pending_rows (bbip, FALSE);
-#endif
+	free ((char *) order);
+	free ((char *) efficacy);
 
-		/* Add the new violations to the LP tableaux... */
-		_gst_add_pending_rows_to_LP (bbip);
-	}
+#undef	BATCH_DIVISOR
+#undef	MIN_BATCH
+}
+
+/*
+ * Comparison function for sorting pending rows by decreasing
+ * efficacy.  Ties are broken by position, so that the order is
+ * deterministic.
+ */
 
-	print_pool_memory_usage (pool, bbip -> params -> print_solve_trace);
+	static
+	int
+compare_efficacy (
 
-	return (num_con);
+int		i1,		/* IN - first index */
+int		i2,		/* IN - second index */
+void *		array		/* IN - efficacy of each row */
+)
+{
+double		key1, key2;
+
+	key1 = ((double *) array) [i1];
+	key2 = ((double *) array) [i2];
+
+	if ((key1 > key2) OR
+	    ((key1 EQ key2) AND (i1 < i2))) {
+		return (-1);
+	}
+
+	return (1);
 }
 
 /*
@@ -3886,117 +3667,6 @@ struct rblk *		tmp;
  * solver has to contend with at any one time.
  */
 
-#ifdef LPSOLVE
-
-	void
-_gst_delete_slack_rows_from_LP (
-
-struct bbinfo *		bbip		/* IN - branch and bound info */
-)
-{
-int			i;
-int			j;
-int			k;
-int			n;
-int			row;
-int			nrows;
-int *			dlist;
-int *			rowflags;
-LP_t *			lp;
-struct cpool *		pool;
-double *		slack;
-struct rcon *		rcp;
-struct bbnode *		nodep;
-
-	lp	= bbip -> lp;
-	restore_call_count++;
-	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
-	pool	= bbip -> cpool;
-	nodep	= bbip -> node;
-
-	if (nodep -> z <= nodep -> delrow_z) {
-		/* Cannot delete any rows until the objective value at	*/
-		/* this node strictly improves over the last time we	*/
-		/* deleted slack rows.					*/
-		return;
-	}
-
-	nrows	= GET_LP_NUM_ROWS (lp);
-
-	if (nrows NE pool -> nlprows) {
-		/* LP and constraint pool are out of sync... */
-		FATAL_ERROR;
-	}
-
-	slack = bbip -> slack;
-
-	n = pool -> nlprows;
-
-	dlist	= NEWA (nrows, int);
-
-	j = 0;
-	k = 0;
-	for (i = 0; i < n; i++) {
-		row = pool -> lprows [i];
-		rcp = &(pool -> rows [row]);
-		FATAL_ERROR_IF (rcp -> lprow NE i);
-		if (slack [i] > FUZZ) {
-			/* This row is slack -- move to delete list... */
-			rcp -> lprow = -1;
-			dlist [k++] = i;
-		}
-		else if ((rcp -> flags) & RCON_FLAG_DISCARD) {
-			/* This row is to be discarded because it is	*/
-			/* shadowed by a new constraint...		*/
-			rcp -> lprow = -1;
-			dlist [k++] = i;
-		}
-		else {
-			/* Slide constraint up to new position in LP... */
-			rcp -> lprow = j;
-			pool -> lprows [j++] = row;
-		}
-	}
-	pool -> nlprows = j;
-
-	/* Copy any pending constraints... */
-	for (i = 0; i < pool -> npend; i++) {
-		pool -> lprows [j++] = pool -> lprows [n + i];
-	}
-
-	if (k > 0) {
-		/* Time to actually delete the constraints.	*/
-
-		gst_channel_printf (bbip -> params -> print_solve_trace, "@D deleting %d slack rows\n", k);
-
-		rowflags = NEWA (n + 1, int);
-		for (i = 0; i <= n; i++) {
-			rowflags [i] = 0;
-		}
-		for (i = 0; i < k; i++) {
-			rowflags [1 + dlist [i]] = 1;
-		}
-		delete_row_set (lp, rowflags);
-
-		free ((char *) rowflags);
-
-		nodep -> delrow_z = nodep -> z;
-	}
-
-	free ((char *) dlist);
-}
-
-#endif
-
-/*
- * This routine deletes all rows from the LP that are currently slack.
- * Note that these constraints remain in the pool.  This is purely an
- * efficiency hack designed to limit the number of rows that the LP
- * solver has to contend with at any one time.
- */
-
-#ifdef CPLEX
-
 	void
 _gst_delete_slack_rows_from_LP (
 
@@ -4009,7 +3679,6 @@ int			k;
 int			n;
 int			row;
 int			nrows;
-int			slack_nz;
 int *			dlist;
 int *			rowflags;
 LP_t *			lp;
@@ -4042,16 +3711,6 @@ struct bbnode *		nodep;
 
 	n = pool -> nlprows;
 
-	k = 0;
-	slack_nz = 0;
-	for (i = 0; i < n; i++) {
-		if (slack [i] > FUZZ) {
-			++k;
-			j = pool -> lprows [i];
-			slack_nz += pool -> rows [j].len;
-		}
-	}
-
 	dlist	= NEWA (nrows, int);
 
 	j = 0;
@@ -4096,9 +3755,8 @@ struct bbnode *		nodep;
 		for (i = 0; i < k; i++) {
 			rowflags [dlist [i]] = 1;
 		}
-		if (_MYCPX_delsetrows (lp, rowflags) NE 0) {
-			FATAL_ERROR;
-		}
+		(*_gst_lpops.delete_rows) (lp, rowflags);
+
 		free ((char *) rowflags);
 
 		nodep -> delrow_z = nodep -> z;
@@ -4106,69 +3764,21 @@ struct bbnode *		nodep;
 
 	free ((char *) dlist);
 }
-
-#endif
-
-/*
- * Free up the LP tableaux for a CPLEX problem.
- */
-
-#ifdef CPLEX
-
-	void
-_gst_destroy_initial_formulation (
-
-struct bbinfo *		bbip		/* IN - branch-and-bound info */
-)
-{
-LP_t *			lp;
-struct lpmem *		lpmem;
-
-	lp	= bbip -> lp;
-	restore_call_count++;
-	fprintf(stderr, "\n=== DEBUG RESTORE CALL #%d ===\n", restore_call_count);
-	lpmem	= bbip -> lpmem;
-
-	/* Free up CPLEX's memory... */
-	if (_MYCPX_freeprob (&lp) NE 0) {
-		FATAL_ERROR;
-	}
-
-	/* Free up our own memory... */
-	free ((char *) (lpmem -> objx));
-	free ((char *) (lpmem -> rhsx));
-	free ((char *) (lpmem -> senx));
-	free ((char *) (lpmem -> matbeg));
-	free ((char *) (lpmem -> matcnt));
-	free ((char *) (lpmem -> matind));
-	free ((char *) (lpmem -> matval));
-	free ((char *) (lpmem -> bdl));
-	free ((char *) (lpmem -> bdu));
-	memset ((char *) lpmem, 0, sizeof (*lpmem));
-
-	bbip -> lp = NULL;
-}
-
-#endif
 
 /*
- * Free up the LP tableaux for an LP_SOLVE problem.
+ * Free up the LP tableaux.
  */
 
-#ifdef LPSOLVE
-
 	void
 _gst_destroy_initial_formulation (
 
 struct bbinfo *		bbip		/* IN - branch-and-bound info */
 )
 {
-	delete_lp (bbip -> lp);
+	(*_gst_lpops.destroy) (bbip -> lp, bbip -> lpmem);
 
 	bbip -> lp = NULL;
 }
-
-#endif
 
 /*
  * This routine records the current state of the node's LP tableaux and
@@ -4234,16 +3844,8 @@ struct rcon *		rcp;
 	nodep -> cstat		= NEWA (nvars + 1, int);
 	fprintf(stderr, "DEBUG SAVE_BASIS: cstat allocated, calling getbase\n");
 
-#ifdef CPLEX
-	if (_MYCPX_getbase (lp, nodep -> cstat, nodep -> rstat) NE 0) {
-		FATAL_ERROR;
-	}
+	(*_gst_lpops.get_basis) (lp, nodep -> cstat, nodep -> rstat);
 	fprintf(stderr, "DEBUG SAVE_BASIS: getbase completed successfully\n");
-#endif
-
-#ifdef LPSOLVE
-	get_current_basis (lp, nodep -> cstat, nodep -> rstat);
-#endif
 
 	/* Now record the rows and bump the reference counts... */
 	j = 0;
@@ -4337,21 +3939,11 @@ int *			rowflags;
 	pool -> nlprows = 0;
 
 	/* Delete all rows from the LP tableaux... */
-	rowflags = NEWA (n, int);
+	rowflags = NEWA (n + 1, int);
 	for (i = 0; i < n; i++) {
 		rowflags [i] = 1;
 	}
-
-#ifdef CPLEX
-	if (_MYCPX_delsetrows (lp, rowflags) NE 0) {
-		FATAL_ERROR;
-	}
-#endif
-
-#ifdef LPSOLVE
-	rowflags [0] = 0;	/* keep the objective row! */
-	delete_row_set (lp, rowflags);
-#endif
+	(*_gst_lpops.delete_rows) (lp, rowflags);
 
 	free ((char *) rowflags);
 
@@ -4400,19 +3992,13 @@ int *			rowflags;
 	/* Load all pending rows into the LP tableaux! */
 	fprintf(stderr, "DEBUG RESTORE: About to add pending rows\n");
 	_gst_add_pending_rows_to_LP (bbip);
+	lp = bbip -> lp;
 
 	if ((nodep -> cstat NE NULL) AND (nodep -> rstat NE NULL)) {
 		fprintf(stderr, "DEBUG RESTORE: About to copybase with %d rows, %d cols\n", GET_LP_NUM_ROWS(lp), GET_LP_NUM_COLS(lp));
 		/* We have a basis to restore... */
 		fprintf(stderr, "DEBUG RESTORE: copybase completed\n");
-#ifdef CPLEX
-		i = _MYCPX_copybase (lp, nodep -> cstat, nodep -> rstat);
-		FATAL_ERROR_IF (i NE 0);
-#endif
-
-#ifdef LPSOLVE
-		set_current_basis (lp, nodep -> cstat, nodep -> rstat);
-#endif
+		(*_gst_lpops.set_basis) (lp, nodep -> cstat, nodep -> rstat);
 		free ((char *) (nodep -> rstat));
 		free ((char *) (nodep -> cstat));
 	}
@@ -4489,103 +4075,6 @@ struct rcon *		rcp_endp;
 	nodep -> cstat	 = NULL;
 }
 
-/*
- * This routine retrieves the current basis under lp_solve, which records
- * the basis differently than CPLEX.  We use the "cstat" array to hold
- * the column upper/lower bound flags of the non-basic columns, and in
- * "rstat" we indicate which column is the basic variable for that row
- * (including slack variable columns).
- */
-
-#ifdef LPSOLVE
-
-	static
-	void
-get_current_basis (
-
-LP_t *		lp,		/* IN - LP tableaux to get basis of */
-int *		cstat,		/* OUT - basis flags for each column */
-int *		rstat		/* OUT - basis flags for each row */
-)
-{
-int		i;
-int		j;
-
-	if (NOT (lp -> basis_valid)) {
-		/* Scribble out the default starting basis. */
-		for (i = 0; i < lp -> rows; i++) {
-			rstat [i] = i + 1;
-		}
-		for (i = 0; i < lp -> columns; i++) {
-			cstat [i] = 1;
-		}
-		return;
-	}
-
-	/* Set the row status flags... */
-	for (i = 0; i < lp -> rows; i++) {
-		rstat [i] = lp -> bas [i + 1];
-	}
-
-	/* Set the column status flags... */
-	j = 0;
-	for (i = 1; i <= lp -> sum; i++) {
-		if (lp -> basis [i]) continue;
-		cstat [j] = lp -> lower [i];
-		++j;
-	}
-}
-
-#endif
-
-/*
- * This routine sets the current basis under lp_solve, which records
- * the basis differently than CPLEX.  We use the "cstat" array to hold
- * the column upper/lower bound flags, and in "rstat" we indicate which
- * column is the basic variable for that row (including slack variable
- * columns).
- */
-
-#ifdef LPSOLVE
-
-	static
-	void
-set_current_basis (
-
-LP_t *		lp,		/* IN - LP tableaux to set basis of */
-int *		cstat,		/* IN - basis flags for each column */
-int *		rstat		/* IN - basis flags for each row */
-)
-{
-int		i;
-int		j;
-
-	for (i = 1; i <= lp -> sum; i++) {
-		lp -> basis [i] = 0;
-		lp -> lower [i] = 1;
-	}
-
-	/* Set the row status flags... */
-	for (i = 0; i < lp -> rows; i++) {
-		j = rstat [i];
-		lp -> bas [i + 1] = j;
-		lp -> basis [j] = 1;
-	}
-
-	/* Set the column status flags... */
-	j = 0;
-	for (i = 1; i <= lp -> sum; i++) {
-		if (lp -> basis [i]) continue;
-		lp -> lower [i] = cstat [j];
-		++j;
-	}
-
-	lp -> basis_valid = TRUE;
-	lp -> eta_valid = FALSE;
-}
-
-#endif
-
 /*
  * This routine prints debugging information about the amount of memory
  * currently being used by the constraint pool.
@@ -4876,12 +4365,8 @@ gst_channel_ptr		trace;
 	gst_channel_printf (trace, "Minimize\n");
 
 
-#ifdef CPLEX
 	C = NEWA (nedges, double);
-
-	if (_MYCPX_getobj (bbip -> lp, C, 0, nedges - 1) NE 0) {
-		FATAL_ERROR;
-	}
+	(*_gst_lpops.get_objective) (bbip -> lp, bbip -> lpmem, nedges, C);
 	for (i = 0; i < nedges; i++) {
 		coeff = C [i];
 		if (coeff EQ 0.0) continue;
@@ -4893,23 +4378,6 @@ gst_channel_ptr		trace;
 		gst_channel_printf (trace, "\t%c %f x%d\n", ch, coeff, i);
 	}
 	free ((char *) C);
-#endif
-
-#ifdef LPSOLVE
-	C = NEWA (nedges + 1, double);
-	get_row (bbip -> lp, 0, C);
-	for (i = 0; i < nedges; i++) {
-		coeff = C [i + 1];
-		if (coeff EQ 0.0) continue;
-		ch = '+';
-		if (coeff < 0.0) {
-			coeff = - coeff;
-			ch = '-';
-		}
-		gst_channel_printf (trace, "\t%c %f x%d\n", ch, coeff, i);
-	}
-	free ((char *) C);
-#endif
 
 	gst_channel_printf (trace, "\nSubject To\n");
 
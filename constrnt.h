@@ -3,8 +3,8 @@
 	$Id: constrnt.h,v 1.14 2022/11/19 13:45:50 warme Exp $
 
 	File:	constrnt.h
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -34,6 +34,8 @@
 		: Reorganize include files, apply prefixes.
 	e-4:	11/18/2022	warme
 		: Simplify calling convention.
+	e-5:	10/18/2026	warme
+		: Added dual value to each pool row.
 
 ************************************************************************/
 
@@ -76,6 +78,7 @@ struct rcon {
 	int		refc;	/* reference count: number of *suspended* */
 				/* nodes for which this constraint is */
 				/* binding */
+	double		dual;	/* dual value when last in an optimal LP */
 };
 
 /* flags */
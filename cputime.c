@@ -3,8 +3,8 @@
 	$Id: cputime.c,v 1.17 2022/11/19 13:45:50 warme Exp $
 
 	File:	cputime.c
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 1993, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -30,6 +30,8 @@
 		: Add new interfaces to encapsulate conversions
 		:  to/from seconds to cpu_time_t units.
 		: Fix -Wall issues.  Upgrade fatals.
+	e-4:	10/18/2026	warme
+		: Added _gst_get_wall_time.
 
 ************************************************************************/
 
@@ -62,6 +64,7 @@ double		_gst_cpu_time_t_to_double_seconds (cpu_time_t ticks);
 cpu_time_t	_gst_double_seconds_to_cpu_time_t (double seconds);
 cpu_time_t	_gst_get_cpu_time (void);
 cpu_time_t	_gst_get_delta_cpu_time (cpu_time_t * Tn);
+cpu_time_t	_gst_get_wall_time (void);
 void		_gst_initialize_cpu_time (struct environment * env);
 cpu_time_t	_gst_int_seconds_to_cpu_time_t (unsigned int seconds);
 
@@ -138,6 +141,17 @@ int32u		Q, R, method;
 	env -> Q = Q;
 	env -> R = R;
 	env -> method = method;
+
+	/* Wall times are measured from here, so they do not overflow. */
+#if defined(UNIX_CPU_TIME) AND defined(CLOCK_MONOTONIC)
+	{ struct timespec	ts;
+
+		clock_gettime (CLOCK_MONOTONIC, &ts);
+		env -> wall_origin = ts.tv_sec;
+	}
+#else
+	env -> wall_origin = time (NULL);
+#endif
 }
 
 	cpu_time_t
@@ -202,6 +216,38 @@ struct environment *	env;
 	return (cpu_time);
 }
 
+/*
+ * This routine gets the elapsed wall-clock time, in the same units as
+ * _gst_get_cpu_time.  Unlike CPU time, it does not run faster when
+ * several threads are busy.  A monotonic clock is used where there is
+ * one, so that changes to the system clock do not matter.  The times
+ * are relative to when _gst_initialize_cpu_time was called.
+ */
+
+	cpu_time_t
+_gst_get_wall_time (void)
+
+{
+int32u			seconds;
+int32u			ticks;
+
+#if defined(UNIX_CPU_TIME) AND defined(CLOCK_MONOTONIC)
+	{ struct timespec	ts;
+
+		clock_gettime (CLOCK_MONOTONIC, &ts);
+
+		seconds	= ts.tv_sec - gst_env -> wall_origin;
+		ticks	= ts.tv_nsec / (1000000000 / TICKS_PER_SEC);
+	}
+#else
+	/* Using the ANSI C defined interface... */
+	seconds	= time (NULL) - gst_env -> wall_origin;
+	ticks	= 0;
+#endif
+
+	return (seconds * TICKS_PER_SEC + ticks);
+}
+
 /*
  * This routine will convert the given CPU time into a printable
  * null-terminated ASCII string.  The answer contains two decimal places.
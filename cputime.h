@@ -3,8 +3,8 @@
 	$Id: cputime.h,v 1.6 2022/11/19 13:45:50 warme Exp $
 
 	File:	cputime.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -28,6 +28,8 @@
 		: Reorganize include files, apply prefixes.
 		: Add new iterfaces to encapsulate conversions
 		:  to/from seconds to cpu_time_t units.
+	e-4:	10/18/2026	warme
+		: Added _gst_get_wall_time.
 
 ************************************************************************/
 
@@ -56,6 +58,7 @@ extern double		_gst_cpu_time_t_to_double_seconds (cpu_time_t ticks);
 extern cpu_time_t	_gst_double_seconds_to_cpu_time_t (double seconds);
 extern cpu_time_t	_gst_get_cpu_time (void);
 extern cpu_time_t	_gst_get_delta_cpu_time (cpu_time_t *);
+extern cpu_time_t	_gst_get_wall_time (void);
 extern void		_gst_initialize_cpu_time (struct environment *);
 extern cpu_time_t	_gst_int_seconds_to_cpu_time_t (unsigned int seconds);
 
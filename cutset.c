@@ -3,8 +3,8 @@
 	$Id: cutset.c,v 1.16 2022/11/19 13:45:50 warme Exp $
 
 	File:	cutset.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -40,6 +40,10 @@
 		: Simplify calling convention of various functions.
 		: Eliminate memory waste with find_comps().
 		: Fix -Wall issues.
+	e-5:	10/18/2026	warme
+		: Maintain the connected components of the support
+		:  incrementally, instead of recomputing them from
+		:  scratch on every call.
 
 ************************************************************************/
 
@@ -55,6 +59,7 @@
 #include "parmblk.h"
 #include "sec_heur.h"
 #include "steiner.h"
+#include "suppconn.h"
 #include <string.h>
 
 
@@ -88,7 +93,7 @@ static struct constraint * enumerate_cuts (int			i,
 					   bitmap_t *		cut_terms,
 					   double *		x,
 					   struct bbinfo *	bbip);
-static int		find_comps (bitmap_t *			sol,
+static int		find_comps (struct suppconn *		scp,
 				    int **			cc_verts,
 				    int *			vlist,
 				    struct bbinfo *		bbip);
@@ -100,7 +105,7 @@ static struct constraint * simple_cuts (int **			cc_verts,
 
 /*
  * This routine quickly finds cutsets of zero weight -- totally
- * disconnected solutions.  It first computes the connected components
+ * disconnected solutions.  It first updates the connected components
  * of the solution and then uses either a combinatorially thorough
  * method to generate a complete set of constraints, or a quicker
  * method to generate one constraint per component.  The method used
@@ -116,13 +121,10 @@ struct bbinfo *		bbip		/* IN - branch and bound info */
 {
 int			i;
 int			nverts;
-int			nedges;
 int			kmasks;
-int			nmasks;
 int			ncomps;
 struct gst_hypergraph *	cip;
-bitmap_t *		edge_mask;
-bitmap_t *		sol;
+struct suppconn *	scp;
 bitmap_t *		cut_terms;
 struct constraint *	cutlist;
 int **			cc_verts;
@@ -130,45 +132,40 @@ int *			vlist;
 bitmap_t *		vtemp;
 bool *			cstack;
 
-	cip		= bbip -> cip;
-	edge_mask	= bbip -> edge_mask;
+	cip	= bbip -> cip;
 
 	nverts	= cip -> num_verts;
-	nedges	= cip -> num_edges;
 	kmasks	= cip -> num_vert_masks;
-	nmasks	= cip -> num_edge_masks;
-
-	sol	= NEWA (nmasks, bitmap_t);
 
 	cutlist = NULL;
 
-	/* Get bit-mask of all full-sets even partially present in soln. */
-	memset (sol, 0, nmasks * sizeof (*sol));
-	for (i = 0; i < nedges; i++) {
-		if (NOT BITON (edge_mask, i)) continue;
-		if (x [i] > FUZZ) {
-			SETBIT (sol, i);
-		}
+	/* Bring the connected components of the support hypergraph	*/
+	/* (all full-sets even partially present in the solution) up	*/
+	/* to date.  Usually only a few full-sets have entered or left	*/
+	/* the support since the last time.				*/
+	scp = bbip -> suppconn;
+	if (scp EQ NULL) {
+		scp = _gst_create_support_conn (cip);
+		bbip -> suppconn = scp;
+	}
+	_gst_update_support_conn (scp, x, bbip -> edge_mask, cip);
+
+	ncomps = scp -> ncomps;
+
+	FATAL_ERROR_IF (ncomps <= 0);
+	if (ncomps EQ 1) {
+		return (NULL);
 	}
 
-	/* This bitmask now represents the edges of the support hypergraph. */
 	/* Partition the vertices into subsets, one for each connected	*/
 	/* component.							*/
 	cc_verts	= NEWA (nverts + 1, int *);
 	vlist		= NEWA (nverts, int);
 	vtemp		= NEWA (kmasks, bitmap_t);
 
-	/* Compute the connected components (i.e., the vertices in each CC). */
-	ncomps = find_comps (sol, cc_verts, vlist, bbip);
-
-	FATAL_ERROR_IF (ncomps <= 0);
-	if (ncomps EQ 1) {
-		free (vtemp);
-		free (vlist);
-		free (cc_verts);
-		free (sol);
-		return (NULL);
-	}
+	/* Get the vertices in each CC. */
+	i = find_comps (scp, cc_verts, vlist, bbip);
+	FATAL_ERROR_IF (i NE ncomps);
 
 #if 1
 	gst_channel_printf (bbip -> params -> print_solve_trace,
@@ -208,97 +205,79 @@ bool *			cstack;
 	free (vtemp);
 	free (vlist);
 	free (cc_verts);
-	free (sol);
 
 	return (cutlist);
 }
 
 /*
- * This routine finds the connected components of the given set of
- * full-sets.  The result is a partition of the given terminals,
- * one list of vertex indices for each component.
+ * This routine lists the vertices of each connected component of the
+ * support hypergraph.  The result is a partition of the terminals
+ * that are in the support, one list of vertex indices for each
+ * component.  The components are numbered in order of their lowest
+ * numbered full-set.
  */
 
 	static
 	int
 find_comps (
 
-bitmap_t *		sol,		/* IN: solution to get components of */
+struct suppconn *	scp,		/* IN: support connectivity */
 int **			cc_verts,	/* OUT: partition of verts into CCs */
 int *			vlist,		/* OUT: partitioned vertex list */
 struct bbinfo *		bbip		/* IN: branch-and-bound info */
 )
 {
-int			e, v, nverts, nedges, kmasks, ncomps, edge;
+int			e, i, r, v, nverts, nedges, ncomps;
 struct gst_hypergraph *	cip;
-int *			ep1;
-int *			ep2;
-int *			vp1;
-int *			vp2;
-bitmap_t *		visited;
-int *			sp;
-int *			stack;
+int *			cnum;
+int *			count;
 
 	cip	= bbip -> cip;
 	nverts	= cip -> num_verts;
 	nedges	= cip -> num_edges;
-	kmasks	= cip -> num_vert_masks;
 
-	visited = NEWA (kmasks, bitmap_t);
-	stack	= NEWA (nverts, int);
+	cnum	= NEWA (2 * nverts + 1, int);
+	count	= cnum + nverts;
 
-	memset (visited, 0, kmasks * sizeof (visited [0]));
+	for (v = 0; v < nverts; v++) {
+		cnum [v] = -1;
+	}
 
+	/* Number the components, by canonical vertex. */
 	ncomps = 0;
-	edge = 0;
-	for (;;) {
-		/* Record start of next connected component (or end of	*/
-		/* the final component).				*/
-		*cc_verts++ = vlist;
-
-		/* Find next remaining full-set... */
-		for (; edge < nedges; edge++) {
-			if (BITON (sol, edge)) break;
+	for (e = 0; e < nedges; e++) {
+		if (scp -> epos [e] < 0) continue;
+		r = _gst_support_conn_find (scp, cip -> edge [e][0]);
+		if (cnum [r] < 0) {
+			cnum [r] = ncomps++;
 		}
-		if (edge >= nedges) break;
-		CLRBIT (sol, edge);
+	}
 
-		/* Identify next component... */
-		sp = &stack [0];
-		vp1 = cip -> edge [edge];
-		vp2 = cip -> edge [edge + 1];
-		while (vp1 < vp2) {
-			v = *vp1++;
-			if (BITON (visited, v)) continue;
-			SETBIT (visited, v);
-			*vlist++ = v;
-			*sp++ = v;
-		}
+	/* Count the vertices of each component, and assign each	*/
+	/* component its share of vlist.				*/
+	for (i = 0; i <= ncomps; i++) {
+		count [i] = 0;
+	}
+	for (v = 0; v < nverts; v++) {
+		if (scp -> degree [v] <= 0) continue;
+		r = _gst_support_conn_find (scp, v);
+		++(count [cnum [r]]);
+	}
+	for (i = 0; i < ncomps; i++) {
+		cc_verts [i] = vlist;
+		vlist += count [i];
+		count [i] = 0;
+	}
+	cc_verts [ncomps] = vlist;
 
-		while (sp > stack) {
-			v = *--sp;
-			ep1 = cip -> term_trees [v];
-			ep2 = cip -> term_trees [v + 1];
-			while (ep1 < ep2) {
-				e = *ep1++;
-				if (NOT BITON (sol, e)) continue;
-				CLRBIT (sol, e);
-				vp1 = cip -> edge [e];
-				vp2 = cip -> edge [e + 1];
-				while (vp1 < vp2) {
-					v = *vp1++;
-					if (BITON (visited, v)) continue;
-					SETBIT (visited, v);
-					*vlist++ = v;
-					*sp++ = v;
-				}
-			}
-		}
-		++ncomps;
+	for (v = 0; v < nverts; v++) {
+		if (scp -> degree [v] <= 0) continue;
+		r = _gst_support_conn_find (scp, v);
+		i = cnum [r];
+		cc_verts [i][count [i]++] = v;
 	}
 
-	free ((char *) stack);
-	free ((char *) visited);
+	free ((char *) cnum);
 
 	return (ncomps);
 }
@@ -3,8 +3,8 @@
 	$Id: efst.c,v 1.42 2022/11/19 13:45:51 warme Exp $
 
 	File:	efst.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-15
+	Date:	10/18/2026
 
 	Copyright (c) 1998, 2022 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -57,9 +57,61 @@
 		: Fix -Wall issues.  Upgrade fatals.
 	e-4:	11/18/2022	warme
 		: Fix -Wall issues.
+	e-5:	10/18/2026	warme
+		: Generate the eq-points of each size on several
+		:  threads, merging the results in a fixed order.
+	e-6:	10/18/2026	warme
+		: Use a k-d tree of terminals to find the terminals
+		:  that may lie in a lune.
+	e-7:	10/18/2026	warme
+		: Added gst_update_efsts(), which regenerates the FSTs
+		:  only near added and deleted terminals.
+	e-8:	10/18/2026	warme
+		: Added FST_TIME_LIMIT, a wall-clock limit that stops
+		:  generation early and records which sizes are
+		:  complete.
+	e-9:	10/18/2026	warme
+		: Allocate terminal lists and the EFST list from
+		:  arenas, so that terminal lists never move.
+	e-10:	10/18/2026	warme
+		: Apply the basic projection test to all candidate
+		:  partners of an eq-point at once, using AVX2 when
+		:  the processor has it.
+	e-11:	10/18/2026	warme
+		: Report the hit rate of the floating point filter
+		:  used with multiple precision.
+	e-12:	10/18/2026	warme
+		: Use AVX2 only on x86-64, where the scalar
+		:  fallback uses SSE2 and gives identical results.
+	e-13:	10/18/2026	warme
+		: Apply the BSD test to the FSTs returned by
+		:  gst_update_efsts().
+	e-14:	10/18/2026	warme
+		: Bound the neighborhood updated by
+		:  gst_update_efsts() with the BSDs, and mark
+		:  results that may lack some FSTs as incomplete.
+	e-15:	10/18/2026	warme
+		: Never contract floating point expressions, so that
+		:  the AVX2 and scalar paths agree when compiled
+		:  for processors with fused multiply-add.
 
 ************************************************************************/
 
+/*
+ * The AVX2 and scalar versions of the projection test must round
+ * identically.  A compiler told that the processor has fused
+ * multiply-add (e.g., -march=haswell) may contract a * b + c into a
+ * single rounding, and may do so differently in the two versions.
+ * We forbid it here, ahead of the includes, so that it also covers
+ * the inline functions of efuncs.h.
+ */
+
+#if defined(__clang__)
+ #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+ #pragma GCC optimize ("fp-contract=off")
+#endif
+
 #include "efst.h"
 
 #include "bsd.h"
@@ -76,13 +128,29 @@
 #include "logic.h"
 #include <math.h>
 #include "memory.h"
+#include "parallel.h"
+#include "p1read.h"
 #include "parmblk.h"
+#include "polltime.h"
 #include "prepostlude.h"
 #include "sll.h"
 #include "sortfuncs.h"
 #include "steiner.h"
 #include <string.h>
 
+/*
+ * GCC and Clang can compile selected functions for AVX2, which we use
+ * only after checking that the processor has it.  We restrict this to
+ * x86-64:  on 32-bit x86 the scalar code may use the x87 unit, whose
+ * excess precision could make the two paths disagree.  (Contraction
+ * into fused multiply-adds is disabled above for the same reason.)
+ */
+
+#if defined(__GNUC__) AND defined(__x86_64__)
+ #define EFST_AVX2
+ #include <immintrin.h>
+#endif
+
 
 /*
  * Global Routines
@@ -92,6 +160,53 @@ struct gst_hypergraph *	gst_generate_efsts (int,
 					    double *,
 					    struct gst_param *,
 			       int *);
+struct gst_hypergraph *	gst_update_efsts (struct gst_hypergraph *,
+					  int,
+					  double *,
+					  int,
+					  int *,
+					  struct gst_param *,
+					  int *);
+
+/*
+ * Local Types
+ */
+
+struct eqp_task {
+	int		first;		/* First eq-point i to combine */
+	int		last;		/* Last eq-point i + 1 */
+	struct eqp_t *	eqp;		/* New eq-points */
+	int		neqp;		/* Number of new eq-points */
+	int		eqp_size;	/* Size of eqp array */
+	struct arena	eqpZ;		/* Their terminal lists */
+	struct full_set * fsts;		/* FSTs to be saved */
+	bool		timed_out;	/* Stopped early by the time limit */
+};
+
+struct eqp_batch {
+	struct einfo *	eip;		/* The global EFST info */
+	int		size;		/* Size of eq-points to generate */
+	struct eqp_task * tasks;	/* The tasks */
+	struct einfo *	eips;		/* Private EFST info per thread */
+	struct eqp_t ***
+			lists;		/* Compatible eq-points per thread */
+};
+
+struct lune_query {
+	struct point	p1;		/* Center of first disk */
+	struct point	p2;		/* Center of second disk */
+	dist_t		dist2;		/* Squared radius of disks */
+	dist_t		radius;		/* Radius of disks */
+	dist_t		minx, maxx;	/* Bounding box of lune */
+	dist_t		miny, maxy;
+	int		after;		/* Largest terminal not wanted */
+	int		last;		/* Last terminal returned */
+	int		scan_end;	/* End of initial linear scan */
+	int		nfound;		/* Number of terminals in nbrs, */
+					/* or -1 if not yet searched */
+	int		pos;		/* Next terminal of nbrs */
+};
+
 
 /*
  * Local Routines
@@ -99,6 +214,11 @@ struct gst_hypergraph *	gst_generate_efsts (int,
 
 static void		add_zero_length_fsts (struct einfo *, int, int **);
 static void		build_fst_list (struct einfo *);
+static struct full_set *
+			build_efst (struct einfo *,
+				    struct eqp_t *,
+				    struct eqp_t *,
+				    dist_t);
 static void		build_efst_graph (struct einfo *,
 					  int,
 					  struct point *,
@@ -109,8 +229,53 @@ static void		build_efst_graph (struct einfo *,
 					  struct point *,
 					  int *,
 					  int *);
+static struct gst_hypergraph *
+			build_efst_hypergraph (struct einfo *,
+					       int,
+					       cpu_time_t);
 static int		compute_efsts_for_unique_terminals (struct einfo *,
 							    cpu_time_t *);
+static struct full_set *
+			copy_efst (struct full_set *, int *);
+static void		eqp_task (void *, int, int);
+static bool		fails_bsd_test (struct full_set *,
+					struct bsd *,
+					dist_t);
+static struct elist **	find_efst (struct einfo *, int *, int, int *);
+static bool *		find_update_neighborhood (struct gst_hypergraph *,
+						  int *,
+						  struct pset *,
+						  int,
+						  int,
+						  int,
+						  int *,
+						  struct bsd *,
+						  int,
+						  struct gst_param *);
+static int		generate_efst_list (struct einfo *,
+					    struct pset *,
+					    struct pset *,
+					    int *,
+					    cpu_time_t *);
+static int		generate_eqps_in_parallel (struct einfo *,
+						   int,
+						   int,
+						   int,
+						   int,
+						   int);
+static void		insert_efst (struct einfo *,
+				     struct elist **,
+				     struct full_set *,
+				     int);
+static bool		lune_holds_terminal (struct full_set *,
+					     struct pset *,
+					     int *,
+					     int,
+					     dist_t);
+static void		merge_eqp_task (struct einfo *,
+					struct eqp_task *,
+					int,
+					int *);
 static void		renumber_terminals (struct einfo *,
 					    struct pset *,
 					    int *);
@@ -124,9 +289,43 @@ static dist_t		test_and_save_fst (struct einfo *,
 
 #define UPDATE_PTR(p,old,new) ((new) + ((p) - (old)))
 
+/* Orders of combining eq-points i and j that pass projection test I. */
+#define CAND_OK_IJ	0x01
+#define CAND_OK_JI	0x02
+
 #define UPDATE_RECTANGLE_BOUNDS(p) \
 	{ *minx = MIN(*minx, p.x); *maxx = MAX(*maxx, p.x); \
 	  *miny = MIN(*miny, p.y); *maxy = MAX(*maxy, p.y); }
+
+/*
+ * Eq-points of a given size are generated on several threads only if
+ * there are at least MIN_PARALLEL_EQPS eq-points to combine.  Each
+ * thread then gets about TASKS_PER_THREAD tasks, so that the threads
+ * stay busy even when some tasks take much longer than others.
+ */
+
+#define MIN_PARALLEL_EQPS	64
+#define TASKS_PER_THREAD	8
+
+/*
+ * Maximum number of terminals in a leaf of the k-d tree of terminals.
+ */
+
+#define KD_LEAF_SIZE		8
+
+/*
+ * Number of terminals checked one by one, in order, before the k-d tree
+ * is used to find the others in a lune.
+ */
+
+#define LUNE_SCAN		32
+
+/*
+ * When FSTs are updated, every FST containing an added terminal and
+ * spanning at most UPDATE_FST_SIZE terminals is found.
+ */
+
+#define UPDATE_FST_SIZE		8
 
 
 	struct gst_hypergraph *
@@ -138,30 +337,15 @@ struct gst_param *	params,
 int *			status
 )
 {
-int			i;
-int			j;
-int			k;
-int			ndg;
-int			ntrees;
-int			count;
 int			neqpoints;
 int			code;
-int **			dup_grps;
-int *			fwd_map;
-int *			rev_map;
-int *			ip1;
-struct full_set *	fsp;
-int *			tlist;
 struct einfo		einfo;
 struct gst_hypergraph *	cip;
 struct pset *		pts;
-struct pset *		pts2;
 cpu_time_t		T0;
 cpu_time_t		Tn;
-cpu_time_t		Trenum;
 char			buf1 [32];
 struct gst_channel *	timing;
-struct gst_proplist *	plist;
 
 	GST_PRELUDE
 
@@ -187,17 +371,735 @@ struct gst_proplist *	plist;
 	T0 = _gst_get_cpu_time ();
 	Tn = T0;
 
-	einfo.x_order = _gst_heapsort_x (pts);
+	einfo.params	= params;
+	_gst_start_wall_poll (&(einfo.fst_poll), params -> fst_time_limit);
+	einfo.complete_size = 0;
+
+	neqpoints = generate_efst_list (&einfo, pts, pts, NULL, &Tn);
+
+	if (timing NE NULL) {
+		_gst_convert_cpu_time (Tn - T0, buf1);
+		gst_channel_printf (timing, "Total:                  %s\n", buf1);
+	}
+
+	cip = build_efst_hypergraph (&einfo, neqpoints, Tn - T0);
+
+	if (status NE NULL) {
+		*status = code;
+	}
+
+	GST_POSTLUDE
+	return cip;
+}
+
+/*
+ * Update a set of EFSTs after some terminals are added and others are
+ * deleted.  The vertices of the new hypergraph are the remaining
+ * vertices of H, in the same order, followed by the added terminals.
+ *
+ * The FSTs are regenerated only for a neighborhood of the changes.
+ * Two terminals u and v of an FST of k terminals in an SMT are joined
+ * by a path of at most k-1 edges, none longer than the bottleneck
+ * Steiner distance BSD(u,v).  So |uv| <= (k-1) * BSD(u,v), and every
+ * FST of at most kmax terminals that contains an added terminal spans
+ * only terminals this close to it.  These terminals form the
+ * neighborhood, with kmax the smaller of UPDATE_FST_SIZE and
+ * MAX_FST_SIZE.  The FSTs of H that span some terminal outside the
+ * neighborhood (and no deleted terminal) are kept, except for those
+ * having an added terminal in the lune of one of their edges -- such
+ * FSTs cannot be part of any SMT.  New FSTs having some other terminal
+ * in the lune of an edge are discarded for the same reason.  Every FST
+ * must also pass the BSD test for the new set of terminals.
+ *
+ * Adding terminals only makes the tests of the FST generator stronger,
+ * so when terminals are only added, every FST of at most kmax terminals
+ * that gst_generate_efsts() would give is found.  If larger FSTs may be
+ * missing, the result records kmax as its complete FST size.  Deleting
+ * a terminal can admit FSTs that it used to rule out, and nothing
+ * bounds where they lie.  The same bound is used around each deleted
+ * terminal (with the BSDs of H), but only as a heuristic, so the
+ * complete FST size of the result is then 0.  When the neighborhood
+ * holds at least half of the terminals, all FSTs are regenerated, and
+ * the result is exact.
+ */
+
+	struct gst_hypergraph *
+gst_update_efsts (
+
+struct gst_hypergraph *	H,
+int			nadd,
+double *		add_terms,
+int			ndel,
+int *			del_terms,
+struct gst_param *	params,
+int *			status
+)
+{
+int			i;
+int			j;
+int			k;
+int			n;
+int			old_n;
+int			new_n;
+int			nsub;
+int			nfringe;
+int			kmax;
+int			code;
+int			neqpoints;
+int			metric_type;
+int			metric_parameter;
+int			nmst;
+int *			fwd_map;
+int *			sub_map;
+int *			fringe;
+int *			tlist;
+bool			inside;
+bool			whole;
+bool *			nbhd;
+dist_t			eps;
+dist_t			mst_len;
+struct full_set *	fsp;
+struct full_set *	next;
+struct full_set **	hookp;
+struct full_set *	kept;
+struct edge *		mst_edges;
+struct bsd *		bsdp;
+struct einfo		einfo;
+struct gst_hypergraph *	cip;
+struct pset *		pts;
+struct pset *		subpts;
+cpu_time_t		T0;
+cpu_time_t		Tn;
+char			buf1 [32];
+struct gst_channel *	timing;
+
+	GST_PRELUDE
+
+	code = 0;
+
+	cip = NULL;
+
+	if (params EQ NULL) {
+		params = (struct gst_param *) &_gst_default_parmblk;
+	}
+	timing = params -> detailed_timings_channel;
+
+	do {		/* Used only for "break"... */
+		if (H EQ NULL) {
+			code = GST_ERR_INVALID_HYPERGRAPH;
+			break;
+		}
+
+		metric_type = GST_METRIC_NONE;
+		metric_parameter = 0;
+		if (H -> metric NE NULL) {
+			gst_get_metric_info (H -> metric,
+					     &metric_type,
+					     &metric_parameter);
+		}
+		if ((metric_type NE GST_METRIC_L) OR (metric_parameter NE 2)) {
+			code = GST_ERR_INVALID_METRIC;
+			break;
+		}
+		if ((H -> pts EQ NULL) OR (H -> full_trees EQ NULL)) {
+			code = GST_ERR_NO_EMBEDDING;
+			break;
+		}
+		if ((nadd < 0) OR (ndel < 0)) {
+			code = GST_ERR_INVALID_NUMBER_OF_TERMINALS;
+			break;
+		}
+		for (i = 0; i < ndel; i++) {
+			j = del_terms [i];
+			if ((j < 0) OR (j >= H -> pts -> n)) {
+				code = GST_ERR_INVALID_VERTEX;
+				break;
+			}
+		}
+	} while (FALSE);
+
+	if (code NE 0) {
+		if (status NE NULL) {
+			*status = code;
+		}
+		GST_POSTLUDE
+		return (NULL);
+	}
+
+	T0 = _gst_get_cpu_time ();
+	Tn = T0;
+
+	if (H -> term_trees EQ NULL) {
+		_gst_init_term_trees (H);
+	}
+
+	/* Number the remaining terminals, and append the new ones. */
+	old_n	= H -> pts -> n;
+	fwd_map	= NEWA (old_n, int);
+	for (i = 0; i < old_n; i++) {
+		fwd_map [i] = 0;
+	}
+	for (i = 0; i < ndel; i++) {
+		fwd_map [del_terms [i]] = -1;
+	}
+	n = 0;
+	for (i = 0; i < old_n; i++) {
+		if (fwd_map [i] >= 0) {
+			fwd_map [i] = n++;
+		}
+	}
+	new_n = n + nadd;
+
+	pts = NEW_PSET (new_n);
+	ZERO_PSET (pts, new_n);
+	pts -> n = new_n;
+	for (i = 0; i < old_n; i++) {
+		if (fwd_map [i] >= 0) {
+			pts -> a [fwd_map [i]] = H -> pts -> a [i];
+		}
+	}
+	for (i = 0; i < nadd; i++) {
+		pts -> a [n + i].x	 = *add_terms++;
+		pts -> a [n + i].y	 = *add_terms++;
+		pts -> a [n + i].battery = *add_terms++;
+	}
+
+	eps = params -> eps_mult_factor * DBL_EPSILON;
+
+	/* Compute the MST and the BSDs of the whole new set of	*/
+	/* terminals.  They bound the neighborhood of the changes,	*/
+	/* and every FST must pass the BSD test.			*/
+	mst_len = 0.0;
+	bsdp = NULL;
+	if (new_n > 1) {
+		mst_edges = NEWA (new_n - 1, struct edge);
+		nmst = _gst_euclidean_mst (pts, mst_edges);
+		for (i = 0; i < nmst; i++) {
+			mst_len += mst_edges [i].len;
+		}
+		if (nmst EQ new_n - 1) {
+			bsdp = _gst_compute_bsd (nmst,
+						 mst_edges,
+						 params -> bsd_method);
+		}
+		free ((char *) mst_edges);
+	}
+
+	/* Find the neighborhood of the changes.  The other	*/
+	/* terminals form the fringe just outside of it.	*/
+	k = params -> max_fst_size;
+	if (k > new_n) {
+		k = new_n;
+	}
+	kmax = (k < UPDATE_FST_SIZE) ? k : UPDATE_FST_SIZE;
+	nbhd = find_update_neighborhood (H, fwd_map, pts, n, nadd,
+					 ndel, del_terms, bsdp, kmax,
+					 params);
+
+	/* Generating the FSTs of a subset is slower per terminal, for	*/
+	/* its boundary prunes less.  If the neighborhood holds half of	*/
+	/* the terminals, regenerate them all, which is also exact.	*/
+	j = nadd;
+	for (i = 0; i < old_n; i++) {
+		if ((fwd_map [i] >= 0) AND nbhd [i]) {
+			++j;
+		}
+	}
+	whole = (2 * j >= new_n);
+	if (whole) {
+		for (i = 0; i < old_n; i++) {
+			nbhd [i] = TRUE;
+		}
+	}
+
+	sub_map	= NEWA (new_n, int);
+	fringe	= NEWA (old_n + 1, int);
+	nsub	= 0;
+	nfringe	= 0;
+	for (i = 0; i < old_n; i++) {
+		j = fwd_map [i];
+		if (j < 0) continue;
+		if (nbhd [i]) {
+			sub_map [nsub++] = j;
+		}
+		else {
+			fringe [nfringe++] = j;
+		}
+	}
+	for (i = 0; i < nadd; i++) {
+		sub_map [nsub++] = n + i;
+	}
+
+	if (timing NE NULL) {
+		_gst_convert_delta_cpu_time (buf1, &Tn);
+		gst_channel_printf (timing, "Find Neighborhood:      %s\n", buf1);
+	}
+
+	/* Generate the FSTs of the neighborhood, in the new numbering. */
+	einfo.params	= params;
+	einfo.pts	= pts;
+	einfo.full_sets	= NULL;
+	neqpoints	= 0;
+	_gst_start_wall_poll (&(einfo.fst_poll), params -> fst_time_limit);
+	einfo.complete_size = 0;
+	if (nsub >= 2) {
+		subpts = NEW_PSET (nsub);
+		ZERO_PSET (subpts, nsub);
+		subpts -> n = nsub;
+		for (i = 0; i < nsub; i++) {
+			subpts -> a [i] = pts -> a [sub_map [i]];
+		}
+		neqpoints = generate_efst_list (&einfo, subpts, pts, sub_map, &Tn);
+		free ((char *) subpts);
+	}
+	einfo.mst_length = mst_len;
+
+	/* Larger FSTs containing an added terminal may be missing. */
+	if ((NOT whole) AND
+	    (nadd > 0) AND
+	    (kmax < k) AND
+	    ((einfo.complete_size EQ 0) OR (kmax < einfo.complete_size))) {
+		einfo.complete_size = kmax;
+	}
+
+	/* The FSTs kept from H are only as complete as those of H. */
+	if ((NOT whole) AND
+	    (gst_get_int_property (H -> proplist,
+				   GST_PROP_HG_COMPLETE_FST_SIZE,
+				   &k) EQ 0) AND
+	    ((einfo.complete_size EQ 0) OR (k < einfo.complete_size))) {
+		einfo.complete_size = k;
+	}
+
+	/* Keep the old FSTs that do not lie within the neighborhood. */
+	hookp = &(einfo.full_sets);
+	fsp = einfo.full_sets;
+	einfo.full_sets = NULL;
+	for (i = 0; i < H -> num_edges; i++) {
+		tlist	= H -> full_trees [i] -> tlist;
+		k	= H -> full_trees [i] -> terminals -> n;
+		inside	= TRUE;
+		for (j = 0; j < k; j++) {
+			if (fwd_map [tlist [j]] < 0) break;
+			if (NOT nbhd [tlist [j]]) {
+				inside = FALSE;
+			}
+		}
+		if ((j < k) OR inside) continue;
+		if (lune_holds_terminal (H -> full_trees [i],
+					 pts,
+					 &(sub_map [nsub - nadd]),
+					 nadd,
+					 eps)) continue;
+		kept = copy_efst (H -> full_trees [i], fwd_map);
+		if ((bsdp NE NULL) AND fails_bsd_test (kept, bsdp, eps)) {
+			_gst_free_full_set (kept);
+			continue;
+		}
+		*hookp = kept;
+		hookp = &(kept -> next);
+	}
+
+	/* Then the new ones. */
+	for (; fsp NE NULL; fsp = next) {
+		next = fsp -> next;
+		if (lune_holds_terminal (fsp, pts, fringe, nfringe, eps) OR
+		    ((bsdp NE NULL) AND fails_bsd_test (fsp, bsdp, eps))) {
+			_gst_free_full_set (fsp);
+			continue;
+		}
+		*hookp = fsp;
+		hookp = &(fsp -> next);
+	}
+	*hookp = NULL;
+
+	k = 0;
+	for (fsp = einfo.full_sets; fsp NE NULL; fsp = fsp -> next) {
+		fsp -> tree_num = k++;
+	}
+	einfo.ntrees = k;
+
+	if (bsdp NE NULL) {
+		_gst_shutdown_bsd (bsdp);
+	}
 
 	if (timing NE NULL) {
 		_gst_convert_delta_cpu_time (buf1, &Tn);
+		gst_channel_printf (timing, "Merge FSTs:             %s\n", buf1);
+		_gst_convert_cpu_time (Tn - T0, buf1);
+		gst_channel_printf (timing, "Total:                  %s\n", buf1);
+	}
+
+	cip = build_efst_hypergraph (&einfo, neqpoints, Tn - T0);
+
+	if ((NOT whole) AND (ndel > 0)) {
+		/* No size is known to be complete. */
+		gst_set_int_property (cip -> proplist,
+				      GST_PROP_HG_COMPLETE_FST_SIZE,
+				      0);
+	}
+
+	gst_set_hg_scale_info (cip, H -> scale);
+
+	free ((char *) nbhd);
+	free ((char *) fringe);
+	free ((char *) sub_map);
+	free ((char *) fwd_map);
+
+	if (status NE NULL) {
+		*status = code;
+	}
+
+	GST_POSTLUDE
+	return cip;
+}
+
+/*
+ * Find the terminals of H near the changes.  An old terminal v is near
+ * an added terminal a if |av| <= (kmax-1) * BSD(a,v), using the BSDs of
+ * the new terminals, so that every FST of at most kmax terminals that
+ * contains a lies within the neighborhood.  The same test is made
+ * against each deleted terminal, using the BSDs of H.  Returns a flag
+ * for each old terminal, which is TRUE if the terminal is near some
+ * change.
+ */
+
+	static
+	bool *
+find_update_neighborhood (
+
+struct gst_hypergraph *	H,		/* IN - old FSTs */
+int *			fwd_map,	/* IN - old to new terminal numbers */
+struct pset *		pts,		/* IN - new terminals */
+int			n,		/* IN - number of old terminals kept */
+int			nadd,		/* IN - number of added terminals */
+int			ndel,		/* IN - number of deleted terminals */
+int *			del_terms,	/* IN - deleted terminals */
+struct bsd *		bsdp,		/* IN - BSDs of new terminals, or NULL */
+int			kmax,		/* IN - largest FST size to cover */
+struct gst_param *	params		/* IN - parameters */
+)
+{
+int			i;
+int			j;
+int			t;
+int			old_n;
+int			nmst;
+bool *			nbhd;
+dist_t			slack;
+struct edge *		mst_edges;
+struct bsd *		old_bsdp;
+struct point *		p;
+
+	old_n = H -> pts -> n;
+
+	/* The number of edges on the path, relaxed for roundoff. */
+	slack = (kmax - 1) *
+		(1.0 + params -> eps_mult_factor * DBL_EPSILON * kmax);
+
+	nbhd = NEWA (old_n, bool);
+	for (i = 0; i < old_n; i++) {
+		nbhd [i] = FALSE;
+	}
+
+	if (nadd > 0) {
+		for (j = 0; j < old_n; j++) {
+			if (fwd_map [j] < 0) continue;
+			if (bsdp EQ NULL) {
+				nbhd [j] = TRUE;
+				continue;
+			}
+			for (i = 0; i < nadd; i++) {
+				if (EDIST (&(pts -> a [n + i]),
+					   &(pts -> a [fwd_map [j]])) <=
+				    slack * _gst_bsd (bsdp, n + i, fwd_map [j])) {
+					nbhd [j] = TRUE;
+					break;
+				}
+			}
+		}
+	}
+
+	if (ndel > 0) {
+		old_bsdp = NULL;
+		if (old_n > 1) {
+			mst_edges = NEWA (old_n - 1, struct edge);
+			nmst = _gst_euclidean_mst (H -> pts, mst_edges);
+			if (nmst EQ old_n - 1) {
+				old_bsdp = _gst_compute_bsd (nmst,
+							     mst_edges,
+							     params -> bsd_method);
+			}
+			free ((char *) mst_edges);
+		}
+		for (i = 0; i < ndel; i++) {
+			t = del_terms [i];
+			p = &(H -> pts -> a [t]);
+			for (j = 0; j < old_n; j++) {
+				if ((fwd_map [j] < 0) OR nbhd [j]) continue;
+				if ((old_bsdp EQ NULL) OR
+				    (EDIST (p, &(H -> pts -> a [j])) <=
+				     slack * _gst_bsd (old_bsdp, t, j))) {
+					nbhd [j] = TRUE;
+				}
+			}
+		}
+		if (old_bsdp NE NULL) {
+			_gst_shutdown_bsd (old_bsdp);
+		}
+	}
+
+	return (nbhd);
+}
+
+/*
+ * Determine whether one of the given terminals lies strictly inside the
+ * lune of some edge of an FST.  Connecting the terminal to one end of
+ * that edge, instead of using the edge, would give a shorter tree, so
+ * the FST cannot be part of any SMT.
+ */
+
+	static
+	bool
+lune_holds_terminal (
+
+struct full_set *	fsp,		/* IN - FST to check */
+struct pset *		pts,		/* IN - terminals */
+int *			list,		/* IN - terminals to look for */
+int			nlist,		/* IN - number of terminals in list */
+dist_t			eps		/* IN - relative epsilon */
+)
+{
+int			i;
+int			j;
+int			k;
+dist_t			len;
+struct edge *		ep;
+struct point *		p;
+struct point *		p1;
+struct point *		p2;
+
+	k = fsp -> terminals -> n;
+
+	ep = fsp -> edges;
+	for (i = 0; i < fsp -> nedges; ep++, i++) {
+		p1 = (ep -> p1 < k) ? &(fsp -> terminals -> a [ep -> p1])
+				    : &(fsp -> steiners -> a [ep -> p1 - k]);
+		p2 = (ep -> p2 < k) ? &(fsp -> terminals -> a [ep -> p2])
+				    : &(fsp -> steiners -> a [ep -> p2 - k]);
+		len = EDIST (p1, p2) * (1.0 - eps * ((double) k));
+		for (j = 0; j < nlist; j++) {
+			p = &(pts -> a [list [j]]);
+			if ((EDIST (p, p1) < len) AND (EDIST (p, p2) < len)) {
+				return (TRUE);
+			}
+		}
+	}
+
+	return (FALSE);
+}
+
+/*
+ * Check an FST against the bottleneck Steiner distances of the new
+ * terminals.  No edge on the path between two terminals of an FST in
+ * an SMT can be longer than their BSD.  Returns TRUE if the FST fails
+ * this test.
+ */
+
+	static
+	bool
+fails_bsd_test (
+
+struct full_set *	fsp,		/* IN - FST to check */
+struct bsd *		bsdp,		/* IN - BSD of the new terminals */
+dist_t			eps		/* IN - relative epsilon */
+)
+{
+int			i;
+int			j;
+int			k;
+int			u;
+int			v;
+int			nverts;
+int			nstack;
+int *			start;
+int *			adj;
+int *			parent;
+int *			stack;
+bool			fails;
+dist_t *		elen;
+dist_t *		longest;
+struct edge *		ep;
+struct point *		p1;
+struct point *		p2;
+
+	k = fsp -> terminals -> n;
+	nverts = k;
+	if (fsp -> steiners NE NULL) {
+		nverts += fsp -> steiners -> n;
+	}
+
+	start	= NEWA (nverts + 1, int);
+	adj	= NEWA (2 * fsp -> nedges, int);
+	elen	= NEWA (2 * fsp -> nedges, dist_t);
+	parent	= NEWA (nverts, int);
+	stack	= NEWA (nverts, int);
+	longest	= NEWA (nverts, dist_t);
+
+	/* Build the adjacency lists of the tree. */
+	for (i = 0; i <= nverts; i++) {
+		start [i] = 0;
+	}
+	ep = fsp -> edges;
+	for (i = 0; i < fsp -> nedges; ep++, i++) {
+		++(start [ep -> p1 + 1]);
+		++(start [ep -> p2 + 1]);
+	}
+	for (i = 0; i < nverts; i++) {
+		start [i + 1] += start [i];
+		parent [i] = start [i];
+	}
+	ep = fsp -> edges;
+	for (i = 0; i < fsp -> nedges; ep++, i++) {
+		p1 = (ep -> p1 < k) ? &(fsp -> terminals -> a [ep -> p1])
+				    : &(fsp -> steiners -> a [ep -> p1 - k]);
+		p2 = (ep -> p2 < k) ? &(fsp -> terminals -> a [ep -> p2])
+				    : &(fsp -> steiners -> a [ep -> p2 - k]);
+		j = parent [ep -> p1]++;
+		adj [j]	 = ep -> p2;
+		elen [j] = EDIST (p1, p2);
+		j = parent [ep -> p2]++;
+		adj [j]	 = ep -> p1;
+		elen [j] = EDIST (p1, p2);
+	}
+
+	/* Walk the tree from each terminal, recording the longest	*/
+	/* edge on the path to every other vertex.			*/
+	fails = FALSE;
+	for (i = 0; (i < k - 1) AND (NOT fails); i++) {
+		parent [i]	= -1;
+		longest [i]	= 0.0;
+		stack [0]	= i;
+		nstack		= 1;
+		while (nstack > 0) {
+			u = stack [--nstack];
+			for (j = start [u]; j < start [u + 1]; j++) {
+				v = adj [j];
+				if (v EQ parent [u]) continue;
+				parent [v]  = u;
+				longest [v] = (elen [j] > longest [u])
+						? elen [j] : longest [u];
+				stack [nstack++] = v;
+			}
+		}
+		for (j = i + 1; j < k; j++) {
+			if (_gst_bsd (bsdp, fsp -> tlist [i], fsp -> tlist [j])
+			    < longest [j] * (1.0 - eps * ((double) k))) {
+				fails = TRUE;
+				break;
+			}
+		}
+	}
+
+	free ((char *) longest);
+	free ((char *) stack);
+	free ((char *) parent);
+	free ((char *) elen);
+	free ((char *) adj);
+	free ((char *) start);
+
+	return (fails);
+}
+
+/*
+ * Make a copy of an FST, renumbering its terminals.
+ */
+
+	static
+	struct full_set *
+copy_efst (
+
+struct full_set *	fsp,		/* IN - FST to copy */
+int *			map		/* IN - old to new terminal numbers */
+)
+{
+int			i;
+int			k;
+struct full_set *	new_fsp;
+
+	k = fsp -> terminals -> n;
+
+	new_fsp = NEW (struct full_set);
+
+	new_fsp -> next		 = NULL;
+	new_fsp -> tree_num	 = 0;
+	new_fsp -> tree_len	 = fsp -> tree_len;
+	new_fsp -> battery_score = fsp -> battery_score;
+	new_fsp -> tlist	 = NEWA (k, int);
+	for (i = 0; i < k; i++) {
+		new_fsp -> tlist [i] = map [fsp -> tlist [i]];
+	}
+	new_fsp -> terminals	 = NEW_PSET (k);
+	COPY_PSET (new_fsp -> terminals, fsp -> terminals);
+	new_fsp -> steiners	 = NULL;
+	if (fsp -> steiners NE NULL) {
+		new_fsp -> steiners = NEW_PSET (fsp -> steiners -> n);
+		COPY_PSET (new_fsp -> steiners, fsp -> steiners);
+	}
+	new_fsp -> nedges	 = fsp -> nedges;
+	new_fsp -> edges	 = NEWA (fsp -> nedges, struct edge);
+	memcpy (new_fsp -> edges,
+		fsp -> edges,
+		fsp -> nedges * sizeof (struct edge));
+
+	return (new_fsp);
+}
+
+/*
+ * Generate the FSTs for a set of terminals, leaving them in the list
+ * eip -> full_sets.  If map is not NULL, the terminals of each FST are
+ * then renumbered into to_pts using the map.  Returns the number of
+ * eq-points generated.
+ */
+
+	static
+	int
+generate_efst_list (
+
+struct einfo *		eip,		/* IN/OUT - global EFST info */
+struct pset *		pts,		/* IN - terminals */
+struct pset *		to_pts,		/* IN - final set of terminals */
+int *			map,		/* IN - terminal to final terminal */
+cpu_time_t *		Tn		/* IN/OUT - CPU time of last step */
+)
+{
+int			i;
+int			j;
+int			k;
+int			ndg;
+int			neqpoints;
+int **			dup_grps;
+int *			fwd_map;
+int *			rev_map;
+int *			ip1;
+struct pset *		pts2;
+cpu_time_t		Trenum;
+char			buf1 [32];
+struct gst_channel *	timing;
+
+	timing = eip -> params -> detailed_timings_channel;
+
+	eip -> x_order = _gst_heapsort_x (pts);
+
+	if (timing NE NULL) {
+		_gst_convert_delta_cpu_time (buf1, Tn);
 		gst_channel_printf (timing, "Sort X:                 %s\n", buf1);
 	}
 
 	/* Find all duplicate terminals in the input. */
-	ndg = _gst_generate_duplicate_terminal_groups (pts, einfo.x_order, &dup_grps);
+	ndg = _gst_generate_duplicate_terminal_groups (pts, eip -> x_order, &dup_grps);
 
-	einfo.num_term_masks = BMAP_ELTS (pts -> n);
+	eip -> num_term_masks = BMAP_ELTS (pts -> n);
 
 	/* Remove all but the first of each duplicate terminal. */
 	/* Compute forward and reverse maps to renumber the terminals. */
@@ -206,81 +1108,133 @@ struct gst_proplist *	plist;
 	/* Renumber the x_order list -- instead of re-sorting pts2. */
 	j = 0;
 	for (i = 0; i < pts -> n; i++) {
-		k = einfo.x_order [i];
+		k = eip -> x_order [i];
 		FATAL_ERROR_IF ((k < 0) OR (pts -> n < k));
 		k = fwd_map [k];
 		if (k < 0) continue;
-		einfo.x_order [j++] = k;
+		eip -> x_order [j++] = k;
 	}
 
 	if (timing NE NULL) {
-		_gst_convert_delta_cpu_time (buf1, &Tn);
+		_gst_convert_delta_cpu_time (buf1, Tn);
 		gst_channel_printf (timing, "Remove Duplicates:      %s\n", buf1);
 	}
 
 	/* From now on, we work only with the reduced terminal set, and */
 	/* we assume that all terminals are unique. */
 
-	einfo.pts	= pts2;
-	einfo.params	= params;
+	eip -> pts	= pts2;
 
-	neqpoints = compute_efsts_for_unique_terminals (&einfo, &Tn);
+	neqpoints = compute_efsts_for_unique_terminals (eip, Tn);
 
 
 
 	/* Now put the terminal numbers back the way they were, */
 	/* renumber the terminals within each EFST, etc. */
 
-	renumber_terminals (&einfo, pts, rev_map);
+	renumber_terminals (eip, pts, rev_map);
+
+	if (map NE NULL) {
+		/* And once more, into the final set of terminals. */
+		renumber_terminals (eip, to_pts, map);
+		if (ndg > 0) {
+			for (ip1 = dup_grps [0]; ip1 < dup_grps [ndg]; ip1++) {
+				*ip1 = map [*ip1];
+			}
+		}
+	}
 
 	/* Link the FSTs together into one long list, and number them. */
-	build_fst_list (&einfo);
+	build_fst_list (eip);
 
 	/* Add one FST for each duplicate terminal that was removed. */
 	if (ndg > 0) {
-		add_zero_length_fsts (&einfo, ndg, dup_grps);
+		add_zero_length_fsts (eip, ndg, dup_grps);
 	}
 
 	/* Measure renumber time.  This also sets Tn so that Tn-T0 is	*/
 	/* the total processing time.					*/
-	Trenum = _gst_get_delta_cpu_time (&Tn);
+	Trenum = _gst_get_delta_cpu_time (Tn);
 
 	if (timing NE NULL) {
 		_gst_convert_cpu_time (Trenum, buf1);
 		gst_channel_printf (timing, "Renumber Terminals:     %s\n", buf1);
-		_gst_convert_cpu_time (Tn - T0, buf1);
-		gst_channel_printf (timing, "Total:                  %s\n", buf1);
 	}
 
+	/* Clean up. */
+	free ((char *) pts2); /* renumber_terminals has set eip->pts = pts */
+	free ((char *) rev_map);
+	free ((char *) fwd_map);
+	if (dup_grps NE NULL) {
+		if (dup_grps [0] NE NULL) {
+			free ((char *) (dup_grps [0]));
+		}
+		free ((char *) dup_grps);
+	}
+	free ((char *) (eip -> x_order));
+	eip -> x_order = NULL;
+
+	return (neqpoints);
+}
+
+/*
+ * Put the list of FSTs into a new hypergraph.
+ */
+
+	static
+	struct gst_hypergraph *
+build_efst_hypergraph (
+
+struct einfo *		eip,		/* IN - global EFST info */
+int			neqpoints,	/* IN - number of eq-points generated */
+cpu_time_t		T		/* IN - total processing time */
+)
+{
+int			i;
+int			j;
+int			k;
+int			ntrees;
+int			count;
+int *			ip1;
+struct full_set *	fsp;
+int *			tlist;
+struct gst_hypergraph *	cip;
+struct gst_proplist *	plist;
+
 	cip = gst_create_hg (NULL);
-	gst_set_hg_number_of_vertices (cip, einfo.pts -> n);
+	gst_set_hg_number_of_vertices (cip, eip -> pts -> n);
 	plist = cip -> proplist;
 
 	gst_free_metric (cip -> metric);
 	cip -> metric = gst_create_metric (GST_METRIC_L, 2, NULL);
 
-	cip -> num_edges		= einfo.ntrees;
+	cip -> num_edges		= eip -> ntrees;
 	cip -> num_edge_masks		= BMAP_ELTS (cip -> num_edges);
-	cip -> edge			= NEWA (einfo.ntrees + 1, int *);
-	cip -> edge_size		= NEWA (einfo.ntrees, int);
-	cip -> cost			= NEWA (einfo.ntrees, dist_t);
-	cip -> pts			= einfo.pts;
+	cip -> edge			= NEWA (eip -> ntrees + 1, int *);
+	cip -> edge_size		= NEWA (eip -> ntrees, int);
+	cip -> cost			= NEWA (eip -> ntrees, dist_t);
+	cip -> pts			= eip -> pts;
 	cip -> full_trees		= _gst_put_trees_in_array (
-							einfo.full_sets,
+							eip -> full_sets,
 							&ntrees);
 
 	/* PSW: Compute global normalization constants after FSTs are loaded */
 	_gst_compute_global_normalization (cip);
 
 	gst_set_dbl_property (plist, GST_PROP_HG_INTEGRALITY_DELTA, 0);
-	gst_set_dbl_property (plist, GST_PROP_HG_MST_LENGTH, einfo.mst_length);
+	gst_set_dbl_property (plist, GST_PROP_HG_MST_LENGTH, eip -> mst_length);
 	gst_set_dbl_property (cip -> proplist,
 			      GST_PROP_HG_GENERATION_TIME,
-			      _gst_cpu_time_t_to_double_seconds (Tn - T0));
+			      _gst_cpu_time_t_to_double_seconds (T));
 	gst_set_int_property (plist, GST_PROP_HG_HALF_FST_COUNT, neqpoints);
+	if (eip -> complete_size > 0) {
+		gst_set_int_property (plist,
+				      GST_PROP_HG_COMPLETE_FST_SIZE,
+				      eip -> complete_size);
+	}
 
 	count = 0;
-	for (i = 0; i < einfo.ntrees; i++) {
+	for (i = 0; i < eip -> ntrees; i++) {
 		fsp = cip -> full_trees [i];
 		k = fsp -> terminals -> n;
 		cip -> edge_size [i]	= k;
@@ -289,7 +1243,7 @@ struct gst_proplist *	plist;
 		count += k;
 	}
 	ip1 = NEWA (count, int);
-	for (i = 0; i < einfo.ntrees; i++) {
+	for (i = 0; i < eip -> ntrees; i++) {
 		cip -> edge [i] = ip1;
 		fsp = cip -> full_trees [i];
 		tlist = fsp -> tlist;
@@ -300,27 +1254,10 @@ struct gst_proplist *	plist;
 	}
 	cip -> edge [i] = ip1;
 
-	/* Clean up all that is not in cip. */
-	free ((char *) pts2); /* renumber_terminals has set einfo.pts = pts */
-	free ((char *) rev_map);
-	free ((char *) fwd_map);
-	if (dup_grps NE NULL) {
-		if (dup_grps [0] NE NULL) {
-			free ((char *) (dup_grps [0]));
-		}
-		free ((char *) dup_grps);
-	}
-	free ((char *) (einfo.x_order));
-
 	/* Initialize any missing information in the hypergraph */
 	_gst_initialize_hypergraph (cip);
 
-	if (status NE NULL) {
-		*status = code;
-	}
-
-	GST_POSTLUDE
-	return cip;
+	return (cip);
 }
 
 /* Solve a quadratic equation of the form
@@ -504,6 +1441,32 @@ bool flag	     /* IN - value of flag */
 	}
 }
 
+/*
+ * Make room for at least nterms more terminal numbers at eqpZ_curr.
+ * When the current block is too full we simply start another one, so
+ * the terminal lists already built never move.
+ */
+
+	static
+	void
+reserve_terminal_lists (
+
+struct einfo *	eip,	/* IN/OUT - global EFST info */
+int		nterms	/* IN - number of terminals to make room for */
+)
+{
+size_t		n;
+
+	if (eip -> eqpZ_curr + nterms <= eip -> eqpZ_end) return;
+
+	n = eip -> eqpZ.blksize / sizeof (eterm_t);
+	if (n < (size_t) nterms) {
+		n = nterms;
+	}
+	eip -> eqpZ_curr	= ARENA_NEWA (&(eip -> eqpZ), n, eterm_t);
+	eip -> eqpZ_end		= eip -> eqpZ_curr + n;
+}
+
 /*
  * Merge two disjoint ordered lists of terminal numbers.  The result
  * is of course also ordered.
@@ -516,36 +1479,17 @@ merge_terminal_lists (
 struct einfo *	eip,  /* IN/OUT - global EFST info */
 struct eqp_t *	eqpi, /* IN - first eq-point */
 struct eqp_t *	eqpj, /* IN - second eq-point */
-struct eqp_t *	eqpk,  /* IN - new eq-point */
-gst_channel_ptr	timing
+struct eqp_t *	eqpk   /* IN - new eq-point */
 )
 {
-	eterm_t *p1, *endp1, *p2, *endp2, *Zp, *eqpZ_old;
+	eterm_t *p1, *endp1, *p2, *endp2, *Zp;
 	int t1, t2;
-	struct eqp_t *eqpt;
+
+	reserve_terminal_lists (eip, eqpi -> S + eqpj -> S);
 
 	/* Set new eq-point terminal list pointer */
 	eqpk -> Z = eip -> eqpZ_curr;
 
-	if (eip -> eqpZ_curr + eqpi -> S + eqpj -> S
-		>  eip -> eqpZ + eip -> eqpZ_size)  {
-
-		/* Terminal list space exhausted - double array */
-		if (timing)
-			gst_channel_printf (timing, "- doubling terminal list array\n");
-
-		eqpZ_old = eip -> eqpZ;
-		eip -> eqpZ = NEWA ( eip -> eqpZ_size * 2, eterm_t );
-		memcpy ( eip -> eqpZ, eqpZ_old, eip -> eqpZ_size * sizeof(eterm_t) );
-		eip -> eqpZ_size = 2 * eip -> eqpZ_size;
-		eip -> eqpZ_curr = UPDATE_PTR( eip -> eqpZ_curr, eqpZ_old, eip -> eqpZ );
-
-		/* Update pointers from eq-point array */
-		for (eqpt = eip -> eqp; eqpt <= eqpk; eqpt++)
-			eqpt -> Z = UPDATE_PTR( eqpt -> Z, eqpZ_old, eip -> eqpZ );
-		free( eqpZ_old );
-	}
-
 	p1 = eqpi -> Z;
 	p2 = eqpj -> Z;
 	endp1 = p1 + eqpi -> S;
@@ -1046,17 +1990,386 @@ int last_eqp	     /* IN - index of last eq-point to be saved */
 	free(curr_count);
 }
 
+
+/*
+ * Partially sort the n terminals in array a by x-coordinate (if xdir)
+ * or y-coordinate, so that a[k] is the one that would be there if the
+ * array were fully sorted.  Those before it are then no greater, and
+ * those after it no smaller.
+ */
+
+	static
+	void
+select_kth_terminal (
+
+int *		a,	/* IN/OUT - array of terminals */
+int		n,	/* IN - number of terminals in array */
+int		k,	/* IN - position to select */
+struct point *	tp,	/* IN - terminal coordinates */
+bool		xdir	/* IN - use x-coordinates? */
+)
+{
+	int i, j, lo, hi, tmp;
+	dist_t pivot;
+
+#define KD_KEY(t)	(xdir ? tp[t].x : tp[t].y)
+
+	lo = 0;
+	hi = n - 1;
+	while (lo < hi) {
+		pivot = KD_KEY(a[(lo + hi) / 2]);
+		i = lo; j = hi;
+		while (i <= j) {
+			while (KD_KEY(a[i]) < pivot) i++;
+			while (KD_KEY(a[j]) > pivot) j--;
+			if (i <= j) {
+				tmp = a[i]; a[i] = a[j]; a[j] = tmp;
+				i++; j--;
+			}
+		}
+		if (k <= j) hi = j;
+		else if (k >= i) lo = i;
+		else break;
+	}
+
+#undef KD_KEY
+}
 
+
 /*
- * Generate compatible eq-points, i.e., eq-points that are
- * close enough to be joined to a given eq-point.
+ * Build the subtree of the k-d tree for terminals first through last-1
+ * of eip -> kd_term, splitting across the longer side of their bounding
+ * box.  Returns the index of its root node.
+ */
+
+	static
+	int
+build_kd_tree (
+
+struct einfo *	eip,	/* IN/OUT - global EFST info */
+struct point *	tp,	/* IN - terminal coordinates */
+int		first,	/* IN - first terminal of subtree */
+int		last,	/* IN - last terminal of subtree + 1 */
+int *		nnodes	/* IN/OUT - number of nodes used */
+)
+{
+	int i, t, mid, node, left, right;
+	struct kd_node_t * np;
+
+	node = (*nnodes)++;
+	np = &(eip -> kd_node[node]);
+	np -> first = first;
+	np -> last  = last;
+	np -> left  = -1;
+	np -> right = -1;
+
+	np -> minx =  INF_DISTANCE;
+	np -> maxx = -INF_DISTANCE;
+	np -> miny =  INF_DISTANCE;
+	np -> maxy = -INF_DISTANCE;
+	for (i = first; i < last; i++) {
+		t = eip -> kd_term[i];
+		np -> minx = MIN(np -> minx, tp[t].x);
+		np -> maxx = MAX(np -> maxx, tp[t].x);
+		np -> miny = MIN(np -> miny, tp[t].y);
+		np -> maxy = MAX(np -> maxy, tp[t].y);
+	}
+
+	if (last - first > KD_LEAF_SIZE) {
+		mid = (first + last) / 2;
+		select_kth_terminal (&(eip -> kd_term[first]),
+				     last - first,
+				     mid - first,
+				     tp,
+				     np -> maxx - np -> minx >= np -> maxy - np -> miny);
+		left  = build_kd_tree (eip, tp, first, mid, nnodes);
+		right = build_kd_tree (eip, tp, mid, last, nnodes);
+		np = &(eip -> kd_node[node]);
+		np -> left  = left;
+		np -> right = right;
+	}
+
+	return node;
+}
+
+
+/*
+ * Initialize the k-d tree of terminals.  This lets the lune tests look
+ * only at the terminals near a lune, rather than at every terminal,
+ * and adapts to clustered terminals much better than a grid does.
+ */
+
+	static
+	void
+initialize_terminal_tree (
+
+struct einfo * eip /* IN/OUT - global EFST info */
+)
+{
+	int i, n, nnodes;
+	struct point * tp;
+
+	n = eip -> pts -> n;
+
+	/* Terminals are translated just as the eq-points are. */
+	tp = NEWA (n, struct point);
+	for (i = 0; i < n; i++) {
+		tp[i].x = eip -> pts -> a[i].x - eip -> mean.x;
+		tp[i].y = eip -> pts -> a[i].y - eip -> mean.y;
+	}
+
+	eip -> kd_node = NEWA (2 * n, struct kd_node_t);
+	eip -> kd_term = NEWA (n, int);
+	eip -> nbrs    = NEWA (n, int);
+	eip -> nbr_mask = NEWA (BMAP_ELTS (n), bitmap_t);
+	memset (eip -> nbr_mask, 0, BMAP_ELTS (n) * sizeof (bitmap_t));
+	for (i = 0; i < n; i++)
+		eip -> kd_term[i] = i;
+
+	nnodes = 0;
+	(void) build_kd_tree (eip, tp, 0, n, &nnodes);
+
+	eip -> kd_slack = 1.0e-9 * MAX(eip -> maxx - eip -> minx,
+				       eip -> maxy - eip -> miny);
+
+	free(tp);
+}
+
+
+/*
+ * Free memory used by the k-d tree of terminals.
+ */
+
+	static
+	void
+destroy_terminal_tree (
+
+struct einfo * eip /* IN/OUT - global EFST info */
+)
+{
+	free( eip -> nbr_mask );
+	free( eip -> nbrs );
+	free( eip -> kd_term );
+	free( eip -> kd_node );
+}
+
+
+/*
+ * Mark in eip -> nbr_mask each terminal of the given subtree that lies
+ * in the lune described by qp.  Returns the new number of terminals
+ * marked.
+ */
+
+	static
+	int
+collect_terminals (
+
+struct einfo *		eip,	/* IN/OUT - global EFST info */
+int			node,	/* IN - root of subtree */
+struct lune_query *	qp,	/* IN - the lune */
+int			n	/* IN - number of terminals found so far */
+)
+{
+	int i, t;
+	struct kd_node_t * np;
+	struct point * p;
+
+	np = &(eip -> kd_node[node]);
+	if ((np -> minx > qp -> maxx) OR (np -> maxx < qp -> minx) OR
+	    (np -> miny > qp -> maxy) OR (np -> maxy < qp -> miny)) return n;
+
+	if (np -> left < 0) {
+		for (i = np -> first; i < np -> last; i++) {
+			t = eip -> kd_term[i];
+			if (t <= qp -> after) continue;
+			p = &(eip -> eqp[t].E);
+			if (sqr_dist(p, &(qp -> p1)) >= qp -> dist2) continue;
+			if (sqr_dist(p, &(qp -> p2)) >= qp -> dist2) continue;
+			SETBIT(eip -> nbr_mask, t);
+			++n;
+		}
+		return n;
+	}
+
+	n = collect_terminals (eip, np -> left,  qp, n);
+	n = collect_terminals (eip, np -> right, qp, n);
+	return n;
+}
+
+
+/*
+ * Start listing the terminals r in the lune formed by two disks of
+ * squared radius dist2, centered at p1 and p2 -- i.e., those for which
+ * both sqr_dist(r, p1) and sqr_dist(r, p2) are less than dist2.  Only
+ * those numbered greater than "after" are listed, in increasing order,
+ * by lune_next().
  */
 
 	static
 	void
+lune_start (
+
+struct einfo *		eip,	/* IN - global EFST info */
+struct lune_query *	qp,	/* OUT - the lune */
+struct point *		p1,	/* IN - center of first disk */
+struct point *		p2,	/* IN - center of second disk */
+dist_t			dist2,	/* IN - squared radius of disks */
+int			after	/* IN - largest terminal not wanted */
+)
+{
+	dist_t r;
+
+	/* A bit of slack, so that rounding cannot lose a terminal. */
+	r = sqrt (dist2) + eip -> kd_slack;
+
+	qp -> p1	= *p1;
+	qp -> p2	= *p2;
+	qp -> dist2	= dist2;
+	qp -> radius	= sqrt (dist2);
+	qp -> minx	= MAX(p1 -> x, p2 -> x) - r;
+	qp -> maxx	= MIN(p1 -> x, p2 -> x) + r;
+	qp -> miny	= MAX(p1 -> y, p2 -> y) - r;
+	qp -> maxy	= MIN(p1 -> y, p2 -> y) + r;
+	qp -> last	= after;
+	qp -> scan_end	= MIN(after + 1 + LUNE_SCAN, eip -> pts -> n);
+	qp -> nfound	= -1;
+	qp -> pos	= 0;
+}
+
+
+/*
+ * Return the next terminal in the lune being listed, or -1 if there
+ * are no more.  Lunes often contain many terminals, and the caller
+ * usually stops at the first one or two.  So we first simply check the
+ * next LUNE_SCAN terminals in order, and only then ask the k-d tree
+ * for all of the remaining terminals in the lune.
+ */
+
+	static
+	int
+lune_next (
+
+struct einfo *		eip,	/* IN/OUT - global EFST info */
+struct lune_query *	qp	/* IN/OUT - the lune */
+)
+{
+	int i, j, n, w;
+	bitmap_t bits;
+	struct point * p;
+
+	while (qp -> last + 1 < qp -> scan_end) {
+		i = ++(qp -> last);
+		p = &(eip -> eqp[i].E);
+		if (sqr_dist(p, &(qp -> p1)) >= qp -> dist2) continue;
+		if (sqr_dist(p, &(qp -> p2)) >= qp -> dist2) continue;
+		return i;
+	}
+
+	if (qp -> nfound < 0) {
+		qp -> after = qp -> scan_end - 1;
+		n = collect_terminals (eip, 0, qp, 0);
+
+		/* List them in order, clearing the bit-map again. */
+		i = 0;
+		for (w = (qp -> after + 1) / BPW; i < n; w++) {
+			bits = eip -> nbr_mask[w];
+			if (bits EQ 0) continue;
+			eip -> nbr_mask[w] = 0;
+			for (j = 0; bits NE 0; j++, bits >>= 1)
+				if (bits & 1) eip -> nbrs[i++] = w * BPW + j;
+		}
+		qp -> nfound = n;
+	}
+
+	if (qp -> pos >= qp -> nfound) return -1;
+
+	return (eip -> nbrs[(qp -> pos)++]);
+}
+
+
+/*
+ * Determine whether the lune formed by two disks of squared radius
+ * dist2, centered at p1 and p2, lies within the lune being listed.  If so, every terminal in the new lune is also in
+ * the list found for the old one.  We check that each disk of the old
+ * lune contains one of the new disks.
+ */
+
+	static
+	bool
+lune_within (
+
+struct einfo *		eip,	/* IN - global EFST info */
+struct lune_query *	qp,	/* IN - the old lune */
+struct point *		p1,	/* IN - center of first disk */
+struct point *		p2,	/* IN - center of second disk */
+dist_t			dist2	/* IN - squared radius of disks */
+)
+{
+	dist_t r, r0;
+
+	r  = sqrt (dist2) + eip -> kd_slack;
+	r0 = sqrt (qp -> dist2);
+
+	if (NOT ((EDIST(p1, &(qp -> p1)) + r <= r0) OR
+		 (EDIST(p2, &(qp -> p1)) + r <= r0))) return FALSE;
+	if (NOT ((EDIST(p1, &(qp -> p2)) + r <= r0) OR
+		 (EDIST(p2, &(qp -> p2)) + r <= r0))) return FALSE;
+
+	return TRUE;
+}
+
+
+/*
+ * Determine whether the subtree contains a terminal other than "except"
+ * that is at distance less than qp -> radius from both qp -> p1 and
+ * qp -> p2.
+ */
+
+	static
+	bool
+lune_occupied (
+
+struct einfo *		eip,	/* IN - global EFST info */
+int			node,	/* IN - root of subtree */
+struct lune_query *	qp,	/* IN - the lune */
+int			except	/* IN - terminal to ignore */
+)
+{
+	int i, t;
+	struct kd_node_t * np;
+	struct point * p;
+
+	np = &(eip -> kd_node[node]);
+	if ((np -> minx > qp -> maxx) OR (np -> maxx < qp -> minx) OR
+	    (np -> miny > qp -> maxy) OR (np -> maxy < qp -> miny)) return FALSE;
+
+	if (np -> left < 0) {
+		for (i = np -> first; i < np -> last; i++) {
+			t = eip -> kd_term[i];
+			if (t EQ except) continue;
+			p = &(eip -> eqp[t].E);
+			if ((EDIST(&(qp -> p1), p) < qp -> radius) AND
+			    (EDIST(&(qp -> p2), p) < qp -> radius)) return TRUE;
+		}
+		return FALSE;
+	}
+
+	return (lune_occupied (eip, np -> left,  qp, except) OR
+		lune_occupied (eip, np -> right, qp, except));
+}
+
+
+/*
+ * Generate compatible eq-points, i.e., eq-points that are
+ * close enough to be joined to a given eq-point.  Returns the
+ * number of them.
+ */
+
+	static
+	int
 generate_compatible_eqp (
 
-struct einfo * eip,	  /* IN - global EFST info */
+struct einfo * eip,	  /* IN/OUT - global EFST info */
 int size,		  /* IN - prespecified size of eq-points */
 struct eqp_t * eqpi,	  /* IN - given eq-point */
 struct eqp_t ** eqp_list  /* OUT - list of compatible eq-points */
@@ -1076,14 +2389,16 @@ struct eqp_t ** eqp_list  /* OUT - list of compatible eq-points */
 				si = i * eip -> srangey + j;
 				for (l = 0; l < sqr[si].n; l++) {
 					eqpj = sqr[si].eqp[l];
-					if (NOT (eqpj -> CHOSEN)) {
+					if (NOT (eip -> CHOSEN [eqpj -> index])) {
 						*(eqpp++) = eqpj;
-						eqpj -> CHOSEN = TRUE;
+						eip -> CHOSEN [eqpj -> index] = TRUE;
 					}
 				}
 			}
 	}
 	*eqpp = NULL;
+
+	return (eqpp - eqp_list);
 }
 
 
@@ -1108,14 +2423,274 @@ struct eqp_t * eqpj   /* IN - second eq-point */
 			return FALSE;
 	}
 
-	if (eqpj -> R) {
-		get_angle_vector(&(eqpi -> E), &(eqpj -> E), &(eqpj -> LP),
-				 &(eip -> dxj), &(eip -> dyj));
-		if (angle_geq_120(eip -> dxj, eip -> dyj))
-			return FALSE;
+	if (eqpj -> R) {
+		get_angle_vector(&(eqpi -> E), &(eqpj -> E), &(eqpj -> LP),
+				 &(eip -> dxj), &(eip -> dyj));
+		if (angle_geq_120(eip -> dxj, eip -> dyj))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+/*
+ * Free the arrays of a candidate list.
+ */
+
+	static
+	void
+free_eqp_cands (
+
+struct eqp_cands *	cp	/* IN/OUT - candidate list */
+)
+{
+	if (cp -> size > 0) {
+		free ((char *) (cp -> ok));
+		free ((char *) (cp -> Ex));
+	}
+	memset (cp, 0, sizeof (*cp));
+}
+
+/*
+ * Apply projection test I to both orders of combining eq-point i with
+ * each of the candidates, starting from the given one.  This is the
+ * same computation as projection_test_case_I(), so it makes exactly
+ * the same decisions.
+ */
+
+	static
+	void
+case_I_screen (
+
+struct eqp_cands *	cp,	/* IN/OUT - candidate eq-points */
+struct eqp_t *		eqpi,	/* IN - eq-point i */
+bool			jR,	/* IN - candidates are not terminals */
+int			first	/* IN - first candidate to test */
+)
+{
+int		l;
+int8u		ok;
+double		dx, dy;
+struct point	E, LP, RP;
+
+	memset (&E, 0, sizeof (E));
+	memset (&LP, 0, sizeof (LP));
+	memset (&RP, 0, sizeof (RP));
+
+	for (l = first; l < cp -> n; l++) {
+		E.x = cp -> Ex [l];
+		E.y = cp -> Ey [l];
+		ok = CAND_OK_IJ | CAND_OK_JI;
+		if (eqpi -> R) {
+			get_angle_vector(&(eqpi -> RP), &(eqpi -> E), &E, &dx, &dy);
+			if (angle_geq_120(dx, dy)) ok &= ~CAND_OK_IJ;
+			get_angle_vector(&E, &(eqpi -> E), &(eqpi -> LP), &dx, &dy);
+			if (angle_geq_120(dx, dy)) ok &= ~CAND_OK_JI;
+		}
+		if (jR) {
+			LP.x = cp -> LPx [l];
+			LP.y = cp -> LPy [l];
+			RP.x = cp -> RPx [l];
+			RP.y = cp -> RPy [l];
+			get_angle_vector(&(eqpi -> E), &E, &LP, &dx, &dy);
+			if (angle_geq_120(dx, dy)) ok &= ~CAND_OK_IJ;
+			get_angle_vector(&RP, &E, &(eqpi -> E), &dx, &dy);
+			if (angle_geq_120(dx, dy)) ok &= ~CAND_OK_JI;
+		}
+		cp -> ok [l] = ok;
+	}
+}
+
+#ifdef EFST_AVX2
+
+/*
+ * Four at a time version of get_angle_vector() followed by
+ * angle_geq_120(), for points b and c fixed, and a given by
+ * ab = a - b.  Every operation matches the scalar one, so the
+ * results are identical.  (There are no fused multiply-adds, since
+ * contraction is disabled for this file.)
+ */
+
+	static
+	inline
+	__m256d
+	__attribute__ ((target ("avx2")))
+angle_geq_120_avx2 (
+
+__m256d		abx,	/* IN - x-coordinates of a - b */
+__m256d		aby,	/* IN - y-coordinates of a - b */
+__m256d		cbx,	/* IN - x-coordinates of c - b */
+__m256d		cby	/* IN - y-coordinates of c - b */
+)
+{
+__m256d		dx, dy, zero, m1, m2, m3;
+
+	dx = _mm256_add_pd (_mm256_mul_pd (abx, cbx), _mm256_mul_pd (aby, cby));
+	dy = _mm256_sub_pd (_mm256_mul_pd (abx, cby), _mm256_mul_pd (cbx, aby));
+
+	zero = _mm256_setzero_pd ();
+	m1 = _mm256_cmp_pd (dy, zero, _CMP_LT_OQ);
+	m2 = _mm256_and_pd (_mm256_cmp_pd (dy, zero, _CMP_EQ_OQ),
+			    _mm256_cmp_pd (dx, zero, _CMP_LE_OQ));
+	m3 = _mm256_and_pd (_mm256_cmp_pd (dy, zero, _CMP_GT_OQ),
+			    _mm256_cmp_pd (dx, zero, _CMP_LT_OQ));
+	m3 = _mm256_and_pd (m3,
+			    _mm256_cmp_pd (dy,
+					   _mm256_mul_pd (_mm256_set1_pd (-SQRT3), dx),
+					   _CMP_LE_OQ));
+
+	return (_mm256_or_pd (m1, _mm256_or_pd (m2, m3)));
+}
+
+/*
+ * AVX2 version of case_I_screen(), doing four candidates at a time.
+ */
+
+	static
+	void
+	__attribute__ ((target ("avx2")))
+case_I_screen_avx2 (
+
+struct eqp_cands *	cp,	/* IN/OUT - candidate eq-points */
+struct eqp_t *		eqpi,	/* IN - eq-point i */
+bool			jR	/* IN - candidates are not terminals */
+)
+{
+int		l, m, mij, mji;
+__m256d		Ex, Ey, Aix, Aiy, Rix, Riy, Lix, Liy;
+__m256d		bx, by, rij, rji;
+
+	/* Eq-point i's vectors, as get_angle_vector() computes them. */
+	Aix = _mm256_set1_pd (eqpi -> E.x);
+	Aiy = _mm256_set1_pd (eqpi -> E.y);
+	Rix = _mm256_setzero_pd ();
+	Riy = _mm256_setzero_pd ();
+	Lix = _mm256_setzero_pd ();
+	Liy = _mm256_setzero_pd ();
+	if (eqpi -> R) {
+		Rix = _mm256_set1_pd (eqpi -> RP.x - eqpi -> E.x);
+		Riy = _mm256_set1_pd (eqpi -> RP.y - eqpi -> E.y);
+		Lix = _mm256_set1_pd (eqpi -> LP.x - eqpi -> E.x);
+		Liy = _mm256_set1_pd (eqpi -> LP.y - eqpi -> E.y);
+	}
+
+	for (l = 0; l + 4 <= cp -> n; l += 4) {
+		Ex = _mm256_loadu_pd (&(cp -> Ex [l]));
+		Ey = _mm256_loadu_pd (&(cp -> Ey [l]));
+		rij = _mm256_setzero_pd ();
+		rji = _mm256_setzero_pd ();
+		if (eqpi -> R) {
+			/* Angle RP(i), E(i), E(j) */
+			bx = _mm256_sub_pd (Ex, Aix);
+			by = _mm256_sub_pd (Ey, Aiy);
+			rij = angle_geq_120_avx2 (Rix, Riy, bx, by);
+			/* Angle E(j), E(i), LP(i) */
+			rji = angle_geq_120_avx2 (bx, by, Lix, Liy);
+		}
+		if (jR) {
+			/* Angle E(i), E(j), LP(j) */
+			bx = _mm256_sub_pd (_mm256_loadu_pd (&(cp -> LPx [l])), Ex);
+			by = _mm256_sub_pd (_mm256_loadu_pd (&(cp -> LPy [l])), Ey);
+			rij = _mm256_or_pd (rij,
+					    angle_geq_120_avx2 (_mm256_sub_pd (Aix, Ex),
+								_mm256_sub_pd (Aiy, Ey),
+								bx,
+								by));
+			/* Angle RP(j), E(j), E(i) */
+			bx = _mm256_sub_pd (_mm256_loadu_pd (&(cp -> RPx [l])), Ex);
+			by = _mm256_sub_pd (_mm256_loadu_pd (&(cp -> RPy [l])), Ey);
+			rji = _mm256_or_pd (rji,
+					    angle_geq_120_avx2 (bx,
+								by,
+								_mm256_sub_pd (Aix, Ex),
+								_mm256_sub_pd (Aiy, Ey)));
+		}
+		mij = _mm256_movemask_pd (rij);
+		mji = _mm256_movemask_pd (rji);
+		for (m = 0; m < 4; m++) {
+			cp -> ok [l + m] =
+				(((mij >> m) & 1) ? 0 : CAND_OK_IJ) |
+				(((mji >> m) & 1) ? 0 : CAND_OK_JI);
+		}
+	}
+
+	/* Do the last few one at a time. */
+	case_I_screen (cp, eqpi, jR, l);
+}
+
+#endif
+
+/*
+ * Reduce the list of eq-points compatible with eq-point i to those
+ * that it can actually be combined with: those with index at most i
+ * whose terminals are disjoint from those of eq-point i (which must be
+ * flagged in MEMB).  The CHOSEN flags of the whole list are cleared.
+ * Then apply projection test I to both orders of combining eq-point i
+ * with each remaining candidate, recording in eip -> cands.ok which
+ * orders can possibly yield a new eq-point.
+ */
+
+	static
+	void
+screen_candidates (
+
+struct einfo *	eip,		/* IN/OUT - global EFST info */
+struct eqp_t *	eqpi,		/* IN - eq-point i */
+struct eqp_t **	eqp_list,	/* IN/OUT - compatible eq-points */
+int		nlist		/* IN - number of compatible eq-points */
+)
+{
+int			n;
+bool			jR;
+struct eqp_t *		eqpj;
+struct eqp_t **		src;
+struct eqp_t **		dst;
+struct eqp_cands *	cp;
+
+	cp = &(eip -> cands);
+	if (nlist > cp -> size) {
+		free_eqp_cands (cp);
+		cp -> size = 2 * nlist;
+		cp -> Ex  = NEWA (6 * cp -> size, double);
+		cp -> Ey  = cp -> Ex  + cp -> size;
+		cp -> LPx = cp -> Ey  + cp -> size;
+		cp -> LPy = cp -> LPx + cp -> size;
+		cp -> RPx = cp -> LPy + cp -> size;
+		cp -> RPy = cp -> RPx + cp -> size;
+		cp -> ok  = NEWA (cp -> size, int8u);
+	}
+
+	/* The candidates all have the same number of terminals, so	*/
+	/* either all of them are terminals or none are.		*/
+	jR = FALSE;
+	n = 0;
+	dst = eqp_list;
+	for (src = eqp_list; (eqpj = *src) NE NULL; src++) {
+		eip -> CHOSEN [eqpj -> index] = FALSE;
+		if (eqpj -> index > eqpi -> index)	continue;
+		if (NOT disjoint(eip, eqpj))		continue;
+		cp -> Ex [n] = eqpj -> E.x;
+		cp -> Ey [n] = eqpj -> E.y;
+		if (eqpj -> R) {
+			jR = TRUE;
+			cp -> LPx [n] = eqpj -> LP.x;
+			cp -> LPy [n] = eqpj -> LP.y;
+			cp -> RPx [n] = eqpj -> RP.x;
+			cp -> RPy [n] = eqpj -> RP.y;
+		}
+		*dst++ = eqpj;
+		++n;
 	}
+	*dst = NULL;
+	cp -> n = n;
 
-	return TRUE;
+#ifdef EFST_AVX2
+	if (__builtin_cpu_supports ("avx2")) {
+		case_I_screen_avx2 (cp, eqpi, jR);
+		return;
+	}
+#endif
+	case_I_screen (cp, eqpi, jR, 0);
 }
 
 /*
@@ -1319,6 +2894,7 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 )
 {
 	int r;
+	struct lune_query q;
 	struct point CJ, AI, CLP, CLPP, CRP, CRPP;
 	dist_t a, aa, b, bb, c, d, e, f, ff, g, gg, h, hh;
 	dist_t dist_qicj, dist_oacr, dist_opqr, dist_pqi, dist_piai, dist_qpi;
@@ -1334,7 +2910,8 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 		aa	  = sqr_dist(&CJ, &(eqpk -> LP));
 		dist_qicj = 0.999 * aa; /* only look at terminals which really are inside lune */
 
-		for (r = 0; r < eip -> pts -> n; r++) {
+		lune_start(eip, &q, &CJ, &(eqpk -> LP), dist_qicj, -1);
+		while ((r = lune_next(eip, &q)) >= 0) {
 			if (sqr_dist(&(eip -> eqp[r].E), &CJ)		>= dist_qicj) continue;
 			if (sqr_dist(&(eip -> eqp[r].E), &(eqpk -> LP)) >= dist_qicj) continue;
 
@@ -1391,13 +2968,18 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 				      &(eqpk -> LP), &CJ);
 			aa	  = sqr_dist(&CJ, &(eqpk -> LP));
 			dist_qicj = 0.999 * aa;
+
+			/* The lune has changed -- look again, unless it shrank. */
+			if (NOT lune_within(eip, &q, &CJ, &(eqpk -> LP), dist_qicj))
+				lune_start(eip, &q, &CJ, &(eqpk -> LP), dist_qicj, r);
 		}
 	}
 	else {
 		aa	 = sqr_dist(&(eqpi -> E), &(eqpk -> LP));
 		dist_pqi = 0.999 * aa;
 
-		for (r = 0; r < eip -> pts -> n; r++) {
+		lune_start(eip, &q, &(eqpi -> E), &(eqpk -> LP), dist_pqi, -1);
+		while ((r = lune_next(eip, &q)) >= 0) {
 			if (r EQ eqpi -> index) continue;
 			if (sqr_dist(&(eip -> eqp[r].E), &(eqpi -> E))	>= dist_pqi) continue;
 			if (sqr_dist(&(eip -> eqp[r].E), &(eqpk -> LP)) >= dist_pqi) continue;
@@ -1434,6 +3016,10 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 
 			aa	 = sqr_dist(&(eqpi -> E), &(eqpk -> LP));
 			dist_pqi = 0.999 * aa;
+
+			/* The lune has changed -- look again, unless it shrank. */
+			if (NOT lune_within(eip, &q, &(eqpi -> E), &(eqpk -> LP), dist_pqi))
+				lune_start(eip, &q, &(eqpi -> E), &(eqpk -> LP), dist_pqi, r);
 		}
 	}
 
@@ -1445,7 +3031,8 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 		aa	  = sqr_dist(&AI, &(eqpk -> RP));
 		dist_piai = 0.999 * aa;
 
-		for (r = 0; r < eip -> pts -> n; r++) {
+		lune_start(eip, &q, &AI, &(eqpk -> RP), dist_piai, -1);
+		while ((r = lune_next(eip, &q)) >= 0) {
 			if (sqr_dist(&(eip -> eqp[r].E), &AI)		>= dist_piai) continue;
 			if (sqr_dist(&(eip -> eqp[r].E), &(eqpk -> RP)) >= dist_piai) continue;
 
@@ -1502,13 +3089,18 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 				      &(eqpk -> RP), &AI);
 			aa	  = sqr_dist(&AI, &(eqpk -> RP));
 			dist_piai = 0.999 * aa;
+
+			/* The lune has changed -- look again, unless it shrank. */
+			if (NOT lune_within(eip, &q, &AI, &(eqpk -> RP), dist_piai))
+				lune_start(eip, &q, &AI, &(eqpk -> RP), dist_piai, r);
 		}
 	}
 	else {
 		aa	 = sqr_dist(&(eqpj -> E), &(eqpk -> RP));
 		dist_qpi = 0.999 * aa;
 
-		for (r = 0; r < eip -> pts -> n; r++) {
+		lune_start(eip, &q, &(eqpj -> E), &(eqpk -> RP), dist_qpi, -1);
+		while ((r = lune_next(eip, &q)) >= 0) {
 			if (r EQ eqpj -> index) continue;
 			if (sqr_dist(&(eip -> eqp[r].E), &(eqpj -> E))	>= dist_qpi) continue;
 			if (sqr_dist(&(eip -> eqp[r].E), &(eqpk -> RP)) >= dist_qpi) continue;
@@ -1545,6 +3137,10 @@ struct eqp_t * eqpk  /* IN - new eq-point */
 
 			aa	 = sqr_dist(&(eqpj -> E), &(eqpk -> RP));
 			dist_qpi = 0.999 * aa;
+
+			/* The lune has changed -- look again, unless it shrank. */
+			if (NOT lune_within(eip, &q, &(eqpj -> E), &(eqpk -> RP), dist_qpi))
+				lune_start(eip, &q, &(eqpj -> E), &(eqpk -> RP), dist_qpi, r);
 		}
 	}
 
@@ -1825,7 +3421,8 @@ struct eqp_t *	eqpj,	/* IN - second eq-point */
 struct eqp_t *	eqpk	/* IN - new eq-point */
 )
 {
-	int r, t;
+	int t;
+	struct lune_query q;
 	int right_counter = 0;
 	int middle_counter = 0;
 	int left_counter = 0;
@@ -1877,15 +3474,17 @@ struct eqp_t *	eqpk	/* IN - new eq-point */
 			/* Is the last edge too long? */
 			if (dist >= getBSD(eip, eqpt, eqpk)) continue;
 
+			/* Is there a terminal in the lune of the last edge? */
+			q.p1	 = SP;
+			q.p2	 = eqpt -> E;
+			q.radius = dist;
+			q.minx	 = MAX(SP.x, eqpt -> E.x) - dist - eip -> kd_slack;
+			q.maxx	 = MIN(SP.x, eqpt -> E.x) + dist + eip -> kd_slack;
+			q.miny	 = MAX(SP.y, eqpt -> E.y) - dist - eip -> kd_slack;
+			q.maxy	 = MIN(SP.y, eqpt -> E.y) + dist + eip -> kd_slack;
+			if (lune_occupied(eip, 0, &q, t)) continue;
+
 			flag = TRUE;
-			for (r = 0; r < eip -> pts -> n; r++) {
-				if (r EQ t) continue;
-				if ((EDIST(&SP, &(eip -> eqp[r].E))	     < dist) AND
-				    (EDIST(&(eqpt -> E), &(eip -> eqp[r].E)) < dist)) {
-					flag = FALSE; break;
-				}
-			}
-			if (NOT flag) continue;
 
 			eip -> termlist -> a[0] = eqpt -> E;
 			eip -> termindex [0]	= t;
@@ -1926,6 +3525,68 @@ struct eqp_t *	eqpk	/* IN - new eq-point */
 	}
 	return(flag);
 }
+
+/*
+ * Try to combine eq-points i and j (in that order) into new eq-point k.
+ * Returns TRUE if eq-point k survives all of the screening tests, in
+ * which case its terminal list is kept in eip -> eqpZ.
+ */
+
+	static
+	bool
+build_eqp (
+
+struct einfo *	eip,	/* IN/OUT - global EFST info */
+struct eqp_t *	eqpi,	/* IN - first eq-point */
+struct eqp_t *	eqpj,	/* IN - second eq-point */
+struct eqp_t *	eqpk	/* OUT - new eq-point */
+)
+{
+	eterm_t *new_Zp;
+	dist_t upper_bound;
+
+	if (NOT projection_test_case_I(eip, eqpi, eqpj)) return FALSE;
+
+	/* Compute new eq-point. We do this by first computing */
+	/* its displacement relative to one of its terminals   */
+	/* and then add the result to that point	       */
+
+	eq_point_disp_vector(eip, eqpi, eqpj, eqpk);
+	eqpk -> E = eip -> eqp [ eqpk -> origin_term ].E;
+	eqpk -> E.x += eqpk -> DV.x;
+	eqpk -> E.y += eqpk -> DV.y;
+
+	eqpk -> R  = eqpi;
+	eqpk -> L  = eqpj;
+	eqpk -> S  = eqpi -> S + eqpj -> S;
+	eqpk -> RP = eqpi -> E;
+	eqpk -> LP = eqpj -> E;
+	eq_circle_center(&(eqpi -> E), &(eqpj  -> E), &(eqpk -> E), &(eqpk -> DC));
+	eqpk -> DR2 = sqr_dist(&(eqpk -> DC), &(eqpi -> E));
+
+	if (NOT projection_test_cases_II_VI(eip, eqpi, eqpj, eqpk)) return FALSE;
+
+	eqpk -> DR = sqrt(eqpk -> DR2);
+	if (NOT bsd_test(eip, eqpi, eqpj, eqpk))			 return FALSE;
+	if (NOT lune_test(eip, eqpi, eqpj, eqpk))			 return FALSE;
+
+	new_Zp = merge_terminal_lists(eip, eqpi, eqpj, eqpk);
+
+	if (NOT upper_bound_test(eip, eqpi, eqpj, eqpk))		 return FALSE;
+	if (NOT wedge_test(eip, eqpi, eqpj, eqpk))			 return FALSE;
+
+	eip -> eqpZ_curr = new_Zp;
+
+	if (eqpk -> S > 2) {
+		eip -> termlist -> n = 0;
+		eqpoint_terminals(eip, eqpk);
+		upper_bound = upper_bound_heuristic(eip);
+		if (eqpk -> UB > upper_bound) eqpk -> UB = upper_bound;
+	}
+
+	return TRUE;
+}
+
 
 /*
  * Compute the EFSTs for the given set of terminals, which are now
@@ -1949,12 +3610,13 @@ struct edge *		ep;
 struct edge *		mst_edges;
 dist_t			mst_len;
 char			buf1 [32];
-eterm_t			*new_Zp;
-int			i, j, k, si, l, size, iter, sz, starti, endi;
-dist_t			upper_bound;
+int			i, k, si, l, size, iter, sz, starti, endi;
+int			nthreads, old_size, nlist;
+int8u			ok;
 struct eqp_t		*eqpi, *eqpj, *eqpk, *eqpt, *eqp_old;
 struct eqp_t		**eqp_list, **eqpp, **eqppp;
 struct elist		*rp;
+bool			*chosen_old;
 int			max_fst_size;
 gst_channel_ptr		timing;
 
@@ -2014,6 +3676,7 @@ gst_channel_ptr		timing;
 	}
 	eip -> list.forw	= &(eip -> list);
 	eip -> list.back	= &(eip -> list);
+	_gst_arena_init (&(eip -> list_mem), 1024 * sizeof (struct elist));
 
 	/* Compute the mean of all terminals.  We translate the terminals */
 	/* so that the mean is at the origin.  The coordinates of the */
@@ -2034,14 +3697,22 @@ gst_channel_ptr		timing;
 	eip -> eqp_size		= eip->params->initial_eqpoints_terminal * n;
 	eip -> eqp		= NEWA (eip -> eqp_size, struct eqp_t);
 	eip -> size_start	= NEWA (n, int);
-	eip -> eqpZ_size	= 10 * eip -> eqp_size;
-	eip -> eqpZ		= NEWA (eip -> eqpZ_size, eterm_t);
-	eip -> eqpZ_curr	= eip -> eqpZ;
+	_gst_arena_init (&(eip -> eqpZ), 10 * eip -> eqp_size * sizeof (eterm_t));
+	eip -> eqpZ_curr	= NULL;
+	eip -> eqpZ_end		= NULL;
+	reserve_terminal_lists (eip, n);
 	eip -> MEMB		= NEWA (n, bool);
+	eip -> CHOSEN		= NEWA (eip -> eqp_size, bool);
+	memset (eip -> CHOSEN, 0, eip -> eqp_size * sizeof (bool));
+	memset (&(eip -> cands), 0, sizeof (eip -> cands));
+	eip -> defer_hookp	= NULL;
 	initialize_eqp_rectangles(eip);
+	initialize_terminal_tree(eip);
 	eip -> fsts_checked = 0;
 
 #ifdef HAVE_GMP
+	eip -> filter_tries	= 0;
+	eip -> filter_hits	= 0;
 	if (eip->params->multiple_precision > 0) {
 		_gst_qr3_init (&(eip -> cur_eqp.x));
 		_gst_qr3_init (&(eip -> cur_eqp.y));
@@ -2062,7 +3733,6 @@ gst_channel_ptr		timing;
 		eqpk -> L	= NULL;
 		eqpk -> S	= 1;
 		eqpk -> UB	= 0.0;
-		eqpk -> CHOSEN	= FALSE;
 		eqpk -> Z	= eip -> eqpZ_curr++;
 		*(eqpk -> Z)	= k;
 		eip -> MEMB[k]	= FALSE;
@@ -2079,7 +3749,22 @@ gst_channel_ptr		timing;
 	eqp_list = NEWA( eip -> eqp_size, struct eqp_t *);
 	if (max_fst_size EQ 0) max_fst_size = n;
 
+	nthreads = _gst_resolve_num_threads (eip -> params -> num_threads);
+#ifdef USE_TRIANGLE
+	/* The heuristics use Triangle, which is not reentrant. */
+	nthreads = 1;
+#endif
+
 	for (size = 2; size <= max_fst_size-1; size++) {
+		/* The eq-points of each size yield the FSTs having one	*/
+		/* more terminal, and the MST edges are added below, so	*/
+		/* all FSTs up to this size have been found.		*/
+		if (TIME_LIMIT_REACHED (eip -> params -> fst_time_limit,
+					&(eip -> fst_poll))) {
+			eip -> complete_size = size;
+			break;
+		}
+
 		starti = eip -> size_start[(size-1)/2 + 1];
 		endi   = k;
 		if (size EQ 2) endi = n-1; /* skip last terminal */
@@ -2092,65 +3777,49 @@ gst_channel_ptr		timing;
 				 size, k);
 		}
 
+		if ((nthreads > 1) AND (endi - starti >= MIN_PARALLEL_EQPS)) {
+			/* All eq-points of this size are combinations of	*/
+			/* smaller ones, so they can be generated in any	*/
+			/* order.  Let several threads do it.			*/
+			old_size = eip -> eqp_size;
+			k = generate_eqps_in_parallel (eip, size, starti, endi, k, nthreads);
+			eqpk = &(eip -> eqp[k]);
+			if (eip -> eqp_size NE old_size) {
+				free( eqp_list );
+				eqp_list = NEWA( eip -> eqp_size, struct eqp_t *);
+			}
+			save_eqp_rectangles(eip, eip -> size_start[size], k-1);
+			if (eip -> complete_size > 0) break;
+			continue;
+		}
+
 		for (i = starti; i < endi; i++) {
+			if (TIME_LIMIT_REACHED (eip -> params -> fst_time_limit,
+						&(eip -> fst_poll))) {
+				/* Keep the eq-points and FSTs found so far. */
+				eip -> complete_size = size;
+				break;
+			}
 			eqpi = &(eip -> eqp[i]);
 			set_member_arr(eip, eqpi, TRUE);
-			generate_compatible_eqp(eip, size - eqpi -> S, eqpi, eqp_list);
+			nlist = generate_compatible_eqp(eip, size - eqpi -> S, eqpi, eqp_list);
+			screen_candidates (eip, eqpi, eqp_list, nlist);
 
 			eqpp = eqp_list;
 			while (*eqpp) {
+				ok = eip -> cands.ok [eqpp - eqp_list];
 				eqpj = *(eqpp++);
-				eqpj -> CHOSEN = FALSE;
-				j = eqpj -> index;
-				if (j > i)				continue;
-				if (NOT disjoint(eip,eqpj))		continue;
 				for (iter = 1; iter <= 3; iter++) {
 					if (iter >= 2) {
 						struct eqp_t * eqptmp = eqpi;
 						eqpi = eqpj; eqpj = eqptmp;   /* swap i and j */
 						if (iter >= 3) break;	      /* finished */
 					}
+					if (NOT (ok & ((iter EQ 1) ? CAND_OK_IJ : CAND_OK_JI))) continue;
 
-					if (NOT projection_test_case_I(eip, eqpi, eqpj)) continue;
-
-					/* Compute new eq-point. We do this by first computing */
-					/* its displacement relative to one of its terminals   */
-					/* and then add the result to that point	       */
-
-					eq_point_disp_vector(eip, eqpi, eqpj, eqpk);
-					eqpk -> E = eip -> eqp [ eqpk -> origin_term ].E;
-					eqpk -> E.x += eqpk -> DV.x;
-					eqpk -> E.y += eqpk -> DV.y;
 					eqpk -> index = k;
+					if (NOT build_eqp(eip, eqpi, eqpj, eqpk)) continue;
 
-					eqpk -> R  = eqpi;
-					eqpk -> L  = eqpj;
-					eqpk -> S  = eqpi -> S + eqpj -> S;
-					eqpk -> RP = eqpi -> E;
-					eqpk -> LP = eqpj -> E;
-					eqpk -> CHOSEN = FALSE;
-					eq_circle_center(&(eqpi -> E), &(eqpj  -> E), &(eqpk -> E), &(eqpk -> DC));
-					eqpk -> DR2 = sqr_dist(&(eqpk -> DC), &(eqpi -> E));
-
-					if (NOT projection_test_cases_II_VI(eip, eqpi, eqpj, eqpk)) continue;
-
-					eqpk -> DR = sqrt(eqpk -> DR2);
-					if (NOT bsd_test(eip, eqpi, eqpj, eqpk))			 continue;
-					if (NOT lune_test(eip, eqpi, eqpj, eqpk))			 continue;
-
-					new_Zp = merge_terminal_lists(eip, eqpi, eqpj, eqpk, timing);
-
-					if (NOT upper_bound_test(eip, eqpi, eqpj, eqpk))		 continue;
-					if (NOT wedge_test(eip, eqpi, eqpj, eqpk))			 continue;
-
-					eip -> eqpZ_curr = new_Zp;
-
-					if (eqpk -> S > 2) {
-						eip -> termlist -> n = 0;
-						eqpoint_terminals(eip, eqpk);
-						upper_bound = upper_bound_heuristic(eip);
-						if (eqpk -> UB > upper_bound) eqpk -> UB = upper_bound;
-					}
 					k++;
 					if (k >= eip -> eqp_size) {
 						/* Eq-point space exhausted - double array */
@@ -2179,6 +3848,13 @@ gst_channel_ptr		timing;
 						eqpp = UPDATE_PTR( eqpp, eqppp, eqp_list );
 						free( eqppp );
 
+						/* Double compatibility flags */
+						chosen_old = eip -> CHOSEN;
+						eip -> CHOSEN = NEWA( eip -> eqp_size * 2, bool );
+						memcpy ( eip -> CHOSEN, chosen_old, eip -> eqp_size * sizeof(bool) );
+						memset ( eip -> CHOSEN + eip -> eqp_size, 0, eip -> eqp_size * sizeof(bool) );
+						free( chosen_old );
+
 						/* Update eq-point array left/right pointers */
 						for (eqpt = &(eip -> eqp[n]); eqpt <= eqpk; eqpt++) {
 							eqpt -> L = UPDATE_PTR( eqpt -> L, eqp_old, eip -> eqp );
@@ -2201,10 +3877,17 @@ gst_channel_ptr		timing;
 			set_member_arr(eip, eqpi, FALSE);
 		}
 		save_eqp_rectangles(eip, eip -> size_start[size], k-1);
+		if (eip -> complete_size > 0) break;
 	}
 
 	if (timing NE NULL) {
 		gst_channel_printf (timing, "%d eq-points generated.\n", k);
+		if (eip -> complete_size > 0) {
+			gst_channel_printf (timing,
+					    "- time limit reached, FSTs complete"
+					    " up to size %d\n",
+					    eip -> complete_size);
+		}
 	}
 
 	/* Finally add MST-edges */
@@ -2229,6 +3912,15 @@ gst_channel_ptr		timing;
 	}
 
 	if (timing NE NULL) {
+#ifdef HAVE_GMP
+		if (eip -> params -> multiple_precision > 0) {
+			gst_channel_printf (timing,
+					    "%d of %d exact values certified"
+					    " by the floating point filter.\n",
+					    eip -> filter_hits,
+					    eip -> filter_tries);
+		}
+#endif
 		_gst_convert_delta_cpu_time (buf1, Tn);
 		gst_channel_printf (timing, "Generating eq-points:   %s\n", buf1);
 	}
@@ -2247,9 +3939,12 @@ gst_channel_ptr		timing;
 	free( eip -> termlist );
 
 	destroy_eqp_rectangles(eip);
+	destroy_terminal_tree(eip);
 
+	free_eqp_cands (&(eip -> cands));
+	free( eip -> CHOSEN );
 	free( eip -> MEMB );
-	free( eip -> eqpZ );
+	_gst_arena_free (&(eip -> eqpZ));
 	free( eip -> size_start );
 	free( eip -> eqp );
 
@@ -2267,6 +3962,323 @@ gst_channel_ptr		timing;
 
 	return k;
 }
+
+/*
+ * Generate all eq-points of the given size, by combining each eq-point i
+ * (starti <= i < endi) with the compatible eq-points j <= i, using up to
+ * nthreads threads.  Each thread works with its own copy of the EFST
+ * info, so that the screening tests can use its scratch space freely.
+ * The eq-points and FSTs found by each task are then added to the
+ * global info in task order.  This yields exactly what the serial loop
+ * in compute_efsts_for_unique_terminals() does.  Returns the new total
+ * number of eq-points.
+ */
+
+	static
+	int
+generate_eqps_in_parallel (
+
+struct einfo *	eip,		/* IN/OUT - global EFST info */
+int		size,		/* IN - size of eq-points to generate */
+int		starti,		/* IN - first eq-point to combine */
+int		endi,		/* IN - last eq-point to combine + 1 */
+int		k,		/* IN - number of eq-points so far */
+int		nthreads	/* IN - number of threads to use */
+)
+{
+int			i;
+int			n;
+int			chunk;
+int			ntasks;
+struct einfo *		tip;
+struct eqp_task *	tp;
+struct eqp_batch	batch;
+
+	n = eip -> pts -> n;
+
+	chunk = (endi - starti) / (TASKS_PER_THREAD * nthreads);
+	if (chunk < 1) {
+		chunk = 1;
+	}
+	ntasks = (endi - starti + chunk - 1) / chunk;
+
+	batch.eip	= eip;
+	batch.size	= size;
+	batch.tasks	= NEWA (ntasks, struct eqp_task);
+	for (i = 0; i < ntasks; i++) {
+		tp = &(batch.tasks [i]);
+		tp -> first	= starti + i * chunk;
+		tp -> last	= tp -> first + chunk;
+		if (tp -> last > endi) {
+			tp -> last = endi;
+		}
+		tp -> eqp	= NULL;
+		tp -> neqp	= 0;
+		tp -> eqp_size	= 0;
+		_gst_arena_init (&(tp -> eqpZ), 0);
+		tp -> fsts	= NULL;
+		tp -> timed_out	= FALSE;
+	}
+
+	/* Every eq-point that could be compatible has index < k.	*/
+	batch.eips	= NEWA (nthreads, struct einfo);
+	batch.lists	= NEWA (nthreads, struct eqp_t **);
+	for (i = 0; i < nthreads; i++) {
+		tip = &(batch.eips [i]);
+		*tip = *eip;
+		tip -> MEMB		= NEWA (n, bool);
+		memset (tip -> MEMB, 0, n * sizeof (bool));
+		tip -> CHOSEN		= NEWA (k, bool);
+		memset (tip -> CHOSEN, 0, k * sizeof (bool));
+		memset (&(tip -> cands), 0, sizeof (tip -> cands));
+		tip -> termlist		= NEW_PSET (n + 2);
+		tip -> termindex	= NEWA (n + 2, int);
+		tip -> nbrs		= NEWA (n, int);
+		tip -> nbr_mask		= NEWA (BMAP_ELTS (n), bitmap_t);
+		memset (tip -> nbr_mask, 0, BMAP_ELTS (n) * sizeof (bitmap_t));
+		tip -> fsts_checked	= 0;
+#ifdef HAVE_GMP
+		tip -> filter_tries	= 0;
+		tip -> filter_hits	= 0;
+		if (eip -> params -> multiple_precision > 0) {
+			_gst_qr3_init (&(tip -> cur_eqp.x));
+			_gst_qr3_init (&(tip -> cur_eqp.y));
+		}
+#endif
+		batch.lists [i] = NEWA (k + 1, struct eqp_t *);
+	}
+
+	(void) _gst_parallel_for (nthreads, ntasks, eqp_task, &batch);
+
+	for (i = 0; i < nthreads; i++) {
+		tip = &(batch.eips [i]);
+		eip -> fsts_checked += tip -> fsts_checked;
+#ifdef HAVE_GMP
+		eip -> filter_tries += tip -> filter_tries;
+		eip -> filter_hits  += tip -> filter_hits;
+		if (eip -> params -> multiple_precision > 0) {
+			_gst_qr3_clear (&(tip -> cur_eqp.y));
+			_gst_qr3_clear (&(tip -> cur_eqp.x));
+		}
+#endif
+		free ((char *) (batch.lists [i]));
+		free ((char *) (tip -> nbr_mask));
+		free ((char *) (tip -> nbrs));
+		free ((char *) (tip -> termindex));
+		free ((char *) (tip -> termlist));
+		free_eqp_cands (&(tip -> cands));
+		free ((char *) (tip -> CHOSEN));
+		free ((char *) (tip -> MEMB));
+	}
+
+	for (i = 0; i < ntasks; i++) {
+		merge_eqp_task (eip, &(batch.tasks [i]), size, &k);
+		if (batch.tasks [i].timed_out) {
+			eip -> complete_size = size;
+		}
+	}
+
+	free ((char *) (batch.lists));
+	free ((char *) (batch.eips));
+	free ((char *) (batch.tasks));
+
+	return (k);
+}
+
+/*
+ * Combine each eq-point of one task with the compatible eq-points,
+ * on behalf of generate_eqps_in_parallel().  The new eq-points and
+ * their terminal lists go into memory private to the task, as does
+ * every FST that passes the screening tests.
+ */
+
+	static
+	void
+eqp_task (
+
+void *		arg,		/* IN/OUT - the batch */
+int		task,		/* IN - task to perform */
+int		thread		/* IN - thread executing task */
+)
+{
+int			i, iter, nlist;
+int8u			ok;
+struct eqp_batch *	bp;
+struct eqp_task *	tp;
+struct einfo *		eip;
+struct eqp_t *		eqpi;
+struct eqp_t *		eqpj;
+struct eqp_t *		eqpk;
+struct eqp_t *		eqp_old;
+struct eqp_t **		eqp_list;
+struct eqp_t **		eqpp;
+
+	bp	 = (struct eqp_batch *) arg;
+	tp	 = &(bp -> tasks [task]);
+	eip	 = &(bp -> eips [thread]);
+	eqp_list = bp -> lists [thread];
+
+	tp -> eqp_size		= 2 * (tp -> last - tp -> first);
+	tp -> eqp		= NEWA (tp -> eqp_size, struct eqp_t);
+	_gst_arena_init (&(eip -> eqpZ),
+			 bp -> size * tp -> eqp_size * sizeof (eterm_t));
+	eip -> eqpZ_curr	= NULL;
+	eip -> eqpZ_end		= NULL;
+	eip -> defer_hookp	= &(tp -> fsts);
+
+	for (i = tp -> first; i < tp -> last; i++) {
+		if (TIME_LIMIT_REACHED (eip -> params -> fst_time_limit,
+					&(eip -> fst_poll))) {
+			tp -> timed_out = TRUE;
+			break;
+		}
+		eqpi = &(eip -> eqp[i]);
+		set_member_arr(eip, eqpi, TRUE);
+		nlist = generate_compatible_eqp(eip, bp -> size - eqpi -> S, eqpi, eqp_list);
+		screen_candidates (eip, eqpi, eqp_list, nlist);
+
+		eqpp = eqp_list;
+		while (*eqpp) {
+			ok = eip -> cands.ok [eqpp - eqp_list];
+			eqpj = *(eqpp++);
+			for (iter = 1; iter <= 3; iter++) {
+				if (iter >= 2) {
+					struct eqp_t * eqptmp = eqpi;
+					eqpi = eqpj; eqpj = eqptmp;   /* swap i and j */
+					if (iter >= 3) break;	      /* finished */
+				}
+				if (NOT (ok & ((iter EQ 1) ? CAND_OK_IJ : CAND_OK_JI))) continue;
+
+				if (tp -> neqp >= tp -> eqp_size) {
+					/* Nothing else points into this array. */
+					eqp_old = tp -> eqp;
+					tp -> eqp = NEWA (2 * tp -> eqp_size, struct eqp_t);
+					memcpy (tp -> eqp, eqp_old, tp -> eqp_size * sizeof (struct eqp_t));
+					tp -> eqp_size *= 2;
+					free ((char *) eqp_old);
+				}
+				eqpk = &(tp -> eqp [tp -> neqp]);
+
+				/* Its real index is assigned by merge_eqp_task(). */
+				eqpk -> index = -1;
+				if (NOT build_eqp(eip, eqpi, eqpj, eqpk)) continue;
+
+				++(tp -> neqp);
+			}
+		}
+		set_member_arr(eip, eqpi, FALSE);
+	}
+
+	tp -> eqpZ = eip -> eqpZ;
+	_gst_arena_init (&(eip -> eqpZ), 0);
+	eip -> defer_hookp = NULL;
+}
+
+/*
+ * Add the eq-points and FSTs found by one task to the global EFST info,
+ * in the order the task found them.
+ */
+
+	static
+	void
+merge_eqp_task (
+
+struct einfo *		eip,		/* IN/OUT - global EFST info */
+struct eqp_task *	tp,		/* IN/OUT - the task */
+int			size,		/* IN - size of the new eq-points */
+int *			kp		/* IN/OUT - number of eq-points */
+)
+{
+int			i, k, l, si, sz;
+int			new_size;
+gst_channel_ptr		timing;
+struct eqp_t *		eqpk;
+struct eqp_t *		eqpt;
+struct eqp_t *		eqp_old;
+struct elist **		hookp;
+struct full_set *	fsp;
+bool *			chosen_old;
+
+	/* Save the FSTs, discarding those that are no shorter than	*/
+	/* one already saved.						*/
+	while (tp -> fsts NE NULL) {
+		fsp = tp -> fsts;
+		tp -> fsts = fsp -> next;
+		fsp -> next = NULL;
+		hookp = find_efst (eip, fsp -> tlist, fsp -> terminals -> n, &k);
+		if ((hookp NE NULL) AND (fsp -> tree_len >= (*hookp) -> fst -> tree_len)) {
+			free ((char *) (fsp -> tlist));
+			free ((char *) (fsp -> terminals));
+			free ((char *) (fsp -> steiners));
+			free ((char *) (fsp -> edges));
+			free ((char *) fsp);
+			continue;
+		}
+		insert_efst (eip, hookp, fsp, k);
+	}
+
+	k = *kp;
+	timing = eip -> params -> detailed_timings_channel;
+
+	/* Grow eq-point array so that there is still room for eq-point	*/
+	/* k after adding the new ones.					*/
+	new_size = eip -> eqp_size;
+	while (k + tp -> neqp >= new_size) {
+		if (timing NE NULL) {
+			gst_channel_printf (timing, "- doubling eq-point array\n");
+		}
+		new_size *= 2;
+	}
+	if (new_size > eip -> eqp_size) {
+		eqp_old = eip -> eqp;
+		eip -> eqp = NEWA (new_size, struct eqp_t);
+		memcpy (eip -> eqp, eqp_old, k * sizeof (struct eqp_t));
+
+		chosen_old = eip -> CHOSEN;
+		eip -> CHOSEN = NEWA (new_size, bool);
+		memcpy (eip -> CHOSEN, chosen_old, eip -> eqp_size * sizeof (bool));
+		memset (eip -> CHOSEN + eip -> eqp_size,
+			0,
+			(new_size - eip -> eqp_size) * sizeof (bool));
+		free ((char *) chosen_old);
+
+		/* Update eq-point array left/right pointers */
+		for (eqpt = &(eip -> eqp[eip -> pts -> n]); eqpt < &(eip -> eqp[k]); eqpt++) {
+			eqpt -> L = UPDATE_PTR( eqpt -> L, eqp_old, eip -> eqp );
+			eqpt -> R = UPDATE_PTR( eqpt -> R, eqp_old, eip -> eqp );
+		}
+		for (i = 0; i < tp -> neqp; i++) {
+			eqpt = &(tp -> eqp [i]);
+			eqpt -> L = UPDATE_PTR( eqpt -> L, eqp_old, eip -> eqp );
+			eqpt -> R = UPDATE_PTR( eqpt -> R, eqp_old, eip -> eqp );
+		}
+
+		/* Update rectangle pointers */
+		for (sz = 1; sz < size; sz++)
+		 if (eip -> eqp_squares[sz] NE NULL)
+		  for (si = 0; si < eip -> srangex * eip -> srangey; si++)
+		   for (l = 0; l < eip -> eqp_squares[sz][si].n; l++)
+		    eip -> eqp_squares[sz][si].eqp[l] =
+		       UPDATE_PTR( eip -> eqp_squares[sz][si].eqp[l], eqp_old, eip -> eqp );
+		free ((char *) eqp_old);
+		eip -> eqp_size = new_size;
+	}
+
+	/* Append the new eq-points.  Their terminal lists stay where	*/
+	/* they are, but now belong to the global arena.		*/
+	for (i = 0; i < tp -> neqp; i++) {
+		eqpk = &(eip -> eqp [k]);
+		*eqpk = tp -> eqp [i];
+		eqpk -> index = k;
+		++k;
+	}
+	_gst_arena_join (&(eip -> eqpZ), &(tp -> eqpZ));
+
+	free ((char *) (tp -> eqp));
+
+	*kp = k;
+}
+
 
 /*
  * This routine performs all of the FST specific screening tests.
@@ -2282,37 +4294,21 @@ struct eqp_t *	eqpt,		/* IN - terminal endpoint of this FST */
 struct eqp_t *	eqpk		/* IN - eq-point of this FST */
 )
 {
-int			i, j, k;
-int			nedges;
-int			previdx;
-int size, spidx, termidx;
-dist_t length;
-struct edge *		ep;
-struct point *		sp;
-struct point		nsp;
-struct point *		tp;
-struct pset *		pts;
-struct elist *		rp;
+int			k;
+int			size;
+dist_t			length;
 struct elist **		hookp;
-struct elist *		rp1;
-struct elist *		rp2;
-int *			tlist;
-int *			new_tlist;
-struct pset *		new_terms;
-struct pset *		new_steiners;
 struct full_set *	fsp;
-struct edge *		edges;
 
 	/* Assume that termlist has been constructed (change later!!) */
 
 	++(eip -> fsts_checked);
 
-	pts	= eip -> pts;
 	size	= eip -> termlist -> n;
 
 #ifdef HAVE_GMP
 	if (eip->params->multiple_precision > 0) {
-		/* Exact position of eqpk is already in eip -> cur_eqp. */
+		/* Position of eqpk is already in eip (exact or approx). */
 		length	= _gst_compute_EFST_length (eip, eqpt);
 	}
 	else {
@@ -2322,6 +4318,51 @@ struct edge *		edges;
 	length	= eq_point_dist (eip, eqpt, eqpk);
 #endif
 
+	if (eip -> defer_hookp NE NULL) {
+		/* Another thread owns the hash table.  Build the FST,	*/
+		/* and leave the rest to merge_eqp_task().		*/
+		fsp = build_efst (eip, eqpt, eqpk, length);
+		*(eip -> defer_hookp) = fsp;
+		eip -> defer_hookp = &(fsp -> next);
+		return (length);
+	}
+
+	hookp = find_efst (eip, eip -> termindex, size, &k);
+
+	/* Standard pruning: only keep if shorter (removed battery-aware pruning) */
+	if ((hookp NE NULL) AND (length >= (*hookp) -> fst -> tree_len)) {
+		/* New FST is not shorter, discard it */
+		return ((*hookp) -> fst -> tree_len);
+	}
+
+	fsp = build_efst (eip, eqpt, eqpk, length);
+
+	insert_efst (eip, hookp, fsp, k);
+
+	return (length);
+}
+
+/*
+ * Look for a saved FST having the given set of terminals.  Returns the
+ * hash table link that points to it, or NULL if there is none.  The
+ * hash bucket for this set of terminals is returned in *bucket.
+ */
+
+	static
+	struct elist **
+find_efst (
+
+struct einfo *	eip,		/* IN - The global EFST info */
+int *		tlist,		/* IN - terminals of FST */
+int		size,		/* IN - number of terminals */
+int *		bucket		/* OUT - hash bucket */
+)
+{
+int			i, j, k;
+struct elist *		rp;
+struct elist **		hookp;
+int *			tlist2;
+
 	/* General duplicate test.  We use a hash table, for speed.	*/
 	/* For correctness, the hash function must not depend upon the	*/
 	/* order of the terminals in the FST.  A simple checksum has	*/
@@ -2330,11 +4371,12 @@ struct edge *		edges;
 	/* Compute hash and prepare for rapid set comparison. */
 	k = 0;
 	for (i = 0; i < size; i++) {
-		j = eip -> termindex [i];
+		j = tlist [i];
 		eip -> term_check [j] = TRUE;
 		k += j;
 	}
-	k %= pts -> n;
+	k %= eip -> pts -> n;
+	*bucket = k;
 
 	hookp = &(eip -> hash [k]);
 	for (;;) {
@@ -2346,10 +4388,10 @@ struct edge *		edges;
 			break;
 		}
 		if (rp -> size EQ size) {
-			tlist = rp -> fst -> tlist;
+			tlist2 = rp -> fst -> tlist;
 			for (i = 0; ; i++) {
 				if (i >= size) goto found_efst;
-				if (NOT eip -> term_check [tlist [i]]) break;
+				if (NOT eip -> term_check [tlist2 [i]]) break;
 			}
 		}
 		hookp = &(rp -> next);
@@ -2358,30 +4400,42 @@ struct edge *		edges;
 found_efst:
 
 	for (i = 0; i < size; i++) {
-		eip -> term_check [eip -> termindex [i] ] = FALSE;
+		eip -> term_check [tlist [i]] = FALSE;
 	}
 
-	if (rp NE NULL) {
-		/* An FST for these terminals already exists. */
-		fsp = rp -> fst;
+	return ((rp EQ NULL) ? NULL : hookp);
+}
 
-		/* Standard pruning: only keep if shorter (removed battery-aware pruning) */
-		if (length >= fsp -> tree_len) {
-			/* New FST is not shorter, discard it */
-			return (fsp -> tree_len);
-		}
-		/* Keep the new one!  Delete the old one. */
-		*hookp = rp -> next;
-		rp2 = rp -> forw;
-		rp1 = rp -> back;
-		rp2 -> back = rp1;
-		rp1 -> forw = rp2;
-		free ((char *) (fsp -> terminals));
-		free ((char *) (fsp -> steiners));
-		free ((char *) (fsp -> edges));
-		free ((char *) fsp);
-		free ((char *) rp);
-	}
+/*
+ * Build the FST whose terminals are in eip -> termlist (and
+ * eip -> termindex), that joins terminal eqpt to eq-point eqpk.
+ */
+
+	static
+	struct full_set *
+build_efst (
+
+struct einfo *	eip,		/* IN - The global EFST info */
+struct eqp_t *	eqpt,		/* IN - terminal endpoint of this FST */
+struct eqp_t *	eqpk,		/* IN - eq-point of this FST */
+dist_t		length		/* IN - length of this FST */
+)
+{
+int			i;
+int			nedges;
+int			previdx;
+int size, spidx, termidx;
+struct edge *		ep;
+struct point *		sp;
+struct point		nsp;
+struct point *		tp;
+int *			new_tlist;
+struct pset *		new_terms;
+struct pset *		new_steiners;
+struct full_set *	fsp;
+struct edge *		edges;
+
+	size	= eip -> termlist -> n;
 
 	/* Build FST graph in edge list form. */
 
@@ -2456,25 +4510,60 @@ found_efst:
 	}
 	fprintf(stderr, "DEBUG EFST Multi: Final battery_score=%.2f\n", fsp->battery_score);
 
+	return (fsp);
+}
+
+/*
+ * Save the given FST, replacing the saved FST that hookp points to (if
+ * hookp is not NULL), which has the same terminals.
+ */
+
+	static
+	void
+insert_efst (
+
+struct einfo *		eip,		/* IN/OUT - The global EFST info */
+struct elist **		hookp,		/* IN - link to FST to replace */
+struct full_set *	fsp,		/* IN - FST to save */
+int			k		/* IN - hash bucket of FST */
+)
+{
+struct elist *		rp;
+struct elist *		rp1;
+struct elist *		rp2;
+struct full_set *	fsp2;
 
+	if (hookp NE NULL) {
+		/* Keep the new one!  Delete the old one. */
+		rp = *hookp;
+		fsp2 = rp -> fst;
+		*hookp = rp -> next;
+		rp2 = rp -> forw;
+		rp1 = rp -> back;
+		rp2 -> back = rp1;
+		rp1 -> forw = rp2;
+		free ((char *) (fsp2 -> tlist));
+		free ((char *) (fsp2 -> terminals));
+		free ((char *) (fsp2 -> steiners));
+		free ((char *) (fsp2 -> edges));
+		free ((char *) fsp2);
+	}
 
-	rp = NEW (struct elist);
+	rp = ARENA_NEW (&(eip -> list_mem), struct elist);
 
 	rp2 = &(eip -> list);
 	rp1 = rp2 -> back;
 	rp -> back	= rp1;
 	rp -> forw	= rp2;
 	rp -> next	= eip -> hash [k];
-	rp -> size	= size;
+	rp -> size	= fsp -> terminals -> n;
 	rp -> fst	= fsp;
 
 	rp1 -> forw	= rp;
 	rp2 -> back	= rp;
 	eip -> hash [k] = rp;
-
-	return (length);
 }
-
+
 /*
  * This routine constructs a graph of the EFST in edge list form.
  * This routine also fills in the proper Steiner points.
@@ -2612,7 +4701,7 @@ struct pset *		terms;
 
 /*
  * Link all of the FSTs together into one long list and number them
- * each sequentially.  Free the doubly-linked elists as we go.
+ * each sequentially.  The doubly-linked elists are then freed.
  */
 
 	static
@@ -2625,7 +4714,6 @@ struct einfo *		eip		/* IN - global EFST info */
 int			i;
 struct elist *		rp1;
 struct elist *		rp2;
-struct elist *		rp3;
 struct full_set *	fsp;
 struct full_set **	hookp;
 
@@ -2633,19 +4721,17 @@ struct full_set **	hookp;
 
 	rp2 = &(eip -> list);
 	i = 0;
-	for (rp1 = rp2 -> forw; rp1 NE rp2; ) {
+	for (rp1 = rp2 -> forw; rp1 NE rp2; rp1 = rp1 -> forw) {
 		fsp = rp1 -> fst;
 		fsp -> tree_num = i++;
 		*hookp = fsp;
 		hookp = &(fsp -> next);
-		rp3 = rp1;
-		rp1 = rp1 -> forw;
-		free ((char *) rp3);
 	}
 	*hookp = NULL;
 
 	eip -> list.forw = rp2;
 	eip -> list.back = rp2;
+	_gst_arena_free (&(eip -> list_mem));
 
 	/* Make it easy to add zero-length FSTs onto the end. */
 	eip -> ntrees	= i;
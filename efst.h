@@ -3,8 +3,8 @@
 	$Id: efst.h,v 1.13 2022/11/19 13:45:51 warme Exp $
 
 	File:	efst.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-9
+	Date:	10/18/2026
 
 	Copyright (c) 1998, 2022 by Pawel Winter, Martin Zachariasen.
 	This work is Licensed under a Creative Commons
@@ -43,17 +43,37 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Reorganize include files.
+	e-4:	10/18/2026	warme
+		: Move CHOSEN flags out of the eq-points, and
+		:  add deferred saving of FSTs, so that eq-points
+		:  can be generated on several threads.
+	e-5:	10/18/2026	warme
+		: Add k-d tree of terminals for the lune tests.
+	e-6:	10/18/2026	warme
+		: Add FST generation time limit to einfo.
+	e-7:	10/18/2026	warme
+		: Allocate terminal lists and the EFST list from
+		:  arenas.
+	e-8:	10/18/2026	warme
+		: Add structure-of-arrays candidate list for the
+		:  batched projection test.
+	e-9:	10/18/2026	warme
+		: Add state for the floating point filter in
+		:  front of the exact GMP computations.
 
 ************************************************************************/
 
 #ifndef EFST_H
 #define EFST_H
 
+#include "bitmaskmacros.h"
 #include "config.h"
 #include "egmp.h"
 #include "geomtypes.h"
 #include "gsttypes.h"
+#include "memory.h"
 #include "point.h"
+#include "polltime.h"
 
 /*
  * A structure to keep track of one EFST.  They are kept in a hash table
@@ -123,7 +143,6 @@ struct eqp_t {
 	int		SMAXX;	/* square data structure */
 	int		SMINY;
 	int		SMAXY;
-	bool		CHOSEN;
 };
 
 
@@ -136,6 +155,39 @@ struct eqp_square_t {
 	int		n;	/* Number of eq-points in array */
 };
 
+/*
+ * Node of the k-d tree of terminals.  Each node covers a contiguous
+ * range of the terminal array, which a non-leaf node splits evenly
+ * among its two children.
+ */
+
+struct kd_node_t {
+	dist_t		minx, maxx;	/* Bounding box of the terminals */
+	dist_t		miny, maxy;
+	int		first;		/* First terminal in kd_term */
+	int		last;		/* Last terminal + 1 */
+	int		left;		/* Child nodes, or -1 if a leaf */
+	int		right;
+};
+
+/*
+ * The eq-points that are candidates for combining with a given
+ * eq-point, in structure-of-arrays form, so that the first projection
+ * test can be applied to several of them at once.
+ */
+
+struct eqp_cands {
+	int		n;		/* Number of candidates */
+	int		size;		/* Allocated size of arrays */
+	double *	Ex;		/* Eq-point coordinates */
+	double *	Ey;
+	double *	LPx;		/* Left endpoints of Steiner arcs */
+	double *	LPy;
+	double *	RPx;		/* Right endpoints of Steiner arcs */
+	double *	RPy;
+	int8u *		ok;		/* Orders of combination that pass */
+};
+
 /*
  * Global information used by the EFST generator.
  */
@@ -156,12 +208,13 @@ struct einfo {
 	int		eqp_size;	/* Current size of eq-point array */
 	int *		size_start;	/* Starting index of eq-points of */
 					/* given size */
-	int		zalloc_size;	/* Current maximum number of */
-					/* terminal lists */
-	eterm_t *	eqpZ;		/* List of terminals for each eq-point */
-	int		eqpZ_size;	/* Current size of terminals list */
+	struct arena	eqpZ;		/* Lists of terminals for eq-points */
 	eterm_t *	eqpZ_curr;	/* Current allocation pointer */
+	eterm_t *	eqpZ_end;	/* End of current block of eqpZ */
 	bool *		MEMB;		/* For checking eq-point overlap */
+	bool *		CHOSEN;		/* Eq-points already found to be */
+					/* compatible (by index) */
+	struct eqp_cands cands;		/* Candidates for combining */
 
 	/* Variables used while generating eq-points */
 	dist_t		dxi, dyi, dxj, dyj;
@@ -174,20 +227,41 @@ struct einfo {
 	dist_t		minx, maxx, miny, maxy; /* Terminal coordinate range */
 	int		srangex, srangey;	/* Range of squares */
 
+	/* Variables used for the k-d tree of terminals */
+	struct kd_node_t * kd_node;	/* Nodes of tree (root is first) */
+	int *		kd_term;	/* Terminals, in leaf order */
+	dist_t		kd_slack;	/* Slack added to query ranges */
+	int *		nbrs;		/* Terminals found by a query */
+	bitmap_t *	nbr_mask;	/* Same, as a bit-map (kept clear) */
+
 	int		fsts_checked;	/* Num FSTs sent to screening tests */
 	bool *		term_check;	/* To compare FST terminal sets */
 
 	int		num_term_masks; /* Size of terminal mask in each FST */
 
 	struct elist ** hash;		/* FST hash table */
+	struct full_set ** defer_hookp;	/* Where to queue new FSTs when */
+					/* the hash table is not ours */
 	struct elist	list;		/* Head of circular EFST list */
+	struct arena	list_mem;	/* Memory for the EFST list */
 
 	int		ntrees;		/* Final number of FSTs */
 	struct full_set * full_sets;	/* Final list of FSTs */
 	struct full_set ** hookp;	/* For adding to end of FST list */
 
+	struct cpu_poll	fst_poll;	/* Time limit of FST generation */
+	int		complete_size;	/* Largest size of which all FSTs */
+					/* were generated (0 = every size) */
+
 #ifdef HAVE_GMP
+	struct eqp_t *	cur_eqpk;	/* Current eq-point */
+	bool		cur_exact;	/* cur_eqp has been computed */
 	struct qr3_point cur_eqp;	/* Exact pos of current eq-point */
+	bool		cur_approx_ok;	/* cur_approx has been computed */
+	struct dd_point	cur_approx;	/* Approx pos of current eq-point */
+	int		filter_tries;	/* Exact values requested */
+	int		filter_hits;	/* Exact values certified by the */
+					/* floating point filter */
 #endif
 };
 
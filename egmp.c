@@ -3,8 +3,8 @@
 	$Id: egmp.c,v 1.14 2022/11/19 13:45:51 warme Exp $
 
 	File:	egmp.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-6
+	Date:	10/18/2026
 
 	Copyright (c) 2000, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -35,6 +35,15 @@
 		: Fix -Wall issues.  Upgrade fatals.
 	e-4:	11/18/2022	warme
 		: Fix -Wall issues.
+	e-5:	10/18/2026	warme
+		: Put a floating point filter in front of the
+		:  exact eq-point and FST length computations.
+		:  GMP is used only when the filter cannot
+		:  certify the result.
+	e-6:	10/18/2026	warme
+		: Also filter the lengths of FSTs whose eq-point
+		:  is a terminal, and compute them exactly when
+		:  they are exactly doubles.
 
 ************************************************************************/
 
@@ -50,6 +59,7 @@
 #include "costextension.h"
 #include "efst.h"
 #include "fatal.h"
+#include <float.h>
 #include "logic.h"
 #include <math.h>
 #include "memory.h"
@@ -83,6 +93,30 @@ struct cost_extension *
 
 #define DEBUG_PRINT	0
 
+/*
+ * The floating point filter computes eq-points and FST lengths in
+ * double-double arithmetic, together with a rigorous bound on the
+ * absolute error.  The error-free transformations it is built upon
+ * require that double arithmetic really be done in double precision
+ * (e.g., not in the x87's extended precision).
+ */
+
+#if defined(FLT_EVAL_METHOD) AND		\
+    ((FLT_EVAL_METHOD EQ 0) OR		\
+     (FLT_EVAL_METHOD EQ 1) OR		\
+     (FLT_EVAL_METHOD EQ 16))
+ #define FP_FILTER	1
+#else
+ #define FP_FILTER	0
+#endif
+
+#define DD_ADD_ERR	9.860761315262648e-32	/* 2^(-103) */
+#define DD_MUL_ERR	1.9721522630525295e-31	/* 2^(-102) */
+#define DD_TINY		9.332636185032189e-302	/* 2^(-1000) */
+#define DD_MIN		6.223015277861142e-61	/* 2^(-200) */
+#define DD_MAX		1.6069380442589903e+60	/* 2^200 */
+#define NEWTON_SLACK	2.168404344971009e-19	/* 2^(-62) */
+
 struct ExEqp;
 struct GceInfo;
 
@@ -96,6 +130,9 @@ static void	_egmp_cext_write_edge_cost (
 				FILE *				fp,
 				int				i);
 static void	allocate_graph_arrays (struct GceInfo * gcp);
+static bool	certify_dd (double * result, const struct dd_real * p);
+static bool	compute_dd_eqpoint (struct dd_point *	p,
+				    struct eqp_t *	eqpk);
 static void	compute_edges_for_fst (struct GceInfo *		gcp,
 				       mpq_srcptr		scale_factor,
 				       int			fstidx);
@@ -116,6 +153,20 @@ static void	compute_sqrt_scaled_qr3 (mpf_ptr	res,
 					 const qr3_t *	A,
 					 mpq_srcptr	scale);
 static void	count_graph_items (struct GceInfo * gcp);
+static void	dd_add (struct dd_real *	res,
+			const struct dd_real *	a,
+			const struct dd_real *	b);
+static bool	dd_from_double (struct dd_real * res, double x);
+static void	dd_half (struct dd_real * p);
+static void	dd_mul (struct dd_real *	res,
+			const struct dd_real *	a,
+			const struct dd_real *	b);
+static void	dd_sub (struct dd_real *	res,
+			const struct dd_real *	a,
+			const struct dd_real *	b);
+static bool	exact_length_squared (double *			result,
+				      const struct dd_real *	dx,
+				      const struct dd_real *	dy);
 static void	free_graph_arrays (struct GceInfo * gcp);
 static void	print_qr3 (const qr3_t * x);
 static void	process_fst (struct GceInfo * gcp, int i);
@@ -141,6 +192,7 @@ static struct ExEqp *	traverse_fst_graph (
 				int			v1,
 				int			e1,
 				int			v2);
+static double	two_prod (double * err, double a, double b);
 
 /*
  * A routine to recompute the coordinates of the given eq-point and its
@@ -150,6 +202,11 @@ static struct ExEqp *	traverse_fst_graph (
  * call this routine that re-computes these quantities correct to within
  * 1/2 ULP of the floating point arithmetic -- thus preventing the
  * accumulation of such errors.
+ *
+ * The exact computation is expensive, so we first try the floating
+ * point filter, which usually certifies all four quantities.  Only
+ * when it cannot do so is the exact position of the eq-point computed
+ * (and remembered for _gst_compute_EFST_length).
  */
 
 	void
@@ -161,17 +218,65 @@ struct eqp_t *		eqpk		/* IN - eq-point to recompute */
 {
 double			nx;
 double			ny;
+double			dvx;
+double			dvy;
 mpq_t			rtmp;
 struct point *		tp;
 struct qr3_point *	ep;
+struct dd_point *	ap;
+struct dd_real		t1;
+struct dd_real		t2;
 qr3_t			dv_tmp;
 
+	eip -> cur_eqpk		= eqpk;
+	eip -> cur_exact	= FALSE;
+	eip -> cur_approx_ok	= FALSE;
+
+	if (eqpk -> L EQ NULL) {
+		/* A terminal is exact already, and has DV = 0.	*/
+		/* Its position is also its approximation, so	*/
+		/* that the filter can try its FST lengths.	*/
+		ap = &(eip -> cur_approx);
+		eip -> cur_approx_ok =
+			FP_FILTER AND
+			dd_from_double (&(ap -> x), eqpk -> E.x) AND
+			dd_from_double (&(ap -> y), eqpk -> E.y);
+		return;
+	}
+
+	tp = &(eip -> eqp [eqpk -> origin_term].E);
+
+	++(eip -> filter_tries);
+
+	ap = &(eip -> cur_approx);
+	if (FP_FILTER AND compute_dd_eqpoint (ap, eqpk)) {
+		eip -> cur_approx_ok = TRUE;
+
+		dd_from_double (&t1, tp -> x);
+		dd_sub (&t1, &(ap -> x), &t1);
+		dd_from_double (&t2, tp -> y);
+		dd_sub (&t2, &(ap -> y), &t2);
+
+		if (certify_dd (&nx, &(ap -> x)) AND
+		    certify_dd (&ny, &(ap -> y)) AND
+		    certify_dd (&dvx, &t1) AND
+		    certify_dd (&dvy, &t2)) {
+			++(eip -> filter_hits);
+			eqpk -> E.x	= nx;
+			eqpk -> E.y	= ny;
+			eqpk -> DV.x	= dvx;
+			eqpk -> DV.y	= dvy;
+			return;
+		}
+	}
+
 	mpq_init (rtmp);
 	_gst_qr3_init (&dv_tmp);
 
 	ep = &(eip -> cur_eqp);
 
 	compute_eqpoint (ep, eip, eqpk);
+	eip -> cur_exact = TRUE;
 
 #if DEBUG_PRINT
 	printf ("\nPoint %3d: original = (%24.20f, %24.20f)\n",
@@ -217,8 +322,6 @@ qr3_t			dv_tmp;
 	eqpk -> E.x = nx;
 	eqpk -> E.y = ny;
 
-	tp = &(eip -> eqp [eqpk -> origin_term].E);
-
 	r_to_q (rtmp, tp -> x);
 	mpq_sub (dv_tmp.a, ep -> x.a, rtmp);
 	mpq_set (dv_tmp.b, ep -> x.b);
@@ -582,8 +685,9 @@ double		xf;
  * Routine to compute the length of a given EFST (i.e., Simpson line)
  * to within 1/2 ULP.  (Modulo good behavior of the sqrt() function...)
  *
- * The exact position of the eq-point end of the Simpson line has already
- * been stored in eip -> cur_eqp.
+ * The position of the eq-point end of the Simpson line has already been
+ * approximated (or computed exactly) by the call to
+ * _gst_update_eqpoint_and_displacement() for that eq-point.
  */
 
 	double
@@ -596,6 +700,37 @@ struct eqp_t *		eqpt		/* IN - terminal end of Simpson line */
 qr3_t			x;
 qr3_t			y;
 double			len;
+struct dd_real		dx;
+struct dd_real		dy;
+
+	if (eip -> cur_approx_ok) {
+		++(eip -> filter_tries);
+
+		dd_from_double (&dx, eqpt -> E.x);
+		dd_sub (&dx, &(eip -> cur_approx.x), &dx);
+		dd_from_double (&dy, eqpt -> E.y);
+		dd_sub (&dy, &(eip -> cur_approx.y), &dy);
+
+		if ((eip -> cur_eqpk -> L EQ NULL) AND
+		    exact_length_squared (&len, &dx, &dy)) {
+			++(eip -> filter_hits);
+			return (sqrt (len));
+		}
+
+		dd_mul (&dx, &dx, &dx);
+		dd_mul (&dy, &dy, &dy);
+		dd_add (&dx, &dx, &dy);
+
+		if (certify_dd (&len, &dx)) {
+			++(eip -> filter_hits);
+			return (sqrt (len));
+		}
+	}
+
+	if (NOT eip -> cur_exact) {
+		compute_eqpoint (&(eip -> cur_eqp), eip, eip -> cur_eqpk);
+		eip -> cur_exact = TRUE;
+	}
 
 	_gst_qr3_init (&x);
 	_gst_qr3_init (&y);
@@ -622,6 +757,346 @@ double			len;
 	return (len);
 }
 
+/*
+ * The floating point filter.  On behalf of qr3_to_double(), decide
+ * which double the exact GMP computation would yield for the value X
+ * that is known to lie within p -> err of p -> hi + p -> lo.  That
+ * computation truncates (towards zero) some Z having
+ * |Z - X| < 2^(-EPS) * |X|.  If every such Z truncates to the same
+ * double, we return it.  Otherwise X is too close to a double (or the
+ * error bound is too large) and we return FALSE, so that the exact
+ * computation must be done after all.
+ */
+
+	static
+	bool
+certify_dd (
+
+double *		result,		/* OUT - certified double */
+const struct dd_real *	p		/* IN - value to convert */
+)
+{
+double		hi;
+double		lo;
+double		m;
+double		up;
+double		down;
+
+	hi = p -> hi;
+	lo = p -> lo;
+
+	/* Every Z lies within m of hi + lo. */
+	m = p -> err + fabs (hi) * NEWTON_SLACK;
+
+	/* Gaps to the neighbors of hi. */
+	up	= nextafter (hi, HUGE_VAL) - hi;
+	down	= hi - nextafter (hi, - HUGE_VAL);
+
+	if ((lo - m > 0.0) AND (lo + m < 0.75 * up)) {
+		/* Every Z lies strictly between hi and its successor. */
+		*result = (hi > 0.0) ? hi : nextafter (hi, 0.0);
+		return (TRUE);
+	}
+	if ((lo + m < 0.0) AND (m - lo < 0.75 * down)) {
+		/* Every Z lies strictly between hi and its predecessor. */
+		*result = (hi > 0.0) ? nextafter (hi, 0.0) : hi;
+		return (TRUE);
+	}
+
+	/* Also fails for NaN or infinite errors. */
+	return (FALSE);
+}
+
+/*
+ * Between two terminals, the squared length is often exactly a double
+ * (always, for instance, when the coordinates are small integers).
+ * certify_dd() can never certify such a value, since it does not know
+ * that the value is exact.  Here dx and dy are the exact differences
+ * of the coordinates, because they come from subtracting two doubles.
+ * If both are doubles and the squared length is computed without
+ * rounding, return it.  The exact computation would truncate the same
+ * value, and so yield the same double.
+ */
+
+	static
+	bool
+exact_length_squared (
+
+double *		result,		/* OUT - exact squared length */
+const struct dd_real *	dx,		/* IN - exact X difference */
+const struct dd_real *	dy		/* IN - exact Y difference */
+)
+{
+double		a;
+double		ea;
+double		b;
+double		eb;
+double		s;
+double		v;
+
+	/* Coordinates out of range for dd_from_double() could make	*/
+	/* the products below overflow or underflow.			*/
+	if ((dx -> err >= HUGE_VAL) OR (dy -> err >= HUGE_VAL)) return (FALSE);
+
+	if ((dx -> lo NE 0.0) OR (dy -> lo NE 0.0)) return (FALSE);
+
+	a = two_prod (&ea, dx -> hi, dx -> hi);
+	b = two_prod (&eb, dy -> hi, dy -> hi);
+	if ((ea NE 0.0) OR (eb NE 0.0)) return (FALSE);
+
+	/* This is the exact rounding error of a + b (two_sum). */
+	s = a + b;
+	v = s - a;
+	if ((a - (s - v)) + (b - v) NE 0.0) return (FALSE);
+
+	*result = s;
+	return (TRUE);
+}
+
+/*
+ * Compute an approximation of the given eq-point in double-double
+ * arithmetic, following the same recurrence as compute_eqpoint().
+ * Returns FALSE if some terminal coordinate is of a magnitude for
+ * which the error bounds might not hold.
+ */
+
+	static
+	bool
+compute_dd_eqpoint (
+
+struct dd_point *	out,		/* OUT - approximate eq-point */
+struct eqp_t *		eqpk		/* IN - eq-point to calculate */
+)
+{
+struct dd_point		P;
+struct dd_point		Q;
+struct dd_real		Rx;
+struct dd_real		Ry;
+struct dd_real		t;
+
+static const struct dd_real	sqrt3 = {
+	1.7320508075688772,
+	1.0035084221806903e-16,
+	2.0e-33,
+};
+
+	if (eqpk -> L EQ NULL) {
+		/* Base case -- a terminal. */
+		return (dd_from_double (&(out -> x), eqpk -> E.x) AND
+			dd_from_double (&(out -> y), eqpk -> E.y));
+	}
+
+	/* Recurse, let P be the right point, and Q the left eq-point. */
+
+	if (NOT compute_dd_eqpoint (&P, eqpk -> R)) return (FALSE);
+	if (NOT compute_dd_eqpoint (&Q, eqpk -> L)) return (FALSE);
+
+	dd_sub (&Rx, &(Q.x), &(P.x));
+	dd_sub (&Ry, &(Q.y), &(P.y));
+
+	/* x = P.x + (R.x - sqrt(3) * R.y) / 2 */
+	dd_mul (&t, &sqrt3, &Ry);
+	dd_sub (&t, &Rx, &t);
+	dd_half (&t);
+	dd_add (&(out -> x), &(P.x), &t);
+
+	/* y = P.y + (R.y + sqrt(3) * R.x) / 2 */
+	dd_mul (&t, &sqrt3, &Rx);
+	dd_add (&t, &Ry, &t);
+	dd_half (&t);
+	dd_add (&(out -> y), &(P.y), &t);
+
+	return (TRUE);
+}
+
+/*
+ * Convert a double to double-double form.  Returns FALSE (and an
+ * infinite error bound) for magnitudes at which the error bounds of
+ * the double-double operations might not hold due to underflow or
+ * overflow.
+ */
+
+	static
+	bool
+dd_from_double (
+
+struct dd_real *	res,		/* OUT - double-double value */
+double			x		/* IN - double to convert */
+)
+{
+	res -> hi	= x;
+	res -> lo	= 0.0;
+	res -> err	= 0.0;
+
+	if ((x NE 0.0) AND ((fabs (x) < DD_MIN) OR (fabs (x) > DD_MAX))) {
+		res -> err = HUGE_VAL;
+		return (FALSE);
+	}
+
+	return (TRUE);
+}
+
+/*
+ * Add two double-double numbers (the accurate algorithm, having
+ * relative error at most 3u^2 with u = 2^(-53)), and bound the error.
+ */
+
+	static
+	void
+dd_add (
+
+struct dd_real *	res,		/* OUT - a + b */
+const struct dd_real *	a,		/* IN - first operand */
+const struct dd_real *	b		/* IN - second operand */
+)
+{
+double		sh;
+double		sl;
+double		th;
+double		tl;
+double		v;
+double		err;
+
+	err = a -> err + b -> err;
+
+	/* (sh, sl) = two_sum (a -> hi, b -> hi) */
+	sh = a -> hi + b -> hi;
+	v  = sh - a -> hi;
+	sl = (a -> hi - (sh - v)) + (b -> hi - v);
+
+	/* (th, tl) = two_sum (a -> lo, b -> lo) */
+	th = a -> lo + b -> lo;
+	v  = th - a -> lo;
+	tl = (a -> lo - (th - v)) + (b -> lo - v);
+
+	/* (sh, sl) = fast_two_sum (sh, sl + th) */
+	sl += th;
+	v  = sh + sl;
+	sl = sl - (v - sh);
+	sh = v;
+
+	/* res = fast_two_sum (sh, sl + tl) */
+	sl += tl;
+	res -> hi = sh + sl;
+	res -> lo = sl - (res -> hi - sh);
+
+	res -> err = err + DD_ADD_ERR * fabs (res -> hi) + DD_TINY;
+}
+
+/*
+ * Subtract two double-double numbers.
+ */
+
+	static
+	void
+dd_sub (
+
+struct dd_real *	res,		/* OUT - a - b */
+const struct dd_real *	a,		/* IN - first operand */
+const struct dd_real *	b		/* IN - second operand */
+)
+{
+struct dd_real		nb;
+
+	nb.hi	= - b -> hi;
+	nb.lo	= - b -> lo;
+	nb.err	= b -> err;
+
+	dd_add (res, a, &nb);
+}
+
+/*
+ * Multiply two double-double numbers (relative error at most 7u^2),
+ * and bound the error.
+ */
+
+	static
+	void
+dd_mul (
+
+struct dd_real *	res,		/* OUT - a * b */
+const struct dd_real *	a,		/* IN - first operand */
+const struct dd_real *	b		/* IN - second operand */
+)
+{
+double		ph;
+double		pl;
+double		aa;
+double		bb;
+double		err;
+
+	aa	= fabs (a -> hi) + fabs (a -> lo);
+	bb	= fabs (b -> hi) + fabs (b -> lo);
+	err	= aa * b -> err + bb * a -> err + a -> err * b -> err;
+
+	ph = two_prod (&pl, a -> hi, b -> hi);
+	pl += a -> hi * b -> lo + a -> lo * b -> hi;
+
+	res -> hi = ph + pl;
+	res -> lo = pl - (res -> hi - ph);
+
+	res -> err = err + DD_MUL_ERR * fabs (res -> hi) + DD_TINY;
+}
+
+/*
+ * Halve a double-double number (exactly).
+ */
+
+	static
+	void
+dd_half (
+
+struct dd_real *	p		/* IN/OUT - number to halve */
+)
+{
+	p -> hi		*= 0.5;
+	p -> lo		*= 0.5;
+	p -> err	= 0.5 * p -> err + DD_TINY;
+}
+
+/*
+ * Compute the product of two doubles exactly, as the sum of the
+ * (rounded) product and the returned error term.  Without a fused
+ * multiply-add we use Dekker's algorithm.
+ */
+
+	static
+	double
+two_prod (
+
+double *	err,		/* OUT - a * b - product */
+double		a,		/* IN - first factor */
+double		b		/* IN - second factor */
+)
+{
+double		p;
+
+#if defined(FP_FAST_FMA)
+	p = a * b;
+	*err = fma (a, b, -p);
+#else
+double		t;
+double		ah;
+double		al;
+double		bh;
+double		bl;
+
+	p = a * b;
+
+	/* Split a and b into 26-bit halves. */
+	t  = 134217729.0 * a;
+	ah = t - (t - a);
+	al = a - ah;
+	t  = 134217729.0 * b;
+	bh = t - (t - b);
+	bl = b - bh;
+
+	*err = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+#endif
+
+	return (p);
+}
+
 /*
  * Multiply two elements of Q(sqrt(3)).
  */
@@ -3,8 +3,8 @@
 	$Id: egmp.h,v 1.10 2022/11/19 13:45:51 warme Exp $
 
 	File:	egmp.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 2000, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -29,6 +29,9 @@
 		: Add cost_extension for SteinLib "integer" format.
 	e-3:	09/24/2016	warme
 		: Reorganize include files, apply prefixes.
+	e-4:	10/18/2026	warme
+		: Add error-bounded double-double approximations
+		:  of eq-points, for the floating point filter.
 
 ************************************************************************/
 
@@ -61,6 +64,17 @@ struct qr3_point {
 	qr3_t		y;
 };
 
+struct dd_real {			/* hi + lo, within +/- err */
+	double		hi;
+	double		lo;
+	double		err;
+};
+
+struct dd_point {
+	struct dd_real	x;
+	struct dd_real	y;
+};
+
 
 /*
  * Global Routines
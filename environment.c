@@ -3,10 +3,10 @@
 	$Id: environment.c,v 1.34 2023/04/03 17:43:34 warme Exp $
 
 	File:	environment.c
-	Rev:	e-4
-	Date:	04/03/2023
+	Rev:	e-5
+	Date:	10/18/2026
 
-	Copyright (c) 2002, 2023 by Pawel Winter, Martin Zachariasen.
+	Copyright (c) 2002, 2026 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
 	Attribution-NonCommercial 4.0 International License.
 
@@ -32,6 +32,8 @@
 		: Upgrade fatals.
 	e-4:	04/03/2023	warme
 		: Added table initialization routine.
+	e-5:	10/18/2026	warme
+		: Added HiGHS version string.
 
 ************************************************************************/
 
@@ -334,8 +336,10 @@ char *	version_string;
 
 	GST_PRELUDE
 
-#ifdef CPLEX
+#if defined(CPLEX)
 	version_string = "CPLEX " CPLEX_VERSION_STRING;
+#elif defined(HIGHS)
+	version_string = "HiGHS";
 #else
 	version_string = "lp_solve " PATCHLEVEL;
 #endif
@@ -3,8 +3,8 @@
 	$Id: environment.h,v 1.27 2023/04/03 17:45:35 warme Exp $
 
 	File:	environment.h
-	Rev:	e-4
-	Date:	04/03/2023
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2023 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -32,6 +32,8 @@
 		: Reorganize include files, apply prefixes.
 	e-4:	04/03/2023	warme
 		: Added table initialization routine.
+	e-5:	10/18/2026	warme
+		: Added origin for wall-clock times.
 
 ************************************************************************/
 
@@ -67,6 +69,7 @@ struct environment {
 	/* Some variables used for timing. */
 	clock_t		clocks_per_sec;
 	int32u		Q, R, method;
+	time_t		wall_origin;	/* Origin for wall-clock times */
 
 	/* Access to parameter definition info. */
 	struct gst_parmdefs *	parmdefs;
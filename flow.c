@@ -3,8 +3,8 @@
 	$Id: flow.c,v 1.12 2023/04/03 17:40:50 warme Exp $
 
 	File:	flow.c
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-6
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -12,8 +12,11 @@
 
 ************************************************************************
 
-	A standard network maximum flow solver.  Uses the augmenting
-	path method with breadth-first search.
+	Network maximum flow solvers.  The first uses the augmenting
+	path method with breadth-first search.  The second is a
+	highest-label push-relabel method (with gap and global
+	relabeling heuristics) that can be warm-started after the
+	source/sink capacities are changed.
 
 ************************************************************************
 
@@ -34,6 +37,8 @@
 		: Fix -Wall issue.
 	e-5:	04/03/2023	warme
 		: Fix a bug that made temp arrays be wrong size.
+	e-6:	10/18/2026	warme
+		: Added push-relabel solver with warm restarts.
 
 ************************************************************************/
 
@@ -60,6 +65,22 @@ void	_gst_create_flow_temp_data (struct flow_prob *	prob,
 				    struct flow_temp *	temp);
 void	_gst_free_flow_solution_data (struct flow_soln * soln);
 void	_gst_free_flow_temp_data (struct flow_temp *	temp);
+void	_gst_pr_create_network (struct pr_network *	net,
+				int			num_nodes,
+				int			num_arcs,
+				int *			arc_src,
+				int *			arc_dst,
+				double *		capacity);
+void	_gst_pr_free_network (struct pr_network *	net);
+double	_gst_pr_max_flow (struct pr_network *	net,
+			  bitmap_t *		cut);
+void	_gst_pr_reset (struct pr_network *	net);
+void	_gst_pr_set_sink_cap (struct pr_network *	net,
+			      int			node,
+			      double			cap);
+void	_gst_pr_set_source_cap (struct pr_network *	net,
+				int			node,
+				double			cap);
 
 
 /*
@@ -69,6 +90,16 @@ void	_gst_free_flow_temp_data (struct flow_temp *	temp);
 	/* none */
 
 
+/*
+ * Local Routines
+ */
+
+static void	pr_discharge (struct pr_network * net, int u);
+static void	pr_gap (struct pr_network * net, int k);
+static void	pr_global_relabel (struct pr_network * net);
+static void	pr_relabel (struct pr_network * net, int u);
+
+
 /*
  * Local Equates
  */
@@ -313,3 +344,588 @@ struct flow_temp *	temp	/* IN - flow temp buffers to free */
 	free ((char *) (temp -> pred_arc));
 	free ((char *) (temp -> delta));
 }
+
+/*
+ * This routine builds a push-relabel network from the given list of
+ * directed arcs.  Every arc is stored together with its reverse
+ * residual arc, and the arcs are sorted by tail node into a flat CSR
+ * layout.  All source and sink capacities are initially zero.
+ */
+
+	void
+_gst_pr_create_network (
+
+struct pr_network *	net,		/* OUT - network to build */
+int			num_nodes,	/* IN - number of nodes */
+int			num_arcs,	/* IN - number of arcs */
+int *			arc_src,	/* IN - tail node of each arc */
+int *			arc_dst,	/* IN - head node of each arc */
+double *		capacity	/* IN - capacity of each arc */
+)
+{
+int		i;
+int		j;
+int		k;
+int		u;
+int		v;
+int		n;
+int		m;
+int *		ptr;
+
+	n = num_nodes;
+	m = 2 * num_arcs;
+
+	net -> num_nodes	= n;
+	net -> num_arcs		= m;
+
+	net -> first	= NEWA (n + 1, int);
+	net -> head	= NEWA (m, int);
+	net -> mate	= NEWA (m, int);
+	net -> cap	= NEWA (m, double);
+	net -> rcap	= NEWA (m, double);
+
+	net -> src_cap	= NEWA (n, double);
+	net -> snk_cap	= NEWA (n, double);
+	net -> snk_flow	= NEWA (n, double);
+	net -> shift	= NEWA (n, double);
+	net -> excess	= NEWA (n, double);
+	net -> label	= NEWA (n, int);
+	net -> cur	= NEWA (n, int);
+	net -> anext	= NEWA (n, int);
+	net -> bnext	= NEWA (n, int);
+	net -> bprev	= NEWA (n, int);
+	net -> queue	= NEWA (n, int);
+
+	/* Labels run from 1 to n for nodes that can reach the sink,	*/
+	/* and n+1 for nodes that cannot.				*/
+	net -> abucket	= NEWA (n + 2, int);
+	net -> bucket	= NEWA (n + 2, int);
+
+	/* Count residual arcs leaving each node. */
+	ptr = NEWA (n + 1, int);
+	for (i = 0; i <= n; i++) {
+		ptr [i] = 0;
+	}
+	for (k = 0; k < num_arcs; k++) {
+		FATAL_ERROR_IF ((arc_src [k] < 0) OR (arc_src [k] >= n) OR
+				(arc_dst [k] < 0) OR (arc_dst [k] >= n));
+		++(ptr [arc_src [k]]);
+		++(ptr [arc_dst [k]]);
+	}
+	j = 0;
+	for (i = 0; i < n; i++) {
+		k = ptr [i];
+		net -> first [i] = j;
+		ptr [i] = j;
+		j += k;
+	}
+	net -> first [n] = j;
+	FATAL_ERROR_IF (j NE m);
+
+	/* Place each arc and its reverse. */
+	for (k = 0; k < num_arcs; k++) {
+		u = arc_src [k];
+		v = arc_dst [k];
+		i = ptr [u]++;
+		j = ptr [v]++;
+		net -> head [i]	= v;
+		net -> mate [i]	= j;
+		net -> cap [i]	= capacity [k];
+		net -> head [j]	= u;
+		net -> mate [j]	= i;
+		net -> cap [j]	= 0.0;
+	}
+	free ((char *) ptr);
+
+	for (i = 0; i < n; i++) {
+		net -> src_cap [i]	= 0.0;
+		net -> snk_cap [i]	= 0.0;
+	}
+
+	net -> warm		= FALSE;
+	net -> num_solves	= 0;
+	net -> num_warm		= 0;
+	net -> num_pushes	= 0;
+	net -> num_relabels	= 0;
+	net -> num_gaps		= 0;
+	net -> num_global	= 0;
+}
+
+/*
+ * This routine frees the memory associated with the given push-relabel
+ * network.
+ */
+
+	void
+_gst_pr_free_network (
+
+struct pr_network *	net	/* IN - network to free */
+)
+{
+	free ((char *) (net -> bucket));
+	free ((char *) (net -> abucket));
+	free ((char *) (net -> queue));
+	free ((char *) (net -> bprev));
+	free ((char *) (net -> bnext));
+	free ((char *) (net -> anext));
+	free ((char *) (net -> cur));
+	free ((char *) (net -> label));
+	free ((char *) (net -> excess));
+	free ((char *) (net -> shift));
+	free ((char *) (net -> snk_flow));
+	free ((char *) (net -> snk_cap));
+	free ((char *) (net -> src_cap));
+	free ((char *) (net -> rcap));
+	free ((char *) (net -> cap));
+	free ((char *) (net -> mate));
+	free ((char *) (net -> head));
+	free ((char *) (net -> first));
+}
+
+/*
+ * Discard any previous preflow.  The next solve starts from scratch.
+ */
+
+	void
+_gst_pr_reset (
+
+struct pr_network *	net	/* IN/OUT - network to reset */
+)
+{
+	net -> warm = FALSE;
+}
+
+/*
+ * Change the capacity of the arc from the given node to the sink.  If
+ * a previous preflow exists, any flow exceeding the new capacity is
+ * returned to the node as excess.
+ */
+
+	void
+_gst_pr_set_sink_cap (
+
+struct pr_network *	net,	/* IN/OUT - network */
+int			node,	/* IN - node whose sink arc to change */
+double			cap	/* IN - new capacity */
+)
+{
+double		eff;
+
+	net -> snk_cap [node] = cap;
+
+	if (NOT (net -> warm)) return;
+
+	eff = cap + net -> shift [node];
+	if (net -> snk_flow [node] > eff) {
+		net -> excess [node] += (net -> snk_flow [node] - eff);
+		net -> snk_flow [node] = eff;
+	}
+}
+
+/*
+ * Change the capacity of the arc from the source to the given node.
+ * The source arcs are always saturated, so the change goes directly
+ * into the excess of the node.  If this would make the excess
+ * negative, we instead add the deficit to BOTH terminal capacities of
+ * the node.  This adds the same constant to the capacity of every cut,
+ * and thus leaves the minimum cut unchanged.
+ */
+
+	void
+_gst_pr_set_source_cap (
+
+struct pr_network *	net,	/* IN/OUT - network */
+int			node,	/* IN - node whose source arc to change */
+double			cap	/* IN - new capacity */
+)
+{
+double		deficit;
+
+	if (net -> warm) {
+		net -> excess [node] += (cap - net -> src_cap [node]);
+		if (net -> excess [node] < 0.0) {
+			deficit = - (net -> excess [node]);
+			net -> shift [node]  += deficit;
+			net -> excess [node]  = 0.0;
+		}
+	}
+	net -> src_cap [node] = cap;
+}
+
+/*
+ * This routine computes the maximum flow in the given network using
+ * the highest-label push-relabel method.  If a preflow from a previous
+ * call is present (and only the source/sink capacities have changed
+ * since), we resume from that preflow.  Upon return, the given cut
+ * contains the nodes on the source side of a minimum cut -- these are
+ * exactly the nodes that cannot reach the sink in the residual network,
+ * so the source side is the largest among all minimum cuts.  The value
+ * of the maximum flow is returned.
+ */
+
+	double
+_gst_pr_max_flow (
+
+struct pr_network *	net,	/* IN/OUT - network to solve */
+bitmap_t *		cut	/* OUT - nodes on source side of cut */
+)
+{
+int		i;
+int		n;
+int		u;
+int		dead;
+int		nmasks;
+int32u		freq;
+double		z;
+
+	n	= net -> num_nodes;
+	dead	= n + 1;
+
+	++(net -> num_solves);
+
+	if (net -> warm) {
+		++(net -> num_warm);
+	}
+	else {
+		/* Cold start: zero flow, all source arcs saturated. */
+		for (i = 0; i < net -> num_arcs; i++) {
+			net -> rcap [i] = net -> cap [i];
+		}
+		for (i = 0; i < n; i++) {
+			net -> excess [i]	= net -> src_cap [i];
+			net -> snk_flow [i]	= 0.0;
+			net -> shift [i]	= 0.0;
+		}
+	}
+
+	/* Terminal capacity changes may have invalidated the labels.	*/
+	/* Compute exact labels before we start.			*/
+	pr_global_relabel (net);
+
+	freq = 6 * n + net -> num_arcs / 2;
+
+	for (;;) {
+		while ((net -> max_active > 0) AND
+		       (net -> abucket [net -> max_active] < 0)) {
+			--(net -> max_active);
+		}
+		if (net -> max_active <= 0) break;
+
+		u = net -> abucket [net -> max_active];
+		net -> abucket [net -> max_active] = net -> anext [u];
+
+		pr_discharge (net, u);
+
+		if ((net -> excess [u] > FUZZ) AND (net -> label [u] < dead)) {
+			/* Relabeled, but still active. */
+			i = net -> label [u];
+			net -> anext [u] = net -> abucket [i];
+			net -> abucket [i] = u;
+			if (i > net -> max_active) {
+				net -> max_active = i;
+			}
+		}
+
+		if (net -> work > freq) {
+			pr_global_relabel (net);
+		}
+	}
+
+	/* The labels are only lower bounds on the distance to the	*/
+	/* sink.  One last global relabel tells us exactly which	*/
+	/* nodes can still reach the sink.				*/
+	pr_global_relabel (net);
+
+	nmasks = BMAP_ELTS (n);
+	for (i = 0; i < nmasks; i++) {
+		cut [i] = 0;
+	}
+	z = 0.0;
+	for (i = 0; i < n; i++) {
+		if (net -> label [i] >= dead) {
+			SETBIT (cut, i);
+		}
+		z += (net -> snk_flow [i] - net -> shift [i]);
+	}
+
+	net -> warm = TRUE;
+
+	return (z);
+}
+
+/*
+ * Push as much excess as possible out of the given node, relabeling
+ * it when no admissible arcs remain.  We stop when the node has no
+ * more excess, or when it has been relabeled (the caller re-queues it
+ * so that we always work on the highest label).
+ */
+
+	static
+	void
+pr_discharge (
+
+struct pr_network *	net,	/* IN/OUT - network */
+int			u	/* IN - node to discharge */
+)
+{
+int		a;
+int		v;
+int		d;
+int		end;
+int		dead;
+double		delta;
+double		r;
+double *	excess;
+double *	rcap;
+int *		label;
+
+	dead	= net -> num_nodes + 1;
+	excess	= net -> excess;
+	rcap	= net -> rcap;
+	label	= net -> label;
+
+	d = label [u];
+	if (d >= dead) return;
+
+	if (d EQ 1) {
+		/* The sink has label 0.  Push directly to it. */
+		r = net -> snk_cap [u] + net -> shift [u] - net -> snk_flow [u];
+		if (r > FUZZ) {
+			delta = (excess [u] < r) ? excess [u] : r;
+			net -> snk_flow [u] += delta;
+			excess [u] -= delta;
+			++(net -> num_pushes);
+			if (excess [u] <= FUZZ) return;
+		}
+	}
+
+	end = net -> first [u + 1];
+	for (a = net -> cur [u]; a < end; a++) {
+		if (rcap [a] <= FUZZ) continue;
+		v = net -> head [a];
+		if (label [v] NE d - 1) continue;
+
+		delta = (excess [u] < rcap [a]) ? excess [u] : rcap [a];
+		if (excess [v] <= FUZZ) {
+			if ((excess [v] + delta > FUZZ) AND (label [v] < dead)) {
+				/* v becomes active. */
+				net -> anext [v] = net -> abucket [d - 1];
+				net -> abucket [d - 1] = v;
+			}
+		}
+		rcap [a]		-= delta;
+		rcap [net -> mate [a]]	+= delta;
+		excess [u]		-= delta;
+		excess [v]		+= delta;
+		++(net -> num_pushes);
+
+		if (excess [u] <= FUZZ) {
+			net -> cur [u] = a;
+			return;
+		}
+	}
+
+	/* No admissible arcs remain. */
+	pr_relabel (net, u);
+}
+
+/*
+ * Relabel the given node to one more than the lowest label among its
+ * residual neighbors.  If this empties the bucket of its old label, we
+ * have found a gap: every node above the gap is cut off from the sink.
+ */
+
+	static
+	void
+pr_relabel (
+
+struct pr_network *	net,	/* IN/OUT - network */
+int			u	/* IN - node to relabel */
+)
+{
+int		a;
+int		d;
+int		v;
+int		end;
+int		dead;
+int		old;
+int		best;
+
+	dead	= net -> num_nodes + 1;
+	old	= net -> label [u];
+
+	++(net -> num_relabels);
+
+	/* Remove u from the bucket of its old label. */
+	if (net -> bprev [u] >= 0) {
+		net -> bnext [net -> bprev [u]] = net -> bnext [u];
+	}
+	else {
+		net -> bucket [old] = net -> bnext [u];
+	}
+	if (net -> bnext [u] >= 0) {
+		net -> bprev [net -> bnext [u]] = net -> bprev [u];
+	}
+
+	if (net -> bucket [old] < 0) {
+		/* Gap at label old.  Node u is above it. */
+		net -> label [u] = dead;
+		pr_gap (net, old);
+		return;
+	}
+
+	d = dead;
+	best = net -> first [u];
+	if (net -> snk_cap [u] + net -> shift [u] - net -> snk_flow [u] > FUZZ) {
+		d = 1;
+	}
+	end = net -> first [u + 1];
+	for (a = net -> first [u]; a < end; a++) {
+		if (net -> rcap [a] <= FUZZ) continue;
+		v = net -> head [a];
+		if (net -> label [v] + 1 < d) {
+			d = net -> label [v] + 1;
+			best = a;
+		}
+	}
+	net -> work += 12 + (end - net -> first [u]);
+
+	net -> label [u] = d;
+	net -> cur [u] = best;
+	if (d >= dead) return;
+
+	net -> bprev [u] = -1;
+	net -> bnext [u] = net -> bucket [d];
+	if (net -> bucket [d] >= 0) {
+		net -> bprev [net -> bucket [d]] = u;
+	}
+	net -> bucket [d] = u;
+	if (d > net -> max_label) {
+		net -> max_label = d;
+	}
+}
+
+/*
+ * Perform a gap relabeling: all nodes having label greater than k can
+ * no longer reach the sink.
+ */
+
+	static
+	void
+pr_gap (
+
+struct pr_network *	net,	/* IN/OUT - network */
+int			k	/* IN - label that has become empty */
+)
+{
+int		j;
+int		u;
+int		dead;
+
+	dead = net -> num_nodes + 1;
+
+	++(net -> num_gaps);
+
+	for (j = k + 1; j <= net -> max_label; j++) {
+		for (u = net -> bucket [j]; u >= 0; u = net -> bnext [u]) {
+			net -> label [u] = dead;
+		}
+		net -> bucket [j]	= -1;
+		net -> abucket [j]	= -1;
+	}
+	net -> max_label = k - 1;
+	if (net -> max_active > k - 1) {
+		net -> max_active = k - 1;
+	}
+}
+
+/*
+ * Compute exact distance labels by a backward breadth-first search from
+ * the sink through the residual network.  Nodes that cannot reach the
+ * sink receive the "dead" label.  The label and active buckets are
+ * rebuilt from scratch.
+ */
+
+	static
+	void
+pr_global_relabel (
+
+struct pr_network *	net	/* IN/OUT - network */
+)
+{
+int		a;
+int		i;
+int		n;
+int		u;
+int		v;
+int		d;
+int		end;
+int		dead;
+int *		headp;
+int *		tailp;
+int *		label;
+
+	n	= net -> num_nodes;
+	dead	= n + 1;
+	label	= net -> label;
+
+	++(net -> num_global);
+
+	for (i = 0; i <= dead; i++) {
+		net -> bucket [i]	= -1;
+		net -> abucket [i]	= -1;
+	}
+
+	headp = net -> queue;
+	tailp = headp;
+	for (i = 0; i < n; i++) {
+		if (net -> snk_cap [i] + net -> shift [i] - net -> snk_flow [i]
+		    > FUZZ) {
+			label [i] = 1;
+			*tailp++ = i;
+		}
+		else {
+			label [i] = dead;
+		}
+	}
+
+	while (headp < tailp) {
+		v = *headp++;
+		d = label [v] + 1;
+		end = net -> first [v + 1];
+		for (a = net -> first [v]; a < end; a++) {
+			u = net -> head [a];
+			if (label [u] < dead) continue;
+			/* Can u push to v? */
+			if (net -> rcap [net -> mate [a]] <= FUZZ) continue;
+			label [u] = d;
+			*tailp++ = u;
+		}
+	}
+
+	net -> max_label	= 0;
+	net -> max_active	= 0;
+	for (i = 0; i < n; i++) {
+		net -> cur [i] = net -> first [i];
+		d = label [i];
+		if (d >= dead) continue;
+		net -> bprev [i] = -1;
+		net -> bnext [i] = net -> bucket [d];
+		if (net -> bucket [d] >= 0) {
+			net -> bprev [net -> bucket [d]] = i;
+		}
+		net -> bucket [d] = i;
+		if (d > net -> max_label) {
+			net -> max_label = d;
+		}
+		if (net -> excess [i] > FUZZ) {
+			net -> anext [i] = net -> abucket [d];
+			net -> abucket [d] = i;
+			if (d > net -> max_active) {
+				net -> max_active = d;
+			}
+		}
+	}
+
+	net -> work = 0;
+}
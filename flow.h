@@ -3,8 +3,8 @@
 	$Id: flow.h,v 1.8 2022/11/19 13:45:51 warme Exp $
 
 	File:	flow.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -27,6 +27,8 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Reorganize include files, apply prefixes.
+	e-4:	10/18/2026	warme
+		: Added push-relabel solver with warm restarts.
 
 ************************************************************************/
 
@@ -34,6 +36,7 @@
 #define	FLOW_H
 
 #include "bitmaskmacros.h"
+#include "gsttypes.h"
 
 
 /*
@@ -89,6 +92,56 @@ struct flow_temp {
 };
 
 
+/*
+ * The following structure describes a network for the push-relabel
+ * max-flow solver.  Arcs between the nodes are kept in a flat CSR
+ * (compressed sparse row) layout, each arc being paired with its
+ * reverse residual arc.  The source and sink are NOT nodes of the
+ * network.  Instead, every node has a capacity from the source and a
+ * capacity to the sink.  These "terminal" capacities can be changed
+ * between consecutive solves, and the solver then re-uses the preflow
+ * and labels of the previous solve rather than starting over.
+ */
+
+struct pr_network {
+	int		num_nodes;	/* Number of nodes (excluding */
+					/* source and sink) */
+	int		num_arcs;	/* Number of residual arcs */
+	int *		first;		/* first residual arc of each node */
+	int *		head;		/* head node of each residual arc */
+	int *		mate;		/* reverse of each residual arc */
+	double *	cap;		/* initial capacity of each arc */
+	double *	rcap;		/* residual capacity of each arc */
+	double *	src_cap;	/* capacity source -> node */
+	double *	snk_cap;	/* capacity node -> sink */
+	double *	snk_flow;	/* flow node -> sink */
+	double *	shift;		/* amount added to BOTH terminal */
+					/* capacities of each node to */
+					/* absorb capacity decreases */
+	double *	excess;		/* excess flow at each node */
+	int *		label;		/* distance label of each node */
+	int *		cur;		/* current arc of each node */
+	int *		anext;		/* next node in active bucket */
+	int *		bnext;		/* next node in label bucket */
+	int *		bprev;		/* prev node in label bucket */
+	int *		abucket;	/* active nodes having each label */
+	int *		bucket;		/* all nodes having each label */
+	int *		queue;		/* breadth-first queue of nodes */
+	int		max_active;	/* highest label of an active node */
+	int		max_label;	/* highest label of any node */
+	bool		warm;		/* a previous preflow is present */
+	int32u		work;		/* work since last global relabel */
+
+	/* Statistics... */
+	int32u		num_solves;	/* Number of solves */
+	int32u		num_warm;	/* Number of warm restarts */
+	int32u		num_pushes;	/* Number of push operations */
+	int32u		num_relabels;	/* Number of relabel operations */
+	int32u		num_gaps;	/* Number of gap relabelings */
+	int32u		num_global;	/* Number of global relabelings */
+};
+
+
 extern void	_gst_compute_max_flow (struct flow_prob *	prob,
 				       struct flow_temp *	temp,
 				       struct flow_soln *	soln);
@@ -99,6 +152,22 @@ extern void	_gst_create_flow_temp_data (struct flow_prob *	prob,
 					    struct flow_temp *	temp);
 extern void	_gst_free_flow_solution_data (struct flow_soln * soln);
 extern void	_gst_free_flow_temp_data (struct flow_temp *	temp);
+extern void	_gst_pr_create_network (struct pr_network *	net,
+					int			num_nodes,
+					int			num_arcs,
+					int *			arc_src,
+					int *			arc_dst,
+					double *		capacity);
+extern void	_gst_pr_free_network (struct pr_network *	net);
+extern double	_gst_pr_max_flow (struct pr_network *	net,
+				  bitmap_t *		cut);
+extern void	_gst_pr_reset (struct pr_network *	net);
+extern void	_gst_pr_set_sink_cap (struct pr_network *	net,
+				      int			node,
+				      double			cap);
+extern void	_gst_pr_set_source_cap (struct pr_network *	net,
+					int			node,
+					double			cap);
 
 
 #endif
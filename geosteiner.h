@@ -26,6 +26,7 @@ extern "C" {
 /* Hypergraph properties */
 
 #define GST_PROP_HG_HALF_FST_COUNT                        10000
+#define GST_PROP_HG_COMPLETE_FST_SIZE                     10001
 #define GST_PROP_HG_GENERATION_TIME                       20000
 #define GST_PROP_HG_MST_LENGTH                            20001
 #define GST_PROP_HG_PRUNING_TIME                          20002
@@ -51,9 +52,23 @@ extern "C" {
 #define GST_PROP_SOLVER_FINAL_LPROWS                      11014
 #define GST_PROP_SOLVER_FINAL_LPNZ                        11015
 #define GST_PROP_SOLVER_LOWER_BOUND                       11016
+#define GST_PROP_SOLVER_SEP_ZWCUTSET_CUTS                 11017
+#define GST_PROP_SOLVER_SEP_INTCYCLE_CUTS                 11018
+#define GST_PROP_SOLVER_SEP_ENUMSUBTOUR_CUTS              11019
+#define GST_PROP_SOLVER_SEP_FLOWHEUR_CUTS                 11020
+#define GST_PROP_SOLVER_SEP_SMALLSUBTOUR_CUTS             11021
+#define GST_PROP_SOLVER_SEP_SECFLOW_CUTS                  11022
+#define GST_PROP_SOLVER_SEP_LOCALCUT_CUTS                 11023
 #define GST_PROP_SOLVER_CPU_TIME                          21000
 #define GST_PROP_SOLVER_ROOT_TIME                         21001
 #define GST_PROP_SOLVER_ROOT_LENGTH                       21002
+#define GST_PROP_SOLVER_SEP_ZWCUTSET_TIME                 21003
+#define GST_PROP_SOLVER_SEP_INTCYCLE_TIME                 21004
+#define GST_PROP_SOLVER_SEP_ENUMSUBTOUR_TIME              21005
+#define GST_PROP_SOLVER_SEP_FLOWHEUR_TIME                 21006
+#define GST_PROP_SOLVER_SEP_SMALLSUBTOUR_TIME             21007
+#define GST_PROP_SOLVER_SEP_SECFLOW_TIME                  21008
+#define GST_PROP_SOLVER_SEP_LOCALCUT_TIME                 21009
 
 /* Error codes */
 
@@ -135,6 +150,9 @@ extern "C" {
 #define GST_PARAM_INITIAL_PRIMAL_HEURISTIC                1039
 #define GST_PARAM_INITIAL_PRIMAL_HEUR_STOP                1040
 #define GST_PARAM_LOCALCUTS_TRACE_STYLE                   1041
+#define GST_PARAM_NUM_THREADS                             1042
+#define GST_PARAM_SEPARATION_SCHEDULE                     1043
+#define GST_PARAM_LAGRANGIAN_BOUND                        1044
 #define GST_PARAM_INITIAL_UPPER_BOUND                     2000
 #define GST_PARAM_LOCAL_CUTS_VERTEX_THRESHOLD             2001
 #define GST_PARAM_CPU_TIME_LIMIT                          2002
@@ -143,6 +161,7 @@ extern "C" {
 #define GST_PARAM_LOWER_BOUND_TARGET                      2005
 #define GST_PARAM_CHECKPOINT_INTERVAL                     2006
 #define GST_PARAM_CPLEX_MIP_GAP_TOLERANCE                 2007
+#define GST_PARAM_FST_TIME_LIMIT                          2008
 #define GST_PARAM_CHECKPOINT_FILENAME                     3000
 #define GST_PARAM_MERGE_CONSTRAINT_FILES                  3001
 #define GST_PARAM_DETAILED_TIMINGS_CHANNEL                4000
@@ -247,6 +266,14 @@ extern "C" {
 #define GST_PVAL_INITIAL_PRIMAL_HEUR_STOP_DISABLE	0
 #define GST_PVAL_INITIAL_PRIMAL_HEUR_STOP_ENABLE	1
 
+/* For GST_PARAM_SEPARATION_SCHEDULE */
+#define GST_PVAL_SEPARATION_SCHEDULE_FIXED		0
+#define GST_PVAL_SEPARATION_SCHEDULE_ADAPTIVE		1
+
+/* For GST_PARAM_LAGRANGIAN_BOUND */
+#define GST_PVAL_LAGRANGIAN_BOUND_DISABLE		0
+#define GST_PVAL_LAGRANGIAN_BOUND_ENABLE		1
+
 /* For GST_PARAM_SAVE_FORMAT */
 #define GST_PVAL_SAVE_FORMAT_ORLIBRARY                  0
 #define GST_PVAL_SAVE_FORMAT_STEINLIB                   1
@@ -1965,6 +1992,45 @@ gst_hg_ptr
 
 /****************************************/
 
+/*
+ * gst_update_efsts
+ * 
+ * Given a hypergraph $H$ of Euclidean FSTs (such as one returned by
+ * gst_generate_efsts()), return a hypergraph of Euclidean FSTs
+ * for the terminals of $H$ with some terminals added and others deleted.
+ * The vertices of the new hypergraph are the remaining vertices of $H$,
+ * in the same order, followed by the added terminals.  FSTs are
+ * regenerated only for the terminals near the changes; the other FSTs of
+ * $H$ are kept.  The time needed thus depends mainly upon the number of
+ * terminals changed, rather than the size of $H$.  Every FST returned
+ * passes the lune and bottleneck Steiner distance tests for the new set
+ * of terminals; FSTs that fail them cannot be part of a Steiner minimal
+ * tree.  When terminals are only added, every FST containing an added
+ * terminal and spanning at most 8 terminals (or MAX_FST_SIZE,
+ * if smaller) is found.  If larger FSTs may be missing, the hypergraph
+ * property GST_PROP_HG_COMPLETE_FST_SIZE of the result is
+ * set to this size.  When terminals are deleted, the neighborhood is
+ * only a heuristic, and the property is set to 0.  A solution is then
+ * optimal only with respect to the FSTs given, and is not known to be a
+ * Steiner minimal tree.  Use gst_generate_efsts() when a
+ * Steiner minimal tree must be guaranteed.
+ */
+
+gst_hg_ptr
+    gst_update_efsts (gst_hg_ptr     H,
+                      int            nadd,
+                      double*        add_terms,
+                      int            ndel,
+                      int*           del_terms,
+                      gst_param_ptr  param,
+                      int*           status);
+
+/*
+ * Returns the resulting FSTs in a new hypergraph structure.
+ */
+
+/****************************************/
+
 /*
  * gst_hg_prune_edges
  * 
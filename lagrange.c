@@ -0,0 +1,311 @@
+/***********************************************************************
+
+	$Id: lagrange.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lagrange.c
+	Rev:	e-1
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Lagrangian lower bounds for branch-and-bound nodes.
+
+	Every row of the constraint pool is valid for every node, so
+	dualizing all of them with multipliers u (of the proper sign)
+	leaves the subproblem
+
+		L(u) = u.b + min { (c - u.A) x : 0 <= x <= 1, x fixed },
+
+	which is solved by inspecting the sign of each reduced cost.
+	L(u) is a lower bound on the node for any such u, and the LP
+	dual values of the parent's rows are usually a good start.  A
+	few subgradient steps then account for the variables fixed by
+	branching.  The reduced costs c - u.A also permit fixing
+	variables exactly as LP reduced costs do.  All of this takes
+	time linear in the size of the pool, so it is done before the
+	first LP of each node.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+
+************************************************************************/
+
+#include "lagrange.h"
+
+#include "bb.h"
+#include "constrnt.h"
+#include "fatal.h"
+#include <float.h>
+#include "logic.h"
+#include "lpsolver.h"
+#include "memory.h"
+#include "parmblk.h"
+#include "steiner.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Global Routines
+ */
+
+double		_gst_lagrangian_bound (struct bbinfo *	bbip,
+				       double *		rc,
+				       int *		niter);
+void		_gst_save_lp_duals (struct bbinfo * bbip);
+
+
+/*
+ * Local Routines
+ */
+
+static double		project (double, int);
+
+
+/*
+ * Limits on the subgradient method.  The step size multiplier is
+ * halved whenever the bound has not improved for STALL_ITER iterations.
+ */
+
+#define	MAX_ITER	50
+#define	STALL_ITER	5
+#define	INITIAL_THETA	0.5
+#define	MIN_THETA	0.001
+
+/*
+ * Remember the dual value of each row of the LP just solved, as the
+ * starting Lagrange multiplier for bounding later nodes.
+ */
+
+	void
+_gst_save_lp_duals (
+
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
+)
+{
+int			i;
+int			nrows;
+struct cpool *		pool;
+double *		pi;
+
+	pool	= bbip -> cpool;
+	nrows	= pool -> nlprows;
+
+	FATAL_ERROR_IF (GET_LP_NUM_ROWS (bbip -> lp) NE nrows);
+
+	pi = NEWA (nrows + 1, double);
+	(*_gst_lpops.get_duals) (bbip -> lp, bbip -> lpmem, pi);
+
+	for (i = 0; i < nrows; i++) {
+		pool -> rows [pool -> lprows [i]].dual = pi [i];
+	}
+
+	free ((char *) pi);
+}
+
+/*
+ * Compute a Lagrangian lower bound for the current node, starting from
+ * the dual values last seen for the rows now in the LP.  The reduced
+ * cost of each hyperedge with respect to the best multipliers found is
+ * returned in rc.  Returns -DBL_MAX if no bound can be computed.
+ */
+
+	double
+_gst_lagrangian_bound (
+
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+double *		rc,		/* OUT - reduced costs */
+int *			niter		/* OUT - number of iterations */
+)
+{
+int			i;
+int			j;
+int			iter;
+int			nrows;
+int			nedges;
+int			stall;
+struct cpool *		pool;
+struct rcon *		rcp;
+struct rcoef *		cp;
+bitmap_t *		fixed;
+bitmap_t *		value;
+double			L;
+double			best_L;
+double			target;
+double			theta;
+double			sum;
+double			norm;
+double			t;
+double *		cost;
+double *		u;
+double *		g;
+double *		red;
+char *			x;
+char *			sense;
+
+	*niter	= 0;
+
+	pool	= bbip -> cpool;
+	nedges	= bbip -> cip -> num_edges;
+	nrows	= pool -> nrows;
+	target	= bbip -> best_z;
+	fixed	= bbip -> fixed;
+	value	= bbip -> value;
+
+	if ((pool -> nvars NE nedges) OR (target >= DBL_MAX)) {
+		/* Extra variables (whose bounds we do not know), or	*/
+		/* no upper bound to steer the step size.		*/
+		return (-DBL_MAX);
+	}
+
+	cost	= NEWA (2 * nedges, double);
+	red	= cost + nedges;
+	x	= NEWA (nedges, char);
+	u	= NEWA (2 * nrows, double);
+	g	= u + nrows;
+	sense	= NEWA (nrows, char);
+
+	(*_gst_lpops.get_objective) (bbip -> lp, bbip -> lpmem, nedges, cost);
+
+	/* Start from the dual values of the rows in the LP, which	*/
+	/* (after restoring the node) are those binding at the parent.	*/
+	rcp = pool -> rows;
+	for (i = 0; i < nrows; i++, rcp++) {
+		for (cp = rcp -> coefs; cp -> var >= RC_VAR_BASE; cp++) {
+		}
+		sense [i] = cp -> var;
+		u [i] = 0.0;
+		if (rcp -> lprow >= 0) {
+			u [i] = project (rcp -> dual, sense [i]);
+		}
+	}
+
+	best_L	= -DBL_MAX;
+	theta	= INITIAL_THETA;
+	stall	= 0;
+
+	for (iter = 0; iter < MAX_ITER; iter++) {
+		/* Compute the reduced costs c - u.A, and u.b... */
+		memcpy (red, cost, nedges * sizeof (double));
+		L = 0.0;
+		rcp = pool -> rows;
+		for (i = 0; i < nrows; i++, rcp++) {
+			if (u [i] EQ 0.0) continue;
+			for (cp = rcp -> coefs; cp -> var >= RC_VAR_BASE; cp++) {
+				red [cp -> var - RC_VAR_BASE] -= u [i] * cp -> val;
+			}
+			L += u [i] * cp -> val;
+		}
+
+		/* Minimize the reduced cost over the unit box... */
+		for (j = 0; j < nedges; j++) {
+			if (BITON (fixed, j)) {
+				x [j] = BITON (value, j);
+			}
+			else {
+				x [j] = (red [j] < 0.0);
+			}
+			if (x [j]) {
+				L += red [j];
+			}
+		}
+
+		if (L > best_L) {
+			best_L = L;
+			memcpy (rc, red, nedges * sizeof (double));
+			stall = 0;
+		}
+		else if (++stall >= STALL_ITER) {
+			theta *= 0.5;
+			stall = 0;
+			if (theta < MIN_THETA) break;
+		}
+
+		if (best_L >= target) {
+			/* Node can be cut off -- no need to go on. */
+			break;
+		}
+
+		/* Compute the subgradient b - A.x, projected so that	*/
+		/* it does not push multipliers at zero the wrong way.	*/
+		norm = 0.0;
+		rcp = pool -> rows;
+		for (i = 0; i < nrows; i++, rcp++) {
+			sum = 0.0;
+			for (cp = rcp -> coefs; cp -> var >= RC_VAR_BASE; cp++) {
+				if (x [cp -> var - RC_VAR_BASE]) {
+					sum += cp -> val;
+				}
+			}
+			sum = cp -> val - sum;
+			if (u [i] EQ 0.0) {
+				sum = project (sum, sense [i]);
+			}
+			g [i] = sum;
+			norm += sum * sum;
+		}
+
+		if (norm <= 0.0) {
+			/* x satisfies every row, and is optimal. */
+			++iter;
+			break;
+		}
+
+		/* Polyak step towards the upper bound... */
+		t = theta * (target - L) / norm;
+		for (i = 0; i < nrows; i++) {
+			if (g [i] EQ 0.0) continue;
+			u [i] = project (u [i] + t * g [i], sense [i]);
+		}
+	}
+
+	*niter = iter;
+
+	free ((char *) sense);
+	free ((char *) u);
+	free ((char *) x);
+	free ((char *) cost);
+
+	return (best_L);
+}
+
+/*
+ * Project a multiplier (or a component of the subgradient at a zero
+ * multiplier) onto the values permitted by the row's sense:
+ * non-negative for >= rows, non-positive for <= rows, and anything
+ * for equations.
+ */
+
+	static
+	double
+project (
+
+double		val,		/* IN - value to project */
+int		op		/* IN - row operator */
+)
+{
+	switch (op) {
+	case RC_OP_LE:
+		return ((val > 0.0) ? 0.0 : val);
+
+	case RC_OP_GE:
+		return ((val < 0.0) ? 0.0 : val);
+
+	case RC_OP_EQ:
+		return (val);
+
+	default:
+		FATAL_ERROR;
+		break;
+	}
+
+	return (0.0);
+}
@@ -0,0 +1,41 @@
+/***********************************************************************
+
+	$Id: lagrange.h,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lagrange.h
+	Rev:	e-1
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Lagrangian lower bounds for branch-and-bound nodes.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+
+************************************************************************/
+
+#ifndef	LAGRANGE_H
+#define	LAGRANGE_H
+
+struct bbinfo;
+
+
+/*
+ * Global Routines
+ */
+
+extern double	_gst_lagrangian_bound (struct bbinfo *	bbip,
+				       double *		rc,
+				       int *		niter);
+extern void	_gst_save_lp_duals (struct bbinfo * bbip);
+
+#endif
@@ -3,8 +3,8 @@
 	$Id: localcut.c,v 1.33 2023/04/03 17:25:53 warme Exp $
 
 	File:	localcut.c
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-9
+	Date:	10/18/2026
 
 	Copyright (c) 1997, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -48,6 +48,18 @@
 		:  handle edges with negative costs.
 		: Add a new parameter that selects different
 		:  trace output formats.
+	e-6:	10/18/2026	warme
+		: Separate the fractional components on several
+		:  threads (when the LP solver permits it).
+	e-7:	10/18/2026	warme
+		: Cache the local cuts found for each component,
+		:  and re-use them whenever they are violated.
+	e-8:	10/18/2026	warme
+		: Use the auxiliary LP solver, which is lp_solve
+		:  when the main LP uses HiGHS.
+	e-9:	10/18/2026	warme
+		: Use the size limits of the adaptive separation
+		:  schedule.
 
 ************************************************************************/
 
@@ -65,6 +77,7 @@
 #include <math.h>
 #include "memory.h"
 #include "p1read.h"
+#include "parallel.h"
 #include "parmblk.h"
 #include "sec_comp.h"
 #include "sec_heur.h"
@@ -89,6 +102,7 @@ struct constraint *	_gst_find_local_cuts_in_component (
 					struct bbinfo *		bbip,
 					struct constraint *	cp);
 
+void		_gst_free_local_cut_cache (struct lccache * cachep);
 int		_gst_find_forests (struct comp *	comp,
 				   bitmap_t **		flist,
 				   gst_channel_ptr	print_solve_trace);
@@ -104,10 +118,57 @@ void		_gst_print_forests (struct comp *	comp,
 
 #define FORMULATE_DUAL		0
 
+	/* Size of the hash table of previously separated components,	*/
+	/* and the number of local cuts remembered for each of them.	*/
+#define	LCCACHE_HASH_SIZE	1009
+#define	LCCACHE_MAX_CUTS	8
+
 /*
  * Local Types
  */
 
+/*
+ * One fractional component to be separated by a local cut task.
+ */
+
+struct lc_task {
+	struct comp *	comp;		/* Component to separate */
+	bool		cached;		/* Cut was found in the cache */
+	double *	y;		/* OUT - coefficients of constraint */
+	double		z;		/* OUT - LHS evaluated at LP solution */
+	gst_param_ptr	params;		/* Private copy of parameters */
+	struct par_trace ptrace;	/* Output written to trace */
+};
+
+/*
+ * The local cut cache.  The same (reduced) fractional components tend
+ * to recur at many nodes of the branch-and-bound tree, usually with
+ * slightly different weights.  A local cut depends only upon the
+ * structure of the component, so we remember the cuts found for each
+ * distinct structure, and try them before solving the separation LP
+ * all over again.  Cuts are stored in the low-dimensional space (i.e.,
+ * prior to lifting), with an implicit right-hand side of 1.
+ */
+
+struct lccut {
+	struct lccut *	next;		/* Next cut for same component */
+	double *	y;		/* Coefficient of each edge */
+};
+
+struct lcentry {
+	struct lcentry *	next;	/* Next entry in hash bucket */
+	int			nverts;	/* Number of vertices */
+	int			nedges;	/* Number of edges */
+	int *			eidx;	/* Start of each edge in everts */
+	int *			everts;	/* Vertices of each edge */
+	int			ncuts;	/* Number of cuts remembered */
+	struct lccut *		cuts;	/* Cuts, most recent first */
+};
+
+struct lccache {
+	struct lcentry *	hash [LCCACHE_HASH_SIZE];
+};
+
 struct bc {
 	struct comp *	comp;		/* component being split */
 	struct comp *	list;		/* output list of BCC's */
@@ -142,7 +203,7 @@ struct ff {
  */
 
 struct LCTrace {
-	struct bbinfo *	bbip;	/* Branch-and-bound info */
+	gst_param_ptr	params;	/* Parameters (and trace channel) */
 	int		num_cv;
 	int		num_af;
 	int		num_exact;
@@ -186,8 +247,11 @@ struct LCTrace_terse {
  * Local Routines
  */
 
-static void		add_forest_to_lp (LP_t *, int, int *);
+static void		add_forest_to_lp (AUX_LP_t *, int, int *);
 static void		bcc_fcomp (struct bc *, int);
+static void		cache_fcomp_cut (struct comp *	comp,
+					 double *	y,
+					 struct bbinfo *	bbip);
 static void		classic_trace_add_forest (
 					struct LCTrace *	tp,
 					int			nf,
@@ -221,7 +285,16 @@ static struct comp *	copy_fsubcomp (struct comp *	comp,
 				       bitmap_t *	vert_mask,
 				       bitmap_t *	edge_mask);
 static void		create_fcomp_masks (struct comp *);
-static void		delete_slack (LP_t *, double *, struct LCTrace * tp);
+static void		delete_slack (AUX_LP_t *, double *, struct LCTrace * tp);
+static int		fcomp_hash (struct comp * comp);
+static void		fcomp_cut_task (void * arg, int task, int thread);
+static struct lcentry *	find_cache_entry (struct comp *		comp,
+					  struct bbinfo *	bbip,
+					  bool			create);
+static bool		find_cached_cut (struct comp *		comp,
+					 struct bbinfo *	bbip,
+					 double *		y,
+					 double *		z);
 static void		ff_recurse (int, int, int, bitmap_t, struct ff *);
 static struct constraint * find_fcomp_cut (struct comp *,
 					   struct bbinfo *,
@@ -243,16 +316,17 @@ static int		find_max_forest (struct comp *,
 					 int *,
 					 gst_param_ptr);
 static int *		heapsort_edges (struct comp *);
+static bool		is_candidate_fcomp (struct comp *, struct bbinfo *);
 static bool		is_failed_subproblem (struct comp *, struct bbinfo *);
 static struct constraint * lift_constraint (struct comp *,
 					    double *,
 					    double,
 					    struct bbinfo *);
-static struct LCTrace *	make_classic_tracer (struct bbinfo * bbip);
-static LP_t *		make_fcomp_lp (struct comp *, struct lpmem *);
-static struct LCTrace *	make_quiet_tracer (struct bbinfo * bbip);
-static struct LCTrace *	make_terse_tracer (struct bbinfo * bbip);
-static struct LCTrace *	make_tracer (struct bbinfo * bbip);
+static struct LCTrace *	make_classic_tracer (gst_param_ptr params);
+static AUX_LP_t *	make_fcomp_lp (struct comp *, struct lpmem *);
+static struct LCTrace *	make_quiet_tracer (gst_param_ptr params);
+static struct LCTrace *	make_terse_tracer (gst_param_ptr params);
+static struct LCTrace *	make_tracer (gst_param_ptr params);
 static int		max_forest_heuristic (struct comp *,
 					      double *,
 					      int *,
@@ -283,8 +357,20 @@ static void		quiet_trace_lp_error (
 					struct LCTrace *	tp,
 					const char *		format,
 					int			status);
+static struct constraint * parallel_fcomp_cuts (struct comp *	comp,
+					       int		nthreads,
+					       struct bbinfo *	bbip,
+					       struct constraint * cp);
 static void		record_failed_fcomp (struct comp *, struct bbinfo *);
+static struct constraint * record_fcomp_cut (struct comp *	comp,
+					     double *		y,
+					     double		z,
+					     struct bbinfo *	bbip,
+					     struct constraint * cp);
 static void		reduce_fcomp_in_place (struct comp *);
+static double		separate_fcomp (struct comp *	comp,
+					double *	y,
+					gst_param_ptr	params);
 static struct comp *	simplify_one_fcomp (struct comp *, struct bbinfo *);
 static int *		sort_edges_by_cost_ratio (struct comp *,
 						  double *,
@@ -336,6 +422,8 @@ int			i;
 int			j;
 int			nverts;
 int			nedges;
+int			max_verts;
+int			max_edges;
 int			kmasks;
 bitmap_t *		comp_vert_mask;
 int *			ip1;
@@ -356,13 +444,19 @@ gst_param_ptr		params;
 	nverts	= comp -> num_verts;
 	nedges	= comp -> num_edges;
 
+	max_verts = _gst_separator_limit (bbip,
+					  SEP_LOCAL_CUTS,
+					  bbip -> params -> local_cuts_max_vertices);
+	max_edges = _gst_separator_limit (bbip,
+					  SEP_LOCAL_CUTS,
+					  bbip -> params -> local_cuts_max_edges);
+
 	_gst_create_comp_masks (comp);
 
 	vert_mask = comp -> vert_mask;
 	edge_mask = comp -> edge_mask;
 
-	if (   (nverts > bbip -> params -> local_cuts_max_vertices)
-	    OR (nedges > bbip -> params -> local_cuts_max_edges)) {
+	if ((nverts > max_verts) OR (nedges > max_edges)) {
 		/* Component already exceeds maximums -- even before	*/
 		/* we expand it back to "real" vertices!		*/
 		return (cp);
@@ -408,8 +502,8 @@ gst_param_ptr		params;
 
 	free ((char *) comp_vert_mask);
 
-	if ((comp2 -> num_verts <= params -> local_cuts_max_vertices) AND
-	    (comp2 -> num_edges <= params -> local_cuts_max_edges)) {
+	if ((comp2 -> num_verts <= max_verts) AND
+	    (comp2 -> num_edges <= max_edges)) {
 
 		comp2 = merge_equivalent_edges (comp2);
 
@@ -617,6 +711,7 @@ struct bbinfo *		bbip,		/* IN - branch-and-bound info */
 struct constraint *	cp		/* IN - list of constraints */
 )
 {
+int			nthreads;
 struct comp *		comp;
 struct comp *		p;
 bool			print_flag;
@@ -640,8 +735,21 @@ gst_param_ptr		params;
 	print_flag = TRUE;
 	comp = find_fractional_comps (x, print_flag, bbip);
 
-	for (p = comp; p NE NULL; p = p -> next) {
-		cp = find_fcomp_cut (p, bbip, cp);
+#ifdef AUX_LPSOLVE
+	/* lp_solve keeps much of its state in global variables, so	*/
+	/* only one of its LPs may be solved at a time.			*/
+	nthreads = 1;
+#else
+	nthreads = _gst_resolve_num_threads (bbip -> params -> num_threads);
+#endif
+
+	if ((nthreads > 1) AND (comp NE NULL) AND (comp -> next NE NULL)) {
+		cp = parallel_fcomp_cuts (comp, nthreads, bbip, cp);
+	}
+	else {
+		for (p = comp; p NE NULL; p = p -> next) {
+			cp = find_fcomp_cut (p, bbip, cp);
+		}
 	}
 
 	_gst_free_congested_component_list (comp);
@@ -651,6 +759,123 @@ gst_param_ptr		params;
 	return (cp);
 }
 
+/*
+ * Find local cuts for each of the given fractional components, using
+ * several threads.  The separation LP of each component is independent
+ * of all the others, so each task builds and solves its own.  Trace
+ * output from each task is buffered, and the results are then merged
+ * serially in component order -- exactly as if each component had been
+ * separated in turn by find_fcomp_cut().
+ */
+
+	static
+	struct constraint *
+parallel_fcomp_cuts (
+
+struct comp *		comp,		/* IN - list of fractional components */
+int			nthreads,	/* IN - number of threads to use */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+struct constraint *	cp		/* IN - existing constraints */
+)
+{
+int			i;
+int			ntasks;
+struct comp *		p;
+struct lc_task *	tasks;
+struct lc_task *	tp;
+gst_channel_ptr		trace;
+
+	trace = bbip -> params -> print_solve_trace;
+
+	ntasks = 0;
+	for (p = comp; p NE NULL; p = p -> next) {
+		++ntasks;
+	}
+
+	tasks = NEWA (ntasks, struct lc_task);
+
+	/* Decide which components to separate, and give each task	*/
+	/* its own parameters and trace channel.			*/
+	ntasks = 0;
+	for (p = comp; p NE NULL; p = p -> next) {
+		if (NOT is_candidate_fcomp (p, bbip)) continue;
+
+		tp = &tasks [ntasks++];
+		tp -> comp		= p;
+		tp -> y			= NEWA (p -> num_edges, double);
+		tp -> z			= 0.0;
+		tp -> cached		= find_cached_cut (p,
+							   bbip,
+							   tp -> y,
+							   &(tp -> z));
+		tp -> params		= gst_create_param (NULL);
+
+		gst_copy_param (tp -> params, bbip -> params);
+		_gst_par_trace_init (&(tp -> ptrace), trace);
+		tp -> params -> print_solve_trace = tp -> ptrace.chan;
+	}
+
+	(void) _gst_parallel_for (nthreads, ntasks, fcomp_cut_task, tasks);
+
+	for (i = 0; i < ntasks; i++) {
+		tp = &tasks [i];
+
+		/* A cut recorded by an earlier task may apply here, too.  */
+		/* Use the cache exactly as a serial run would have done. */
+		if (find_cached_cut (tp -> comp, bbip, tp -> y, &(tp -> z))) {
+			/* Discard the output of the LP we did not need. */
+			tp -> ptrace.len = 0;
+			_gst_par_trace_flush (&(tp -> ptrace), trace);
+			gst_channel_printf (trace,
+				"find_fcomp_cut: using cached cut\n");
+		}
+		else {
+			if (tp -> cached) {
+				/* The cut we found in the cache has	*/
+				/* since been displaced.  Solve it now.	*/
+				tp -> params -> print_solve_trace = trace;
+				tp -> z = separate_fcomp (tp -> comp,
+							  tp -> y,
+							  tp -> params);
+			}
+			_gst_par_trace_flush (&(tp -> ptrace), trace);
+		}
+
+		cp = record_fcomp_cut (tp -> comp, tp -> y, tp -> z, bbip, cp);
+
+		gst_free_param (tp -> params);
+		free ((char *) (tp -> y));
+	}
+
+	free ((char *) tasks);
+
+	return (cp);
+}
+
+/*
+ * Separate one fractional component on behalf of parallel_fcomp_cuts().
+ */
+
+	static
+	void
+fcomp_cut_task (
+
+void *			arg,		/* IN/OUT - array of tasks */
+int			task,		/* IN - task to perform */
+int			thread		/* IN - thread executing task */
+)
+{
+struct lc_task *	tp;
+
+	(void) thread;
+
+	tp = ((struct lc_task *) arg) + task;
+
+	if (NOT tp -> cached) {
+		tp -> z = separate_fcomp (tp -> comp, tp -> y, tp -> params);
+	}
+}
+
 /*
  * This routine performs a set of reductions, similar to those that
  * are done by the SEC separator.  These reductions are less powerful
@@ -1999,8 +2224,6 @@ bitmap_t *	mask;
  * the constraint is valid and violated.
  */
 
-#define USE_EUCLIDEAN_NORM	0
-
 	static
 	struct constraint *
 find_fcomp_cut (
@@ -2010,6 +2233,98 @@ struct bbinfo *		bbip,		/* IN - branch-and-bound info */
 struct constraint *	cp		/* IN - existing constraints */
 )
 {
+double *		y;
+double			z;
+
+	if (NOT is_candidate_fcomp (comp, bbip)) {
+		return (cp);
+	}
+
+	y = NEWA (comp -> num_edges, double);
+
+	if (find_cached_cut (comp, bbip, y, &z)) {
+		gst_channel_printf (bbip -> params -> print_solve_trace,
+			"find_fcomp_cut: using cached cut\n");
+	}
+	else {
+		z = separate_fcomp (comp, y, bbip -> params);
+	}
+
+	cp = record_fcomp_cut (comp, y, z, bbip, cp);
+
+	free ((char *) y);
+
+	return (cp);
+}
+
+/*
+ * Determine whether it is worth attempting to find a local cut for
+ * the given fractional component.
+ */
+
+	static
+	bool
+is_candidate_fcomp (
+
+struct comp *		comp,		/* IN - component to separate */
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
+)
+{
+int			nverts;
+int			nedges;
+gst_param_ptr		params;
+
+	params = bbip -> params;
+
+	nverts	= comp -> num_verts;
+	nedges	= comp -> num_edges;
+
+	if (   (nverts > _gst_separator_limit (bbip,
+						   SEP_LOCAL_CUTS,
+						   params -> local_cuts_max_vertices))
+	    OR (nedges > _gst_separator_limit (bbip,
+						   SEP_LOCAL_CUTS,
+						   params -> local_cuts_max_edges))) {
+		/* Problem is too big to attempt! */
+		return (FALSE);
+	}
+	if (nverts > (params -> local_cuts_vertex_threshold * bbip -> cip -> num_verts)) {
+		/* Sub-problem is too large a fraction */
+		/* of the containing problem. */
+		return (FALSE);
+	}
+	if (is_failed_subproblem (comp, bbip)) {
+		/* Sub-problem was previously tried and failed. */
+		return (FALSE);
+	}
+
+	return (TRUE);
+}
+
+/*
+ * Solve the separation problem for the given fractional component.
+ * This builds and repeatedly solves a small LP of its own, adding
+ * violated forests until the LP solution y satisfies y*x <= 1 for
+ * every forest x of the component.  The value of y evaluated at the
+ * component's LP solution is returned -- the resulting constraint is
+ * violated if and only if this exceeds 1.
+ *
+ * This routine touches nothing outside of the component, the given
+ * parameters and its own LP, so that several components can be
+ * separated simultaneously.
+ */
+
+#define USE_EUCLIDEAN_NORM	0
+
+	static
+	double
+separate_fcomp (
+
+struct comp *		comp,		/* IN - component to separate */
+double *		y,		/* OUT - coefficients of constraint */
+gst_param_ptr		params		/* IN - parameters and trace channel */
+)
+{
 int			i;
 int			nverts;
 int			nedges;
@@ -2017,15 +2332,12 @@ int			nf;
 int			status;
 int			slack_size;
 int *			forest;
-double *		y;
 double *		slack;
-LP_t *			lp;
-struct constraint *	newcp;
+AUX_LP_t *		lp;
 int *			edge_freq;
 double			w;
 double			z;
 struct lpmem		lpmem;
-gst_param_ptr		params;
 gst_channel_ptr		print_solve_trace;
 struct LCTrace *	tp;
 
@@ -2037,44 +2349,20 @@ struct LCTrace *	tp;
   double		best_w;
 #endif
 
-	params = bbip -> params;
 	print_solve_trace = params -> print_solve_trace;
 
 	nverts	= comp -> num_verts;
 	nedges	= comp -> num_edges;
 
-#if 0
-	if (cp EQ NULL) goto pull_out_all_the_stops;
-#endif
-
-	if (   (nverts > params -> local_cuts_max_vertices)
-	    OR (nedges > params -> local_cuts_max_edges)) {
-		/* Problem is too big to attempt! */
-		return (cp);
-	}
-#if 0
-pull_out_all_the_stops:
-#endif
-	if (nverts > (params -> local_cuts_vertex_threshold * bbip -> cip -> num_verts)) {
-		/* Sub-problem is too large a fraction */
-		/* of the containing problem. */
-		return (cp);
-	}
-	if (is_failed_subproblem (comp, bbip)) {
-		/* Sub-problem was previously tried and failed. */
-		return (cp);
-	}
-
 	gst_channel_printf (print_solve_trace,
 		"Enter find_fcomp_cut with %d vertices and %d edges\n",
 		nverts, nedges);
 
 	lp = make_fcomp_lp (comp, &lpmem);
 
-	y	= NEWA (nedges, double);
 	forest	= NEWA (nverts, int);
 
-	slack_size = 10 * GET_LP_NUM_ROWS (lp);
+	slack_size = 10 * GET_AUX_LP_NUM_ROWS (lp);
 	slack = NEWA (slack_size, double);
 
 	edge_freq = NEWA (nedges, int);
@@ -2088,10 +2376,10 @@ pull_out_all_the_stops:
 	best_w		= DBL_MAX;
 #endif
 
-	tp = make_tracer (bbip);
+	tp = make_tracer (params);
 
 	for (;;) {
-		i = GET_LP_NUM_ROWS (lp) + 1;
+		i = GET_AUX_LP_NUM_ROWS (lp) + 1;
 		if (slack_size < i) {
 			/* Reallocate the slack vector. */
 			slack_size = 2 * i;
@@ -2128,7 +2416,7 @@ pull_out_all_the_stops:
 		}
 #endif
 
-#ifdef LPSOLVE
+#ifdef AUX_LPSOLVE
 		status = solve (lp);
 
 		if (status NE OPTIMAL) {
@@ -2226,22 +2514,9 @@ pull_out_all_the_stops:
 		z += comp -> x [i] * y [i];
 	}
 
-	if (z <= 1.0 + FUZZ) {
-		gst_channel_printf (print_solve_trace,
-			"find_fcomp_cut failed\n");
-		record_failed_fcomp (comp, bbip);
-	}
-	else {
-		newcp = lift_constraint (comp, y, z, bbip);
-
-		newcp -> next = cp;
-		cp = newcp;
-	}
-
 	free ((char *) edge_freq);
 	free ((char *) slack);
 	free ((char *) forest);
-	free ((char *) y);
 
 #ifdef CPLEX
 	_MYCPX_freeprob (&lp);
@@ -2257,10 +2532,47 @@ pull_out_all_the_stops:
 	free ((char *) lpmem.objx);
 #endif
 
-#ifdef LPSOLVE
+#ifdef AUX_LPSOLVE
 	delete_lp (lp);
 #endif
 
+	return (z);
+}
+
+/*
+ * Finish off the local cut found for a fractional component.  If it
+ * is not violated, remember that the component failed.  Otherwise,
+ * lift the constraint and add it to the list.
+ */
+
+	static
+	struct constraint *
+record_fcomp_cut (
+
+struct comp *		comp,		/* IN - component separated */
+double *		y,		/* IN - coefficients of constraint */
+double			z,		/* IN - LHS evaluated at LP solution */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+struct constraint *	cp		/* IN - existing constraints */
+)
+{
+struct constraint *	newcp;
+
+	if (z <= 1.0 + FUZZ) {
+		gst_channel_printf (bbip -> params -> print_solve_trace,
+			"find_fcomp_cut failed\n");
+		record_failed_fcomp (comp, bbip);
+	}
+	else {
+		/* Remember the cut before lifting scales it. */
+		cache_fcomp_cut (comp, y, bbip);
+
+		newcp = lift_constraint (comp, y, z, bbip);
+
+		newcp -> next = cp;
+		cp = newcp;
+	}
+
 	return (cp);
 }
 
@@ -2271,7 +2583,7 @@ pull_out_all_the_stops:
 #if defined(CPLEX) AND FORMULATE_DUAL
 
 	static
-	LP_t *
+	AUX_LP_t *
 make_fcomp_lp (
 
 struct comp *		comp,
@@ -2298,7 +2610,7 @@ double *		bdl;
 double *		bdu;
 double *		rhsx;
 double *		matval;
-LP_t *			lp;
+AUX_LP_t *		lp;
 
 	nverts	= comp -> num_verts;
 	nedges	= comp -> num_edges;
@@ -2391,7 +2703,7 @@ LP_t *			lp;
 #if defined(CPLEX) AND NOT FORMULATE_DUAL
 
 	static
-	LP_t *
+	AUX_LP_t *
 make_fcomp_lp (
 
 struct comp *		comp,
@@ -2418,7 +2730,7 @@ double *		bdl;
 double *		bdu;
 double *		rhsx;
 double *		matval;
-LP_t *			lp;
+AUX_LP_t *		lp;
 
 	nverts	= comp -> num_verts;
 	nedges	= comp -> num_edges;
@@ -2521,7 +2833,7 @@ LP_t *			lp;
 	void
 delete_slack (
 
-LP_t *			lp,
+AUX_LP_t *		lp,
 double *		slack,
 struct LCTrace *	tp
 )
@@ -2532,8 +2844,8 @@ int		nrows;
 int		ncols;
 int *		dflag;
 
-	ncols = GET_LP_NUM_COLS (lp);
-	nrows = GET_LP_NUM_ROWS (lp);
+	ncols = GET_AUX_LP_NUM_COLS (lp);
+	nrows = GET_AUX_LP_NUM_ROWS (lp);
 
 	dflag = NEWA (nrows, int);
 	memset (dflag, 0, nrows * sizeof (dflag [0]));
@@ -2562,13 +2874,13 @@ int *		dflag;
  */
 
 
-#if defined(LPSOLVE) AND FORMULATE_DUAL
+#if defined(AUX_LPSOLVE) AND FORMULATE_DUAL
 
 	static
 	void
 delete_slack (
 
-LP_t *			lp,
+AUX_LP_t *		lp,
 double *		slack,
 struct LCTrace *	tp
 )
@@ -2578,7 +2890,7 @@ int		j;
 int		nrows;
 int		ncols;
 
-	ncols = GET_LP_NUM_COLS (lp);
+	ncols = GET_AUX_LP_NUM_COLS (lp);
 
 	/* Grog!  This is totally gross... */
 
@@ -2602,13 +2914,13 @@ int		ncols;
  */
 
 
-#if defined(LPSOLVE) AND NOT FORMULATE_DUAL
+#if defined(AUX_LPSOLVE) AND NOT FORMULATE_DUAL
 
 	static
 	void
 delete_slack (
 
-LP_t *			lp,
+AUX_LP_t *		lp,
 double *		slack,
 struct LCTrace *	tp
 )
@@ -2618,7 +2930,7 @@ int		j;
 int		nrows;
 int *		dflag;
 
-	nrows = GET_LP_NUM_ROWS (lp);
+	nrows = GET_AUX_LP_NUM_ROWS (lp);
 
 	dflag = NEWA (nrows + 1, int);
 
@@ -2654,7 +2966,7 @@ int *		dflag;
 	void
 add_forest_to_lp (
 
-LP_t *		lp,		/* IN - LP to add forest to */
+AUX_LP_t *	lp,		/* IN - LP to add forest to */
 int		nf,		/* IN - number of edges in forest */
 int *		forest		/* IN - list of edges in forest */
 )
@@ -2669,7 +2981,7 @@ double		lowerbd;
 double		upperbd;
 double		cval;
 
-	nedges = GET_LP_NUM_ROWS (lp);
+	nedges = GET_AUX_LP_NUM_ROWS (lp);
 
 	cmatval = NEWA (nedges, double);
 	cmatind = NEWA (nedges, int);
@@ -2713,7 +3025,7 @@ double		cval;
 	void
 add_forest_to_lp (
 
-LP_t *		lp,		/* IN - LP to add forest to */
+AUX_LP_t *	lp,		/* IN - LP to add forest to */
 int		nf,		/* IN - number of edges in forest */
 int *		forest		/* IN - list of edges in forest */
 )
@@ -2727,7 +3039,7 @@ double *	rmatval;
 double		rval;
 char		sense;
 
-	nedges = GET_LP_NUM_COLS (lp);
+	nedges = GET_AUX_LP_NUM_COLS (lp);
 
 	rmatval = NEWA (nedges, double);
 	rmatind = NEWA (nedges, int);
@@ -2764,10 +3076,10 @@ char		sense;
  * Make the initial LP instance for lp_solve (dual formulation).
  */
 
-#if defined(LPSOLVE) AND FORMULATE_DUAL
+#if defined(AUX_LPSOLVE) AND FORMULATE_DUAL
 
 	static
-	LP_t *
+	AUX_LP_t *
 make_fcomp_lp (
 
 struct comp *		comp,
@@ -2785,7 +3097,7 @@ int *			matind;
 double *		objx;
 double *		rhs;
 double *		matval;
-LP_t *			lp;
+AUX_LP_t *		lp;
 
 	nverts	= comp -> num_verts;
 	nedges	= comp -> num_edges;
@@ -2847,10 +3159,10 @@ LP_t *			lp;
  * Make the initial LP instance for lp_solve (primal formulation).
  */
 
-#if defined(LPSOLVE) AND NOT FORMULATE_DUAL
+#if defined(AUX_LPSOLVE) AND NOT FORMULATE_DUAL
 
 	static
-	LP_t *
+	AUX_LP_t *
 make_fcomp_lp (
 
 struct comp *		comp,
@@ -2867,7 +3179,7 @@ int *			matind;
 double *		objx;
 double *		rhs;
 double *		matval;
-LP_t *			lp;
+AUX_LP_t *		lp;
 
 	nedges	= comp -> num_edges;
 
@@ -2936,13 +3248,13 @@ LP_t *			lp;
  * Add the given forest to the given lp_solve LP (dual formulation).
  */
 
-#if defined(LPSOLVE) AND FORMULATE_DUAL
+#if defined(AUX_LPSOLVE) AND FORMULATE_DUAL
 
 	static
 	void
 add_forest_to_lp (
 
-LP_t *		lp,		/* IN - LP to add forest to */
+AUX_LP_t *	lp,		/* IN - LP to add forest to */
 int		nf,		/* IN - number of edges in forest */
 int *		forest		/* IN - list of edges in forest */
 )
@@ -2951,7 +3263,7 @@ int		j;
 int		nedges;
 double *	colvec;
 
-	nedges = GET_LP_NUM_ROWS (lp);
+	nedges = GET_AUX_LP_NUM_ROWS (lp);
 
 	colvec = NEWA (nedges + 1, double);
 
@@ -2978,13 +3290,13 @@ double *	colvec;
  * Add the given forest to the given lp_solve LP (primal formulation).
  */
 
-#if defined(LPSOLVE) AND NOT FORMULATE_DUAL
+#if defined(AUX_LPSOLVE) AND NOT FORMULATE_DUAL
 
 	static
 	void
 add_forest_to_lp (
 
-LP_t *		lp,		/* IN - LP to add forest to */
+AUX_LP_t *	lp,		/* IN - LP to add forest to */
 int		nf,		/* IN - number of edges in forest */
 int *		forest		/* IN - list of edges in forest */
 )
@@ -2993,7 +3305,7 @@ int		j;
 int		nedges;
 double *	rowvec;
 
-	nedges = GET_LP_NUM_COLS (lp);
+	nedges = GET_AUX_LP_NUM_COLS (lp);
 
 	rowvec = NEWA (nedges + 1, double);
 
@@ -3270,6 +3582,266 @@ struct comp *		comp2;
 	bbip -> failed_fcomps = comp2;
 }
 
+/*
+ * Compute a hash value for the structure of the given fractional
+ * component.  The weights of its edges are not included.
+ */
+
+	static
+	int
+fcomp_hash (
+
+struct comp *		comp		/* IN - component to hash */
+)
+{
+int			hval;
+int			i;
+int			nedges;
+int *			vp1;
+int *			vp2;
+
+#define	_HASH(reg,value) \
+	(reg) ^= (value); \
+	(reg) = ((reg) < 0) ? ((reg) << 1) + 1 : ((reg) << 1);
+
+	nedges = comp -> num_edges;
+
+	hval = 0;
+	_HASH (hval, comp -> num_verts);
+	_HASH (hval, nedges);
+	for (i = 0; i < nedges; i++) {
+		vp1 = comp -> everts [i];
+		vp2 = comp -> everts [i + 1];
+		_HASH (hval, vp2 - vp1);
+		while (vp1 < vp2) {
+			_HASH (hval, *vp1++);
+		}
+	}
+
+#undef _HASH
+
+	hval %= LCCACHE_HASH_SIZE;
+	if (hval < 0) {
+		hval += LCCACHE_HASH_SIZE;
+	}
+
+	return (hval);
+}
+
+/*
+ * Find the cache entry for the structure of the given component.  If
+ * there is none, either create it or return NULL, as requested.
+ */
+
+	static
+	struct lcentry *
+find_cache_entry (
+
+struct comp *		comp,		/* IN - component to look up */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+bool			create		/* IN - create entry if missing? */
+)
+{
+int			i;
+int			hval;
+int			nedges;
+int			total_card;
+int *			vp1;
+struct lccache *	cachep;
+struct lcentry *	ep;
+
+	cachep = bbip -> lccache;
+	if (cachep EQ NULL) {
+		if (NOT create) return (NULL);
+		cachep = NEW (struct lccache);
+		for (i = 0; i < LCCACHE_HASH_SIZE; i++) {
+			cachep -> hash [i] = NULL;
+		}
+		bbip -> lccache = cachep;
+	}
+
+	nedges		= comp -> num_edges;
+	vp1		= comp -> everts [0];
+	total_card	= comp -> everts [nedges] - vp1;
+
+	hval = fcomp_hash (comp);
+	for (ep = cachep -> hash [hval]; ep NE NULL; ep = ep -> next) {
+		if (ep -> nverts NE comp -> num_verts) continue;
+		if (ep -> nedges NE nedges) continue;
+		if (ep -> eidx [nedges] NE total_card) continue;
+		for (i = 0; i < nedges; i++) {
+			if (ep -> eidx [i] NE (comp -> everts [i] - vp1)) {
+				goto mismatch;
+			}
+		}
+		for (i = 0; i < total_card; i++) {
+			if (ep -> everts [i] NE vp1 [i]) goto mismatch;
+		}
+		return (ep);
+mismatch:	;
+	}
+
+	if (NOT create) return (NULL);
+
+	ep = NEW (struct lcentry);
+	ep -> nverts	= comp -> num_verts;
+	ep -> nedges	= nedges;
+	ep -> eidx	= NEWA (nedges + 1, int);
+	ep -> everts	= NEWA (total_card, int);
+	ep -> ncuts	= 0;
+	ep -> cuts	= NULL;
+	for (i = 0; i <= nedges; i++) {
+		ep -> eidx [i] = comp -> everts [i] - vp1;
+	}
+	for (i = 0; i < total_card; i++) {
+		ep -> everts [i] = vp1 [i];
+	}
+
+	ep -> next = cachep -> hash [hval];
+	cachep -> hash [hval] = ep;
+
+	return (ep);
+}
+
+/*
+ * Look in the cache for a local cut, previously found for a component
+ * having the same structure, that is violated by the weights of the
+ * given component.  If one is found, copy its coefficients into y, set
+ * z to its LHS, and return TRUE.  Otherwise leave y and z untouched.
+ * The most violated of the remembered cuts is used.
+ */
+
+	static
+	bool
+find_cached_cut (
+
+struct comp *		comp,		/* IN - component to separate */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+double *		y,		/* OUT - coefficients of constraint */
+double *		z		/* OUT - LHS evaluated at x */
+)
+{
+int			i;
+int			nedges;
+double			sum;
+double			best_z;
+struct lcentry *	ep;
+struct lccut *		lcp;
+struct lccut *		best;
+
+	ep = find_cache_entry (comp, bbip, FALSE);
+	if (ep EQ NULL) return (FALSE);
+
+	nedges = comp -> num_edges;
+
+	best	= NULL;
+	best_z	= 1.0 + FUZZ;
+	for (lcp = ep -> cuts; lcp NE NULL; lcp = lcp -> next) {
+		sum = 0.0;
+		for (i = 0; i < nedges; i++) {
+			sum += lcp -> y [i] * comp -> x [i];
+		}
+		if (sum > best_z) {
+			best	= lcp;
+			best_z	= sum;
+		}
+	}
+
+	if (best EQ NULL) return (FALSE);
+
+	memcpy (y, best -> y, nedges * sizeof (y [0]));
+	*z = best_z;
+
+	return (TRUE);
+}
+
+/*
+ * Remember a local cut found for the given component.  Once enough cuts
+ * are remembered for a component, the oldest one is discarded.
+ */
+
+	static
+	void
+cache_fcomp_cut (
+
+struct comp *		comp,		/* IN - component separated */
+double *		y,		/* IN - coefficients of constraint */
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
+)
+{
+int			nedges;
+struct lcentry *	ep;
+struct lccut *		lcp;
+struct lccut **		hookp;
+
+	ep = find_cache_entry (comp, bbip, TRUE);
+
+	nedges = comp -> num_edges;
+
+	for (lcp = ep -> cuts; lcp NE NULL; lcp = lcp -> next) {
+		if (memcmp (lcp -> y, y, nedges * sizeof (y [0])) EQ 0) {
+			/* Already have this one. */
+			return;
+		}
+	}
+
+	lcp = NEW (struct lccut);
+	lcp -> y = NEWA (nedges, double);
+	memcpy (lcp -> y, y, nedges * sizeof (y [0]));
+
+	lcp -> next = ep -> cuts;
+	ep -> cuts = lcp;
+	++(ep -> ncuts);
+
+	if (ep -> ncuts > LCCACHE_MAX_CUTS) {
+		/* Discard the oldest cut. */
+		hookp = &(ep -> cuts);
+		while ((*hookp) -> next NE NULL) {
+			hookp = &((*hookp) -> next);
+		}
+		lcp = *hookp;
+		*hookp = NULL;
+		free ((char *) (lcp -> y));
+		free ((char *) lcp);
+		--(ep -> ncuts);
+	}
+}
+
+/*
+ * Free up the local cut cache.
+ */
+
+	void
+_gst_free_local_cut_cache (
+
+struct lccache *	cachep		/* IN - cache to free */
+)
+{
+int			i;
+struct lcentry *	ep;
+struct lcentry *	ep_next;
+struct lccut *		lcp;
+struct lccut *		lcp_next;
+
+	if (cachep EQ NULL) return;
+
+	for (i = 0; i < LCCACHE_HASH_SIZE; i++) {
+		for (ep = cachep -> hash [i]; ep NE NULL; ep = ep_next) {
+			ep_next = ep -> next;
+			for (lcp = ep -> cuts; lcp NE NULL; lcp = lcp_next) {
+				lcp_next = lcp -> next;
+				free ((char *) (lcp -> y));
+				free ((char *) lcp);
+			}
+			free ((char *) (ep -> everts));
+			free ((char *) (ep -> eidx));
+			free ((char *) ep);
+		}
+	}
+
+	free ((char *) cachep);
+}
+
 /*
  * Find any forest x of the given component whose total cost is > 1
  * (i.e., cost*x > 1).  Try a fast heuristic first.  If no such
@@ -4320,31 +4892,29 @@ bitmap_t		mask;
 	struct LCTrace *
 make_tracer (
 
-struct bbinfo *		bbip	/* IN: branch-and-bound info */
+gst_param_ptr		params	/* IN: parameters */
 )
 {
-gst_param_ptr		params;
 gst_channel_ptr		trace;
 struct LCTrace *	tp;
 
-	params	= bbip -> params;
 	trace	= params -> print_solve_trace;
 
 	tp = NULL;
 	if (trace EQ NULL) {
 		/* Be completely silent. */
-		tp = make_quiet_tracer (bbip);
+		tp = make_quiet_tracer (params);
 	}
 	else {
 		switch (params -> local_cuts_trace_style) {
 		case GST_PVAL_LOCAL_CUTS_TRACE_STYLE_NORMAL:
 			/* The "new normal" is very terse output. */
-			tp = make_terse_tracer (bbip);
+			tp = make_terse_tracer (params);
 			break;
 
 		case GST_PVAL_LOCAL_CUTS_TRACE_STYLE_VERBOSE:
 			/* Verbose gets us the "classic" trace output. */
-			tp = make_classic_tracer (bbip);
+			tp = make_classic_tracer (params);
 			break;
 
 		default:
@@ -4364,7 +4934,7 @@ struct LCTrace *	tp;
 	struct LCTrace *
 make_quiet_tracer (
 
-struct bbinfo *		bbip	/* IN: branch-and-bound-info */
+gst_param_ptr		params	/* IN: parameters */
 )
 {
 struct LCTrace *	tp;
@@ -4372,7 +4942,7 @@ struct LCTrace *	tp;
 	tp = NEW (struct LCTrace);
 	memset (tp, 0, sizeof (*tp));
 
-	tp -> bbip		= bbip;
+	tp -> params		= params;
 	tp -> del_slack		= quiet_trace_del_slack;
 	tp -> cut_violation	= quiet_trace_cut_violation;
 	tp -> add_forest	= quiet_trace_add_forest;
@@ -4485,7 +5055,7 @@ struct LCTrace *	tp	/* IN/OUT: LCTrace object */
 	struct LCTrace *
 make_terse_tracer (
 
-struct bbinfo *		bbip	/* IN: branch-and-bound-info */
+gst_param_ptr		params	/* IN: parameters */
 )
 {
 struct LCTrace_terse *	tp;
@@ -4494,7 +5064,7 @@ struct LCTrace_terse *	tp;
 	tp = NEW (struct LCTrace_terse);
 	memset (tp, 0, sizeof (*tp));
 
-	tp -> base.bbip			= bbip;
+	tp -> base.params		= params;
 	tp -> base.del_slack		= terse_trace_del_slack;
 	tp -> base.cut_violation	= terse_trace_cut_violation;
 	tp -> base.add_forest		= terse_trace_add_forest;
@@ -4569,7 +5139,7 @@ gst_channel_ptr		trace;
 	++(p -> fcount);
 	if (p -> fcount >= p -> f_per_dot) {
 		/* Time to output the next '.' or 'x' char. */
-		trace = p -> base.bbip -> params -> print_solve_trace;
+		trace = p -> base.params -> print_solve_trace;
 		if (p -> numdots EQ 0) {
 			/* Start of new line.  Indent it. */
 			gst_channel_printf (trace, "\t");
@@ -4626,7 +5196,7 @@ gst_channel_ptr		trace;
 	/* Access derived class data. */
 	p = (struct LCTrace_terse *) tp;
 
-	trace = p -> base.bbip -> params -> print_solve_trace;
+	trace = p -> base.params -> print_solve_trace;
 
 	if (p -> numdots > 0) {
 		/* Finish current line of output. */
@@ -4659,7 +5229,7 @@ gst_channel_ptr		trace;
 	/* Access derived class data. */
 	p = (struct LCTrace_terse *) tp;
 
-	trace = p -> base.bbip -> params -> print_solve_trace;
+	trace = p -> base.params -> print_solve_trace;
 
 	if (p -> fcount > 0) {
 		/* We have a "partial" dot.  Finish it. */
@@ -4680,7 +5250,7 @@ gst_channel_ptr		trace;
 	struct LCTrace *
 make_classic_tracer (
 
-struct bbinfo *		bbip	/* IN: branch-and-bound-info */
+gst_param_ptr		params	/* IN: parameters */
 )
 {
 struct LCTrace *	tp;
@@ -4688,7 +5258,7 @@ struct LCTrace *	tp;
 	tp = NEW (struct LCTrace);
 	memset (tp, 0, sizeof (*tp));
 
-	tp -> bbip		= bbip;
+	tp -> params		= params;
 	tp -> del_slack		= classic_trace_del_slack;
 	tp -> cut_violation	= classic_trace_cut_violation;
 	tp -> add_forest	= classic_trace_add_forest;
@@ -4714,7 +5284,7 @@ int			nleft	/* IN: Num forests left */
 {
 gst_channel_ptr		trace;
 
-	trace = tp -> bbip -> params -> print_solve_trace;
+	trace = tp -> params -> print_solve_trace;
 
 	gst_channel_printf (trace,
 			    "\tDeleted %d slack forests, %d left.\n",
@@ -4738,7 +5308,7 @@ gst_channel_ptr		trace;
 
 	++(tp -> num_cv);
 
-	trace = tp -> bbip -> params -> print_solve_trace;
+	trace = tp -> params -> print_solve_trace;
 
 	gst_channel_printf (trace, "\t\t\t\t%s = %.24g\n", var, val);
 }
@@ -4762,7 +5332,7 @@ gst_channel_ptr		trace;
 
 	++(tp -> num_af);
 
-	trace = tp -> bbip -> params -> print_solve_trace;
+	trace = tp -> params -> print_solve_trace;
 
 	gst_channel_printf (trace, "Adding forest:");
 	for (i = 0; i < nf; i++) {
@@ -4786,7 +5356,7 @@ gst_channel_ptr		trace;
 
 	++(tp -> num_exact);
 
-	trace = tp -> bbip -> params -> print_solve_trace;
+	trace = tp -> params -> print_solve_trace;
 
 	gst_channel_printf (trace, "\tUsing Exact algorithm.\n");
 }
@@ -4806,7 +5376,7 @@ int			status	/* IN: Status value to display */
 {
 gst_channel_ptr		trace;
 
-	trace = tp -> bbip -> params -> print_solve_trace;
+	trace = tp -> params -> print_solve_trace;
 
 	gst_channel_printf (trace, format, status);
 }
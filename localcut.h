@@ -3,8 +3,8 @@
 	$Id: localcut.h,v 1.10 2022/11/19 13:45:53 warme Exp $
 
 	File:	localcut.h
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1997, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -29,6 +29,8 @@
 		: Make features unconditional.
 	e-4:	11/18/2022	warme
 		: Simplify calling conventions.
+	e-5:	10/18/2026	warme
+		: Added local cut cache.
 
 ************************************************************************/
 
@@ -41,6 +43,7 @@ struct bbinfo;
 struct comp;
 struct constraint;
 struct gst_channel;
+struct lccache;
 
 extern struct constraint *	_gst_find_local_cuts (
 					double *		x,
@@ -51,6 +54,8 @@ extern struct constraint *	_gst_find_local_cuts_in_component (
 					double *		x,
 					struct bbinfo *		bbip,
 					struct constraint *	cp);
+extern void			_gst_free_local_cut_cache (
+					struct lccache *	cachep);
 extern void			_gst_print_forests (
 					struct comp *		comp,
 					bitmap_t *		flist,
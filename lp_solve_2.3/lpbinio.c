@@ -1,8 +1,8 @@
 /***********************************************************************
 
 	File:	lpbinio.c
-	Rev:	e-3
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution 4.0 International
@@ -27,6 +27,11 @@
 		: Change notices for 5.1 release.
 	e-3:	11/18/2022	warme
 		: Fix -Wall issue.
+	e-4:	10/18/2026	warme
+		: Size eta_col_end using ETA_COLS().
+	e-5:	10/18/2026	warme
+		: Dump the matrix packed, since columns may now
+		  have free space after them.
 
 ************************************************************************/
 
@@ -80,6 +85,8 @@ FILE *		fp;
 		return;
 	}
 
+	pack_mat (lp);
+
 	/* First write all of the scalar values... */
 
 	put4 (fp, lp -> verbose);
@@ -262,7 +269,9 @@ lprec *		lp;
 
 	CALLOC (lp -> mat, lp -> mat_alloc);
 	CALLOC (lp -> col_no, lp -> mat_alloc);
+	CALLOC (lp -> col_beg, cols + 1);
 	CALLOC (lp -> col_end, cols + 1);
+	CALLOC (lp -> col_max, cols + 1);
 	CALLOC (lp -> row_end, rows + 1);
 	lp -> row_end_valid = FALSE;
 	CALLOC (lp -> orig_rh, rows + 1);
@@ -282,7 +291,7 @@ lprec *		lp;
 	lp -> eta_alloc = 10000;
 	CALLOC (lp -> eta_value, lp -> eta_alloc);
 	CALLOC (lp -> eta_row_nr, lp -> eta_alloc);
-	CALLOC (lp -> eta_col_end, rows + lp -> max_num_inv);
+	CALLOC (lp -> eta_col_end, ETA_COLS (lp, rows));
 
 	CALLOC (lp -> solution, sum + 1);
 	CALLOC (lp -> best_solution, sum + 1);
@@ -303,6 +312,12 @@ lprec *		lp;
 	for (i = 0; i <= lp -> columns; i++) {
 		lp -> col_end [i]		= get4 (fp);
 	}
+	for (i = 1; i <= lp -> columns; i++) {
+		lp -> col_beg [i]		= lp -> col_end [i - 1];
+		lp -> col_max [i]		= lp -> col_end [i];
+	}
+	lp -> mat_used		= lp -> non_zeros;
+	lp -> mat_packed	= TRUE;
 	for (i = 0; i < lp -> non_zeros; i++) {
 		lp -> col_no [i]		= get4 (fp);
 	}
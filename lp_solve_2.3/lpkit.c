@@ -1,4 +1,6 @@
 /* 11/18/2022: warme: Fix -Wall issues. */
+/* 10/18/2026: warme: Size eta_col_end using ETA_COLS(). */
+/* 10/18/2026: warme: Append and delete rows without moving columns. */
 
 #include "lpkit.h"
 #include "lpglob.h"
@@ -9,6 +11,10 @@
 
 #define HASHSIZE 10007
 
+/* Room given to a column of n elements when it is moved to make space
+   for new rows */
+#define COL_ROOM(n) ((n) + (n) / 2 + 4)
+
 /* Globals */
 int     Rows;
 int     Columns;
@@ -72,9 +78,13 @@ lprec *make_lp(int rows, int columns)
   newlp->epsel = DEF_EPSEL;
   newlp->non_zeros = 0;
   newlp->mat_alloc = 1;
+  newlp->mat_used = 0;
+  newlp->mat_packed = TRUE;
   CALLOC(newlp->mat, newlp->mat_alloc);
   CALLOC(newlp->col_no, newlp->mat_alloc + 1);
+  CALLOC(newlp->col_beg, columns + 1);
   CALLOC(newlp->col_end, columns + 1);
+  CALLOC(newlp->col_max, columns + 1);
   CALLOC(newlp->row_end, rows + 1);
   newlp->row_end_valid = FALSE;
   CALLOC(newlp->orig_rh, rows + 1);
@@ -122,7 +132,7 @@ lprec *make_lp(int rows, int columns)
   CALLOC(newlp->eta_row_nr, newlp->eta_alloc);
 
   /* +1 reported by Christian Rank */
-  CALLOC(newlp->eta_col_end, newlp->rows_alloc + newlp->max_num_inv + 1);
+  CALLOC(newlp->eta_col_end, ETA_COLS(newlp, newlp->rows_alloc));
 
   newlp->bb_rule = FIRST_NI;
   newlp->break_at_int = FALSE;
@@ -166,7 +176,9 @@ void delete_lp(lprec *lp)
 
   free(lp->mat);
   free(lp->col_no);
+  free(lp->col_beg);
   free(lp->col_end);
+  free(lp->col_max);
   free(lp->row_end);
   free(lp->orig_rh);
   free(lp->rh);
@@ -226,7 +238,9 @@ lprec *copy_lp(lprec *lp)
   newlp->colname_hashtab = copy_hash_table(lp->colname_hashtab);
 
   MALLOCCPY(newlp->mat, lp->mat, newlp->mat_alloc);
+  MALLOCCPY(newlp->col_beg, lp->col_beg, colsplus);
   MALLOCCPY(newlp->col_end, lp->col_end, colsplus);
+  MALLOCCPY(newlp->col_max, lp->col_max, colsplus);
   MALLOCCPY(newlp->col_no, lp->col_no, newlp->mat_alloc + 1);
   MALLOCCPY(newlp->row_end, lp->row_end, rowsplus);
   MALLOCCPY(newlp->orig_rh, lp->orig_rh, rowsplus);
@@ -244,7 +258,7 @@ lprec *copy_lp(lprec *lp)
   MALLOCCPY(newlp->eta_value, lp->eta_value, lp->eta_alloc);
   MALLOCCPY(newlp->eta_row_nr, lp->eta_row_nr, lp->eta_alloc);
   MALLOCCPY(newlp->eta_col_end, lp->eta_col_end,
-	    lp->rows_alloc + lp->max_num_inv + 1);
+	    ETA_COLS(lp, lp->rows_alloc));
   MALLOCCPY(newlp->solution, lp->solution, sumplus);
   MALLOCCPY(newlp->best_solution, lp->best_solution, sumplus);
   MALLOCCPY(newlp->duals, lp->duals, rowsplus);
@@ -301,7 +315,7 @@ void inc_row_space(lprec *lp)
     REALLOC(lp->bas, lp->rows_alloc + 1);
     REALLOC(lp->duals, lp->rows_alloc + 1);
     REALLOC(lp->ch_sign, lp->rows_alloc + 1);
-    REALLOC(lp->eta_col_end, lp->rows_alloc + lp->max_num_inv + 1);
+    REALLOC(lp->eta_col_end, ETA_COLS(lp, lp->rows_alloc));
     if(lp->names_used)
       REALLOC(lp->row_name, lp->rows_alloc + 1);
     if(lp->scaling_used)
@@ -327,8 +341,101 @@ void inc_col_space(lprec *lp)
       REALLOC(lp->col_name, lp->columns_alloc + 1);
     if(lp->scaling_used)
       REALLOC(lp->scale, lp->sum_alloc + 1);
+    REALLOC(lp->col_beg, lp->columns_alloc + 1);
     REALLOC(lp->col_end, lp->columns_alloc + 1);
+    REALLOC(lp->col_max, lp->columns_alloc + 1);
+  }
+}
+
+/* Set col_beg and col_max to match the packed columns given by col_end */
+static void set_packed(lprec *lp)
+{
+  int i;
+
+  for(i = 1; i <= lp->columns; i++) {
+    lp->col_beg[i] = lp->col_end[i - 1];
+    lp->col_max[i] = lp->col_end[i];
+  }
+  lp->mat_used = lp->non_zeros;
+  lp->mat_packed = TRUE;
+}
+
+/* Store the columns in order, without free space, as most of the
+   routines that change the matrix expect */
+void pack_mat(lprec *lp)
+{
+  int i, j, elmnr;
+  matrec *newmat;
+
+  if(lp->mat_packed)
+    return;
+
+  MALLOC(newmat, lp->mat_alloc);
+  elmnr = 0;
+  for(i = 1; i <= lp->columns; i++) {
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
+      newmat[elmnr++] = lp->mat[j];
+    lp->col_end[i] = elmnr;
+  }
+  lp->col_end[0] = 0;
+  free(lp->mat);
+  lp->mat = newmat;
+  set_packed(lp);
+}
+
+/* Make room for count[i] more elements at the end of each column i.
+   Columns without enough free space are moved to the end of the
+   matrix, so that only they are copied; if the matrix is full, all
+   columns are copied into a larger one, leaving free space after
+   every column. */
+static void make_col_room(lprec *lp, int *count)
+{
+  int i, j, n, need, elmnr;
+  matrec *newmat;
+
+  need = 0;
+  for(i = 1; i <= lp->columns; i++)
+    if(lp->col_end[i] + count[i] > lp->col_max[i])
+      need += COL_ROOM(lp->col_end[i] - lp->col_beg[i] + count[i]);
+  if(need == 0)
+    return;
+
+  if(lp->mat_used + need <= lp->mat_alloc) {
+    for(i = 1; i <= lp->columns; i++) {
+      if(lp->col_end[i] + count[i] <= lp->col_max[i])
+	continue;
+      n = lp->col_end[i] - lp->col_beg[i];
+      elmnr = lp->mat_used;
+      for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
+	lp->mat[elmnr++] = lp->mat[j];
+      lp->col_beg[i] = lp->mat_used;
+      lp->col_end[i] = elmnr;
+      lp->mat_used += COL_ROOM(n + count[i]);
+      lp->col_max[i] = lp->mat_used;
+    }
+  }
+  else {
+    need = 0;
+    for(i = 1; i <= lp->columns; i++)
+      need += COL_ROOM(lp->col_end[i] - lp->col_beg[i] + count[i]);
+    lp->mat_alloc = need + need / 2;
+    MALLOC(newmat, lp->mat_alloc);
+    elmnr = 0;
+    for(i = 1; i <= lp->columns; i++) {
+      n = lp->col_end[i] - lp->col_beg[i];
+      for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
+	newmat[elmnr + j - lp->col_beg[i]] = lp->mat[j];
+      lp->col_beg[i] = elmnr;
+      lp->col_end[i] = elmnr + n;
+      elmnr += COL_ROOM(n + count[i]);
+      lp->col_max[i] = elmnr;
+    }
+    free(lp->mat);
+    lp->mat = newmat;
+    lp->mat_used = elmnr;
+    REALLOC(lp->col_no, lp->mat_alloc + 1);
   }
+  lp->mat_packed = FALSE;
 }
 
 void set_mat(lprec *lp, int Row, int Column, REAL Value)
@@ -352,6 +459,8 @@ void set_mat(lprec *lp, int Row, int Column, REAL Value)
     lp->basis_valid = FALSE;
   lp->eta_valid = FALSE;
 
+  pack_mat(lp);
+
   /* find out if we already have such an entry */
   elmnr = lp->col_end[Column - 1];
   while((elmnr < lp->col_end[Column]) && (lp->mat[elmnr].row_nr != Row))
@@ -420,6 +529,7 @@ void set_mat(lprec *lp, int Row, int Column, REAL Value)
     
     lp->non_zeros++;
   }      
+  set_packed(lp);
 }
 
 void set_obj_fn(lprec *lp, REAL *row)
@@ -456,6 +566,7 @@ void add_constraint(lprec *lp, REAL *row, short constr_type, REAL rh)
   int  stcol;
   int  *addtoo;
 
+  pack_mat(lp);
   MALLOC(addtoo, lp->columns + 1);
 
     for(i = 1; i <= lp->columns; i++)
@@ -512,6 +623,7 @@ void add_constraint(lprec *lp, REAL *row, short constr_type, REAL rh)
   }    
   
   memcpy(lp->mat, newmat, lp->non_zeros * sizeof(matrec));
+  set_packed(lp);
  
   free(newmat);
   free(addtoo);
@@ -586,10 +698,9 @@ void add_rows(lprec *lp,
 	      int *rmatind,	/* column # of non-zero entries */
 	      REAL *rmatval)	/* non-zero entries */
 {
-  int i, j, nzcnt;
-  int *count;
-  matrec **ptr1, **ptr2, *tmat;
-  matrec *mp, *src, *dst, *end, *save;
+  int i, j, k, r, nzcnt;
+  int *count, *num;
+  matrec *mp;
 
   /* Handle new columns... */
   if(ccnt < 0 || rcnt < 0)
@@ -607,7 +718,6 @@ void add_rows(lprec *lp,
       error("Invalid 'rmatind' array.");
 
   lp->non_zeros += nzcnt;
-  inc_mat_space(lp, 0);
 
   if(ccnt > 0)
     {
@@ -618,6 +728,12 @@ void add_rows(lprec *lp,
 	  lp->orig_lowbo[i] = 0;
 	  lp->orig_upbo[i] = lp->infinite;
 	}
+      for(i = lp->columns + 1 - ccnt; i <= lp->columns; i++)
+	{
+	  lp->col_beg[i] = lp->mat_used;
+	  lp->col_end[i] = lp->mat_used;
+	  lp->col_max[i] = lp->mat_used;
+	}
     }
 
   if(rcnt > 0)
@@ -695,60 +811,39 @@ void add_rows(lprec *lp,
 	  lp->must_be_int[i] = FALSE;
 	}
 
-      lp->row_end_valid = FALSE;
-
-      /* Now integrate the new coefficients into the matrix */
-      MALLOC(count, lp->columns);
-      MALLOC(ptr1, lp->columns+1);
-      MALLOC(ptr2, lp->columns+1);
-      MALLOC(tmat, nzcnt);
-
-      /* reorganize as columns... */
-      for(i = 0; i < lp->columns; i++)
-	count[i] = 0;
+      /* Now append the new coefficients to their columns.  Each
+	 column gets them in row order, after its existing elements. */
+      CALLOC(count, lp->columns + 1);
       for(i = 0; i < nzcnt; i++)
-	++(count[rmatind[i]]);
-
-      mp = tmat;
-      for(i = 0; i < lp->columns; i++)
-	{
-	  ptr1[i] = mp;
-	  ptr2[i] = mp;
-	  mp += count[i];
-	}
-      ptr1[lp->columns] = mp;
-      ptr2[lp->columns] = mp;
+	++(count[rmatind[i] + 1]);
+      make_col_room(lp, count);
 
       for(i = 0; i < rcnt; i++)
 	for(j = rmatbeg[i]; j < rmatbeg[i+1]; j++)
 	  {
-	    mp = (ptr2[rmatind[j]])++;
+	    mp = lp->mat + (lp->col_end[rmatind[j] + 1])++;
 	    mp->row_nr = lp->rows + 1 - rcnt + i;
 	    mp->value = rmatval[j];
 	  }
 
-      /* merge new columns into matrix */
-      dst = lp->mat + lp->non_zeros;
-      for(i = lp->columns; i > 0; i--)
+      if(lp->row_end_valid)
 	{
-	  /* Insert new rows of this column... */
-	  save = lp->mat + lp->col_end[i];
-	  lp->col_end[i] = dst - lp->mat;
-	  src = ptr1[i];
-	  end = ptr1[i-1];
-	  while (src > end)
-	    *--dst = *--src;
-
-	  /* Copy the old rows of this column... */
-	  src = save;
-	  end = lp->mat + lp->col_end[i-1];
-	  while (src > end)
-	    *--dst = *--src;
+	  /* Append the new rows to the row-wise index, listing the
+	     columns of each in increasing order as set_row_end() does */
+	  CALLOC(num, rcnt);
+	  r = lp->rows - rcnt;
+	  for(i = 0; i < rcnt; i++)
+	    lp->row_end[r + 1 + i] = lp->row_end[r + i]
+	      + rmatbeg[i + 1] - rmatbeg[i];
+	  for(i = 1; i <= lp->columns; i++)
+	    for(j = lp->col_end[i] - count[i]; j < lp->col_end[i]; j++)
+	      {
+		k = lp->mat[j].row_nr;
+		lp->col_no[lp->row_end[k - 1] + ++num[k - r - 1]] = i;
+	      }
+	  free(num);
 	}
 
-      free(tmat);
-      free(ptr2);
-      free(ptr1);
       free(count);
     }
 
@@ -767,6 +862,8 @@ void del_constraint(lprec *lp, int del_row)
       exit(EXIT_FAILURE);
     }
 
+  pack_mat(lp);
+
   elmnr = 0;
   startcol = 0;
 
@@ -784,6 +881,7 @@ void del_constraint(lprec *lp, int del_row)
     startcol = lp->col_end[i];
     lp->col_end[i] = elmnr;
   }
+  set_packed(lp);
   for(i = del_row; i < lp->rows; i++) {
     lp->orig_rh[i] = lp->orig_rh[i + 1];
     lp->ch_sign[i] = lp->ch_sign[i + 1];
@@ -816,8 +914,7 @@ void del_constraint(lprec *lp, int del_row)
 void delete_row_set(lprec *lp, int *row_flags)
 {
   int i, j, k;
-  unsigned elmnr;
-  int startcol;
+  int elmnr, prev;
   int * renum;
   int firstrow;
   int num_del;
@@ -849,12 +946,13 @@ void delete_row_set(lprec *lp, int *row_flags)
   for(; i <= lp->sum; i++)
     renum[i] = j++;
 
-  elmnr=0;
-  startcol=0;
-
+  /* Remove the elements of the deleted rows from each column in
+     place.  The space they leave stays with the column, for rows
+     added later. */
   for(i = 1; i <= lp->columns; i++)
     {
-      for(j=startcol; j < lp->col_end[i]; j++)
+      elmnr = lp->col_beg[i];
+      for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
 	{
 	  k = renum[lp->mat[j].row_nr];
 	  if(k >= 0)
@@ -866,9 +964,30 @@ void delete_row_set(lprec *lp, int *row_flags)
 	  else
 	    lp->non_zeros--;
 	}
-      startcol=lp->col_end[i];
-      lp->col_end[i]=elmnr;
+      if(elmnr != lp->col_end[i])
+	lp->mat_packed = FALSE;
+      lp->col_end[i] = elmnr;
+    }
+
+  if(lp->row_end_valid && !row_flags[0])
+    {
+      /* Remove the deleted rows from the row-wise index */
+      elmnr = 0;
+      prev = 0;
+      for(i = 1; i <= lp->rows; i++)
+	{
+	  k = lp->row_end[i];
+	  if(renum[i] >= 0)
+	    {
+	      for(j = prev + 1; j <= k; j++)
+		lp->col_no[++elmnr] = lp->col_no[j];
+	      lp->row_end[renum[i]] = elmnr;
+	    }
+	  prev = k;
+	}
     }
+  else
+    lp->row_end_valid = FALSE;
   for(i = firstrow + 1; i <= lp->rows; i++)
     {
       k = renum[i];
@@ -914,7 +1033,6 @@ void delete_row_set(lprec *lp, int *row_flags)
   lp->rows -= num_del;
   lp->sum -= num_del;;
 
-  lp->row_end_valid=FALSE;
   lp->eta_valid=FALSE;
 }
 
@@ -977,6 +1095,7 @@ void add_column(lprec *lp, REAL *column)
   /* if the column has only one entry, this should be handled as a bound, but
      this currently is not the case */
 
+  pack_mat(lp);
   lp->columns++;
   lp->sum++;
   inc_col_space(lp);
@@ -1000,6 +1119,7 @@ void add_column(lprec *lp, REAL *column)
       elmnr++;
     }
   lp->col_end[lp->columns] = elmnr;
+  set_packed(lp);
   lp->orig_lowbo[lp->sum] = 0;
   lp->orig_upbo[lp->sum] = lp->infinite;
   lp->lower[lp->sum] = TRUE;
@@ -1057,6 +1177,7 @@ void del_column(lprec *lp, int column)
   for(i = 0; i < lp->nr_lagrange; i++)
     for(j = column; j <= lp->columns; j++)
       lp->lag_row[i][j] = lp->lag_row[i][j+1];
+  pack_mat(lp);
   to_elm = lp->col_end[column-1];
   from_elm = lp->col_end[column];
   elm_in_col = from_elm-to_elm;
@@ -1072,6 +1193,7 @@ void del_column(lprec *lp, int column)
 
   lp->sum--;
   lp->columns--;
+  set_packed(lp);
 }
 
 void set_upbo(lprec *lp, int column, REAL value)
@@ -1192,6 +1314,7 @@ void set_maxim(lprec *lp)
 {
   int i;
   if(lp->maximise == FALSE) {
+    pack_mat(lp);
     for(i = 0; i < lp->non_zeros; i++)
       if(lp->mat[i].row_nr == 0)
 	lp->mat[i].value *= -1;
@@ -1206,6 +1329,7 @@ void set_minim(lprec *lp)
 {
   int i;
   if(lp->maximise == TRUE) {
+    pack_mat(lp);
     for(i = 0; i < lp->non_zeros; i++)
       if(lp->mat[i].row_nr == 0)
 	lp->mat[i].value = -lp->mat[i].value;
@@ -1221,6 +1345,7 @@ void set_constr_type(lprec *lp, int row, short con_type)
   int i;
   if(row > lp->rows || row < 1)
     error("Row out of Range");
+  pack_mat(lp);
   if(con_type == REL_EQ) {
     lp->orig_upbo[row] = 0;
     lp->basis_valid = FALSE;
@@ -1273,7 +1398,7 @@ REAL mat_elm(lprec *lp, int row, int column)
   if(column < 1 || column > lp->columns)
     error("Column out of range in mat_elm");
   value = 0;
-  elmnr = lp->col_end[column-1];
+  elmnr = lp->col_beg[column];
   while(lp->mat[elmnr].row_nr != row && elmnr < lp->col_end[column])
     elmnr++;
   if(elmnr != lp->col_end[column]) {
@@ -1295,7 +1420,7 @@ void get_row(lprec *lp, int row_nr, REAL *row)
     error("Row nr. out of range in get_row");
   for(i = 1; i <= lp->columns; i++) {
     row[i] = 0;
-    for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
       if(lp->mat[j].row_nr == row_nr)
 	row[i] = lp->mat[j].value;
     if(lp->scaling_used)
@@ -1315,7 +1440,7 @@ void get_column(lprec *lp, int col_nr, REAL *column)
     error("Col. nr. out of range in get_column");
   for(i = 0; i <= lp->rows; i++)
     column[i] = 0;
-  for(i = lp->col_end[col_nr - 1]; i < lp->col_end[col_nr]; i++)
+  for(i = lp->col_beg[col_nr]; i < lp->col_end[col_nr]; i++)
     column[lp->mat[i].row_nr] = lp->mat[i].value;
   for(i = 0; i <= lp->rows; i++)
     if(column[i] != 0) {
@@ -1349,7 +1474,7 @@ void get_reduced_costs(lprec *lp, REAL *rc)
       if(lp->upbo[varnr] > 0) {
 	if(lp->scaling_used) {
 	  f = 0;
-	  for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++) {
+	  for(j = lp->col_beg[i]; j < lp->col_end[i]; j++) {
 	    row = lp->mat[j].row_nr;
 	    f += rc[row] * lp->mat[j].value
 		  * (lp->scale[row] * lp->scale[varnr]);
@@ -1358,7 +1483,7 @@ void get_reduced_costs(lprec *lp, REAL *rc)
 	}
 	else {
 	  f = 0;
-	  for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+	  for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
 	    f += rc[lp->mat[j].row_nr] * lp->mat[j].value;
 	  rc[varnr] = f;
 	}
@@ -1419,7 +1544,7 @@ short is_feasible(lprec *lp, REAL *values)
   }
   CALLOC(this_rhs, lp->rows + 1);
     for(i = 1; i <= lp->columns; i++)
-      for(elmnr = lp->col_end[i - 1]; elmnr < lp->col_end[i]; elmnr++)
+      for(elmnr = lp->col_beg[i]; elmnr < lp->col_end[i]; elmnr++)
 	this_rhs[lp->mat[elmnr].row_nr] += lp->mat[elmnr].value * values[i]; 
   for(i = 1; i <= lp->rows; i++) {
     dist = lp->orig_rh[i] - this_rhs[i];
@@ -1446,7 +1571,7 @@ short column_in_lp(lprec *lp, REAL *testcolumn)
   if(lp->scaling_used)
     for(i = 1; i <= lp->columns; i++) {
       ident = nz;
-      for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++) {
+      for(j = lp->col_beg[i]; j < lp->col_end[i]; j++) {
 	value = lp->mat[j].value;
 	if(lp->ch_sign[lp->mat[j].row_nr])
 	  value = -value;
@@ -1463,7 +1588,7 @@ short column_in_lp(lprec *lp, REAL *testcolumn)
   else
     for(i = 1; i <= lp->columns; i++) {
       ident = nz;
-      for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++) {
+      for(j = lp->col_beg[i]; j < lp->col_end[i]; j++) {
 	value = lp->mat[j].value;
 	if(lp->ch_sign[lp->mat[j].row_nr])
 	  value = -value;
@@ -1484,7 +1609,7 @@ void print_lp(lprec *lp)
   REAL *fatmat;
   CALLOC(fatmat, (lp->rows + 1) * lp->columns);
   for(i = 1; i <= lp->columns; i++)
-    for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
       fatmat[(i - 1) * (lp->rows + 1) + lp->mat[j].row_nr] = lp->mat[j].value;
 
   printf("problem name: %s\n", lp->lp_name);
@@ -1629,7 +1754,7 @@ void unscale_columns(lprec *lp)
 
   /* unscale mat */
   for(j = 1; j <= lp->columns; j++)
-    for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++)
+    for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
       lp->mat[i].value /= lp->scale[lp->rows + j];
 
   /* unscale bounds as well */
@@ -1653,7 +1778,7 @@ void unscale(lprec *lp)
   if(lp->scaling_used) {
     /* unscale mat */
     for(j = 1; j <= lp->columns; j++)
-      for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++)
+      for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
 	lp->mat[i].value /= lp->scale[lp->rows + j];
 
     /* unscale bounds */
@@ -1666,7 +1791,7 @@ void unscale(lprec *lp)
     
     /* unscale the matrix */
     for(j = 1; j <= lp->columns; j++)
-      for(i = lp->col_end[j-1]; i < lp->col_end[j]; i++)
+      for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
 	lp->mat[i].value /= lp->scale[lp->mat[i].row_nr];
 
     /* unscale the rhs! */
@@ -1712,7 +1837,7 @@ void auto_scale(lprec *lp)
 
   /* calculate min and max absolute values of rows */
   for(j = 1; j <= lp->columns; j++)
-    for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++) {
+    for(i = lp->col_beg[j]; i < lp->col_end[j]; i++) {
       row_nr = lp->mat[i].row_nr;
       absval = my_abs(lp->mat[i].value);
       if(absval != 0) {
@@ -1728,7 +1853,7 @@ void auto_scale(lprec *lp)
 
   /* now actually scale the matrix */
   for(j = 1; j <= lp->columns; j++)
-    for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++)
+    for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
       lp->mat[i].value *= scalechange[lp->mat[i].row_nr];
 
   /* and scale the rhs and the row bounds (RANGES in MPS!!) */
@@ -1753,7 +1878,7 @@ void auto_scale(lprec *lp)
     else {
       col_max = 0;
       col_min = lp->infinite;
-      for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++) {
+      for(i = lp->col_beg[j]; i < lp->col_end[j]; i++) {
 	if(lp->mat[i].value != 0) {
 	  col_max = my_max(col_max, my_abs(lp->mat[i].value));
 	  col_min = my_min(col_min, my_abs(lp->mat[i].value));
@@ -1766,7 +1891,7 @@ void auto_scale(lprec *lp)
   
   /* scale mat */
   for(j = 1; j <= lp->columns; j++)
-    for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++)
+    for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
       lp->mat[i].value *= scalechange[lp->rows + j];
   
   /* scale bounds as well */
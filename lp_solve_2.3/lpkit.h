@@ -8,6 +8,8 @@
 
 04/24/2014: warme: fix 64-bit architecture issues.
 11/18/2022: warme: fix -Wall issues.
+10/18/2026: warme: add SPARSE_LU option and ETA_COLS().
+10/18/2026: warme: leave free space after columns of the matrix.
 */
 
 #include <stddef.h>
@@ -106,6 +108,16 @@
 #endif
 
 #define ETA_START_SIZE 10000 /* start size of array Eta. Realloced if needed */
+
+/* Number of Eta columns to allocate for the given number of rows.
+   invert() produces at most one Eta column per row (two with -DSPARSE_LU:
+   one of L and one of U), and every iteration adds another one until
+   max_num_inv forces the next reinversion. */
+#ifdef SPARSE_LU
+#define ETA_COLS(lp, nrows) (2 * (nrows) + (lp)->max_num_inv + 1)
+#else
+#define ETA_COLS(lp, nrows) ((nrows) + (lp)->max_num_inv + 1)
+#endif
 #define FNAMLEN 64
 #define NAMELEN 25
 #define MAXSTRL (NAMELEN-1)
@@ -216,11 +228,21 @@ typedef struct _lprec
   int       non_zeros;          /* The number of elements in the sparce matrix*/
   int       mat_alloc;		/* The allocated size for matrix sized 
 				   structures */
+  int       mat_used;		/* The number of elements of mat in use,
+				   including free space after columns */
+  short     mat_packed;		/* true if the columns are stored in order,
+				   without free space: col_beg[i] is then
+				   col_end[i-1], and col_end[0] is 0 */
   matrec    *mat;               /* mat_alloc :The sparse matrix */
+  int       *col_beg;           /* columns_alloc+1 :col_beg[i] is the index of
+				   the first element of column i */
   int       *col_end;           /* columns_alloc+1 :Cend[i] is the index of the
 		 		   first element after column i.
 				   column[i] is stored in elements 
-				   col_end[i-1] to col_end[i]-1 */
+				   col_beg[i] to col_end[i]-1 */
+  int       *col_max;           /* columns_alloc+1 :elements col_end[i] to
+				   col_max[i]-1 are free space reserved for
+				   column i */
   int       *col_no;            /* mat_alloc :From Row 1 on, col_no contains the
 				   column nr. of the
                                    nonzero elements, row by row */
@@ -529,9 +551,11 @@ void error(char *format, ...);
 void inc_mat_space(lprec *lp, int max_extra);
 void inc_row_space(lprec *lp);
 void inc_col_space(lprec *lp);
+void pack_mat(lprec *lp);
 void unscale_columns(lprec *lp);
 void btran(lprec *lp, REAL *row);
 short invert(lprec *lp);
+int lu_factor(lprec *lp);
 void presolve(lprec *lp);
 
 
@@ -0,0 +1,868 @@
+/***********************************************************************
+
+	File:	lufactor.c
+	Rev:	e-3
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution 4.0 International
+	License.
+
+************************************************************************
+
+	Sparse LU factorization of the simplex basis, using Markowitz
+	pivot selection with a relative threshold test.  The factors
+	are written into the eta file of the LP, so that the rest of
+	the simplex code (ftran, btran, coldual, the product-form
+	updates done by each iteration, and the rollback of the eta
+	file done when testing branch variables) works unchanged.
+
+	Two refinements are deliberately not done.  A Forrest-Tomlin
+	update of U would break the rollback of the eta file.  And
+	ftran and btran still walk the whole eta file rather than
+	only the etas that touch nonzeros (hypersparse solves).  The
+	result of ftran is indeed very sparse (about 2% of the rows
+	with 1000 terminals), but ftran and btran together take only
+	about 3% of the run time of bb, and btran results are mostly
+	dense, so the bookkeeping would not pay for itself.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+	e-2:	10/18/2026	warme
+		: Columns of the matrix begin at col_beg[].
+	e-3:	10/18/2026	warme
+		: Note why ftran and btran are not hypersparse.
+
+************************************************************************/
+
+#include "lpkit.h"
+#include "lpglob.h"
+#include <string.h>
+
+
+/*
+ * Global Routines
+ */
+
+int		lu_factor (lprec * lp);
+
+
+/*
+ * Local Equates
+ */
+
+#define	LU_THRESHOLD	0.1	/* Pivot must be at least this fraction */
+				/* of the largest entry in its column */
+#define	LU_SEARCH_LIMIT	4	/* Number of rows/columns to examine */
+				/* once an acceptable pivot is known */
+
+
+/*
+ * Local Types
+ */
+
+/*
+ * The active submatrix during elimination.  Columns are stored with
+ * their values, rows only as a pattern of column indices.  Each row
+ * and column not yet pivoted is kept in a doubly linked list of all
+ * rows (columns) having the same number of non-zeros.
+ */
+
+struct lu_work {
+	int		m;		/* Number of rows in the LP */
+	int		n;		/* Number of structural basics */
+	REAL		tol;		/* Drop tolerance */
+	int *		colvar;		/* Basic variable of each column */
+	REAL *		cost;		/* Row 0 entry of each column */
+
+	int *		clen;		/* Non-zeros in each column */
+	int *		ccap;		/* Space allocated for each column */
+	int **		cidx;		/* Row indices of each column */
+	REAL **		cval;		/* Values of each column */
+
+	int *		rlen;		/* Non-zeros in each row */
+	int *		rcap;		/* Space allocated for each row */
+	int **		ridx;		/* Column indices of each row */
+
+	int *		chead;		/* Columns having each count */
+	int *		cnext;
+	int *		cprev;
+	int *		rhead;		/* Rows having each count */
+	int *		rnext;
+	int *		rprev;
+
+	int *		pos;		/* Scatter map: row -> position */
+					/* within the current column */
+
+	int		npiv;		/* Number of pivots done */
+	int *		piv_row;	/* Pivot row of each pivot */
+	int *		piv_col;	/* Pivot column of each pivot */
+	REAL *		piv_val;	/* Pivot element of each pivot */
+
+	int *		lstart;		/* Start of L column of each pivot */
+	int		lsize;		/* Number of L entries */
+	int		lalloc;
+	int *		lrow;		/* L entries: row, multiplier */
+	REAL *		lval;
+
+	int		usize;		/* Number of U entries */
+	int		ualloc;
+	int *		urow;		/* U entries: row, column, value */
+	int *		ucol;
+	REAL *		uval;
+};
+
+
+/*
+ * Local Routines
+ */
+
+static void	add_col_entry (struct lu_work *, int, int, REAL);
+static void	add_row_entry (struct lu_work *, int, int);
+static void	add_u_entry (struct lu_work *, int, int, REAL);
+static void	col_link (struct lu_work *, int);
+static void	col_unlink (struct lu_work *, int);
+static void	del_row_entry (struct lu_work *, int, int);
+static void	eliminate (struct lu_work *, int, int, REAL);
+static int	find_pivot (struct lu_work *, int *, int *, REAL *);
+static void	free_work (struct lu_work *);
+static void	row_link (struct lu_work *, int);
+static void	row_unlink (struct lu_work *, int);
+static void	write_etas (lprec *, struct lu_work *);
+
+/*
+ * Factor the current basis of the given LP.  The basic variables are
+ * assigned to rows according to the pivot sequence, the eta file is
+ * replaced by the factors, and the right-hand side is recomputed.
+ * Columns that are found to be (numerically) singular are dropped
+ * from the basis and replaced by slack variables.  The number of such
+ * columns is returned.
+ */
+
+	int
+lu_factor (
+
+lprec *		lp		/* IN/OUT - LP whose basis to factor */
+)
+{
+int		i, j, k, r, c;
+int		m, n, var, colnr;
+int		singularities;
+REAL		value, theta;
+short *		done;
+struct lu_work	work;
+struct lu_work *wp;
+
+	wp = &work;
+	memset (wp, 0, sizeof (*wp));
+
+	m = lp -> rows;
+	wp -> m = m;
+	wp -> tol = lp -> epsel;
+
+	CALLOC (done, m + 1);
+	MALLOC (wp -> colvar, m + 1);
+
+	/* Basic slack variables are pivoted on their own rows	*/
+	/* before anything else.  Collect the basic structurals.	*/
+	n = 0;
+	for (i = 0; i <= m; i++) {
+		var = lp -> bas [i];
+		if (var > m) {
+			wp -> colvar [n++] = var;
+		}
+		else if (var > 0) {
+			done [var] = TRUE;
+		}
+	}
+	wp -> n = n;
+
+	MALLOC (wp -> cost, n + 1);
+	CALLOC (wp -> clen, n + 1);
+	CALLOC (wp -> ccap, n + 1);
+	CALLOC (wp -> cidx, n + 1);
+	CALLOC (wp -> cval, n + 1);
+	CALLOC (wp -> rlen, m + 1);
+	CALLOC (wp -> rcap, m + 1);
+	CALLOC (wp -> ridx, m + 1);
+	MALLOC (wp -> chead, m + 2);
+	MALLOC (wp -> cnext, n + 1);
+	MALLOC (wp -> cprev, n + 1);
+	MALLOC (wp -> rhead, n + 2);
+	MALLOC (wp -> rnext, m + 1);
+	MALLOC (wp -> rprev, m + 1);
+	MALLOC (wp -> pos, m + 1);
+	MALLOC (wp -> piv_row, n + 1);
+	MALLOC (wp -> piv_col, n + 1);
+	MALLOC (wp -> piv_val, n + 1);
+	MALLOC (wp -> lstart, n + 2);
+
+	wp -> lalloc = 4 * n + 16;
+	MALLOC (wp -> lrow, wp -> lalloc);
+	MALLOC (wp -> lval, wp -> lalloc);
+	wp -> ualloc = 4 * n + 16;
+	MALLOC (wp -> urow, wp -> ualloc);
+	MALLOC (wp -> ucol, wp -> ualloc);
+	MALLOC (wp -> uval, wp -> ualloc);
+
+	for (i = 0; i <= m; i++) {
+		wp -> pos [i] = -1;
+	}
+	for (i = 0; i <= m + 1; i++) {
+		wp -> chead [i] = -1;
+	}
+	for (i = 0; i <= n + 1; i++) {
+		wp -> rhead [i] = -1;
+	}
+
+	/* Load the active submatrix.  Entries in rows that are	*/
+	/* already pivoted (by a slack) go straight into U.	*/
+	for (j = 0; j < n; j++) {
+		colnr = wp -> colvar [j] - m;
+		wp -> cost [j] = -Extrad;
+		for (k = lp -> col_beg [colnr]; k < lp -> col_end [colnr]; k++) {
+			r = lp -> mat [k].row_nr;
+			value = lp -> mat [k].value;
+			if (r == 0) {
+				wp -> cost [j] += value;
+			}
+			else if (my_abs (value) < wp -> tol) {
+				continue;
+			}
+			else if (done [r]) {
+				add_u_entry (wp, r, j, value);
+			}
+			else {
+				add_col_entry (wp, j, r, value);
+				add_row_entry (wp, r, j);
+			}
+		}
+	}
+	for (j = 0; j < n; j++) {
+		col_link (wp, j);
+	}
+	for (i = 1; i <= m; i++) {
+		if (!done [i]) {
+			row_link (wp, i);
+		}
+	}
+
+	/* Eliminate, dropping any columns that become empty. */
+	singularities = 0;
+	wp -> npiv = 0;
+	wp -> lsize = 0;
+	for (;;) {
+		while ((j = wp -> chead [0]) >= 0) {
+			col_unlink (wp, j);
+			wp -> clen [j] = -1;
+			printf ("%% Column %d singular!\n", wp -> colvar [j] - m);
+			++singularities;
+		}
+		if (!find_pivot (wp, &r, &c, &value)) break;
+		eliminate (wp, r, c, value);
+		done [r] = TRUE;
+	}
+
+	/* Assign the basic variables to their pivot rows.  Every	*/
+	/* row that was not pivoted gets its slack variable.		*/
+	for (i = 1; i <= m; i++) {
+		lp -> bas [i] = i;
+		lp -> basis [i] = TRUE;
+	}
+	for (i = 1; i <= lp -> columns; i++) {
+		lp -> basis [m + i] = FALSE;
+	}
+	for (k = 0; k < wp -> npiv; k++) {
+		r = wp -> piv_row [k];
+		var = wp -> colvar [wp -> piv_col [k]];
+		lp -> bas [r] = var;
+		lp -> basis [r] = FALSE;
+		lp -> basis [var] = TRUE;
+	}
+
+	write_etas (lp, wp);
+
+	/* Compute the values of the basic variables. */
+	for (i = 0; i <= m; i++) {
+		lp -> rhs [i] = lp -> rh [i];
+	}
+	for (i = 1; i <= lp -> columns; i++) {
+		var = m + i;
+		if (!lp -> lower [var]) {
+			theta = lp -> upbo [var];
+			for (j = lp -> col_beg [i]; j < lp -> col_end [i]; j++) {
+				lp -> rhs [lp -> mat [j].row_nr] -=
+					theta * lp -> mat [j].value;
+			}
+		}
+	}
+	for (i = 1; i <= m; i++) {
+		if (!lp -> lower [i]) {
+			lp -> rhs [i] -= lp -> upbo [i];
+		}
+	}
+	for (i = 1; i <= lp -> eta_size; i++) {
+		k = lp -> eta_col_end [i] - 1;
+		r = lp -> eta_row_nr [k];
+		theta = lp -> rhs [r];
+		if (theta == 0) continue;
+		for (j = lp -> eta_col_end [i - 1]; j < k; j++) {
+			lp -> rhs [lp -> eta_row_nr [j]] +=
+				theta * lp -> eta_value [j];
+		}
+		lp -> rhs [r] *= lp -> eta_value [k];
+	}
+	for (i = 1; i <= m; i++) {
+		my_round (lp -> rhs [i], lp -> epsb);
+	}
+
+	lp -> num_inv = 0;
+
+	free_work (wp);
+	free (done);
+
+	return (singularities);
+}
+
+/*
+ * Choose the next pivot element using the Markowitz criterion: among
+ * the entries that pass the threshold test, take one minimizing
+ * (r - 1) * (c - 1), where r and c are the counts of its row and
+ * column.  Columns and rows are searched in order of increasing
+ * count.  The search stops as soon as no better pivot can exist, or
+ * once a few candidates have been examined after finding an
+ * acceptable one.  Return FALSE if there are no entries left.
+ */
+
+	static
+	int
+find_pivot (
+
+struct lu_work *	wp,		/* IN - active submatrix */
+int *			prow,		/* OUT - pivot row */
+int *			pcol,		/* OUT - pivot column */
+REAL *			pval		/* OUT - pivot element */
+)
+{
+int		i, j, k, t, cnt, maxcnt, nexam;
+REAL		v, a, colmax, bestval;
+long		cost, best;
+
+	best	= -1;
+	bestval	= 0;
+	nexam	= 0;
+	maxcnt	= (wp -> m > wp -> n) ? wp -> m : wp -> n;
+
+	for (cnt = 1; cnt <= maxcnt; cnt++) {
+		if (cnt <= wp -> m) {
+			for (j = wp -> chead [cnt]; j >= 0; j = wp -> cnext [j]) {
+				colmax = 0;
+				for (k = 0; k < cnt; k++) {
+					a = my_abs (wp -> cval [j] [k]);
+					if (a > colmax) {
+						colmax = a;
+					}
+				}
+				for (k = 0; k < cnt; k++) {
+					v = wp -> cval [j] [k];
+					a = my_abs (v);
+					if (a < LU_THRESHOLD * colmax) continue;
+					i = wp -> cidx [j] [k];
+					cost = ((long) (wp -> rlen [i] - 1)) * (cnt - 1);
+					if ((best < 0) || (cost < best) ||
+					    ((cost == best) && (a > bestval))) {
+						best	= cost;
+						bestval	= a;
+						*prow	= i;
+						*pcol	= j;
+						*pval	= v;
+					}
+				}
+				if (best == 0) return (TRUE);
+				if ((best > 0) && (++nexam >= LU_SEARCH_LIMIT)) {
+					return (TRUE);
+				}
+			}
+		}
+		if (cnt <= wp -> n) {
+			for (i = wp -> rhead [cnt]; i >= 0; i = wp -> rnext [i]) {
+				for (t = 0; t < cnt; t++) {
+					j = wp -> ridx [i] [t];
+					cost = ((long) (cnt - 1)) * (wp -> clen [j] - 1);
+					if ((best >= 0) && (cost > best)) continue;
+					colmax = 0;
+					v = 0;
+					for (k = 0; k < wp -> clen [j]; k++) {
+						a = my_abs (wp -> cval [j] [k]);
+						if (a > colmax) {
+							colmax = a;
+						}
+						if (wp -> cidx [j] [k] == i) {
+							v = wp -> cval [j] [k];
+						}
+					}
+					a = my_abs (v);
+					if (a < LU_THRESHOLD * colmax) continue;
+					if ((best < 0) || (cost < best) ||
+					    ((cost == best) && (a > bestval))) {
+						best	= cost;
+						bestval	= a;
+						*prow	= i;
+						*pcol	= j;
+						*pval	= v;
+					}
+				}
+				if (best == 0) return (TRUE);
+				if ((best > 0) && (++nexam >= LU_SEARCH_LIMIT)) {
+					return (TRUE);
+				}
+			}
+		}
+		/* Every entry not yet examined has cost >= cnt * cnt. */
+		if ((best >= 0) && (best <= ((long) cnt) * cnt)) break;
+	}
+
+	return (best >= 0);
+}
+
+/*
+ * Eliminate the given pivot from the active submatrix.  The pivot
+ * column becomes a column of L (scaled by the pivot), and the rest of
+ * the pivot row becomes a row of U.  Entries that become smaller than
+ * epsel in magnitude are dropped.
+ */
+
+	static
+	void
+eliminate (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			r,		/* IN - pivot row */
+int			c,		/* IN - pivot column */
+REAL			piv		/* IN - pivot element */
+)
+{
+int		i, j, k, p, q, t, last;
+int *		pos;
+REAL		ur;
+
+	pos = wp -> pos;
+
+	p = (wp -> npiv)++;
+	wp -> piv_row [p]	= r;
+	wp -> piv_col [p]	= c;
+	wp -> piv_val [p]	= piv;
+	wp -> lstart [p]	= wp -> lsize;
+
+	row_unlink (wp, r);
+	col_unlink (wp, c);
+
+	/* The rest of the pivot column is the L column. */
+	for (k = 0; k < wp -> clen [c]; k++) {
+		i = wp -> cidx [c] [k];
+		if (i == r) continue;
+		if (wp -> lsize >= wp -> lalloc) {
+			wp -> lalloc *= 2;
+			REALLOC (wp -> lrow, wp -> lalloc);
+			REALLOC (wp -> lval, wp -> lalloc);
+		}
+		wp -> lrow [wp -> lsize] = i;
+		wp -> lval [wp -> lsize] = wp -> cval [c] [k] / piv;
+		++(wp -> lsize);
+		row_unlink (wp, i);
+		del_row_entry (wp, i, c);
+	}
+	wp -> lstart [p + 1] = wp -> lsize;
+	wp -> clen [c] = -1;
+
+	/* Update every other column having an entry in the pivot row. */
+	for (t = 0; t < wp -> rlen [r]; t++) {
+		j = wp -> ridx [r] [t];
+		if (j == c) continue;
+		col_unlink (wp, j);
+
+		for (k = 0; k < wp -> clen [j]; k++) {
+			pos [wp -> cidx [j] [k]] = k;
+		}
+
+		/* Move the pivot row entry into U. */
+		k = pos [r];
+		ur = wp -> cval [j] [k];
+		last = --(wp -> clen [j]);
+		wp -> cidx [j] [k] = wp -> cidx [j] [last];
+		wp -> cval [j] [k] = wp -> cval [j] [last];
+		pos [wp -> cidx [j] [k]] = k;
+		pos [r] = -1;
+		add_u_entry (wp, r, j, ur);
+
+		for (q = wp -> lstart [p]; q < wp -> lsize; q++) {
+			i = wp -> lrow [q];
+			if (pos [i] >= 0) {
+				wp -> cval [j] [pos [i]] -= wp -> lval [q] * ur;
+			}
+			else {
+				add_col_entry (wp, j, i, - wp -> lval [q] * ur);
+				add_row_entry (wp, i, j);
+				pos [i] = wp -> clen [j] - 1;
+			}
+		}
+
+		/* Drop the entries that cancelled out. */
+		for (q = wp -> lstart [p]; q < wp -> lsize; q++) {
+			i = wp -> lrow [q];
+			k = pos [i];
+			if (my_abs (wp -> cval [j] [k]) >= wp -> tol) continue;
+			last = --(wp -> clen [j]);
+			wp -> cidx [j] [k] = wp -> cidx [j] [last];
+			wp -> cval [j] [k] = wp -> cval [j] [last];
+			pos [wp -> cidx [j] [k]] = k;
+			pos [i] = -1;
+			del_row_entry (wp, i, j);
+		}
+
+		for (k = 0; k < wp -> clen [j]; k++) {
+			pos [wp -> cidx [j] [k]] = -1;
+		}
+		col_link (wp, j);
+	}
+	wp -> rlen [r] = 0;
+
+	for (q = wp -> lstart [p]; q < wp -> lsize; q++) {
+		row_link (wp, wp -> lrow [q]);
+	}
+}
+
+/*
+ * Write the factors into the eta file.  Solving B x = y amounts to
+ * applying the L columns in pivot order, followed by back substitution
+ * with the U columns in reverse pivot order.  The basic slack
+ * variables contribute nothing to either, except through the U
+ * entries in their rows.  The objective row is not part of the
+ * factorization -- it is eliminated as part of the back substitution.
+ */
+
+	static
+	void
+write_etas (
+
+lprec *			lp,		/* IN/OUT - LP to write eta file of */
+struct lu_work *	wp		/* IN - completed factorization */
+)
+{
+int		i, j, k, p, q, need, elnr, ncols;
+int *		ustart;
+int *		uorder;
+REAL		piv;
+
+	need = wp -> lsize + wp -> usize + 3 * wp -> npiv + lp -> rows + 2;
+	if (need >= lp -> eta_alloc) {
+		lp -> eta_alloc = need + lp -> eta_alloc / 2;
+		REALLOC (lp -> eta_value, lp -> eta_alloc);
+		REALLOC (lp -> eta_row_nr, lp -> eta_alloc);
+	}
+
+	/* Sort the U entries by column. */
+	CALLOC (ustart, wp -> n + 1);
+	MALLOC (uorder, wp -> usize + 1);
+	for (k = 0; k < wp -> usize; k++) {
+		++(ustart [wp -> ucol [k]]);
+	}
+	for (j = 0, k = 0; j <= wp -> n; j++) {
+		i = ustart [j];
+		ustart [j] = k;
+		k += i;
+	}
+	for (k = 0; k < wp -> usize; k++) {
+		uorder [ustart [wp -> ucol [k]]++] = k;
+	}
+	for (j = wp -> n; j > 0; j--) {
+		ustart [j] = ustart [j - 1];
+	}
+	ustart [0] = 0;
+
+	elnr = 0;
+	ncols = 0;
+	lp -> eta_col_end [0] = 0;
+
+	for (p = 0; p < wp -> npiv; p++) {
+		if (wp -> lstart [p] >= wp -> lstart [p + 1]) continue;
+		for (q = wp -> lstart [p]; q < wp -> lstart [p + 1]; q++) {
+			lp -> eta_row_nr [elnr]	= wp -> lrow [q];
+			lp -> eta_value [elnr]	= - wp -> lval [q];
+			++elnr;
+		}
+		lp -> eta_row_nr [elnr]	= wp -> piv_row [p];
+		lp -> eta_value [elnr]	= 1;
+		++elnr;
+		lp -> eta_col_end [++ncols] = elnr;
+	}
+
+	for (p = wp -> npiv - 1; p >= 0; p--) {
+		j = wp -> piv_col [p];
+		piv = wp -> piv_val [p];
+		for (q = ustart [j]; q < ustart [j + 1]; q++) {
+			k = uorder [q];
+			lp -> eta_row_nr [elnr]	= wp -> urow [k];
+			lp -> eta_value [elnr]	= - wp -> uval [k] / piv;
+			++elnr;
+		}
+		if (wp -> cost [j] != 0) {
+			lp -> eta_row_nr [elnr]	= 0;
+			lp -> eta_value [elnr]	= - wp -> cost [j] / piv;
+			++elnr;
+		}
+		lp -> eta_row_nr [elnr]	= wp -> piv_row [p];
+		lp -> eta_value [elnr]	= 1 / piv;
+		++elnr;
+		lp -> eta_col_end [++ncols] = elnr;
+	}
+
+	lp -> eta_size = ncols;
+
+	free (uorder);
+	free (ustart);
+}
+
+/*
+ * Append an entry to the given column of the active submatrix.
+ */
+
+	static
+	void
+add_col_entry (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			j,		/* IN - column */
+int			i,		/* IN - row */
+REAL			value		/* IN - value */
+)
+{
+int		k;
+
+	k = wp -> clen [j];
+	if (k >= wp -> ccap [j]) {
+		wp -> ccap [j] = 2 * k + 4;
+		REALLOC (wp -> cidx [j], wp -> ccap [j]);
+		REALLOC (wp -> cval [j], wp -> ccap [j]);
+	}
+	wp -> cidx [j] [k] = i;
+	wp -> cval [j] [k] = value;
+	wp -> clen [j] = k + 1;
+}
+
+/*
+ * Append a column to the pattern of the given row.
+ */
+
+	static
+	void
+add_row_entry (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			i,		/* IN - row */
+int			j		/* IN - column */
+)
+{
+int		k;
+
+	k = wp -> rlen [i];
+	if (k >= wp -> rcap [i]) {
+		wp -> rcap [i] = 2 * k + 4;
+		REALLOC (wp -> ridx [i], wp -> rcap [i]);
+	}
+	wp -> ridx [i] [k] = j;
+	wp -> rlen [i] = k + 1;
+}
+
+/*
+ * Remove a column from the pattern of the given row.
+ */
+
+	static
+	void
+del_row_entry (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			i,		/* IN - row */
+int			j		/* IN - column */
+)
+{
+int		k, last;
+int *		ip;
+
+	ip = wp -> ridx [i];
+	last = wp -> rlen [i] - 1;
+	for (k = 0; ip [k] != j; k++) {
+	}
+	ip [k] = ip [last];
+	wp -> rlen [i] = last;
+}
+
+/*
+ * Record an entry of U.
+ */
+
+	static
+	void
+add_u_entry (
+
+struct lu_work *	wp,		/* IN/OUT - factorization */
+int			i,		/* IN - row */
+int			j,		/* IN - column */
+REAL			value		/* IN - value */
+)
+{
+	if (wp -> usize >= wp -> ualloc) {
+		wp -> ualloc *= 2;
+		REALLOC (wp -> urow, wp -> ualloc);
+		REALLOC (wp -> ucol, wp -> ualloc);
+		REALLOC (wp -> uval, wp -> ualloc);
+	}
+	wp -> urow [wp -> usize] = i;
+	wp -> ucol [wp -> usize] = j;
+	wp -> uval [wp -> usize] = value;
+	++(wp -> usize);
+}
+
+/*
+ * Add a column to the list for its count.
+ */
+
+	static
+	void
+col_link (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			j		/* IN - column */
+)
+{
+int		cnt;
+
+	cnt = wp -> clen [j];
+	wp -> cprev [j] = -1;
+	wp -> cnext [j] = wp -> chead [cnt];
+	if (wp -> chead [cnt] >= 0) {
+		wp -> cprev [wp -> chead [cnt]] = j;
+	}
+	wp -> chead [cnt] = j;
+}
+
+/*
+ * Remove a column from the list for its count.
+ */
+
+	static
+	void
+col_unlink (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			j		/* IN - column */
+)
+{
+	if (wp -> cprev [j] >= 0) {
+		wp -> cnext [wp -> cprev [j]] = wp -> cnext [j];
+	}
+	else {
+		wp -> chead [wp -> clen [j]] = wp -> cnext [j];
+	}
+	if (wp -> cnext [j] >= 0) {
+		wp -> cprev [wp -> cnext [j]] = wp -> cprev [j];
+	}
+}
+
+/*
+ * Add a row to the list for its count.
+ */
+
+	static
+	void
+row_link (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			i		/* IN - row */
+)
+{
+int		cnt;
+
+	cnt = wp -> rlen [i];
+	wp -> rprev [i] = -1;
+	wp -> rnext [i] = wp -> rhead [cnt];
+	if (wp -> rhead [cnt] >= 0) {
+		wp -> rprev [wp -> rhead [cnt]] = i;
+	}
+	wp -> rhead [cnt] = i;
+}
+
+/*
+ * Remove a row from the list for its count.
+ */
+
+	static
+	void
+row_unlink (
+
+struct lu_work *	wp,		/* IN/OUT - active submatrix */
+int			i		/* IN - row */
+)
+{
+	if (wp -> rprev [i] >= 0) {
+		wp -> rnext [wp -> rprev [i]] = wp -> rnext [i];
+	}
+	else {
+		wp -> rhead [wp -> rlen [i]] = wp -> rnext [i];
+	}
+	if (wp -> rnext [i] >= 0) {
+		wp -> rprev [wp -> rnext [i]] = wp -> rprev [i];
+	}
+}
+
+/*
+ * Free up the factorization workspace.
+ */
+
+	static
+	void
+free_work (
+
+struct lu_work *	wp		/* IN - workspace to free */
+)
+{
+int		i;
+
+	for (i = 0; i < wp -> n; i++) {
+		free (wp -> cidx [i]);
+		free (wp -> cval [i]);
+	}
+	for (i = 0; i <= wp -> m; i++) {
+		free (wp -> ridx [i]);
+	}
+	free (wp -> uval);
+	free (wp -> ucol);
+	free (wp -> urow);
+	free (wp -> lval);
+	free (wp -> lrow);
+	free (wp -> lstart);
+	free (wp -> piv_val);
+	free (wp -> piv_col);
+	free (wp -> piv_row);
+	free (wp -> pos);
+	free (wp -> rprev);
+	free (wp -> rnext);
+	free (wp -> rhead);
+	free (wp -> cprev);
+	free (wp -> cnext);
+	free (wp -> chead);
+	free (wp -> ridx);
+	free (wp -> rcap);
+	free (wp -> rlen);
+	free (wp -> cval);
+	free (wp -> cidx);
+	free (wp -> ccap);
+	free (wp -> clen);
+	free (wp -> cost);
+	free (wp -> colvar);
+}
@@ -456,6 +456,10 @@ void readinput(lprec *lp)
     }
   }
   lp->col_end[index] = nn_ind; 
+  for(i = 1; i <= index; i++) {
+    lp->col_beg[i] = lp->col_end[i - 1];
+    lp->col_max[i] = lp->col_end[i];
+  }
 
   /* the following should be replaced by a call to the MPS print routine MB */
   
@@ -565,11 +569,15 @@ lprec *read_lp_file(FILE *input, short verbose, nstring lp_name)
   lp->epsel         = DEF_EPSEL;
   lp->non_zeros     = Non_zeros;
   lp->mat_alloc     = Non_zeros;
+  lp->mat_used      = Non_zeros;
+  lp->mat_packed    = TRUE;
   lp->row_end_valid = FALSE;
   
   MALLOC(lp->mat,         Non_zeros);
   CALLOC(lp->col_no,      Non_zeros + 1);
+  CALLOC(lp->col_beg,     Columns + 1);
   CALLOC(lp->col_end,     Columns + 1);
+  CALLOC(lp->col_max,     Columns + 1);
   CALLOC(lp->row_end,     Rows + 1);
   CALLOC(lp->orig_rh,     Rows + 1);
   CALLOC(lp->rh,          Rows + 1);
@@ -609,7 +617,7 @@ lprec *read_lp_file(FILE *input, short verbose, nstring lp_name)
 
   CALLOC(lp->eta_value,   INITIAL_MAT_SIZE);
   CALLOC(lp->eta_row_nr,  INITIAL_MAT_SIZE);
-  CALLOC(lp->eta_col_end, Rows + lp->max_num_inv + 1);
+  CALLOC(lp->eta_col_end, ETA_COLS(lp, Rows));
 
   lp->iter       = 0;
   lp->total_iter = 0;
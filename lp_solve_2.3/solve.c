@@ -1,4 +1,7 @@
 /* 11/18/2022: warme: Fix -Wall issues. */
+/* 10/18/2026: warme: Add sparse LU version of invert(). */
+/* 10/18/2026: warme: Devex pricing and bound flipping in dual simplex. */
+/* 10/18/2026: warme: Columns of the matrix begin at col_beg[]. */
 
 #include <string.h>
 #include "lpkit.h"
@@ -17,6 +20,16 @@ static short Break_bb;
 #define SINGULAR_BASIS			-2
 #define	LOST_PRIMAL_FEASIBILITY		-3
 
+/* Devex reference weights are reset when one grows beyond this */
+#define DEVEX_RESET_WEIGHT		1e7
+
+/* A breakpoint of the dual ratio test */
+struct dual_bp {
+  REAL	quot;		/* dual step length at which it is reached */
+  REAL	absd;		/* magnitude of the pivot row entry */
+  int	varnr;		/* nonbasic variable */
+};
+
 
 static void ftran(lprec *lp, REAL *pcol)
 {
@@ -80,8 +93,9 @@ static void set_row_end(lprec *lp)
     rownum[i] = 0;
   }
 
-  for(i = 0; i < lp->non_zeros; i++)
-    rownum[lp->mat[i].row_nr]++;
+  for(i = 1; i <= lp->columns; i++)
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
+      rownum[lp->mat[j].row_nr]++;
 
   lp->row_end[0] = 0;
 
@@ -89,7 +103,7 @@ static void set_row_end(lprec *lp)
     lp->row_end[i] = lp->row_end[i - 1] + rownum[i];
 
   for(i = 1; i <= lp->columns; i++)
-    for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++) {
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++) {
       row_nr = lp->mat[j].row_nr;
       if(row_nr != 0) {
 	num[row_nr]++;
@@ -118,7 +132,7 @@ static short isvalid(lprec *lp)
   CALLOC(colnum, lp->columns + 1);
 
   for(i = 1 ; i <= lp->columns; i++)
-    for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++) {
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++) {
       colnum[i]++;
       rownum[lp->mat[j].row_nr]++;
     }
@@ -202,7 +216,7 @@ static void setpivcol(lprec *lp,
   if(lp->lower[varin]) {
     if(varin > lp->rows) {
       colnr = varin - lp->rows;
-      for(i = lp->col_end[colnr - 1]; i < lp->col_end[colnr]; i++)
+      for(i = lp->col_beg[colnr]; i < lp->col_end[colnr]; i++)
 	pcol[lp->mat[i].row_nr] = lp->mat[i].value;
       pcol[0] -= Extrad;
     }
@@ -212,7 +226,7 @@ static void setpivcol(lprec *lp,
   else { /* !lower */
     if(varin > lp->rows) {
       colnr = varin - lp->rows;
-      for(i = lp->col_end[colnr - 1]; i < lp->col_end[colnr]; i++)
+      for(i = lp->col_beg[colnr]; i < lp->col_end[colnr]; i++)
 	pcol[lp->mat[i].row_nr] = -lp->mat[i].value;
       pcol[0] += Extrad;
     }
@@ -224,6 +238,32 @@ static void setpivcol(lprec *lp,
 } /* setpivcol */
 
 
+#ifdef SPARSE_LU
+
+/* Factor the basis with lu_factor(), which writes the L and U factors
+   into the Eta file and recomputes rhs. */
+short invert(lprec *lp)
+{
+  int singularities;
+
+  if(lp->print_at_invert)
+    printf("%% Start Invert iter %d eta_size %d rhs[0] %g \n",
+	    lp->iter, lp->eta_size, (double) - lp->rhs[0]);
+
+  singularities = lu_factor(lp);
+
+  if(lp->print_at_invert)
+    printf("%% End Invert                eta_size %d rhs[0] %g\n",
+	    lp->eta_size, (double) - lp->rhs[0]);
+
+  JustInverted = TRUE;
+  DoInvert = FALSE;
+
+  return (singularities <= 0);
+} /* invert */
+
+#else
+
 static void minoriteration(lprec *lp,
 			   int colnr,
 			   int row_nr)
@@ -244,7 +284,7 @@ static void minoriteration(lprec *lp,
       resize_eta(lp);
   }
 
-  for(j = lp->col_end[colnr - 1] ; j < lp->col_end[colnr]; j++) {
+  for(j = lp->col_beg[colnr] ; j < lp->col_end[colnr]; j++) {
     k = lp->mat[j].row_nr;
 
     if(k == 0 && Extrad != 0)
@@ -381,7 +421,7 @@ short invert(lprec *lp)
     varnr = lp->rows + i;
     if(!lp->lower[varnr]) {
       theta = lp->upbo[varnr];
-      for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+      for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
 	lp->rhs[lp->mat[j].row_nr] -= theta * lp->mat[j].value;
     }
   }
@@ -416,7 +456,7 @@ short invert(lprec *lp)
 	fcol[colnr - 1] = FALSE;
 	colnum[colnr] = 0;
 
-	for(j = lp->col_end[colnr - 1]; j < lp->col_end[colnr]; j++)
+	for(j = lp->col_beg[colnr]; j < lp->col_end[colnr]; j++)
 	  if(frow[lp->mat[j].row_nr])
 	    rownum[lp->mat[j].row_nr - 1]--;
 
@@ -436,7 +476,7 @@ short invert(lprec *lp)
     if(colnum[colnr] == 1)
       if(fcol[colnr - 1]) {
 	v = 0;
-	j = lp->col_end[colnr - 1] + 1;
+	j = lp->col_beg[colnr] + 1;
 
 	while(!(frow[lp->mat[j - 1].row_nr]))
 	  j++;
@@ -488,7 +528,7 @@ short invert(lprec *lp)
     for(j = 0; j <= lp->rows; j++)
       pcol[j] = 0;
 
-    for(j = lp->col_end[colnr - 1]; j < lp->col_end[colnr]; j++)
+    for(j = lp->col_beg[colnr]; j < lp->col_end[colnr]; j++)
       pcol[lp->mat[j].row_nr] = lp->mat[j].value;
 
     pcol[0] -= Extrad;
@@ -518,6 +558,8 @@ short invert(lprec *lp)
   return (singularities <= 0);
 } /* invert */
 
+#endif /* SPARSE_LU */
+
 static int colprim(lprec *lp,
 		   short minit,
 		   REAL   *drow)
@@ -537,7 +579,7 @@ static int colprim(lprec *lp,
       if(!lp->basis[varnr])
 	if(lp->upbo[varnr] > 0) {
 	  f = 0;
-	  for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+	  for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
 	    f += drow[lp->mat[j].row_nr] * lp->mat[j].value;
 	  drow[varnr] = f;
 	}
@@ -659,14 +701,17 @@ static int rowprim(lprec *lp,
   return(row_nr);
 } /* rowprim */
 
-static int rowdual(lprec *lp)
+static int rowdual(lprec *lp, REAL *weight)
 {
   int   i, row_nr;
-  REAL  f, g, minrhs;
+  REAL  f, g, score, maxscore;
   short artifs;
 
+  /* Dual Devex pricing: choose the row maximizing the squared
+     infeasibility relative to the reference weight of its basic
+     variable. */
   row_nr = 0;
-  minrhs = -lp->epsb;
+  maxscore = 0;
   i = 0;
   artifs = FALSE;
   while(i < lp->rows && !artifs) {
@@ -681,9 +726,12 @@ static int rowdual(lprec *lp)
 	g = lp->rhs[i];
       else
 	g = f - lp->rhs[i];
-      if(g < minrhs) {
-	minrhs = g;
-	row_nr = i;
+      if(g < -lp->epsb) {
+	score = g * g / weight[lp->bas[i]];
+	if(score > maxscore) {
+	  maxscore = score;
+	  row_nr = i;
+	}
       }
     }
   }
@@ -703,14 +751,88 @@ static int rowdual(lprec *lp)
   return(row_nr);
 } /* rowdual */
 
+static void devex_update(lprec *lp,
+			 REAL *weight,
+			 int row_nr,
+			 int varout,
+			 REAL *pcol)
+{
+  int  i;
+  REAL wr, w, maxw;
+
+  /* Update the dual Devex reference weights after varout left the
+     basis from row row_nr.  pcol is the entering column. */
+  wr = weight[varout] / (pcol[row_nr] * pcol[row_nr]);
+  maxw = 0;
+  for(i = 1; i <= lp->rows; i++)
+    if(i != row_nr && pcol[i] != 0) {
+      w = pcol[i] * pcol[i] * wr;
+      if(w > weight[lp->bas[i]])
+	weight[lp->bas[i]] = w;
+      if(weight[lp->bas[i]] > maxw)
+	maxw = weight[lp->bas[i]];
+    }
+  weight[lp->bas[row_nr]] = my_max(wr, 1);
+
+  if(maxw > DEVEX_RESET_WEIGHT || wr > DEVEX_RESET_WEIGHT)
+    for(i = 0; i <= lp->sum; i++)
+      weight[i] = 1;
+} /* devex_update */
+
+static int compare_dual_bp(struct dual_bp *bp1, struct dual_bp *bp2)
+{
+  if(bp1->quot != bp2->quot)
+    return(bp1->quot < bp2->quot ? -1 : 1);
+  if(bp1->absd != bp2->absd)
+    return(bp1->absd > bp2->absd ? -1 : 1);
+  return(bp1->varnr - bp2->varnr);
+} /* compare_dual_bp */
+
+static void flip_bounds(lprec *lp,
+			struct dual_bp *bp,
+			int nflip,
+			REAL *col)
+{
+  int  i, j, k, varnr, colnr;
+  REAL up;
+
+  /* Move the given nonbasic variables to their opposite bounds, and
+     update the basic variables accordingly.  col is workspace. */
+  for(i = 0; i <= lp->rows; i++)
+    col[i] = 0;
+  for(k = 0; k < nflip; k++) {
+    varnr = bp[k].varnr;
+    up = lp->upbo[varnr];
+    if(!lp->lower[varnr])
+      up = -up;
+    if(varnr > lp->rows) {
+      colnr = varnr - lp->rows;
+      for(j = lp->col_beg[colnr]; j < lp->col_end[colnr]; j++)
+	col[lp->mat[j].row_nr] += up * lp->mat[j].value;
+      col[0] -= up * Extrad;
+    }
+    else
+      col[varnr] += up;
+    lp->lower[varnr] = !lp->lower[varnr];
+  }
+  ftran(lp, col);
+  for(i = 0; i <= lp->rows; i++) {
+    lp->rhs[i] -= col[i];
+    my_round(lp->rhs[i], lp->epsb);
+  }
+} /* flip_bounds */
+
 static int coldual(lprec *lp,
 		   int row_nr,
 		   short minit,
 		   REAL *prow,
-		   REAL *drow)
+		   REAL *drow,
+		   struct dual_bp *bp,
+		   REAL *fcol)
 {
-  int  i, j, k, r, varnr, *rowp, row, colnr;
-  REAL theta, quot, pivot, d, f, g, *valuep, value;
+  int  i, j, k, r, varnr, *rowp, row, colnr, nbp, nflip;
+  REAL quot, d, f, g, slope, *valuep, value;
+  struct dual_bp tmp;
 
   Doiter = FALSE;
   if(!minit) {
@@ -754,7 +876,7 @@ static int coldual(lprec *lp,
 	d = - Extrad * drow[0];
 	f = 0;
 	k = lp->col_end[i];
-	j = lp->col_end[i - 1];
+	j = lp->col_beg[i];
 
 	/* this is one of the loops where the program consumes a lot
 	   of cpu time */
@@ -777,14 +899,16 @@ static int coldual(lprec *lp,
     }
   }
 
-  if(lp->rhs[row_nr] > lp->upbo[lp->bas[row_nr]])
+  if(lp->rhs[row_nr] > lp->upbo[lp->bas[row_nr]]) {
     g = -1;
-  else
+    slope = lp->rhs[row_nr] - lp->upbo[lp->bas[row_nr]];
+  }
+  else {
     g = 1;
+    slope = -lp->rhs[row_nr];
+  }
 
-  pivot = 0;
-  colnr = 0;
-  theta = lp->infinite;
+  nbp = 0;
 
   for(i = 1; i <= lp->sum; i++) {
     if(lp->lower[i])
@@ -797,18 +921,42 @@ static int coldual(lprec *lp,
 	quot = -drow[i] / (REAL) d;
       else
 	quot = drow[i] / (REAL) d;
-      if(quot < theta) {
-	theta = quot;
-	pivot = d;
-	colnr = i;
-      }
-      else if((quot == theta) && (my_abs(d) > my_abs(pivot))) {
-	pivot = d;
-	colnr = i;
-      }
+      bp[nbp].quot = quot;
+      bp[nbp].absd = -d;
+      bp[nbp].varnr = i;
+      nbp++;
     }
   }
 
+  /* Bound flipping ratio test: pass over the breakpoints in order of
+     increasing dual step length.  Each boxed variable passed reduces
+     the rate at which the dual objective improves by |d| times its
+     range, and must be flipped to its other bound to remain dual
+     feasible.  The variable at which the rate would become
+     non-positive enters the basis.  Usually only a few breakpoints
+     are passed, so rather than sorting them all, we repeatedly move
+     the next one to the front. */
+  colnr = 0;
+  nflip = 0;
+  for(k = 0; k < nbp; k++) {
+    j = k;
+    for(i = k + 1; i < nbp; i++)
+      if(compare_dual_bp(&bp[i], &bp[j]) < 0)
+	j = i;
+    tmp = bp[j];
+    bp[j] = bp[k];
+    bp[k] = tmp;
+    colnr = bp[k].varnr;
+    if(k == nbp - 1 || lp->upbo[colnr] >= lp->infinite)
+      break;
+    slope -= bp[k].absd * lp->upbo[colnr];
+    if(slope <= lp->epsb)
+      break;
+    nflip++;
+  }
+  if(nflip > 0)
+    flip_bounds(lp, bp, nflip, fcol);
+
   if(lp->trace)
     printf("%% col_dual:%d, pivot element:  %18g\n", colnr,
 	    (double)prow[colnr]);
@@ -979,10 +1127,11 @@ static void primloop(lprec *lp)
 
 static void dualloop(lprec *lp)
 {
-  int    i, j;
+  int    i, j, varout;
   REAL   f, theta;
   short  primal;
-  REAL   *drow, *prow, *Pcol;
+  REAL   *drow, *prow, *Pcol, *weight, *fcol;
+  struct dual_bp *bp;
   short  minit;
   int    colnr, row_nr;
 
@@ -992,6 +1141,11 @@ static void dualloop(lprec *lp)
   CALLOC(drow, lp->sum + 1);
   CALLOC(prow, lp->sum + 1);
   CALLOC(Pcol, lp->rows + 1);
+  MALLOC(weight, lp->sum + 1);
+  MALLOC(bp, lp->sum + 1);
+  MALLOC(fcol, lp->rows + 1);
+  for(i = 0; i <= lp->sum; i++)
+    weight[i] = 1;
 
   Status = RUNNING;
   primal = FALSE;
@@ -1009,7 +1163,7 @@ static void dualloop(lprec *lp)
   Extrad = 0;
   for(i = 1; i <= lp->columns; i++) {
     f = 0;
-    for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+    for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
       if(lp->mat[j].row_nr == 0)
 	f += lp->mat[j].value;
 
@@ -1030,10 +1184,10 @@ static void dualloop(lprec *lp)
     DoInvert = FALSE;
 
     if(!minit)
-      row_nr = rowdual(lp);
+      row_nr = rowdual(lp, weight);
 
     if(row_nr > 0 ) {
-      colnr = coldual(lp, row_nr, minit, prow, drow);
+      colnr = coldual(lp, row_nr, minit, prow, drow, bp, fcol);
       if(colnr > 0) {
 	setpivcol(lp, colnr, Pcol);
 
@@ -1104,9 +1258,13 @@ static void dualloop(lprec *lp)
       DoInvert = TRUE;
     }
 
-    if(Doiter)
+    if(Doiter) {
+      varout = lp->bas[row_nr];
       iteration(lp, row_nr, colnr, &theta, lp->upbo[colnr], &minit,
 		&lp->lower[colnr], primal, Pcol);
+      if(!minit)
+	devex_update(lp, weight, row_nr, varout, Pcol);
+    }
 
     if(lp->num_inv >= lp->max_num_inv)
       DoInvert = TRUE;
@@ -1122,6 +1280,9 @@ static void dualloop(lprec *lp)
   free(drow);
   free(prow);
   free(Pcol);
+  free(weight);
+  free(bp);
+  free(fcol);
 }
 
 
@@ -1244,7 +1405,7 @@ static void construct_solution(lprec *lp)
     for(j = 1; j <= lp->columns; j++) {
       f = lp->solution[lp->rows + j];
       if(f != 0)
-	for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++)
+	for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
 	  lp->solution[lp->mat[i].row_nr] += (f / lp->scale[lp->rows+j])
 	    * (lp->mat[i].value / lp->scale[lp->mat[i].row_nr]);
     }
@@ -1273,7 +1434,7 @@ static void construct_solution(lprec *lp)
     for(j = 1; j <= lp->columns; j++) {
       f = lp->solution[lp->rows + j];
       if(f != 0)
-	for(i = lp->col_end[j - 1]; i < lp->col_end[j]; i++)
+	for(i = lp->col_beg[j]; i < lp->col_end[j]; i++)
 	  lp->solution[lp->mat[i].row_nr] += f * lp->mat[i].value;
     }
 
@@ -1426,7 +1587,7 @@ static int milpsolve(lprec *lp,
       if((theta = lp->lowbo[lp->rows + i]) != 0) {
 	if(lp->upbo[lp->rows + i] < lp->infinite)
 	  lp->upbo[lp->rows + i] -= theta;
-	for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+	for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
 	  lp->rh[lp->mat[j].row_nr] -= theta * lp->mat[j].value;
       }
     invert(lp);
@@ -1449,7 +1610,7 @@ static int milpsolve(lprec *lp,
       if((theta = lp->lowbo[lp->rows + i] != 0)) {
 	if(lp->upbo[lp->rows + i] < lp->infinite)
 	  lp->upbo[lp->rows + i] -= theta;
-	for(j = lp->col_end[i - 1]; j < lp->col_end[i]; j++)
+	for(j = lp->col_beg[i]; j < lp->col_end[i]; j++)
 	  lp->rh[lp->mat[j].row_nr] -= theta * lp->mat[j].value;
       }
     invert(lp);
@@ -1794,7 +1955,7 @@ double		theta;
 			if (lp->upbo[varnr] < lp->infinite) {
 				lp->upbo[varnr] -= theta;
 			}
-			for (j = lp->col_end[i - 1]; j < lp->col_end[i]; j++) {
+			for (j = lp->col_beg[i]; j < lp->col_end[i]; j++) {
 				lp->rh[lp->mat[j].row_nr]
 					-= theta * lp->mat[j].value;
 			}
@@ -1876,11 +2037,15 @@ short		primal;
 REAL *		drow;
 REAL *		prow;
 REAL *		Pcol;
+REAL *		weight;
+REAL *		fcol;
+struct dual_bp *	bp;
 REAL		save_lb;
 REAL		save_ub;
 short		minit;
 int		colnr;
 int		row_nr;
+int		varout;
 
 	lp -> total_iter	= 0;
 	lp -> max_level		= 1;
@@ -1903,6 +2068,13 @@ int		row_nr;
 	prow	= basp -> prow;
 	Pcol	= basp -> Pcol;
 
+	MALLOC (weight, lp -> sum + 1);
+	MALLOC (bp, lp -> sum + 1);
+	MALLOC (fcol, lp -> rows + 1);
+	for (i = 0; i <= lp -> sum; i++) {
+		weight [i] = 1;
+	}
+
 	lp -> iter = 0;
 	minit = FALSE;
 	Status = RUNNING;
@@ -1940,7 +2112,7 @@ int		row_nr;
 			}
 		}
 		/* Fix up objective function value also! */
-		for (j = lp -> col_end [var - 1]; j < lp -> col_end [var]; j++) {
+		for (j = lp -> col_beg [var]; j < lp -> col_end [var]; j++) {
 			if (lp -> mat [j].row_nr == 0) {
 				lp -> rhs [0] -= lp -> mat [j].value;
 				break;
@@ -1960,7 +2132,7 @@ int		row_nr;
 	for (i = 1; i <= lp -> columns; i++) {
 		varnr = lp -> rows + i;
 		drow [varnr] = 0;
-		for (j = lp -> col_end [i - 1]; j < lp -> col_end [i]; j++) {
+		for (j = lp -> col_beg [i]; j < lp -> col_end [i]; j++) {
 			if (drow [lp -> mat[j].row_nr] != 0) {
 				drow [varnr] +=
 					drow [lp -> mat [j].row_nr]
@@ -1985,10 +2157,10 @@ int		row_nr;
 		DoInvert = FALSE;
 
 		if (!minit) {
-			row_nr = rowdual (lp);
+			row_nr = rowdual (lp, weight);
 		}
 		if (row_nr > 0 ) {
-			colnr = coldual (lp, row_nr, minit, prow, drow);
+			colnr = coldual (lp, row_nr, minit, prow, drow, bp, fcol);
 			if (colnr > 0) {
 				setpivcol (lp, colnr, Pcol);
 				/* getting div by zero here ... MB */
@@ -2025,6 +2197,7 @@ int		row_nr;
 			DoInvert = TRUE;
 		}
 		if (Doiter) {
+			varout = lp -> bas [row_nr];
 			iteration (lp,
 				   row_nr,
 				   colnr,
@@ -2034,6 +2207,9 @@ int		row_nr;
 				   &(lp -> lower [colnr]),
 				   primal,
 				   Pcol);
+			if (!minit) {
+				devex_update (lp, weight, row_nr, varout, Pcol);
+			}
 		}
 		if (lp -> num_inv >= lp -> max_num_inv) {
 			DoInvert = TRUE;
@@ -2048,6 +2224,10 @@ int		row_nr;
 
 	lp -> total_iter += lp -> iter;
 
+	free (fcol);
+	free (bp);
+	free (weight);
+
 	construct_solution (lp);
 	memcpy (x,
 		&(lp -> solution [lp -> rows + 1]),
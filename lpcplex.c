@@ -0,0 +1,618 @@
+/***********************************************************************
+
+	$Id: lpcplex.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lpcplex.c
+	Rev:	e-3
+	Date:	10/18/2026
+
+	Copyright (c) 1996, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Operations on the main LP, implemented using CPLEX.  This code
+	has been compiled, but not yet run, against a CPLEX library.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.  Split off from constrnt.c and bb.c.
+	e-2:	10/18/2026	warme
+		: Added get_duals.
+	e-3:	10/18/2026	warme
+		: Note that this code has not been run with CPLEX.
+
+************************************************************************/
+
+#include "lpsolver.h"
+
+#ifdef CPLEX
+
+#include "fatal.h"
+#include "logic.h"
+#include <math.h>
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Local Routines
+ */
+
+static bool	cpx_add_rows (LP_t *, int, double *, char *,
+			      int *, int *, double *);
+static void	cpx_change_bounds (LP_t *, int, int *, double *, double *);
+static void	cpx_change_objective (LP_t *, struct lpmem *, int,
+				      int *, double *);
+static void	cpx_delete_rows (LP_t *, int *);
+static void	cpx_destroy (LP_t *, struct lpmem *);
+static void	cpx_free_branch_basis (struct lpbasis *);
+static void	cpx_get_basis (LP_t *, int *, int *);
+static void	cpx_get_duals (LP_t *, struct lpmem *, double *);
+static void	cpx_get_objective (LP_t *, struct lpmem *, int, double *);
+static void	cpx_save_branch_basis (LP_t *, struct lpbasis *);
+static void	cpx_set_basis (LP_t *, int *, int *);
+static void	cpx_set_cutoff (LP_t *, struct lpmem *, double);
+static void	cpx_set_scaling (bool);
+static int	cpx_solve (LP_t *, struct lpmem *, double *,
+			   double *, double *, double *);
+static double	cpx_try_branch (LP_t *, struct lpmem *, int, int,
+				double *, double, struct lpbasis *);
+
+
+/*
+ * The table of operations.  CPLEX builds the initial formulation
+ * itself (see _gst_build_initial_formulation), since it must manage
+ * the memory of the problem.
+ */
+
+const struct lpops	_gst_lpops = {
+	"CPLEX",
+	TRUE,
+	NULL,
+	cpx_destroy,
+	cpx_add_rows,
+	cpx_delete_rows,
+	cpx_change_bounds,
+	cpx_change_objective,
+	cpx_get_objective,
+	cpx_set_cutoff,
+	cpx_get_basis,
+	cpx_set_basis,
+	cpx_solve,
+	cpx_get_duals,
+	cpx_set_scaling,
+	cpx_save_branch_basis,
+	cpx_free_branch_basis,
+	cpx_try_branch,
+};
+
+/*
+ * Free up the CPLEX problem, and the memory we allocated for it.
+ */
+
+	static
+	void
+cpx_destroy (
+
+LP_t *			lp,		/* IN - LP to free */
+struct lpmem *		lpmem		/* IN - dynamically allocated mem */
+)
+{
+	/* Free up CPLEX's memory... */
+	if (_MYCPX_freeprob (&lp) NE 0) {
+		FATAL_ERROR;
+	}
+
+	/* Free up our own memory... */
+	free ((char *) (lpmem -> objx));
+	free ((char *) (lpmem -> rhsx));
+	free ((char *) (lpmem -> senx));
+	free ((char *) (lpmem -> matbeg));
+	free ((char *) (lpmem -> matcnt));
+	free ((char *) (lpmem -> matind));
+	free ((char *) (lpmem -> matval));
+	free ((char *) (lpmem -> bdl));
+	free ((char *) (lpmem -> bdu));
+	memset ((char *) lpmem, 0, sizeof (*lpmem));
+}
+
+/*
+ * Append the given rows to the LP.  Older versions of CPLEX do not
+ * grow the problem automatically, so we report when there is no room.
+ */
+
+	static
+	bool
+cpx_add_rows (
+
+LP_t *			lp,		/* IN - LP to add rows to */
+int			nrows,		/* IN - number of rows */
+double *		rhs,		/* IN - right-hand side of each row */
+char *			sense,		/* IN - sense of each row */
+int *			matbeg,		/* IN - start of each row */
+int *			matind,		/* IN - column of each coefficient */
+double *		matval		/* IN - value of each coefficient */
+)
+{
+int		ncoeff;
+
+	ncoeff = matbeg [nrows];
+
+#ifndef CPLEX_HAS_CREATEPROB
+	/* Check to see if the current CPLEX allocations are	*/
+	/* sufficient.  If not, the caller must reallocate...	*/
+	if ((_MYCPX_getnumrows (lp) + nrows > _MYCPX_getrowspace (lp)) OR
+	    (_MYCPX_getnumnz (lp) + ncoeff > _MYCPX_getnzspace (lp))) {
+		return (FALSE);
+	}
+#endif
+
+	if (_MYCPX_addrows (lp,
+			    0,
+			    nrows,
+			    ncoeff,
+			    rhs,
+			    sense,
+			    matbeg,
+			    matind,
+			    matval,
+			    NULL,
+			    NULL) NE 0) {
+		FATAL_ERROR;
+	}
+
+	return (TRUE);
+}
+
+/*
+ * Delete the flagged rows from the LP.
+ */
+
+	static
+	void
+cpx_delete_rows (
+
+LP_t *			lp,		/* IN - LP to delete rows from */
+int *			dflags		/* IN - rows to delete */
+)
+{
+	if (_MYCPX_delsetrows (lp, dflags) NE 0) {
+		FATAL_ERROR;
+	}
+}
+
+/*
+ * Change the bounds of the given variables.
+ */
+
+	static
+	void
+cpx_change_bounds (
+
+LP_t *			lp,		/* IN - LP to change bounds of */
+int			n,		/* IN - number of variables */
+int *			index,		/* IN - variables to change */
+double *		lb,		/* IN - new lower bounds */
+double *		ub		/* IN - new upper bounds */
+)
+{
+int		i;
+int		j;
+int *		b_index;
+char *		b_lu;
+double *	b_bd;
+
+	b_index	= NEWA (2 * n, int);
+	b_lu	= NEWA (2 * n, char);
+	b_bd	= NEWA (2 * n, double);
+
+	j = 0;
+	for (i = 0; i < n; i++) {
+		b_index [j]	= index [i];	/* variable i, */
+		b_lu [j]	= 'L';		/*	lower bound */
+		b_bd [j]	= lb [i];
+		b_index [j+1]	= index [i];	/* variable i, */
+		b_lu [j+1]	= 'U';		/*	upper bound */
+		b_bd [j+1]	= ub [i];
+		j += 2;
+	}
+
+	if (_MYCPX_chgbds (lp, j, b_index, b_lu, b_bd) NE 0) {
+		FATAL_ERROR;
+	}
+
+	free ((char *) b_bd);
+	free ((char *) b_lu);
+	free ((char *) b_index);
+}
+
+/*
+ * Change the objective coefficients of the given variables.  The
+ * CPLEX objective is scaled by a power of two.
+ */
+
+	static
+	void
+cpx_change_objective (
+
+LP_t *			lp,		/* IN - LP to change */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			n,		/* IN - number of variables */
+int *			index,		/* IN - variables to change */
+double *		obj		/* IN - new objective coefficients */
+)
+{
+int		i;
+double *	values;
+
+	values = NEWA (n, double);
+	for (i = 0; i < n; i++) {
+		values [i] = ldexp (obj [i], - (lpmem -> obj_scale));
+	}
+
+	if (_MYCPX_chgobj (lp, n, index, values) NE 0) {
+		FATAL_ERROR;
+	}
+
+	free ((char *) values);
+}
+
+/*
+ * Get the (unscaled) objective coefficients of the first n variables.
+ */
+
+	static
+	void
+cpx_get_objective (
+
+LP_t *			lp,		/* IN - LP to get objective of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			n,		/* IN - number of variables */
+double *		obj		/* OUT - objective coefficients */
+)
+{
+int		i;
+
+	if (_MYCPX_getobj (lp, obj, 0, n - 1) NE 0) {
+		FATAL_ERROR;
+	}
+	for (i = 0; i < n; i++) {
+		obj [i] = ldexp (obj [i], lpmem -> obj_scale);
+	}
+}
+
+/*
+ * Set the objective value beyond which LPs are cut off.
+ */
+
+	static
+	void
+cpx_set_cutoff (
+
+LP_t *			lp,		/* IN - LP to set cutoff of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double			ub		/* IN - cutoff value */
+)
+{
+double		toobig;
+double		toosmall;
+double		ulim;
+
+	(void) lp;
+
+	ulim = ldexp (ub, -(lpmem -> obj_scale));
+	if (_MYCPX_setobjulim (ulim, &toosmall, &toobig) NE 0) {
+		FATAL_ERROR;
+	}
+}
+
+/*
+ * Get the current basis.
+ */
+
+	static
+	void
+cpx_get_basis (
+
+LP_t *		lp,		/* IN - LP tableaux to get basis of */
+int *		cstat,		/* OUT - basis flags for each column */
+int *		rstat		/* OUT - basis flags for each row */
+)
+{
+	if (_MYCPX_getbase (lp, cstat, rstat) NE 0) {
+		FATAL_ERROR;
+	}
+}
+
+/*
+ * Set the current basis.
+ */
+
+	static
+	void
+cpx_set_basis (
+
+LP_t *		lp,		/* IN - LP tableaux to set basis of */
+int *		cstat,		/* IN - basis flags for each column */
+int *		rstat		/* IN - basis flags for each row */
+)
+{
+	if (_MYCPX_copybase (lp, cstat, rstat) NE 0) {
+		FATAL_ERROR;
+	}
+}
+
+/*
+ * Solve the LP, starting from the current basis.
+ */
+
+	static
+	int
+cpx_solve (
+
+LP_t *			lp,		/* IN - LP to solve */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double *		z,		/* OUT - objective value */
+double *		x,		/* OUT - LP solution variables */
+double *		dj,		/* OUT - LP reduced costs */
+double *		slack		/* OUT - LP slack variables */
+)
+{
+int		i;
+int		status;
+int		ncols;
+int		obj_scale;
+
+	/* Solve the current LP instance... */
+	status = _MYCPX_dualopt (lp);
+	if (status NE 0) {
+		fprintf (stderr, " WARNING dualopt: status = %d\n", status);
+	}
+
+	/* Get current LP solution... */
+	i = _MYCPX_solution (lp,
+			     &status,		/* solution status */
+			     z,			/* objective value */
+			     x,			/* solution variables */
+			     NULL,		/* IGNORE dual values */
+			     slack,		/* slack variables */
+			     dj);		/* reduced costs */
+	if (i NE 0) {
+		fprintf (stderr, "err_code = %d\n", i);
+		FATAL_ERROR;
+	}
+
+	obj_scale = lpmem -> obj_scale;
+	ncols	  = _MYCPX_getnumcols (lp);
+
+	if (obj_scale NE 0) {
+		/* Unscale CPLEX results. */
+		*z = ldexp (*z, obj_scale);
+		for (i = 0; i < ncols; i++) {
+			dj [i] = ldexp (dj [i], obj_scale);
+		}
+	}
+
+	/* Get solution status into solver-independent form... */
+	switch (status) {
+	case _MYCPX_STAT_OPTIMAL:
+		status = LPS_OPTIMAL;
+		break;
+
+	case _MYCPX_STAT_INFEASIBLE:
+	case _MYCPX_STAT_UNBOUNDED:	/* (CPLEX sometimes gives this for an	*/
+				/* infeasible problem.)			*/
+		status = LPS_INFEASIBLE;
+		break;
+
+	case _MYCPX_STAT_ABORT_OBJ_LIM:	/* Objective limit exceeded... */
+		status = LPS_CUTOFF;
+		break;
+
+	case _MYCPX_STAT_OPTIMAL_INFEAS:
+		status = LPS_UNSCALED_INFEAS;
+		break;
+
+	default:
+		fprintf (stderr, "Unexpected status = %d\n", status);
+		_MYCPX_lpwrite (lp, "core.lp");
+		FATAL_ERROR;
+		break;
+	}
+
+	return (status);
+}
+
+/*
+ * Enable or disable scaling.  The entire problem must be reloaded
+ * for this to take effect.
+ */
+
+	static
+	void
+cpx_set_scaling (
+
+bool		enable		/* IN - TRUE to enable scaling */
+)
+{
+int		small;
+int		big;
+
+	if (_MYCPX_setscaind (enable ? 0 : -1, &small, &big) NE 0) {
+		FATAL_ERROR;
+	}
+}
+
+/*
+ * Get the dual values of the rows, undoing the objective scaling.
+ */
+
+	static
+	void
+cpx_get_duals (
+
+LP_t *			lp,		/* IN - LP to get duals of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double *		pi		/* OUT - dual value of each row */
+)
+{
+int		i;
+int		nrows;
+int		obj_scale;
+
+	nrows = _MYCPX_getnumrows (lp);
+	if (nrows <= 0) return;
+
+	if (_MYCPX_getpi (lp, pi, 0, nrows - 1) NE 0) {
+		FATAL_ERROR;
+	}
+
+	obj_scale = lpmem -> obj_scale;
+	if (obj_scale NE 0) {
+		for (i = 0; i < nrows; i++) {
+			pi [i] = ldexp (pi [i], obj_scale);
+		}
+	}
+}
+
+/*
+ * This routine saves the current basis of the given LP.
+ */
+
+	static
+	void
+cpx_save_branch_basis (
+
+LP_t *			lp,		/* IN - LP to save basis for */
+struct lpbasis *	basp		/* OUT - saved basis info */
+)
+{
+int		rows;
+int		cols;
+
+	rows = _MYCPX_getnumrows (lp);
+	cols = _MYCPX_getnumcols (lp);
+
+	basp -> cstat	= NEWA (cols, int);
+	basp -> rstat	= NEWA (rows, int);
+	basp -> info	= NULL;
+
+	if (_MYCPX_getbase (lp, basp -> cstat, basp -> rstat) NE 0) {
+		FATAL_ERROR;
+	}
+}
+
+/*
+ * Destroy the saved basis info...
+ */
+
+	static
+	void
+cpx_free_branch_basis (
+
+struct lpbasis *	basp		/* IN - basis info to free up */
+)
+{
+	free ((char *) (basp -> rstat));
+	free ((char *) (basp -> cstat));
+
+	basp -> rstat	= NULL;
+	basp -> cstat	= NULL;
+}
+
+/*
+ * This routine tries the given branch by solving the LP.  It
+ * returns the resulting objective value, or ival if something
+ * goes wrong (like infeasible).
+ */
+
+	static
+	double
+cpx_try_branch (
+
+LP_t *			lp,		/* IN - LP to re-optimize */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			var,		/* IN - variable to try branching */
+int			dir,		/* IN - branch direction, 0 or 1 */
+double *		x,		/* OUT - LP solution obtained */
+double			ival,		/* IN - value to give if infeasible */
+struct lpbasis *	basp		/* IN - basis to restore when done */
+)
+{
+int		status;
+double		z;
+int		b_index [2];
+char		b_lu [2];
+double		b_bd [2];
+
+	b_index [0] = var;	b_lu [0] = 'L';
+	b_index [1] = var;	b_lu [1] = 'U';
+	if (dir EQ 0) {
+		b_bd [0] = 0.0;
+		b_bd [1] = 0.0;
+	}
+	else {
+		b_bd [0] = 1.0;
+		b_bd [1] = 1.0;
+	}
+	if (_MYCPX_chgbds (lp, 2, b_index, b_lu, b_bd) NE 0) {
+		FATAL_ERROR;
+	}
+
+	/* Solve the current LP instance... */
+	status = _MYCPX_dualopt (lp);
+	if (status NE 0) {
+		fprintf (stderr, " WARNING dualopt: status = %d\n", status);
+	}
+
+	/* Get current LP solution... */
+	if (_MYCPX_solution (lp, &status, &z, x, NULL, NULL, NULL) NE 0) {
+		FATAL_ERROR;
+	}
+
+	/* Determine type of LP result... */
+	switch (status) {
+	case _MYCPX_STAT_OPTIMAL:
+	case _MYCPX_STAT_OPTIMAL_INFEAS:
+		/* Unscale the objective value. */
+		z = ldexp (z, lpmem -> obj_scale);
+		break;
+
+	case _MYCPX_STAT_INFEASIBLE:
+	case _MYCPX_STAT_UNBOUNDED:
+			/* (CPLEX 3.0 sometimes gives us infeasible!) */
+	case _MYCPX_STAT_ABORT_OBJ_LIM:	/* Objective limit exceeded. */
+		z = ival;
+		break;
+
+	default:
+		fprintf (stderr, "Status = %d\n", status);
+		_MYCPX_lpwrite (lp, "core.lp");
+		FATAL_ERROR;
+		break;
+	}
+
+	b_bd [0] = 0.0;
+	b_bd [1] = 1.0;
+	if (_MYCPX_chgbds (lp, 2, b_index, b_lu, b_bd) NE 0) {
+		FATAL_ERROR;
+	}
+
+	/* Restore the basis... */
+	status = _MYCPX_copybase (lp, basp -> cstat, basp -> rstat);
+	if (status NE 0) {
+		fprintf (stderr, "try_branch: status = %d\n", status);
+		FATAL_ERROR;
+	}
+
+	return (z);
+}
+
+#endif
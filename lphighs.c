@@ -0,0 +1,702 @@
+/***********************************************************************
+
+	$Id: lphighs.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lphighs.c
+	Rev:	e-3
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Operations on the main LP, implemented using HiGHS.  Tested
+	with HiGHS 1.12.0 (32-bit HighsInt).
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+	e-2:	10/18/2026	warme
+		: Added get_duals.
+	e-3:	10/18/2026	warme
+		: Note the HiGHS version tested.
+
+************************************************************************/
+
+#include "lpsolver.h"
+
+#ifdef HIGHS
+
+#include "fatal.h"
+#include "logic.h"
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Local Routines
+ */
+
+static bool	hs_add_rows (LP_t *, int, double *, char *,
+			     int *, int *, double *);
+static void	hs_change_bounds (LP_t *, int, int *, double *, double *);
+static void	hs_change_objective (LP_t *, struct lpmem *, int,
+				     int *, double *);
+static void	hs_delete_rows (LP_t *, int *);
+static void	hs_destroy (LP_t *, struct lpmem *);
+static void	hs_free_branch_basis (struct lpbasis *);
+static void	hs_get_basis (LP_t *, int *, int *);
+static void	hs_get_duals (LP_t *, struct lpmem *, double *);
+static void	hs_get_objective (LP_t *, struct lpmem *, int, double *);
+static LP_t *	hs_load (int, double *, double *, double *,
+			 int, double *, char *, int *, int *, double *,
+			 struct lpmem *, struct gst_param *);
+static void	hs_row_bounds (LP_t *, int, double *, char *,
+			       double *, double *);
+static void	hs_save_branch_basis (LP_t *, struct lpbasis *);
+static void	hs_set_basis (LP_t *, int *, int *);
+static void	hs_set_cutoff (LP_t *, struct lpmem *, double);
+static int	hs_solve (LP_t *, struct lpmem *, double *,
+			  double *, double *, double *);
+static double	hs_try_branch (LP_t *, struct lpmem *, int, int,
+			       double *, double, struct lpbasis *);
+static HighsInt * to_highs_ints (int *, int);
+
+
+/*
+ * The table of operations.
+ */
+
+const struct lpops	_gst_lpops = {
+	"HiGHS",
+	TRUE,
+	hs_load,
+	hs_destroy,
+	hs_add_rows,
+	hs_delete_rows,
+	hs_change_bounds,
+	hs_change_objective,
+	hs_get_objective,
+	hs_set_cutoff,
+	hs_get_basis,
+	hs_set_basis,
+	hs_solve,
+	hs_get_duals,
+	NULL,
+	hs_save_branch_basis,
+	hs_free_branch_basis,
+	hs_try_branch,
+};
+
+/*
+ * Create an LP having the given columns and rows.  We always
+ * re-optimize using the dual simplex method, without presolve, so
+ * that each solve starts from the basis of the previous one.
+ */
+
+	static
+	LP_t *
+hs_load (
+
+int			ncols,		/* IN - number of columns */
+double *		obj,		/* IN - objective coefficients */
+double *		lb,		/* IN - lower bound of each column */
+double *		ub,		/* IN - upper bound of each column */
+int			nrows,		/* IN - number of rows */
+double *		rhs,		/* IN - right-hand side of each row */
+char *			sense,		/* IN - sense of each row */
+int *			matbeg,		/* IN - start of each row */
+int *			matind,		/* IN - column of each coefficient */
+double *		matval,		/* IN - value of each coefficient */
+struct lpmem *		lpmem,		/* OUT - dynamically allocated mem */
+struct gst_param *	params		/* IN - parameters */
+)
+{
+HighsInt	status;
+LP_t *		lp;
+double *	rlo;
+double *	rhi;
+HighsInt *	start;
+HighsInt *	index;
+
+	(void) lpmem;
+	(void) params;
+
+	lp = Highs_create ();
+	FATAL_ERROR_IF (lp EQ NULL);
+
+	Highs_setBoolOptionValue (lp, "output_flag", 0);
+	Highs_setStringOptionValue (lp, "presolve", "off");
+	Highs_setStringOptionValue (lp, "solver", "simplex");
+	Highs_setIntOptionValue (lp, "simplex_strategy", 1);	/* dual */
+
+	rlo	= NEWA (nrows + 1, double);
+	rhi	= NEWA (nrows + 1, double);
+	hs_row_bounds (lp, nrows, rhs, sense, rlo, rhi);
+
+	start	= to_highs_ints (matbeg, nrows + 1);
+	index	= to_highs_ints (matind, matbeg [nrows]);
+
+	status = Highs_passLp (lp,
+			       ncols,
+			       nrows,
+			       matbeg [nrows],
+			       kHighsMatrixFormatRowwise,
+			       kHighsObjSenseMinimize,
+			       0.0,
+			       obj,
+			       lb,
+			       ub,
+			       rlo,
+			       rhi,
+			       start,
+			       index,
+			       matval);
+	FATAL_ERROR_IF (status EQ kHighsStatusError);
+
+	free ((char *) index);
+	free ((char *) start);
+	free ((char *) rhi);
+	free ((char *) rlo);
+
+	return (lp);
+}
+
+/*
+ * Free up the LP.
+ */
+
+	static
+	void
+hs_destroy (
+
+LP_t *			lp,		/* IN - LP to free */
+struct lpmem *		lpmem		/* IN - dynamically allocated mem */
+)
+{
+	(void) lpmem;
+
+	Highs_destroy (lp);
+}
+
+/*
+ * Append the given rows to the LP.  HiGHS always has room.
+ */
+
+	static
+	bool
+hs_add_rows (
+
+LP_t *			lp,		/* IN - LP to add rows to */
+int			nrows,		/* IN - number of rows */
+double *		rhs,		/* IN - right-hand side of each row */
+char *			sense,		/* IN - sense of each row */
+int *			matbeg,		/* IN - start of each row */
+int *			matind,		/* IN - column of each coefficient */
+double *		matval		/* IN - value of each coefficient */
+)
+{
+HighsInt	status;
+double *	rlo;
+double *	rhi;
+HighsInt *	start;
+HighsInt *	index;
+
+	rlo	= NEWA (nrows, double);
+	rhi	= NEWA (nrows, double);
+	hs_row_bounds (lp, nrows, rhs, sense, rlo, rhi);
+
+	start	= to_highs_ints (matbeg, nrows);
+	index	= to_highs_ints (matind, matbeg [nrows]);
+
+	status = Highs_addRows (lp,
+				nrows,
+				rlo,
+				rhi,
+				matbeg [nrows],
+				start,
+				index,
+				matval);
+	FATAL_ERROR_IF (status EQ kHighsStatusError);
+
+	free ((char *) index);
+	free ((char *) start);
+	free ((char *) rhi);
+	free ((char *) rlo);
+
+	return (TRUE);
+}
+
+/*
+ * Delete the flagged rows from the LP.
+ */
+
+	static
+	void
+hs_delete_rows (
+
+LP_t *			lp,		/* IN - LP to delete rows from */
+int *			dflags		/* IN - rows to delete */
+)
+{
+HighsInt *	mask;
+
+	mask = to_highs_ints (dflags, GET_LP_NUM_ROWS (lp));
+
+	if (Highs_deleteRowsByMask (lp, mask) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	free ((char *) mask);
+}
+
+/*
+ * Change the bounds of the given variables.
+ */
+
+	static
+	void
+hs_change_bounds (
+
+LP_t *			lp,		/* IN - LP to change bounds of */
+int			n,		/* IN - number of variables */
+int *			index,		/* IN - variables to change */
+double *		lb,		/* IN - new lower bounds */
+double *		ub		/* IN - new upper bounds */
+)
+{
+int		i;
+
+	for (i = 0; i < n; i++) {
+		if (Highs_changeColBounds (lp, index [i], lb [i], ub [i])
+		    EQ kHighsStatusError) {
+			FATAL_ERROR;
+		}
+	}
+}
+
+/*
+ * Change the objective coefficients of the given variables.
+ */
+
+	static
+	void
+hs_change_objective (
+
+LP_t *			lp,		/* IN - LP to change */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			n,		/* IN - number of variables */
+int *			index,		/* IN - variables to change */
+double *		obj		/* IN - new objective coefficients */
+)
+{
+int		i;
+
+	(void) lpmem;
+
+	for (i = 0; i < n; i++) {
+		if (Highs_changeColCost (lp, index [i], obj [i])
+		    EQ kHighsStatusError) {
+			FATAL_ERROR;
+		}
+	}
+}
+
+/*
+ * Get the objective coefficients of the first n variables.
+ */
+
+	static
+	void
+hs_get_objective (
+
+LP_t *			lp,		/* IN - LP to get objective of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			n,		/* IN - number of variables */
+double *		obj		/* OUT - objective coefficients */
+)
+{
+HighsInt	num_col;
+HighsInt	num_nz;
+double *	lower;
+double *	upper;
+
+	(void) lpmem;
+
+	if (n <= 0) return;
+
+	lower	= NEWA (n, double);
+	upper	= NEWA (n, double);
+
+	/* The column coefficients themselves are not wanted. */
+	if (Highs_getColsByRange (lp, 0, n - 1,
+				  &num_col, obj, lower, upper,
+				  &num_nz, NULL, NULL, NULL)
+	    EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	free ((char *) upper);
+	free ((char *) lower);
+}
+
+/*
+ * Set the objective value beyond which LPs are cut off.  (The dual
+ * simplex method stops once the objective exceeds this bound.)
+ */
+
+	static
+	void
+hs_set_cutoff (
+
+LP_t *			lp,		/* IN - LP to set cutoff of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double			ub		/* IN - cutoff value */
+)
+{
+	(void) lpmem;
+
+	Highs_setDoubleOptionValue (lp, "objective_bound", ub);
+}
+
+/*
+ * Get the current basis.
+ */
+
+	static
+	void
+hs_get_basis (
+
+LP_t *		lp,		/* IN - LP tableaux to get basis of */
+int *		cstat,		/* OUT - basis flags for each column */
+int *		rstat		/* OUT - basis flags for each row */
+)
+{
+int		i;
+int		ncols;
+int		nrows;
+HighsInt *	hcstat;
+HighsInt *	hrstat;
+
+	ncols = GET_LP_NUM_COLS (lp);
+	nrows = GET_LP_NUM_ROWS (lp);
+
+	hcstat = NEWA (ncols + 1, HighsInt);
+	hrstat = NEWA (nrows + 1, HighsInt);
+
+	if (Highs_getBasis (lp, hcstat, hrstat) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+	for (i = 0; i < ncols; i++) {
+		cstat [i] = hcstat [i];
+	}
+	for (i = 0; i < nrows; i++) {
+		rstat [i] = hrstat [i];
+	}
+
+	free ((char *) hrstat);
+	free ((char *) hcstat);
+}
+
+/*
+ * Set the current basis.
+ */
+
+	static
+	void
+hs_set_basis (
+
+LP_t *		lp,		/* IN - LP tableaux to set basis of */
+int *		cstat,		/* IN - basis flags for each column */
+int *		rstat		/* IN - basis flags for each row */
+)
+{
+HighsInt *	hcstat;
+HighsInt *	hrstat;
+
+	hcstat = to_highs_ints (cstat, GET_LP_NUM_COLS (lp));
+	hrstat = to_highs_ints (rstat, GET_LP_NUM_ROWS (lp));
+
+	if (Highs_setBasis (lp, hcstat, hrstat) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	free ((char *) hrstat);
+	free ((char *) hcstat);
+}
+
+/*
+ * Solve the LP, starting from the current basis.  The slack of each
+ * row is the distance from its activity to its (finite) bound.
+ */
+
+	static
+	int
+hs_solve (
+
+LP_t *			lp,		/* IN - LP to solve */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double *		z,		/* OUT - objective value */
+double *		x,		/* OUT - LP solution variables */
+double *		dj,		/* OUT - LP reduced costs */
+double *		slack		/* OUT - LP slack variables */
+)
+{
+int		i;
+int		nrows;
+HighsInt	status;
+HighsInt	num_row;
+HighsInt	num_nz;
+double		inf;
+double		s1;
+double		s2;
+double *	act;
+double *	dual;
+double *	rlo;
+double *	rhi;
+
+	(void) lpmem;
+
+	nrows = GET_LP_NUM_ROWS (lp);
+
+	if (Highs_run (lp) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	status = Highs_getModelStatus (lp);
+
+	*z = Highs_getObjectiveValue (lp);
+
+	act	= NEWA (nrows + 1, double);
+	dual	= NEWA (nrows + 1, double);
+	rlo	= NEWA (nrows + 1, double);
+	rhi	= NEWA (nrows + 1, double);
+
+	Highs_getSolution (lp, x, dj, act, dual);
+
+	if (nrows > 0) {
+		if (Highs_getRowsByRange (lp, 0, nrows - 1,
+					  &num_row, rlo, rhi,
+					  &num_nz, NULL, NULL, NULL)
+		    EQ kHighsStatusError) {
+			FATAL_ERROR;
+		}
+	}
+
+	inf = Highs_getInfinity (lp);
+	for (i = 0; i < nrows; i++) {
+		s1 = (rhi [i] < inf) ? rhi [i] - act [i] : inf;
+		s2 = (rlo [i] > -inf) ? act [i] - rlo [i] : inf;
+		slack [i] = (s1 < s2) ? s1 : s2;
+	}
+
+	free ((char *) rhi);
+	free ((char *) rlo);
+	free ((char *) dual);
+	free ((char *) act);
+
+	/* Get solution status into solver-independent form.  (The	*/
+	/* HiGHS status codes are const variables, not enumerators,	*/
+	/* so they cannot be used as case labels.)			*/
+	if (status EQ kHighsModelStatusOptimal) {
+		return (LPS_OPTIMAL);
+	}
+	if ((status EQ kHighsModelStatusInfeasible) OR
+	    (status EQ kHighsModelStatusUnboundedOrInfeasible)) {
+		return (LPS_INFEASIBLE);
+	}
+	if (status EQ kHighsModelStatusUnbounded) {
+		return (LPS_UNBOUNDED);
+	}
+	if (status EQ kHighsModelStatusObjectiveBound) {
+		return (LPS_CUTOFF);
+	}
+
+	fprintf (stderr, "HiGHS model status = %d\n", (int) status);
+	FATAL_ERROR;
+
+	return (LPS_INFEASIBLE);
+}
+
+/*
+ * Get the dual values of the rows.
+ */
+
+	static
+	void
+hs_get_duals (
+
+LP_t *			lp,		/* IN - LP to get duals of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double *		pi		/* OUT - dual value of each row */
+)
+{
+	(void) lpmem;
+
+	Highs_getSolution (lp, NULL, NULL, NULL, pi);
+}
+
+/*
+ * Snapshot the current (optimal) basis so that hs_try_branch can
+ * quickly get back to it each time.
+ */
+
+	static
+	void
+hs_save_branch_basis (
+
+LP_t *			lp,		/* IN - LP to save basis for */
+struct lpbasis *	basp		/* OUT - saved basis info */
+)
+{
+	basp -> cstat	= NEWA (GET_LP_NUM_COLS (lp) + 1, int);
+	basp -> rstat	= NEWA (GET_LP_NUM_ROWS (lp) + 1, int);
+	basp -> info	= NULL;
+
+	hs_get_basis (lp, basp -> cstat, basp -> rstat);
+}
+
+/*
+ * Destroy the saved basis info...
+ */
+
+	static
+	void
+hs_free_branch_basis (
+
+struct lpbasis *	basp		/* IN - basis info to free up */
+)
+{
+	free ((char *) (basp -> rstat));
+	free ((char *) (basp -> cstat));
+
+	basp -> rstat	= NULL;
+	basp -> cstat	= NULL;
+}
+
+/*
+ * This routine tries the given branch by solving the LP.  It
+ * returns the resulting objective value, or ival if the branch is
+ * infeasible or cut off.
+ */
+
+	static
+	double
+hs_try_branch (
+
+LP_t *			lp,		/* IN - LP to re-optimize */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			var,		/* IN - variable to try branching */
+int			dir,		/* IN - branch direction, 0 or 1 */
+double *		x,		/* OUT - LP solution obtained */
+double			ival,		/* IN - value to give if infeasible */
+struct lpbasis *	basp		/* IN - basis to restore when done */
+)
+{
+double		z;
+double		bd;
+HighsInt	status;
+
+	(void) lpmem;
+
+	bd = (dir EQ 0) ? 0.0 : 1.0;
+	if (Highs_changeColBounds (lp, var, bd, bd) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	if (Highs_run (lp) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	status = Highs_getModelStatus (lp);
+	if (status EQ kHighsModelStatusOptimal) {
+		z = Highs_getObjectiveValue (lp);
+		Highs_getSolution (lp, x, NULL, NULL, NULL);
+	}
+	else if ((status EQ kHighsModelStatusInfeasible) OR
+		 (status EQ kHighsModelStatusUnboundedOrInfeasible) OR
+		 (status EQ kHighsModelStatusUnbounded) OR
+		 (status EQ kHighsModelStatusObjectiveBound)) {
+		z = ival;
+	}
+	else {
+		fprintf (stderr, "HiGHS model status = %d\n", (int) status);
+		FATAL_ERROR;
+		z = ival;
+	}
+
+	if (Highs_changeColBounds (lp, var, 0.0, 1.0) EQ kHighsStatusError) {
+		FATAL_ERROR;
+	}
+
+	/* Restore the basis... */
+	hs_set_basis (lp, basp -> cstat, basp -> rstat);
+
+	return (z);
+}
+
+/*
+ * Convert the sense and right-hand side of each row into the lower
+ * and upper bounds that HiGHS wants.
+ */
+
+	static
+	void
+hs_row_bounds (
+
+LP_t *			lp,		/* IN - HiGHS instance */
+int			nrows,		/* IN - number of rows */
+double *		rhs,		/* IN - right-hand side of each row */
+char *			sense,		/* IN - sense of each row */
+double *		rlo,		/* OUT - lower bound of each row */
+double *		rhi		/* OUT - upper bound of each row */
+)
+{
+int		i;
+double		inf;
+
+	inf = Highs_getInfinity (lp);
+
+	for (i = 0; i < nrows; i++) {
+		switch (sense [i]) {
+		case 'L':	rlo [i] = -inf;		rhi [i] = rhs [i];	break;
+		case 'E':	rlo [i] = rhs [i];	rhi [i] = rhs [i];	break;
+		case 'G':	rlo [i] = rhs [i];	rhi [i] = inf;		break;
+		default:
+			FATAL_ERROR;
+			break;
+		}
+	}
+}
+
+/*
+ * Copy an array of ints into a newly allocated array of HighsInt.
+ */
+
+	static
+	HighsInt *
+to_highs_ints (
+
+int *		p,		/* IN - array to copy */
+int		n		/* IN - number of elements */
+)
+{
+int		i;
+HighsInt *	hp;
+
+	hp = NEWA (n + 1, HighsInt);
+	for (i = 0; i < n; i++) {
+		hp [i] = p [i];
+	}
+
+	return (hp);
+}
+
+#endif
@@ -0,0 +1,565 @@
+/***********************************************************************
+
+	$Id: lplpsolve.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lplpsolve.c
+	Rev:	e-2
+	Date:	10/18/2026
+
+	Copyright (c) 1996, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Operations on the main LP, implemented using lp_solve.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.  Split off from constrnt.c and bb.c.
+	e-2:	10/18/2026	warme
+		: Added get_duals.
+
+************************************************************************/
+
+#include "lpsolver.h"
+
+#ifdef LPSOLVE
+
+#include "fatal.h"
+#include "logic.h"
+#include "memory.h"
+#include "parmblk.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Local Routines
+ */
+
+static bool	lps_add_rows (LP_t *, int, double *, char *,
+			      int *, int *, double *);
+static void	lps_change_bounds (LP_t *, int, int *, double *, double *);
+static void	lps_change_objective (LP_t *, struct lpmem *, int,
+				      int *, double *);
+static void	lps_delete_rows (LP_t *, int *);
+static void	lps_destroy (LP_t *, struct lpmem *);
+static void	lps_free_branch_basis (struct lpbasis *);
+static void	lps_get_basis (LP_t *, int *, int *);
+static void	lps_get_duals (LP_t *, struct lpmem *, double *);
+static void	lps_get_objective (LP_t *, struct lpmem *, int, double *);
+static LP_t *	lps_load (int, double *, double *, double *,
+			  int, double *, char *, int *, int *, double *,
+			  struct lpmem *, struct gst_param *);
+static void	lps_save_branch_basis (LP_t *, struct lpbasis *);
+static void	lps_set_basis (LP_t *, int *, int *);
+static void	lps_set_cutoff (LP_t *, struct lpmem *, double);
+static int	lps_solve (LP_t *, struct lpmem *, double *,
+			   double *, double *, double *);
+static double	lps_try_branch (LP_t *, struct lpmem *, int, int,
+				double *, double, struct lpbasis *);
+
+
+/*
+ * The table of operations.  Deleting rows from an lp_solve LP
+ * always invalidates the basis.
+ */
+
+const struct lpops	_gst_lpops = {
+	"lp_solve",
+	FALSE,
+	lps_load,
+	lps_destroy,
+	lps_add_rows,
+	lps_delete_rows,
+	lps_change_bounds,
+	lps_change_objective,
+	lps_get_objective,
+	lps_set_cutoff,
+	lps_get_basis,
+	lps_set_basis,
+	lps_solve,
+	lps_get_duals,
+	NULL,
+	lps_save_branch_basis,
+	lps_free_branch_basis,
+	lps_try_branch,
+};
+
+/*
+ * Create an LP having the given columns and rows.  All variables are
+ * minimized.
+ */
+
+	static
+	LP_t *
+lps_load (
+
+int			ncols,		/* IN - number of columns */
+double *		obj,		/* IN - objective coefficients */
+double *		lb,		/* IN - lower bound of each column */
+double *		ub,		/* IN - upper bound of each column */
+int			nrows,		/* IN - number of rows */
+double *		rhs,		/* IN - right-hand side of each row */
+char *			sense,		/* IN - sense of each row */
+int *			matbeg,		/* IN - start of each row */
+int *			matind,		/* IN - column of each coefficient */
+double *		matval,		/* IN - value of each coefficient */
+struct lpmem *		lpmem,		/* OUT - dynamically allocated mem */
+struct gst_param *	params		/* IN - parameters */
+)
+{
+int		i;
+LP_t *		lp;
+double *	rowvec;
+
+	(void) lpmem;
+
+	lp = make_lp (0, ncols);
+
+	/* Set MIP gap tolerance (epsilon) - controls integrality tolerance */
+	lp -> epsilon = 0.00001;
+
+	for (i = 0; i < ncols; i++) {
+		set_bounds (lp, i + 1, lb [i], ub [i]);
+	}
+
+	set_minim (lp);
+
+	rowvec = NEWA (ncols + 1, double);
+	rowvec [0] = 0.0;
+	memcpy (&rowvec [1], obj, ncols * sizeof (double));
+
+	inc_mat_space (lp, ncols + 1);
+	set_obj_fn (lp, rowvec);
+
+	free ((char *) rowvec);
+
+	(void) lps_add_rows (lp, nrows, rhs, sense, matbeg, matind, matval);
+
+	if (params -> lp_solve_perturb) {
+		/* Turn on perturbations to deal with degeneracy... */
+		lp -> anti_degen = TRUE;
+	}
+	if (params -> lp_solve_scale) {
+		/* Turn on auto-scaling of the matrix... */
+		auto_scale (lp);
+	}
+
+	return (lp);
+}
+
+/*
+ * Free up the LP.
+ */
+
+	static
+	void
+lps_destroy (
+
+LP_t *			lp,		/* IN - LP to free */
+struct lpmem *		lpmem		/* IN - dynamically allocated mem */
+)
+{
+	(void) lpmem;
+
+	delete_lp (lp);
+}
+
+/*
+ * Append the given rows to the LP.
+ */
+
+	static
+	bool
+lps_add_rows (
+
+LP_t *			lp,		/* IN - LP to add rows to */
+int			nrows,		/* IN - number of rows */
+double *		rhs,		/* IN - right-hand side of each row */
+char *			sense,		/* IN - sense of each row */
+int *			matbeg,		/* IN - start of each row */
+int *			matind,		/* IN - column of each coefficient */
+double *		matval		/* IN - value of each coefficient */
+)
+{
+int		i;
+short *		ctype;
+
+	ctype = NEWA (nrows, short);
+	for (i = 0; i < nrows; i++) {
+		switch (sense [i]) {
+		case 'L':	ctype [i] = REL_LE;	break;
+		case 'E':	ctype [i] = REL_EQ;	break;
+		case 'G':	ctype [i] = REL_GE;	break;
+		default:
+			FATAL_ERROR;
+			break;
+		}
+	}
+
+	add_rows (lp, 0, nrows, rhs, ctype, matbeg, matind, matval);
+
+	free ((char *) ctype);
+
+	return (TRUE);
+}
+
+/*
+ * Delete the flagged rows from the LP.  (lp_solve expects one flag
+ * per row, plus one for the objective row.)
+ */
+
+	static
+	void
+lps_delete_rows (
+
+LP_t *			lp,		/* IN - LP to delete rows from */
+int *			dflags		/* IN - rows to delete */
+)
+{
+int		i;
+int		n;
+int *		rowflags;
+
+	n = lp -> rows;
+
+	rowflags = NEWA (n + 1, int);
+	rowflags [0] = 0;	/* keep the objective row! */
+	for (i = 0; i < n; i++) {
+		rowflags [i + 1] = dflags [i];
+	}
+	delete_row_set (lp, rowflags);
+
+	free ((char *) rowflags);
+}
+
+/*
+ * Change the bounds of the given variables.
+ */
+
+	static
+	void
+lps_change_bounds (
+
+LP_t *			lp,		/* IN - LP to change bounds of */
+int			n,		/* IN - number of variables */
+int *			index,		/* IN - variables to change */
+double *		lb,		/* IN - new lower bounds */
+double *		ub		/* IN - new upper bounds */
+)
+{
+int		i;
+
+	for (i = 0; i < n; i++) {
+		set_bounds (lp, index [i] + 1, lb [i], ub [i]);
+	}
+}
+
+/*
+ * Change the objective coefficients of the given variables.
+ */
+
+	static
+	void
+lps_change_objective (
+
+LP_t *			lp,		/* IN - LP to change */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			n,		/* IN - number of variables */
+int *			index,		/* IN - variables to change */
+double *		obj		/* IN - new objective coefficients */
+)
+{
+int		i;
+
+	(void) lpmem;
+
+	for (i = 0; i < n; i++) {
+		set_mat (lp, 0, index [i] + 1, obj [i]);
+	}
+}
+
+/*
+ * Get the objective coefficients of the first n variables.
+ */
+
+	static
+	void
+lps_get_objective (
+
+LP_t *			lp,		/* IN - LP to get objective of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			n,		/* IN - number of variables */
+double *		obj		/* OUT - objective coefficients */
+)
+{
+double *	C;
+
+	(void) lpmem;
+
+	C = NEWA (lp -> columns + 1, double);
+	get_row (lp, 0, C);
+	memcpy (obj, &C [1], n * sizeof (double));
+	free ((char *) C);
+}
+
+/*
+ * Set the objective value beyond which LPs are cut off.  (This may
+ * not really work in lp_solve.)
+ */
+
+	static
+	void
+lps_set_cutoff (
+
+LP_t *			lp,		/* IN - LP to set cutoff of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double			ub		/* IN - cutoff value */
+)
+{
+	(void) lpmem;
+
+	lp -> obj_bound = ub;
+}
+
+/*
+ * This routine retrieves the current basis under lp_solve, which records
+ * the basis differently than CPLEX.  We use the "cstat" array to hold
+ * the column upper/lower bound flags of the non-basic columns, and in
+ * "rstat" we indicate which column is the basic variable for that row
+ * (including slack variable columns).
+ */
+
+	static
+	void
+lps_get_basis (
+
+LP_t *		lp,		/* IN - LP tableaux to get basis of */
+int *		cstat,		/* OUT - basis flags for each column */
+int *		rstat		/* OUT - basis flags for each row */
+)
+{
+int		i;
+int		j;
+
+	if (NOT (lp -> basis_valid)) {
+		/* Scribble out the default starting basis. */
+		for (i = 0; i < lp -> rows; i++) {
+			rstat [i] = i + 1;
+		}
+		for (i = 0; i < lp -> columns; i++) {
+			cstat [i] = 1;
+		}
+		return;
+	}
+
+	/* Set the row status flags... */
+	for (i = 0; i < lp -> rows; i++) {
+		rstat [i] = lp -> bas [i + 1];
+	}
+
+	/* Set the column status flags... */
+	j = 0;
+	for (i = 1; i <= lp -> sum; i++) {
+		if (lp -> basis [i]) continue;
+		cstat [j] = lp -> lower [i];
+		++j;
+	}
+}
+
+/*
+ * This routine sets the current basis under lp_solve, which records
+ * the basis differently than CPLEX.  We use the "cstat" array to hold
+ * the column upper/lower bound flags, and in "rstat" we indicate which
+ * column is the basic variable for that row (including slack variable
+ * columns).
+ */
+
+	static
+	void
+lps_set_basis (
+
+LP_t *		lp,		/* IN - LP tableaux to set basis of */
+int *		cstat,		/* IN - basis flags for each column */
+int *		rstat		/* IN - basis flags for each row */
+)
+{
+int		i;
+int		j;
+
+	for (i = 1; i <= lp -> sum; i++) {
+		lp -> basis [i] = 0;
+		lp -> lower [i] = 1;
+	}
+
+	/* Set the row status flags... */
+	for (i = 0; i < lp -> rows; i++) {
+		j = rstat [i];
+		lp -> bas [i + 1] = j;
+		lp -> basis [j] = 1;
+	}
+
+	/* Set the column status flags... */
+	j = 0;
+	for (i = 1; i <= lp -> sum; i++) {
+		if (lp -> basis [i]) continue;
+		lp -> lower [i] = cstat [j];
+		++j;
+	}
+
+	lp -> basis_valid = TRUE;
+	lp -> eta_valid = FALSE;
+}
+
+/*
+ * Solve the LP, starting from the current basis.
+ */
+
+	static
+	int
+lps_solve (
+
+LP_t *			lp,		/* IN - LP to solve */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double *		z,		/* OUT - objective value */
+double *		x,		/* OUT - LP solution variables */
+double *		dj,		/* OUT - LP reduced costs */
+double *		slack		/* OUT - LP slack variables */
+)
+{
+int		status;
+double *	buf;
+
+	(void) lpmem;
+
+	status = solve (lp);
+
+	/* Get current LP solution... */
+	*z = lp -> best_solution [0];
+	memcpy (x,
+		&(lp -> best_solution [lp -> rows + 1]),
+		lp -> columns * sizeof (double));
+
+	/* Get solution status into solver-independent form... */
+	switch (status) {
+	case OPTIMAL:		status = LPS_OPTIMAL;		break;
+	case MILP_FAIL:		status = LPS_CUTOFF;		break;
+	case INFEASIBLE:	status = LPS_INFEASIBLE;	break;
+	case UNBOUNDED:		status = LPS_UNBOUNDED;		break;
+	default:
+		fprintf (stderr, "solve status = %d\n", status);
+		FATAL_ERROR;
+		break;
+	}
+
+	/* Grab the reduced costs... */
+	buf = NEWA (lp -> sum + 1, double);
+	get_reduced_costs (lp, buf);
+	memcpy (dj, &buf [lp -> rows + 1], lp -> columns * sizeof (double));
+
+	/* Grab the values of the slack variables... */
+	get_slack_vars (lp, buf);
+	memcpy (slack, &buf [1], lp -> rows * sizeof (double));
+	free ((char *) buf);
+
+	return (status);
+}
+
+/*
+ * Get the dual values of the rows.  lp_solve computes them each time
+ * it finds an optimal solution.
+ */
+
+	static
+	void
+lps_get_duals (
+
+LP_t *			lp,		/* IN - LP to get duals of */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+double *		pi		/* OUT - dual value of each row */
+)
+{
+	(void) lpmem;
+
+	memcpy (pi, &(lp -> duals [1]), lp -> rows * sizeof (double));
+}
+
+/*
+ * Snapshot the current (optimal) basis so that lps_try_branch can
+ * quickly get back to it each time.
+ */
+
+	static
+	void
+lps_save_branch_basis (
+
+LP_t *			lp,		/* IN - LP to save basis for */
+struct lpbasis *	basp		/* OUT - saved basis info */
+)
+{
+struct basis_save *	bsp;
+
+	bsp = NEW (struct basis_save);
+	save_LP_basis (lp, bsp);
+
+	basp -> cstat	= NULL;
+	basp -> rstat	= NULL;
+	basp -> info	= bsp;
+}
+
+/*
+ * Destroy the saved basis info...
+ */
+
+	static
+	void
+lps_free_branch_basis (
+
+struct lpbasis *	basp		/* IN - basis info to free up */
+)
+{
+struct basis_save *	bsp;
+
+	bsp = (struct basis_save *) (basp -> info);
+	destroy_LP_basis (bsp);
+	free ((char *) bsp);
+
+	basp -> info = NULL;
+}
+
+/*
+ * Give a prospective branch variable a "test run".  This uses the
+ * special code in lp_solve that never reinverts, so the solution it
+ * gives need not be primal feasible.
+ */
+
+	static
+	double
+lps_try_branch (
+
+LP_t *			lp,		/* IN - LP to re-optimize */
+struct lpmem *		lpmem,		/* IN - dynamically allocated mem */
+int			var,		/* IN - variable to try branching */
+int			dir,		/* IN - branch direction, 0 or 1 */
+double *		x,		/* OUT - LP solution obtained */
+double			ival,		/* IN - value to give if infeasible */
+struct lpbasis *	basp		/* IN - basis to restore when done */
+)
+{
+	(void) lpmem;
+
+	return (try_branch (lp,
+			    var + 1,
+			    dir,
+			    x,
+			    ival,
+			    (struct basis_save *) (basp -> info)));
+}
+
+#endif
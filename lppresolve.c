@@ -0,0 +1,631 @@
+/***********************************************************************
+
+	$Id: lppresolve.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lppresolve.c
+	Rev:	e-1
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Presolve of the initial LP formulation.
+
+	The rows of the initial formulation are pending rows of the
+	constraint pool.  Presolve leaves out of the initial LP those
+	pending rows that are redundant, that merely fix a variable, or
+	that are dominated by another pending row.  Such rows remain in
+	the pool (marked as not in the LP), so that the usual scan of
+	the pool for violations appends any of them that are ever
+	violated.  The lprows mapping between LP rows and pool rows
+	therefore remains exact, and nothing needs to be undone after
+	the LP is solved.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+
+************************************************************************/
+
+#include "lppresolve.h"
+
+#include "channels.h"
+#include "constrnt.h"
+#include "cputime.h"
+#include "fatal.h"
+#include "logic.h"
+#include "memory.h"
+#include "parmblk.h"
+#include "steiner.h"
+#include <stdlib.h>
+
+
+/*
+ * Global Routines
+ */
+
+void		_gst_presolve_initial_formulation (
+				struct cpool *		pool,
+				struct gst_hypergraph *	cip,
+				bitmap_t *		fixed,
+				bitmap_t *		value,
+				gst_param_ptr		params);
+
+
+/*
+ * The disposition of each pending row.  Rows whose free variables
+ * all have coefficient 1 and a right-hand side of 1 are "cover" rows
+ * (at least one of the variables is 1) or "packing" rows (at most one
+ * of the variables is 1).  The values from PR_REDUNDANT on are rows
+ * left out of the initial LP.
+ */
+
+#define	PR_KEEP		0	/* Row stays in the initial LP */
+#define	PR_COVER	1	/* Cover row, stays in the initial LP */
+#define	PR_PACK		2	/* Packing row, stays in the initial LP */
+#define	PR_REDUNDANT	3	/* Cannot be violated */
+#define	PR_SINGLETON	4	/* Replaced by fixing its only variable */
+#define	PR_DOMINATED	5	/* Implied by another cover/packing row */
+
+
+/*
+ * Local Routines
+ */
+
+static int		classify_row (struct rcon *,
+				      int,
+				      bitmap_t *,
+				      bitmap_t *,
+				      int *,
+				      int *);
+static int		drop_dominated_rows (struct cpool *,
+					     int *,
+					     int,
+					     bitmap_t *,
+					     int);
+static bool		fix_edge (int,
+				  bool,
+				  bitmap_t *,
+				  bitmap_t *,
+				  int *,
+				  int *);
+static void		propagate_fixings (struct gst_hypergraph *,
+					   bitmap_t *,
+					   bitmap_t *,
+					   int *,
+					   int *,
+					   int *,
+					   int *);
+
+/*
+ * Presolve the rows pending addition to the (not yet created) initial
+ * LP.  On entry, fixed and value give the hyperedges that are already
+ * known to be fixed (those not in the problem at zero, and the
+ * required hyperedges at one).  On exit, they also give the
+ * hyperedges that presolve was able to fix.  Only the hyperedge
+ * variables are ever fixed.
+ */
+
+	void
+_gst_presolve_initial_formulation (
+
+struct cpool *		pool,		/* IN/OUT - initial constraint pool */
+struct gst_hypergraph *	cip,		/* IN - compatibility info */
+bitmap_t *		fixed,		/* IN/OUT - fixed hyperedges */
+bitmap_t *		value,		/* IN/OUT - values of fixed hyperedges */
+gst_param_ptr		params		/* IN - parameters */
+)
+{
+int			i;
+int			j;
+int			e;
+int			var;
+int			val;
+int			npend;
+int			nedges;
+int			nfixed;
+int			nqueue;
+int			ndrop;
+int			nredundant;
+int			nsingleton;
+int			ndominated;
+int			row;
+int *			kind;
+int *			queue;
+int *			count;
+bool			changed;
+cpu_time_t		T0;
+cpu_time_t		T1;
+char			tbuf [32];
+gst_channel_ptr		trace;
+
+	trace = params -> print_solve_trace;
+
+	T0 = _gst_get_cpu_time ();
+
+	/* The initial rows must all still be pending. */
+	FATAL_ERROR_IF (pool -> nlprows NE 0);
+
+	nedges	= cip -> num_edges;
+	npend	= pool -> npend;
+
+	kind	= NEWA (npend, int);
+	queue	= NEWA (nedges, int);
+	count	= NEWA (nedges, int);
+
+	for (i = 0; i < nedges; i++) {
+		count [i] = 0;
+	}
+
+	/* Start with the consequences of the hyperedges already	*/
+	/* fixed at one.						*/
+	nfixed = 0;
+	nqueue = 0;
+	for (e = 0; e < nedges; e++) {
+		if (BITON (fixed, e) AND BITON (value, e)) {
+			queue [nqueue++] = e;
+		}
+	}
+	propagate_fixings (cip, fixed, value, queue, &nqueue, count, &nfixed);
+
+	/* Classify each pending row, fixing the variable of each	*/
+	/* singleton row.  Each new fixing can make other rows		*/
+	/* redundant or singletons, so repeat until nothing changes.	*/
+	for (i = 0; i < npend; i++) {
+		kind [i] = PR_KEEP;
+	}
+	do {
+		changed = FALSE;
+		for (i = 0; i < npend; i++) {
+			if (kind [i] >= PR_REDUNDANT) continue;
+			row = pool -> lprows [i];
+			kind [i] = classify_row (&(pool -> rows [row]),
+						 nedges,
+						 fixed,
+						 value,
+						 &var,
+						 &val);
+			if (kind [i] NE PR_SINGLETON) continue;
+			if (fix_edge (var, val, fixed, value, queue, &nqueue)) {
+				++nfixed;
+				changed = TRUE;
+			}
+			propagate_fixings (cip, fixed, value,
+					   queue, &nqueue, count, &nfixed);
+		}
+	} while (changed);
+
+	ndominated = drop_dominated_rows (pool, kind, npend, fixed, nedges);
+
+	/* Remove the dropped rows from the list of pending rows.  They	*/
+	/* remain in the pool, but are no longer destined for the LP.	*/
+	nredundant	= 0;
+	nsingleton	= 0;
+	j = 0;
+	for (i = 0; i < npend; i++) {
+		row = pool -> lprows [i];
+		switch (kind [i]) {
+		case PR_REDUNDANT:	++nredundant;	break;
+		case PR_SINGLETON:	++nsingleton;	break;
+		case PR_DOMINATED:			break;
+		default:
+			pool -> lprows [j++] = row;
+			continue;
+		}
+		pool -> rows [row].lprow = -1;
+	}
+	pool -> npend = j;
+	ndrop = npend - j;
+
+	free ((char *) count);
+	free ((char *) queue);
+	free ((char *) kind);
+
+	T1 = _gst_get_cpu_time ();
+	_gst_convert_cpu_time (T1 - T0, tbuf);
+	gst_channel_printf (trace,
+		"_gst_presolve_initial_formulation: %s seconds.\n", tbuf);
+
+	gst_channel_printf (trace, "Presolve removed %d of %d initial rows:\n",
+		ndrop, npend);
+	gst_channel_printf (trace, "	%d	Redundant rows\n", nredundant);
+	gst_channel_printf (trace, "	%d	Singleton rows\n", nsingleton);
+	gst_channel_printf (trace, "	%d	Dominated rows\n", ndominated);
+	gst_channel_printf (trace, "	%d	Variables fixed\n", nfixed);
+}
+
+/*
+ * Determine the disposition of the given row, taking the fixed
+ * variables into account.  Rows that are infeasible are kept, so that
+ * the LP solver will discover the infeasibility.  For a singleton row,
+ * the variable and the value it must be fixed at are also returned.
+ */
+
+	static
+	int
+classify_row (
+
+struct rcon *		rcp,		/* IN - pool row to classify */
+int			nedges,		/* IN - number of hyperedges */
+bitmap_t *		fixed,		/* IN - fixed hyperedges */
+bitmap_t *		value,		/* IN - values of fixed hyperedges */
+int *			fix_var,	/* OUT - variable of singleton row */
+int *			fix_val		/* OUT - value to fix it at */
+)
+{
+int			j;
+int			nfree;
+int			last_var;
+int			last_coef;
+bool			unit;
+bool			ok0;
+bool			ok1;
+double			lo;
+double			hi;
+double			rhs;
+struct rcoef *		cp;
+
+	/* Accumulate the range of activity of the free variables, and	*/
+	/* move the contribution of the fixed ones to the rhs.  The	*/
+	/* sums are done in double to avoid overflow with large	*/
+	/* coefficients.						*/
+	nfree		= 0;
+	last_var	= -1;
+	last_coef	= 0;
+	unit		= TRUE;
+	lo		= 0.0;
+	hi		= 0.0;
+	rhs		= 0.0;
+	for (cp = rcp -> coefs; cp -> var >= RC_VAR_BASE; cp++) {
+		j = cp -> var - RC_VAR_BASE;
+		if ((j < nedges) AND BITON (fixed, j)) {
+			if (BITON (value, j)) {
+				rhs -= cp -> val;
+			}
+			continue;
+		}
+		++nfree;
+		last_var	= j;
+		last_coef	= cp -> val;
+		if (cp -> val > 0) {
+			hi += cp -> val;
+		}
+		else {
+			lo += cp -> val;
+		}
+		if (cp -> val NE 1) {
+			unit = FALSE;
+		}
+	}
+	rhs += cp -> val;
+
+	switch (cp -> var) {
+	case RC_OP_LE:
+		if (lo > rhs) return (PR_KEEP);
+		if (hi <= rhs) return (PR_REDUNDANT);
+		break;
+
+	case RC_OP_GE:
+		if (hi < rhs) return (PR_KEEP);
+		if (lo >= rhs) return (PR_REDUNDANT);
+		break;
+
+	case RC_OP_EQ:
+		if ((lo > rhs) OR (hi < rhs)) return (PR_KEEP);
+		if ((lo EQ rhs) AND (hi EQ rhs)) return (PR_REDUNDANT);
+		break;
+
+	default:
+		FATAL_ERROR;
+		break;
+	}
+
+	if ((nfree EQ 1) AND (last_var < nedges)) {
+		/* Exactly one of the values 0 and 1 satisfies the row, */
+		/* since it is neither infeasible nor redundant.	*/
+		switch (cp -> var) {
+		case RC_OP_LE:
+			ok0 = (0.0 <= rhs);
+			ok1 = (last_coef <= rhs);
+			break;
+
+		case RC_OP_GE:
+			ok0 = (0.0 >= rhs);
+			ok1 = (last_coef >= rhs);
+			break;
+
+		default:
+			ok0 = (0.0 EQ rhs);
+			ok1 = (last_coef EQ rhs);
+			break;
+		}
+		FATAL_ERROR_IF (ok0 EQ ok1);
+		*fix_var = last_var;
+		*fix_val = ok1;
+		return (PR_SINGLETON);
+	}
+
+	if (unit AND (rhs EQ 1.0)) {
+		if (cp -> var EQ RC_OP_GE) return (PR_COVER);
+		if (cp -> var EQ RC_OP_LE) return (PR_PACK);
+	}
+
+	return (PR_KEEP);
+}
+
+/*
+ * Fix the given hyperedge at the given value, unless it is already
+ * fixed.  (A hyperedge already fixed at the opposite value means that
+ * the problem is infeasible -- the LP solver will discover this.)
+ * Hyperedges fixed at one are queued so that their consequences can
+ * be propagated.
+ */
+
+	static
+	bool
+fix_edge (
+
+int			e,		/* IN - hyperedge to fix */
+bool			val,		/* IN - value to fix it at */
+bitmap_t *		fixed,		/* IN/OUT - fixed hyperedges */
+bitmap_t *		value,		/* IN/OUT - values of fixed hyperedges */
+int *			queue,		/* IN/OUT - hyperedges fixed at one */
+int *			nqueue		/* IN/OUT - length of queue */
+)
+{
+	if (BITON (fixed, e)) return (FALSE);
+
+	SETBIT (fixed, e);
+	if (val) {
+		SETBIT (value, e);
+		queue [(*nqueue)++] = e;
+	}
+	else {
+		CLRBIT (value, e);
+	}
+
+	return (TRUE);
+}
+
+/*
+ * Fix at zero every hyperedge that cannot be chosen together with a
+ * queued hyperedge:  those known to be incompatible with it, and
+ * those sharing two or more vertices with it (which would form a
+ * cycle).
+ */
+
+	static
+	void
+propagate_fixings (
+
+struct gst_hypergraph *	cip,		/* IN - compatibility info */
+bitmap_t *		fixed,		/* IN/OUT - fixed hyperedges */
+bitmap_t *		value,		/* IN/OUT - values of fixed hyperedges */
+int *			queue,		/* IN/OUT - hyperedges fixed at one */
+int *			nqueue,		/* IN/OUT - length of queue */
+int *			count,		/* IN - scratch, all zero */
+int *			nfixed		/* IN/OUT - number of fixings made */
+)
+{
+int			e;
+int			f;
+int *			ep1;
+int *			ep2;
+int *			vp1;
+int *			vp2;
+
+	while (*nqueue > 0) {
+		e = queue [--(*nqueue)];
+
+		if (cip -> inc_edges NE NULL) {
+			ep1 = cip -> inc_edges [e];
+			ep2 = cip -> inc_edges [e + 1];
+			while (ep1 < ep2) {
+				f = *ep1++;
+				if (fix_edge (f, FALSE, fixed, value,
+					      queue, nqueue)) {
+					++(*nfixed);
+				}
+			}
+		}
+
+		vp1 = cip -> edge [e];
+		vp2 = cip -> edge [e + 1];
+		while (vp1 < vp2) {
+			ep1 = cip -> term_trees [*vp1];
+			ep2 = cip -> term_trees [*vp1 + 1];
+			++vp1;
+			while (ep1 < ep2) {
+				f = *ep1++;
+				if (f EQ e) continue;
+				if (++(count [f]) NE 2) continue;
+				if (fix_edge (f, FALSE, fixed, value,
+					      queue, nqueue)) {
+					++(*nfixed);
+				}
+			}
+		}
+
+		/* Clear the scratch counts again. */
+		vp1 = cip -> edge [e];
+		while (vp1 < vp2) {
+			ep1 = cip -> term_trees [*vp1];
+			ep2 = cip -> term_trees [*vp1 + 1];
+			++vp1;
+			while (ep1 < ep2) {
+				count [*ep1++] = 0;
+			}
+		}
+	}
+}
+
+/*
+ * Drop each cover row whose free variables include all of those of
+ * another cover row, and each packing row whose free variables are
+ * all in another packing row.  (Of two rows having the same free
+ * variables, the later one is dropped.)  For example, the row saying
+ * that at least one hyperedge is chosen is dominated by the cutset
+ * row of any terminal.  Returns the number of rows dropped.
+ */
+
+	static
+	int
+drop_dominated_rows (
+
+struct cpool *		pool,		/* IN - initial constraint pool */
+int *			kind,		/* IN/OUT - disposition of each row */
+int			npend,		/* IN - number of pending rows */
+bitmap_t *		fixed,		/* IN - fixed hyperedges */
+int			nedges		/* IN - number of hyperedges */
+)
+{
+int			i;
+int			j;
+int			k;
+int			s;
+int			b;
+int			len;
+int			best;
+int			nvars;
+int			total;
+int			nmatch;
+int			ndominated;
+int *			rbeg;
+int *			rend;
+int *			rvars;
+int *			cbeg;
+int *			crows;
+int *			mark;
+int *			vp1;
+int *			vp2;
+int *			rp1;
+int *			rp2;
+struct rcoef *		cp;
+
+	nvars = pool -> nvars;
+
+	/* Count the coefficients of the cover and packing rows. */
+	total = 0;
+	for (i = 0; i < npend; i++) {
+		if ((kind [i] NE PR_COVER) AND (kind [i] NE PR_PACK)) continue;
+		cp = pool -> rows [pool -> lprows [i]].coefs;
+		for (; cp -> var >= RC_VAR_BASE; cp++) {
+			++total;
+		}
+	}
+
+	rbeg	= NEWA (npend, int);
+	rend	= NEWA (npend, int);
+	rvars	= NEWA (total + 1, int);
+	cbeg	= NEWA (nvars + 1, int);
+	crows	= NEWA (total + 1, int);
+	mark	= NEWA (nvars, int);
+
+	for (j = 0; j <= nvars; j++) {
+		cbeg [j] = 0;
+	}
+	for (j = 0; j < nvars; j++) {
+		mark [j] = -1;
+	}
+
+	/* Collect the free variables of each such row. */
+	k = 0;
+	for (i = 0; i < npend; i++) {
+		rbeg [i] = k;
+		if ((kind [i] EQ PR_COVER) OR (kind [i] EQ PR_PACK)) {
+			cp = pool -> rows [pool -> lprows [i]].coefs;
+			for (; cp -> var >= RC_VAR_BASE; cp++) {
+				j = cp -> var - RC_VAR_BASE;
+				if ((j < nedges) AND BITON (fixed, j)) continue;
+				rvars [k++] = j;
+				++(cbeg [j + 1]);
+			}
+		}
+		rend [i] = k;
+	}
+
+	/* Build the list of rows containing each variable. */
+	for (j = 0; j < nvars; j++) {
+		cbeg [j + 1] += cbeg [j];
+	}
+	for (i = 0; i < npend; i++) {
+		for (k = rbeg [i]; k < rend [i]; k++) {
+			j = rvars [k];
+			crows [cbeg [j]++] = i;
+		}
+	}
+	for (j = nvars; j > 0; j--) {
+		cbeg [j] = cbeg [j - 1];
+	}
+	cbeg [0] = 0;
+
+	ndominated = 0;
+	for (s = 0; s < npend; s++) {
+		if ((kind [s] NE PR_COVER) AND (kind [s] NE PR_PACK)) continue;
+		len = rend [s] - rbeg [s];
+
+		/* Every row containing row s must contain its variable	*/
+		/* that appears in the fewest rows.			*/
+		best = rvars [rbeg [s]];
+		for (k = rbeg [s]; k < rend [s]; k++) {
+			j = rvars [k];
+			mark [j] = s;
+			if (cbeg [j + 1] - cbeg [j] < cbeg [best + 1] - cbeg [best]) {
+				best = j;
+			}
+		}
+
+		rp1 = &crows [cbeg [best]];
+		rp2 = &crows [cbeg [best + 1]];
+		while (rp1 < rp2) {
+			b = *rp1++;
+			if (b EQ s) continue;
+			if (kind [b] NE kind [s]) continue;
+			if (rend [b] - rbeg [b] < len) continue;
+			nmatch = 0;
+			vp1 = &rvars [rbeg [b]];
+			vp2 = &rvars [rend [b]];
+			while (vp1 < vp2) {
+				if (mark [*vp1++] EQ s) {
+					++nmatch;
+				}
+			}
+			if (nmatch < len) continue;
+
+			/* Row s is a subset of row b. */
+			if (rend [b] - rbeg [b] EQ len) {
+				if (b < s) {
+					kind [s] = PR_DOMINATED;
+					++ndominated;
+					break;
+				}
+				kind [b] = PR_DOMINATED;
+				++ndominated;
+			}
+			else if (kind [s] EQ PR_COVER) {
+				kind [b] = PR_DOMINATED;
+				++ndominated;
+			}
+			else {
+				kind [s] = PR_DOMINATED;
+				++ndominated;
+				break;
+			}
+		}
+	}
+
+	free ((char *) mark);
+	free ((char *) crows);
+	free ((char *) cbeg);
+	free ((char *) rvars);
+	free ((char *) rend);
+	free ((char *) rbeg);
+
+	return (ndominated);
+}
@@ -0,0 +1,47 @@
+/***********************************************************************
+
+	$Id: lppresolve.h,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	lppresolve.h
+	Rev:	e-1
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Presolve of the initial LP formulation.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+
+************************************************************************/
+
+#ifndef	LPPRESOLVE_H
+#define	LPPRESOLVE_H
+
+#include "bitmaskmacros.h"
+
+struct cpool;
+struct gst_hypergraph;
+struct gst_param;
+
+
+/*
+ * Global Routines
+ */
+
+extern void	_gst_presolve_initial_formulation (
+				struct cpool *		pool,
+				struct gst_hypergraph *	cip,
+				bitmap_t *		fixed,
+				bitmap_t *		value,
+				struct gst_param *	params);
+
+#endif
@@ -3,10 +3,10 @@
 	$Id: lpsolver.h,v 1.8 2022/11/19 13:45:53 warme Exp $
 
 	File:	lpsolver.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-5
+	Date:	10/18/2026
 
-	Copyright (c) 1996, 2022 by David M. Warme.  This work is
+	Copyright (c) 1996, 2026 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
 	4.0 International License.
 
@@ -26,6 +26,11 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Reorganize include files, fix -Wall issues.
+	e-4:	10/18/2026	warme
+		: Added the table of LP solver operations, and
+		:  support for HiGHS.
+	e-5:	10/18/2026	warme
+		: Added get_duals operation.
 
 ************************************************************************/
 
@@ -48,7 +53,11 @@
  #endif
 #endif
 
-#ifdef LPSOLVE
+#ifdef HIGHS
+#include "interfaces/highs_c_api.h"
+#endif
+
+#if defined(LPSOLVE) OR defined(HIGHS)
 #include "lpkit.h"
 #endif
 
@@ -68,6 +77,25 @@ typedef struct cpxlp		LP_t;
 #ifdef LPSOLVE
 typedef lprec			LP_t;
 #endif
+
+#ifdef HIGHS
+typedef void			LP_t;	/* a HiGHS instance */
+#endif
+
+/*
+ * The small auxiliary LPs solved by the local cut generator and by
+ * analyze.c use the same LP solver as the main LP, except that when
+ * the main LP uses HiGHS, the auxiliary LPs use lp_solve.
+ */
+
+#if defined(LPSOLVE) OR defined(HIGHS)
+#define	AUX_LPSOLVE	1
+typedef lprec			AUX_LP_t;
+#endif
+
+#ifdef CPLEX
+typedef struct cpxlp		AUX_LP_t;
+#endif
 
 /*
  * Here are a bunch of macros that we use to insulate us from the
@@ -105,6 +133,8 @@ typedef lprec			LP_t;
 			     rmatbeg, rmatind, rmatval, colname, rowname))
   #define _MYCPX_chgbds(lp, cnt, index, lu, bd) \
 		(CPXchgbds (cplex_env, lp, cnt, index, lu, bd))
+  #define _MYCPX_chgobj(lp, cnt, index, values) \
+		(CPXchgobj (cplex_env, lp, cnt, index, values))
   #define _MYCPX_delsetrows(lp, delstat) \
 		(CPXdelsetrows (cplex_env, lp, delstat))
   #define _MYCPX_dualopt(lp)	(CPXdualopt (cplex_env, lp))
@@ -118,6 +148,8 @@ typedef lprec			LP_t;
   #define _MYCPX_getnumrows(lp)	(CPXgetnumrows (cplex_env, lp))
   #define _MYCPX_getnzspace(lp)	(CPXgetnzspace (cplex_env, lp))
   #define _MYCPX_getobj(lp,obj,b,e) (CPXgetobj (cplex_env, lp, obj, b, e))
+  #define _MYCPX_getpi(lp, pi, begin, end) \
+		(CPXgetpi (cplex_env, lp, pi, begin, end))
   #define _MYCPX_getrowspace(lp) (CPXgetrowspace (cplex_env, lp))
   #define _MYCPX_getslack(lp, slack, begin, end) \
 		(CPXgetslack (cplex_env, lp, slack, begin, end))
@@ -247,6 +279,8 @@ typedef lprec			LP_t;
 			  rmatbeg, rmatind, rmatval, colname, rowname))
   #define _MYCPX_chgbds(lp, cnt, index, lu, bd) \
 		(chgbds (lp, cnt, index, lu, bd))
+  #define _MYCPX_chgobj(lp, cnt, index, values) \
+		(chgobj (lp, cnt, index, values))
   #define _MYCPX_delsetrows(lp, delstat) (delsetrows (lp, delstat))
   #define _MYCPX_dualopt(lp)	(dualopt (lp))
   #define _MYCPX_freeprob(lpp)	(freeprob (lpp), 0)
@@ -259,6 +293,8 @@ typedef lprec			LP_t;
   #define _MYCPX_getnumrows(lp) (getmar (lp))
   #define _MYCPX_getnzspace(lp) (getmatsz (lp))
   #define _MYCPX_getobj(lp,obj,b,e) (getobj (lp, obj, b, e))
+  #define _MYCPX_getpi(lp, pi, begin, end) \
+		(getpi (lp, pi, begin, end))
   #define _MYCPX_getrowspace(lp) (getmarsz (lp))
   #define _MYCPX_getslack(lp, slack, begin, end) \
 		(getslack (lp, slack, begin, end))
@@ -308,6 +344,24 @@ typedef lprec			LP_t;
 #define	GET_LP_NUM_NZ(lp)	((lp) -> non_zeros)
 #endif
 
+#ifdef HIGHS
+#define	GET_LP_NUM_COLS(lp)	((int) Highs_getNumCol (lp))
+#define	GET_LP_NUM_ROWS(lp)	((int) Highs_getNumRow (lp))
+#define	GET_LP_NUM_NZ(lp)	((int) Highs_getNumNz (lp))
+#endif
+
+#ifdef CPLEX
+#define	GET_AUX_LP_NUM_COLS(lp)	GET_LP_NUM_COLS (lp)
+#define	GET_AUX_LP_NUM_ROWS(lp)	GET_LP_NUM_ROWS (lp)
+#define	GET_AUX_LP_NUM_NZ(lp)	GET_LP_NUM_NZ (lp)
+#endif
+
+#ifdef AUX_LPSOLVE
+#define	GET_AUX_LP_NUM_COLS(lp)	((lp) -> columns)
+#define	GET_AUX_LP_NUM_ROWS(lp)	((lp) -> rows)
+#define	GET_AUX_LP_NUM_NZ(lp)	((lp) -> non_zeros)
+#endif
+
 
 /*
  * A structure to keep track of dynamic memory used by an LP.
@@ -328,11 +382,131 @@ struct lpmem {
 };
 #endif
 
-#ifdef LPSOLVE
+#if defined(LPSOLVE) OR defined(HIGHS)
 struct lpmem {
 	/* lp_solve_2.0 dynamically manages the LP tableaux memory... */
 	int	dummy;
 };
 #endif
 
+
+/*
+ * A basis saved so that branches can be tried rapidly (i.e., for
+ * strong branching).  The contents are private to the LP solver.
+ */
+
+struct lpbasis {
+	int *		cstat;		/* status of each column */
+	int *		rstat;		/* status of each row */
+	void *		info;		/* any other saved state */
+};
+
+/*
+ * Status values returned by the "solve" operation.
+ */
+
+#define	LPS_OPTIMAL		0	/* optimal solution found */
+#define	LPS_CUTOFF		1	/* objective exceeded the cutoff */
+#define	LPS_INFEASIBLE		2	/* LP is infeasible */
+#define	LPS_UNBOUNDED		3	/* LP is unbounded */
+#define	LPS_UNSCALED_INFEAS	4	/* optimal solution of the scaled */
+					/* LP is infeasible when unscaled */
+
+/*
+ * The operations on the main LP that each LP solver provides.  All
+ * variable and row numbers are zero-origined.  Rows are given in
+ * compressed row-wise form (matbeg has one entry per row, plus one),
+ * and with a sense of 'L', 'E' or 'G'.  The column and row status
+ * arrays used by get_basis and set_basis have one entry per column
+ * and per row, plus one, and are otherwise private to the solver.
+ */
+
+struct gst_param;
+
+struct lpops {
+	const char *	name;		/* name of the LP solver */
+	bool		keeps_basis;	/* deleting rows leaves a valid */
+					/* basis */
+
+	/* Create an LP having the given columns and rows.  NULL if	*/
+	/* the solver builds its own initial formulation.		*/
+	LP_t *	(*load) (int			ncols,
+			 double *		obj,
+			 double *		lb,
+			 double *		ub,
+			 int			nrows,
+			 double *		rhs,
+			 char *			sense,
+			 int *			matbeg,
+			 int *			matind,
+			 double *		matval,
+			 struct lpmem *		lpmem,
+			 struct gst_param *	params);
+	void	(*destroy) (LP_t * lp, struct lpmem * lpmem);
+
+	/* Append rows to the LP.  FALSE if the LP has no room for	*/
+	/* them, in which case it must be rebuilt.			*/
+	bool	(*add_rows) (LP_t *	lp,
+			     int	nrows,
+			     double *	rhs,
+			     char *	sense,
+			     int *	matbeg,
+			     int *	matind,
+			     double *	matval);
+	/* Delete each row i for which dflags [i] is non-zero. */
+	void	(*delete_rows) (LP_t * lp, int * dflags);
+
+	void	(*change_bounds) (LP_t *	lp,
+				  int		n,
+				  int *		index,
+				  double *	lb,
+				  double *	ub);
+	void	(*change_objective) (LP_t *		lp,
+				     struct lpmem *	lpmem,
+				     int		n,
+				     int *		index,
+				     double *		obj);
+	void	(*get_objective) (LP_t *		lp,
+				  struct lpmem *	lpmem,
+				  int			n,
+				  double *		obj);
+	/* Stop solving once the objective is known to exceed ub. */
+	void	(*set_cutoff) (LP_t * lp, struct lpmem * lpmem, double ub);
+
+	void	(*get_basis) (LP_t * lp, int * cstat, int * rstat);
+	void	(*set_basis) (LP_t * lp, int * cstat, int * rstat);
+
+	/* Re-optimize using the dual simplex method.  Returns one of	*/
+	/* the LPS_xxx values.  The objective value, and the value and	*/
+	/* reduced cost of each column, and the slack of each row are	*/
+	/* returned.							*/
+	int	(*solve) (LP_t *		lp,
+			  struct lpmem *	lpmem,
+			  double *		z,
+			  double *		x,
+			  double *		dj,
+			  double *		slack);
+	/* Get the dual value of each row for the most recent optimal	*/
+	/* solve.							*/
+	void	(*get_duals) (LP_t * lp, struct lpmem * lpmem, double * pi);
+	/* Enable or disable scaling.  Takes effect only when the LP	*/
+	/* is rebuilt.  NULL if solve never gives LPS_UNSCALED_INFEAS.	*/
+	void	(*set_scaling) (bool enable);
+
+	/* Tentatively fix a variable to 0 or 1 (dir), starting from	*/
+	/* a saved optimal basis, and return the objective value (or	*/
+	/* ival if infeasible).  The LP is restored afterward.		*/
+	void	(*save_branch_basis) (LP_t * lp, struct lpbasis * basp);
+	void	(*free_branch_basis) (struct lpbasis * basp);
+	double	(*try_branch) (LP_t *			lp,
+			       struct lpmem *		lpmem,
+			       int			var,
+			       int			dir,
+			       double *			x,
+			       double			ival,
+			       struct lpbasis *		basp);
+};
+
+extern const struct lpops	_gst_lpops;
+
 #endif
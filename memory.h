@@ -3,8 +3,8 @@
 	$Id: memory.h,v 1.14 2022/11/19 13:45:53 warme Exp $
 
 	File:	memory.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2022 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -18,6 +18,9 @@
 	a program CHECK_MEMORY can be used to verify that all of the
 	allocated memory has been freed (no memory leaks).
 
+	An arena carves many small objects out of a few large blocks,
+	and frees all of them at once.
+
 ************************************************************************
 
 	Modification Log:
@@ -30,6 +33,8 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Reorganize include files, apply prefixes.
+	e-4:	10/18/2026	warme
+		: Add arena allocator.
 
 ************************************************************************/
 
@@ -82,4 +87,28 @@
 #define	NEW(type)	((type *) _gst_new (sizeof (type)))
 #define	NEWA(n, type)	((type *) _gst_new ((size_t) ((n) * sizeof (type))))
 
+/*
+ * An arena.  Objects allocated from an arena cannot be freed
+ * individually -- they all go away when the arena itself is freed.
+ * An arena that has just been initialized (or freed) holds no memory.
+ */
+
+struct arena_blk;
+
+struct arena {
+	struct arena_blk *	blocks;	/* All blocks, for freeing */
+	char *			ptr;	/* Next free byte of current block */
+	char *			end;	/* End of current block */
+	size_t			blksize; /* Usual size of a block */
+};
+
+extern void *		_gst_arena_alloc (struct arena * ap, size_t size);
+extern void		_gst_arena_free (struct arena * ap);
+extern void		_gst_arena_init (struct arena * ap, size_t blksize);
+extern void		_gst_arena_join (struct arena * to, struct arena * from);
+
+#define	ARENA_NEW(ap, type)	((type *) _gst_arena_alloc ((ap), sizeof (type)))
+#define	ARENA_NEWA(ap, n, type)	\
+	((type *) _gst_arena_alloc ((ap), (size_t) ((n) * sizeof (type))))
+
 #endif	/* MEMORY_H */
@@ -3,8 +3,8 @@
 	$Id: new.c,v 1.4 2022/11/19 13:45:53 warme Exp $
 
 	File:	new.c
-	Rev:	e-2
-	Date:	09/24/2016
+	Rev:	e-3
+	Date:	10/18/2026
 
 	Copyright (c) 1993, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -22,6 +22,8 @@
 		: Split off from utils.c.
 	e-2:	09/24/2016	warme
 		: Apply prefixes.
+	e-3:	10/18/2026	warme
+		: Add arena allocator.
 
 ************************************************************************/
 
@@ -33,6 +35,40 @@
 #include <stdlib.h>
 
 
+/*
+ * Global Routines
+ */
+
+void *		_gst_arena_alloc (struct arena * ap, size_t size);
+void		_gst_arena_free (struct arena * ap);
+void		_gst_arena_init (struct arena * ap, size_t blksize);
+void		_gst_arena_join (struct arena * to, struct arena * from);
+#ifndef WATCH_MEMORY
+void *		_gst_new (size_t size);
+#endif
+
+
+/*
+ * Each block of an arena starts with this header.  The memory that
+ * follows it is aligned suitably for any object we allocate.
+ */
+
+union arena_align {
+	double		d;
+	long		l;
+	void *		p;
+};
+
+struct arena_blk {
+	struct arena_blk *	next;	/* Next block of the arena */
+	union arena_align	data [1]; /* Start of the block's memory */
+};
+
+#define	ARENA_ALIGN	(sizeof (union arena_align))
+#define	ARENA_HDR	(offsetof (struct arena_blk, data))
+#define	ARENA_ROUND(n)	(((n) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+
 /*
  * This routine performs all dynamic memory allocation for the program.
  * We test for out of memory condition here.
@@ -63,3 +99,120 @@ void *		p;
 }
 
 #endif
+
+/*
+ * Initialize an arena that gets its memory in blocks of the given size.
+ * No memory is allocated until the first object is.
+ */
+
+	void
+_gst_arena_init (
+
+struct arena *	ap,		/* OUT - arena to initialize */
+size_t		blksize		/* IN - size of each block in bytes */
+)
+{
+	if (blksize < ARENA_ALIGN) {
+		blksize = ARENA_ALIGN;
+	}
+
+	ap -> blocks	= NULL;
+	ap -> ptr	= NULL;
+	ap -> end	= NULL;
+	ap -> blksize	= ARENA_ROUND (blksize);
+}
+
+/*
+ * Allocate an object from an arena.  When the current block is too full,
+ * we start a new one -- nothing already allocated ever moves.  Objects
+ * larger than a block get a block of their own.
+ */
+
+	void *
+_gst_arena_alloc (
+
+struct arena *	ap,		/* IN/OUT - arena to allocate from */
+size_t		size		/* IN - size of object in bytes */
+)
+{
+char *			p;
+struct arena_blk *	bp;
+
+	if (size EQ 0) {
+		size = 1;
+	}
+	size = ARENA_ROUND (size);
+
+	if ((ap -> ptr EQ NULL) OR (size > (size_t) (ap -> end - ap -> ptr))) {
+		if (size > ap -> blksize) {
+			/* Keep using the current block afterwards. */
+			bp = (struct arena_blk *) _gst_new (ARENA_HDR + size);
+			bp -> next = ap -> blocks;
+			ap -> blocks = bp;
+			return ((void *) (bp -> data));
+		}
+		bp = (struct arena_blk *) _gst_new (ARENA_HDR + ap -> blksize);
+		bp -> next = ap -> blocks;
+		ap -> blocks = bp;
+		ap -> ptr = (char *) (bp -> data);
+		ap -> end = ap -> ptr + ap -> blksize;
+	}
+
+	p = ap -> ptr;
+	ap -> ptr += size;
+
+	return ((void *) p);
+}
+
+/*
+ * Free every object allocated from an arena.  The arena remains
+ * initialized, and can be used again.
+ */
+
+	void
+_gst_arena_free (
+
+struct arena *	ap		/* IN/OUT - arena to free */
+)
+{
+struct arena_blk *	bp;
+struct arena_blk *	next;
+
+	for (bp = ap -> blocks; bp NE NULL; bp = next) {
+		next = bp -> next;
+		free ((char *) bp);
+	}
+
+	ap -> blocks	= NULL;
+	ap -> ptr	= NULL;
+	ap -> end	= NULL;
+}
+
+/*
+ * Give every object allocated from one arena to another, so that they
+ * are freed along with the other's objects.  The first arena is left
+ * empty.
+ */
+
+	void
+_gst_arena_join (
+
+struct arena *	to,		/* IN/OUT - arena to receive objects */
+struct arena *	from		/* IN/OUT - arena to take them from */
+)
+{
+struct arena_blk *	bp;
+
+	bp = from -> blocks;
+	if (bp NE NULL) {
+		while (bp -> next NE NULL) {
+			bp = bp -> next;
+		}
+		bp -> next = to -> blocks;
+		to -> blocks = from -> blocks;
+	}
+
+	from -> blocks	= NULL;
+	from -> ptr	= NULL;
+	from -> end	= NULL;
+}
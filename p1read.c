@@ -3,8 +3,8 @@
 	$Id: p1read.c,v 1.36 2023/04/03 17:23:42 warme Exp $
 
 	File:	p1read.c
-	Rev:	e-6
-	Date:	04/03/2023
+	Rev:	e-7
+	Date:	10/18/2026
 
 	Copyright (c) 1993, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -46,6 +46,8 @@
 	e-6:	04/03/2023	warme
 		: Always set status (if requested).
 o		: Fix -Wall issue.
+	e-7:	10/18/2026	warme
+		: Read the largest complete FST size, if present.
 
 ************************************************************************/
 
@@ -89,6 +91,7 @@ void		_gst_init_term_trees (struct gst_hypergraph *);
  */
 
 static int		get_d (FILE *);
+static bool		get_optional_d (FILE *, int *);
 static double		get_dec_double (FILE *);
 static double		get_hex_double (FILE *);
 static char *		get_line (FILE * fp);
@@ -477,6 +480,14 @@ struct gst_hypergraph *	cip;
 		/* Version 3 has integrality delta... */
 		(void) get_dec_double (fp);
 		idelta = get_hex_double (fp);
+
+		/* ...optionally followed by the largest FST size that	*/
+		/* is known to be complete.				*/
+		if (get_optional_d (fp, &i)) {
+			gst_set_int_property (cip -> proplist,
+					      GST_PROP_HG_COMPLETE_FST_SIZE,
+					      i);
+		}
 	}
 	gst_set_dbl_property (cip -> proplist, GST_PROP_HG_INTEGRALITY_DELTA, idelta);
 
@@ -1328,6 +1339,38 @@ int		i, n;
 
 	return (i);
 }
+
+/*
+ * This routine reads a single decimal number from stdin, if there is
+ * one before the end of the current line.  The end of the line is not
+ * consumed.
+ */
+
+	static
+	bool
+get_optional_d (
+
+FILE *		fp,		/* IN - input file pointer. */
+int *		ip		/* OUT - the number read. */
+)
+{
+int		c;
+
+	do {
+		c = getc (fp);
+	} while ((c EQ ' ') OR (c EQ '\t'));
+	if (c < 0) {
+		return (FALSE);
+	}
+	ungetc (c, fp);
+	if ((c < '0') OR (c > '9')) {
+		return (FALSE);
+	}
+
+	*ip = get_d (fp);
+
+	return (TRUE);
+}
 
 
 #if 0 /* This function is currently not in use... */
@@ -3,8 +3,8 @@
 	$Id: p1write.c,v 1.35 2022/11/19 13:45:53 warme Exp $
 
 	File:	p1write.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1993, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -46,6 +46,8 @@
 		: Use better encapsulation for time conversions.
 	e-4:	11/18/2022	warme
 		: Fix -Wall issue.
+	e-5:	10/18/2026	warme
+		: Write the largest complete FST size, if known.
 
 ************************************************************************/
 
@@ -464,7 +466,15 @@ gst_proplist_ptr	hgprop;
 				      &idelta);
 		_gst_dist_to_string (buf1, idelta, cip -> scale);
 		double_to_hex ((double) idelta, buf2);
-		fprintf (fp, "%s %s\n", buf1, buf2);
+		if (gst_get_int_property (cip -> proplist,
+					  GST_PROP_HG_COMPLETE_FST_SIZE,
+					  &k) EQ 0) {
+			/* Older readers ignore the rest of this line. */
+			fprintf (fp, "%s %s %d\n", buf1, buf2, k);
+		}
+		else {
+			fprintf (fp, "%s %s\n", buf1, buf2);
+		}
 	}
 
 	fprintf (fp, "%s\n", gst_env -> machine_string);
@@ -0,0 +1,347 @@
+/***********************************************************************
+
+	$Id: parallel.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	parallel.c
+	Rev:	e-2
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Simple facilities for running a batch of independent
+	tasks on several threads.
+
+	Tasks are handed out dynamically from a shared counter, so
+	the assignment of tasks to threads is NOT deterministic.
+	Callers that require reproducible results must arrange for
+	each task to write only into storage private to that task,
+	and then combine the results serially in task order.
+
+	When GeoSteiner is configured without POSIX threads, or
+	when only one thread is requested, every task is simply
+	executed by the calling thread in increasing order.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+	e-2:	10/18/2026	warme
+		: Added buffering of trace output produced by tasks.
+
+************************************************************************/
+
+#include "parallel.h"
+
+#include "config.h"
+#include "fatal.h"
+#include "geosteiner.h"
+#include "logic.h"
+#include "memory.h"
+#include "steiner.h"
+
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Global Routines
+ */
+
+int		_gst_parallel_for (int		nthreads,
+				   int		ntasks,
+				   gst_task_func_t	func,
+				   void *	arg);
+void		_gst_par_trace_flush (struct par_trace *	ptp,
+				      gst_channel_ptr		trace);
+void		_gst_par_trace_init (struct par_trace *	ptp,
+				     gst_channel_ptr	trace);
+int		_gst_resolve_num_threads (int nthreads);
+
+
+/*
+ * Local Types
+ */
+
+#ifdef HAVE_PTHREADS
+
+struct pfor_shared {
+	pthread_mutex_t	lock;		/* Protects next_task */
+	int		next_task;	/* Next task to hand out */
+	int		ntasks;		/* Total number of tasks */
+	gst_task_func_t	func;		/* Function to execute */
+	void *		arg;		/* Its argument */
+};
+
+struct pfor_thread {
+	struct pfor_shared *	shared;	/* Shared loop state */
+	int			thread;	/* Index of this thread */
+};
+
+#endif
+
+
+/*
+ * Local Routines
+ */
+
+static size_t		par_trace_write (const char *	buf,
+					 size_t		cnt,
+					 void *		handle);
+#ifdef HAVE_PTHREADS
+static void *		pfor_worker (void * arg);
+#endif
+
+/*
+ * Determine the number of threads actually to use, given the value
+ * of a thread count parameter.  A value of zero means "use one
+ * thread per online processor".  Without thread support the answer
+ * is always one.
+ */
+
+	int
+_gst_resolve_num_threads (
+
+int		nthreads	/* IN - requested number of threads */
+)
+{
+#ifdef HAVE_PTHREADS
+long		ncpu;
+
+	if (nthreads <= 0) {
+		ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+		nthreads = (ncpu > 0) ? ((int) ncpu) : 1;
+	}
+	return (nthreads);
+#else
+	(void) nthreads;
+	return (1);
+#endif
+}
+
+/*
+ * Execute func (arg, task, thread) for every task in 0..ntasks-1,
+ * using up to nthreads threads (the calling thread included).  This
+ * routine does not return until every task has completed.  The
+ * number of threads actually used is returned.
+ */
+
+	int
+_gst_parallel_for (
+
+int		nthreads,	/* IN - number of threads to use */
+int		ntasks,		/* IN - number of tasks */
+gst_task_func_t	func,		/* IN - function to execute per task */
+void *		arg		/* IN - argument passed to func */
+)
+{
+int			i;
+#ifdef HAVE_PTHREADS
+int			nstarted;
+struct pfor_shared	shared;
+struct pfor_thread *	threads;
+pthread_t *		tids;
+#endif
+
+	nthreads = _gst_resolve_num_threads (nthreads);
+	if (nthreads > ntasks) {
+		nthreads = ntasks;
+	}
+
+	if (nthreads <= 1) {
+		for (i = 0; i < ntasks; i++) {
+			(*func) (arg, i, 0);
+		}
+		return (1);
+	}
+
+#ifdef HAVE_PTHREADS
+	pthread_mutex_init (&shared.lock, NULL);
+	shared.next_task	= 0;
+	shared.ntasks		= ntasks;
+	shared.func		= func;
+	shared.arg		= arg;
+
+	threads	= NEWA (nthreads, struct pfor_thread);
+	tids	= NEWA (nthreads, pthread_t);
+
+	for (i = 0; i < nthreads; i++) {
+		threads [i].shared = &shared;
+		threads [i].thread = i;
+	}
+
+	/* Thread 0 is the caller.  If a thread cannot be created, */
+	/* simply run with the ones we have -- the calling thread */
+	/* alone is always sufficient to complete every task. */
+	nstarted = 1;
+	for (i = 1; i < nthreads; i++) {
+		if (pthread_create (&tids [nstarted],
+				    NULL,
+				    pfor_worker,
+				    &threads [nstarted]) NE 0) {
+			break;
+		}
+		++nstarted;
+	}
+
+	(void) pfor_worker (&threads [0]);
+
+	for (i = 1; i < nstarted; i++) {
+		pthread_join (tids [i], NULL);
+	}
+
+	pthread_mutex_destroy (&shared.lock);
+
+	free ((char *) tids);
+	free ((char *) threads);
+
+	return (nstarted);
+#else
+	/* Not reached -- _gst_resolve_num_threads() always yields 1. */
+	FATAL_ERROR;
+	return (1);
+#endif
+}
+
+/*
+ * The body of each thread: repeatedly claim the next unprocessed
+ * task and execute it, until there are none left.
+ */
+
+#ifdef HAVE_PTHREADS
+
+	static
+	void *
+pfor_worker (
+
+void *		arg		/* IN - per-thread info */
+)
+{
+int			task;
+struct pfor_thread *	tp;
+struct pfor_shared *	sp;
+
+	tp = (struct pfor_thread *) arg;
+	sp = tp -> shared;
+
+	for (;;) {
+		pthread_mutex_lock (&sp -> lock);
+		task = sp -> next_task;
+		if (task < sp -> ntasks) {
+			++(sp -> next_task);
+		}
+		pthread_mutex_unlock (&sp -> lock);
+
+		if (task >= sp -> ntasks) break;
+
+		(*(sp -> func)) (sp -> arg, task, tp -> thread);
+	}
+
+	return (NULL);
+}
+
+#endif
+
+/*
+ * Prepare to buffer the trace output of a task.  If the given trace
+ * channel is NULL, there is nothing to buffer, and ptp -> chan is set
+ * to NULL also.  Otherwise ptp -> chan is a private channel that the
+ * task can write to, instead of the given one.
+ */
+
+	void
+_gst_par_trace_init (
+
+struct par_trace *	ptp,		/* OUT - trace buffer to initialize */
+gst_channel_ptr		trace		/* IN - channel to be buffered */
+)
+{
+	ptp -> chan	= NULL;
+	ptp -> buf	= NULL;
+	ptp -> len	= 0;
+	ptp -> size	= 0;
+
+	if (trace NE NULL) {
+		ptp -> chan = gst_create_channel (NULL, NULL);
+		gst_channel_add_functor (ptp -> chan,
+					 par_trace_write,
+					 ptp,
+					 NULL);
+	}
+}
+
+/*
+ * Write the buffered output of a task to the given trace channel,
+ * and free up the buffer and its private channel.
+ */
+
+	void
+_gst_par_trace_flush (
+
+struct par_trace *	ptp,		/* IN/OUT - trace buffer to flush */
+gst_channel_ptr		trace		/* IN - channel to write to */
+)
+{
+	if (ptp -> len > 0) {
+		gst_channel_write (trace, ptp -> buf, ptp -> len);
+	}
+	if (ptp -> chan NE NULL) {
+		gst_free_channel (ptp -> chan);
+	}
+	if (ptp -> buf NE NULL) {
+		free (ptp -> buf);
+	}
+	ptp -> chan	= NULL;
+	ptp -> buf	= NULL;
+	ptp -> len	= 0;
+	ptp -> size	= 0;
+}
+
+/*
+ * Channel function that appends text to a trace buffer.
+ */
+
+	static
+	size_t
+par_trace_write (
+
+const char *		buf,		/* IN - text to append */
+size_t			cnt,		/* IN - number of bytes */
+void *			handle		/* IN/OUT - trace buffer */
+)
+{
+size_t			n;
+char *			p;
+struct par_trace *	ptp;
+
+	ptp = (struct par_trace *) handle;
+
+	if (ptp -> len + cnt > ptp -> size) {
+		n = 2 * ptp -> size;
+		if (n < ptp -> len + cnt) {
+			n = ptp -> len + cnt + 256;
+		}
+		p = NEWA (n, char);
+		if (ptp -> buf NE NULL) {
+			memcpy (p, ptp -> buf, ptp -> len);
+			free (ptp -> buf);
+		}
+		ptp -> buf	= p;
+		ptp -> size	= n;
+	}
+
+	memcpy (ptp -> buf + ptp -> len, buf, cnt);
+	ptp -> len += cnt;
+
+	return (cnt);
+}
@@ -0,0 +1,67 @@
+/***********************************************************************
+
+	$Id: parallel.h,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	parallel.h
+	Rev:	e-2
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Simple facilities for running a batch of independent
+	tasks on several threads.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+	e-2:	10/18/2026	warme
+		: Added buffering of trace output produced by tasks.
+
+************************************************************************/
+
+#ifndef PARALLEL_H
+#define	PARALLEL_H
+
+#include <stddef.h>
+
+/*
+ * The type of function executed for each task of a parallel loop.
+ * The "task" argument is the index of the task (0 <= task < ntasks),
+ * and "thread" is the index of the thread executing it
+ * (0 <= thread < nthreads).  Thread 0 is always the caller.
+ */
+
+typedef void	(*gst_task_func_t) (void * arg, int task, int thread);
+
+/*
+ * Trace output written by a task is collected in one of these, so
+ * that the caller can emit the output of all tasks in task order.
+ */
+
+struct gst_channel;
+
+struct par_trace {
+	struct gst_channel *	chan;	/* Private channel, NULL if none */
+	char *			buf;	/* Buffered text */
+	size_t			len;	/* Number of bytes used */
+	size_t			size;	/* Number of bytes allocated */
+};
+
+extern int	_gst_parallel_for (int		nthreads,
+				   int		ntasks,
+				   gst_task_func_t	func,
+				   void *	arg);
+extern void	_gst_par_trace_flush (struct par_trace *	ptp,
+				      struct gst_channel *	trace);
+extern void	_gst_par_trace_init (struct par_trace *		ptp,
+				     struct gst_channel *	trace);
+extern int	_gst_resolve_num_threads (int nthreads);
+
+#endif
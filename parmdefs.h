@@ -3,8 +3,8 @@
 	$Id: parmdefs.h,v 1.35 2023/04/03 17:21:13 warme Exp $
 
 	File:	parmdefs.h
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-11
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2023 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -31,6 +31,18 @@
 		: Added several new parameters.
 	e-5:	04/03/2023	warme
 		: Added local_cuts_trace_style.
+	e-6:	10/18/2026	warme
+		: Added num_threads.
+	e-7:	10/18/2026	warme
+		: Added separation_schedule.
+	e-8:	10/18/2026	warme
+		: Raised the limit and default of sec_enum_limit.
+	e-9:	10/18/2026	warme
+		: Added lagrangian_bound.
+	e-10:	10/18/2026	warme
+		: Added fst_time_limit.
+	e-11:	10/18/2026	warme
+		: Lowered the limit of sec_enum_limit to 20.
 
 ************************************************************************/
 
@@ -81,7 +93,7 @@
  f(GRID_OVERLAY,		1028, grid_overlay,		 0, 1, 1) \
  f(BSD_METHOD,			1029, bsd_method,		 0, 2, 0) \
  f(MAX_CUTSET_ENUMERATE_COMPS,	1030, max_cutset_enumerate_comps,0, 11, MCEC) \
- f(SEC_ENUM_LIMIT,		1031, sec_enum_limit,		 0, 16, 10) \
+ f(SEC_ENUM_LIMIT,		1031, sec_enum_limit,		 0, 20, 12) \
  f(SAVE_INT_NUMBITS,		1032, save_int_numbits,		32, INT_MAX, 64) \
  f(SPARSE_SUBTOURS,		1033, sparse_subtours,		 0, 1, 1) \
  f(ZERO_WEIGHT_CUTSETS_METHOD,	1034, zero_weight_cutsets_method,0, 1, 0) \
@@ -92,6 +104,9 @@
  f(INITIAL_PRIMAL_HEURISTIC,	1039, initial_primal_heuristic,	 0, 1, 0) \
  f(INITIAL_PRIMAL_HEUR_STOP,	1040, initial_primal_heur_stop,	 0, 1, 0) \
  f(LOCALCUTS_TRACE_STYLE,	1041, local_cuts_trace_style,	 0, 1, 0) \
+ f(NUM_THREADS,			1042, num_threads,		 0, INT_MAX, 1) \
+ f(SEPARATION_SCHEDULE,		1043, separation_schedule,	 0, 1, 1) \
+ f(LAGRANGIAN_BOUND,		1044, lagrangian_bound,		 0, 1, 1) \
 	/* end of list */
 
 /* Define all of the DOUBLE parameters right here. */
@@ -106,6 +121,7 @@
  f(LOWER_BOUND_TARGET,		2005, lower_bound_target,	  -DBL_MAX, DBL_MAX, DBL_MAX) \
  f(CHECKPOINT_INTERVAL,		2006, checkpoint_interval, 0, 1000000.0, 3600) \
  f(CPLEX_MIP_GAP_TOLERANCE,	2007, cplex_mip_gap_tolerance, 0, 1.0, 0.0005) \
+ f(FST_TIME_LIMIT,		2008, fst_time_limit,		  0, DBL_MAX, 0) \
 	/* end of list */
 
 /* Define all of the STRING parameters right here. */
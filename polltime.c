@@ -3,8 +3,8 @@
 	$Id: polltime.c,v 1.8 2022/11/19 13:45:54 warme Exp $
 
 	File:	polltime.c
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -28,6 +28,8 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Reporganize include files, apply prefixes.
+	e-4:	10/18/2026	warme
+		: Added wall-clock time limits that threads can share.
 
 ************************************************************************/
 
@@ -95,3 +97,52 @@ cpu_time_t		time_to_end;	/* Time to wall time */
 
 	return FALSE;
 }
+
+/*
+ * Set up a polling structure whose limit is the given number of
+ * seconds of wall-clock time from now.  Unlike CPU time, wall-clock
+ * time does not pass faster when several threads share the work.
+ */
+
+	void
+_gst_start_wall_poll (
+
+struct cpu_poll *	poll,		/* OUT - polling structure */
+double			seconds		/* IN - time limit */
+)
+{
+cpu_time_t		t0;
+cpu_time_t		limit;
+
+	t0 = _gst_get_wall_time ();
+
+	limit = _gst_double_seconds_to_cpu_time_t (seconds);
+	if (limit <= 0) {
+		/* Time limit was too small.  Make it	*/
+		/* be one "tick", whatever that is...	*/
+		limit = 1;
+	}
+
+	poll -> last		= t0;
+	poll -> end_time	= t0 + limit;
+	poll -> frequency	= 1;
+	poll -> iteration	= 0;
+#ifdef DEBUG_CPU_POLL
+	poll -> name		= NULL;
+#endif
+}
+
+/*
+ * This function compares the wall-clock time to the end time of the
+ * given polling structure every time it is called.  It does not modify
+ * the structure, so several threads may use it at once.
+ */
+
+	bool
+_gst_wall_time_reached (
+
+struct cpu_poll *	poll		/* IN - polling structure */
+)
+{
+	return (_gst_get_wall_time () > poll -> end_time);
+}
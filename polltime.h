@@ -3,8 +3,8 @@
 	$Id: polltime.h,v 1.8 2022/11/19 13:45:54 warme Exp $
 
 	File:	polltime.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -28,6 +28,8 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Apply prefixes.
+	e-4:	10/18/2026	warme
+		: Added wall-clock time limits that threads can share.
 
 ************************************************************************/
 
@@ -61,6 +63,9 @@ struct cpu_poll {
  */
 
 extern bool		_gst_poll_cpu (struct cpu_poll * poll);
+extern void		_gst_start_wall_poll (struct cpu_poll *	poll,
+					      double		seconds);
+extern bool		_gst_wall_time_reached (struct cpu_poll * poll);
 
 
 /*
@@ -70,4 +75,13 @@ extern bool		_gst_poll_cpu (struct cpu_poll * poll);
 #define TIME_LIMIT_EXCEEDED(cpu_time_limit, poll)	\
 	((cpu_time_limit NE 0) AND _gst_poll_cpu (poll))
 
+/*
+ * The same for a wall-clock limit, reading the clock every time.  This
+ * is for tests made only now and then, possibly by several threads at
+ * once.
+ */
+
+#define TIME_LIMIT_REACHED(wall_time_limit, poll)	\
+	((wall_time_limit NE 0) AND _gst_wall_time_reached (poll))
+
 #endif
@@ -3,8 +3,8 @@
 	$Id: propdefs.h,v 1.6 2022/11/19 13:45:54 warme Exp $
 
 	File:	propdefs.h
-	Rev:	e-2
-	Date:	09/05/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2022 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -23,6 +23,10 @@
 		: Changes for 5.0 release.
 	e-2:	09/05/2016	warme
 		: Change notices for 5.1 release.
+	e-3:	10/18/2026	warme
+		: Added separation statistics.
+	e-4:	10/18/2026	warme
+		: Added complete_fst_size.
 
 ************************************************************************/
 
@@ -33,6 +37,7 @@
 /* Columns are symbol and value. */
 #define HG_PROPS(f) \
  f(HALF_FST_COUNT,		10000) \
+ f(COMPLETE_FST_SIZE,		10001) \
  f(GENERATION_TIME,		20000) \
  f(MST_LENGTH,			20001) \
  f(PRUNING_TIME,		20002) \
@@ -58,9 +63,23 @@
  f(FINAL_LPROWS,		11014) \
  f(FINAL_LPNZ,			11015) \
  f(LOWER_BOUND,			11016) \
+ f(SEP_ZWCUTSET_CUTS,		11017) \
+ f(SEP_INTCYCLE_CUTS,		11018) \
+ f(SEP_ENUMSUBTOUR_CUTS,	11019) \
+ f(SEP_FLOWHEUR_CUTS,		11020) \
+ f(SEP_SMALLSUBTOUR_CUTS,	11021) \
+ f(SEP_SECFLOW_CUTS,		11022) \
+ f(SEP_LOCALCUT_CUTS,		11023) \
  f(CPU_TIME,			21000) \
  f(ROOT_TIME,			21001) \
  f(ROOT_LENGTH,			21002) \
+ f(SEP_ZWCUTSET_TIME,		21003) \
+ f(SEP_INTCYCLE_TIME,		21004) \
+ f(SEP_ENUMSUBTOUR_TIME,	21005) \
+ f(SEP_FLOWHEUR_TIME,		21006) \
+ f(SEP_SMALLSUBTOUR_TIME,	21007) \
+ f(SEP_SECFLOW_TIME,		21008) \
+ f(SEP_LOCALCUT_TIME,		21009) \
 	/* end of list */
 
 #endif
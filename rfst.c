@@ -3,8 +3,8 @@
 	$Id: rfst.c,v 1.45 2023/04/03 17:07:49 warme Exp $
 
 	File:	rfst.c
-	Rev:	e-6
-	Date:	04/03/2023
+	Rev:	e-9
+	Date:	10/18/2026
 
 	Copyright (c) 1998, 2023 by Martin Zachariasen.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -47,6 +47,17 @@
 		: Fix -Wall issues.
 	e-6:	04/03/2023	warme
 		: Fix -Wall issue.
+	e-7:	10/18/2026	warme
+		: Grow the FSTs from different roots on several
+		:  threads, merging the results in a fixed order.
+		: Fix battery score of new and zero-length FSTs,
+		:  and give Steiner points a zero battery level.
+	e-8:	10/18/2026	warme
+		: Added FST_TIME_LIMIT, a wall-clock limit.  When it
+		:  is set, FSTs are grown in passes, starting with
+		:  a size limit of 3.
+	e-9:	10/18/2026	warme
+		: Allocate the RFST list from arenas.
 
 ************************************************************************/
 
@@ -63,8 +74,10 @@
 #include "logic.h"
 #include <math.h>
 #include "memory.h"
+#include "parallel.h"
 #include "parmblk.h"
 #include "point.h"
+#include "polltime.h"
 #include "prepostlude.h"
 #include "rmst.h"
 #include "sortfuncs.h"
@@ -90,6 +103,14 @@ gst_hg_ptr gst_generate_rfsts (int,
 #define KAHNG_ROBINS_HEURISTIC	0
 #define DO_STATISTICS		0
 
+/*
+ * The roots from which FSTs are grown are divided into about
+ * TASKS_PER_THREAD tasks per thread, so that the threads stay busy
+ * even when some tasks take much longer than others.
+ */
+
+#define TASKS_PER_THREAD	8
+
 
 /*
  * Local Types
@@ -101,6 +122,22 @@ struct ibuf {
 	int		buf [1];
 };
 
+struct rfst_task {
+	int		dir;		/* Growth direction */
+	int		first;		/* First root terminal */
+	int		last;		/* Last root terminal + 1 */
+	struct rlist *	fsts;		/* FSTs found, linked by forw */
+	bool		timed_out;	/* Stopped early by the time limit */
+};
+
+struct rfst_batch {
+	struct rinfo *	rip;		/* The global RFST info */
+	struct gst_param *
+			params;		/* Parameters */
+	struct rfst_task * tasks;	/* The tasks */
+	struct rinfo *	rips;		/* Private RFST info per thread */
+};
+
 
 /*
  * Local Routines
@@ -130,6 +167,7 @@ static bool		diamond_empty (struct rinfo *,
 				       struct point *,
 				       int,
 				       int);
+static struct rlist **	find_rfst (struct rinfo *, int *, int, int *);
 static void		grow_RFST (struct rinfo *	rip,
 				   int			size,
 				   dist_t		length,
@@ -138,6 +176,12 @@ static void		grow_RFST (struct rinfo *	rip,
 				   dist_t *		ub_shortleg,
 				   int			longindex,
 				   struct gst_param *	params);
+static bool		grow_rfsts_in_parallel (struct rinfo *,
+						struct gst_param *);
+static void		insert_rfst (struct rinfo *,
+				     struct rlist **,
+				     struct full_set *,
+				     int);
 static int		lrindex_dir_0 (struct point *, struct point *);
 static int		lrindex_dir_1 (struct point *, struct point *);
 static int		lrindex_dir_2 (struct point *, struct point *);
@@ -145,6 +189,7 @@ static int		lrindex_dir_3 (struct point *, struct point *);
 static void		renumber_terminals (struct rinfo *,
 					    struct pset *,
 					    int *);
+static void		rfst_task (void *, int, int);
 static dist_t		test_and_save_fst (struct rinfo *,
 					   int,
 					   dist_t,
@@ -250,6 +295,9 @@ gst_proplist_ptr	plist;
 	T0 = _gst_get_cpu_time ();
 	Tn = T0;
 
+	_gst_start_wall_poll (&(rinfo.fst_poll), params -> fst_time_limit);
+	rinfo.complete_size = 0;
+
 	rinfo.x_order = _gst_heapsort_x (pts);
 
 	if (timing NE NULL) {
@@ -345,6 +393,11 @@ gst_proplist_ptr	plist;
 	gst_set_dbl_property (cip -> proplist,
 			      GST_PROP_HG_GENERATION_TIME,
 			      _gst_cpu_time_t_to_double_seconds (Tn - T0));
+	if (rinfo.complete_size > 0) {
+		gst_set_int_property (plist,
+				      GST_PROP_HG_COMPLETE_FST_SIZE,
+				      rinfo.complete_size);
+	}
 
 	count = 0;
 	for (i = 0; i < rinfo.ntrees; i++) {
@@ -418,14 +471,17 @@ cpu_time_t *		Tn
 {
 int			i;
 int			n;
-int			dir;
 int			nedges;
+int			size;
+int			done;
+bool			ok;
+cpu_time_t		t0;
+cpu_time_t		t1;
 struct pset *		pts;
 struct edge *		ep;
 struct edge *		mst_edges;
 struct rlist *		rp;
 dist_t			mst_len;
-double			ub_shortleg [2];
 char			buf1 [32];
 int			max_fst_size;
 gst_channel_ptr		timing;
@@ -515,35 +571,62 @@ gst_channel_ptr		timing;
 	}
 	rip -> list.forw	= &(rip -> list);
 	rip -> list.back	= &(rip -> list);
+	_gst_arena_init (&(rip -> list_mem), 1024 * sizeof (struct rlist));
 
 	rip -> fsts_checked = 0;
 
-	ub_shortleg [0] = INF_DISTANCE;
-	ub_shortleg [1] = INF_DISTANCE;
 	if (max_fst_size EQ 0) max_fst_size = n;
 
-	for (dir = 0; dir < 2; dir++) {
-		for (i = 0; i < n; i++) {
-			rip -> terms [0]	= i;
-			rip -> maxedges [i]	= 0.0;
-			/* Long leg candidate list is initially empty,	*/
-			/* add candidates on demand.			*/
-			rip -> longterms [0]	= i;
-			rip -> longterms [1]	= -1;
-			grow_RFST (rip,
-				   1,		/* size */
-				   0.0,		/* length */
-				   dir,
-				   0.0,		/* ub_length */
-				   ub_shortleg,
-				   0,		/* longindex */
-				   params);
-
-#if DO_STATISTICS
-			for (j = 0; longterms [j] >= 0; j++) {
-				++long_leg_count;
+	if (params -> fst_time_limit EQ 0) {
+		rip -> max_size = params -> max_fst_size;
+		(void) grow_rfsts_in_parallel (rip, params);
+	}
+	else {
+		/* FSTs are grown from each root in turn, so a time	*/
+		/* limit could leave FSTs of every size missing.	*/
+		/* Instead, grow in passes that are each limited to a	*/
+		/* maximum size, starting with 3 terminals.  The small	*/
+		/* FSTs account for most of the work, so once a pass	*/
+		/* fits twice into the remaining time, the next pass	*/
+		/* is given no size limit.  Otherwise the limit grows	*/
+		/* by one.  The FSTs found again by each pass are	*/
+		/* discarded as duplicates.				*/
+		done = 2;
+		size = 3;
+		for (;;) {
+			rip -> max_size		= size;
+			rip -> size_limited	= FALSE;
+			t0 = _gst_get_wall_time ();
+			ok = grow_rfsts_in_parallel (rip, params);
+			t1 = _gst_get_wall_time ();
+			if (timing NE NULL) {
+				_gst_convert_delta_cpu_time (buf1, Tn);
+				gst_channel_printf (timing, "Size %3d growth:        %s\n", size, buf1);
 			}
-#endif
+			if (NOT ok) {
+				rip -> complete_size = done;
+				break;
+			}
+			if ((NOT rip -> size_limited) OR
+			    (size >= max_fst_size)) break;
+			done = size;
+			if (TIME_LIMIT_REACHED (params -> fst_time_limit,
+						&(rip -> fst_poll))) {
+				rip -> complete_size = done;
+				break;
+			}
+			if (t1 + 2 * (t1 - t0) <= rip -> fst_poll.end_time) {
+				size = max_fst_size;
+			}
+			else {
+				++size;
+			}
+		}
+		if ((timing NE NULL) AND (rip -> complete_size > 0)) {
+			gst_channel_printf (timing,
+					    "- time limit reached, FSTs complete"
+					    " up to size %d\n",
+					    rip -> complete_size);
 		}
 	}
 
@@ -605,6 +688,217 @@ gst_channel_ptr		timing;
 	memset (&(rip -> zt),	0, sizeof (rip -> zt));
 }
 
+/*
+ * Grow the FSTs rooted at each terminal, in each of the two backbone
+ * directions.  The roots are divided into tasks that run on several
+ * threads.  Each thread grows its FSTs using a private copy of the
+ * recursion arrays, and saves them in a private hash table that is
+ * emptied after every root.  The FSTs of each task are then merged
+ * into the global list in task order, keeping the shortest FST for
+ * each set of terminals.  The result therefore does not depend upon
+ * the number of threads.  Returns FALSE if the FST time limit stopped
+ * any of the tasks.
+ */
+
+	static
+	bool
+grow_rfsts_in_parallel (
+
+struct rinfo *		rip,		/* IN/OUT - global RFST info */
+struct gst_param *	params		/* IN - parameters */
+)
+{
+int			i;
+int			k;
+int			n;
+int			chunk;
+int			nper;
+int			ntasks;
+int			nthreads;
+struct rinfo *		tip;
+struct rfst_task *	tp;
+struct rlist *		rp;
+struct rlist *		rp_next;
+struct rlist **		hookp;
+bool			ok;
+struct full_set *	fsp;
+struct rfst_batch	batch;
+
+	n = rip -> pts -> n;
+
+	nthreads = _gst_resolve_num_threads (params -> num_threads);
+
+	chunk = n / (TASKS_PER_THREAD * nthreads);
+	if (chunk < 1) {
+		chunk = 1;
+	}
+	nper	= (n + chunk - 1) / chunk;
+	ntasks	= 2 * nper;
+
+	batch.rip	= rip;
+	batch.params	= params;
+	batch.tasks	= NEWA (ntasks, struct rfst_task);
+	for (i = 0; i < ntasks; i++) {
+		tp = &(batch.tasks [i]);
+		tp -> dir	= i / nper;
+		tp -> first	= (i % nper) * chunk;
+		tp -> last	= tp -> first + chunk;
+		if (tp -> last > n) {
+			tp -> last = n;
+		}
+		tp -> fsts	= NULL;
+		tp -> timed_out	= FALSE;
+	}
+
+	batch.rips = NEWA (nthreads, struct rinfo);
+	for (i = 0; i < nthreads; i++) {
+		tip = &(batch.rips [i]);
+		*tip = *rip;
+		tip -> terms		= NEWA (n, int);
+		tip -> longterms	= NEWA (n + 1, int);
+		tip -> maxedges		= NEWA (n, dist_t);
+		tip -> shortterm	= NEWA (n, int);
+		tip -> lrindex		= NEWA (n, int);
+		tip -> term_check	= NEWA (n, bool);
+		tip -> hash		= NEWA (n, struct rlist *);
+		for (k = 0; k < n; k++) {
+			tip -> lrindex [k] = 0;
+			tip -> term_check [k] = FALSE;
+			tip -> hash [k] = NULL;
+		}
+		tip -> list.forw	= &(tip -> list);
+		tip -> list.back	= &(tip -> list);
+		_gst_arena_init (&(tip -> list_mem), 1024 * sizeof (struct rlist));
+		tip -> fsts_checked	= 0;
+		tip -> size_limited	= FALSE;
+	}
+
+	(void) _gst_parallel_for (nthreads, ntasks, rfst_task, &batch);
+
+	for (i = 0; i < nthreads; i++) {
+		tip = &(batch.rips [i]);
+		rip -> fsts_checked += tip -> fsts_checked;
+		if (tip -> size_limited) {
+			rip -> size_limited = TRUE;
+		}
+		free ((char *) (tip -> hash));
+		free ((char *) (tip -> term_check));
+		free ((char *) (tip -> lrindex));
+		free ((char *) (tip -> shortterm));
+		free ((char *) (tip -> maxedges));
+		free ((char *) (tip -> longterms));
+		free ((char *) (tip -> terms));
+	}
+
+	/* Merge the FSTs of each task, in order.  A task stopped by	*/
+	/* the time limit may have missed FSTs of any size it grows.	*/
+	ok = TRUE;
+	for (i = 0; i < ntasks; i++) {
+		if (batch.tasks [i].timed_out) {
+			ok = FALSE;
+		}
+		for (rp = batch.tasks [i].fsts; rp NE NULL; rp = rp_next) {
+			rp_next = rp -> forw;
+			fsp = rp -> fst;
+
+			hookp = find_rfst (rip, fsp -> tlist, fsp -> terminals -> n, &k);
+			if ((hookp NE NULL) AND
+			    ((*hookp) -> fst -> tree_len <= fsp -> tree_len)) {
+				_gst_free_full_set (fsp);
+				continue;
+			}
+			insert_rfst (rip, hookp, fsp, k);
+		}
+	}
+
+	/* The tasks' lists were allocated from their threads' arenas. */
+	for (i = 0; i < nthreads; i++) {
+		_gst_arena_free (&(batch.rips [i].list_mem));
+	}
+
+	free ((char *) (batch.rips));
+	free ((char *) (batch.tasks));
+
+	return (ok);
+}
+
+/*
+ * Grow the FSTs rooted at each terminal of one task, on behalf of
+ * grow_rfsts_in_parallel().
+ */
+
+	static
+	void
+rfst_task (
+
+void *		arg,		/* IN/OUT - the batch */
+int		task,		/* IN - task to perform */
+int		thread		/* IN - thread executing task */
+)
+{
+int			i;
+int			j;
+int			k;
+int			size;
+struct rfst_batch *	bp;
+struct rfst_task *	tp;
+struct rinfo *		rip;
+struct rlist *		rp;
+struct rlist **		tail;
+int *			tlist;
+double			ub_shortleg [2];
+
+	bp	= (struct rfst_batch *) arg;
+	tp	= &(bp -> tasks [task]);
+	rip	= &(bp -> rips [thread]);
+
+	tail = &(tp -> fsts);
+	for (i = tp -> first; i < tp -> last; i++) {
+		if (TIME_LIMIT_REACHED (bp -> params -> fst_time_limit,
+					&(rip -> fst_poll))) {
+			tp -> timed_out = TRUE;
+			break;
+		}
+
+		ub_shortleg [0] = INF_DISTANCE;
+		ub_shortleg [1] = INF_DISTANCE;
+
+		rip -> terms [0]	= i;
+		rip -> maxedges [i]	= 0.0;
+		/* Long leg candidate list is initially empty,	*/
+		/* add candidates on demand.			*/
+		rip -> longterms [0]	= i;
+		rip -> longterms [1]	= -1;
+		grow_RFST (rip,
+			   1,		/* size */
+			   0.0,		/* length */
+			   tp -> dir,
+			   0.0,		/* ub_length */
+			   ub_shortleg,
+			   0,		/* longindex */
+			   bp -> params);
+
+		/* Empty the hash table, and move the FSTs of this	*/
+		/* root to the end of the task's list.			*/
+		for (rp = rip -> list.forw;
+		     rp NE &(rip -> list);
+		     rp = rp -> forw) {
+			size = rp -> size;
+			tlist = rp -> fst -> tlist;
+			k = 0;
+			for (j = 0; j < size; j++) {
+				k += tlist [j];
+			}
+			rip -> hash [k % rip -> pts -> n] = NULL;
+			*tail = rp;
+			tail = &(rp -> forw);
+		}
+		*tail = NULL;
+		rip -> list.forw	= &(rip -> list);
+		rip -> list.back	= &(rip -> list);
+	}
+}
+
 /*
  * Sort the terminals by both X and Y coordinates, and then create the
  * successor lists.  These permit us to start from a random terminal and
@@ -1314,7 +1608,10 @@ try_typeI:
 
 try_growing:
 		/* Should we generate larger FSTs? */
-		if (size >= params -> max_fst_size) continue;
+		if (size >= rip -> max_size) {
+			rip -> size_limited = TRUE;
+			continue;
+		}
 
 		/* Upper bound (A). */
 		d1 = ub_shortleg [lr];
@@ -1414,16 +1711,12 @@ int			nstein;
 int			nedges;
 int			last;
 int *			terms;
-int *			tlist;
 struct pset *		pts;
 struct point *		p1;
 struct point *		p2;
 struct point *		p3;
 struct point *		p4;
-struct rlist *		rp;
 struct rlist **		hookp;
-struct rlist *		rp1;
-struct rlist *		rp2;
 int *			new_tlist;
 struct pset *		new_terms;
 struct pset *		new_steiners;
@@ -1439,7 +1732,7 @@ struct point		s2;
 	terms = rip -> terms;
 
 	/* Is this FST too large? */
-	if (size > params -> max_fst_size) return (length);
+	if (size > rip -> max_size) return (length);
 
 	if (size > 2) {
 		b = _gst_bmst_terms_length (terms, size, rip -> bsd);
@@ -1572,57 +1865,14 @@ struct point		s2;
 	}
 #endif
 
-	/* General duplicate test.  We use a hash table, for speed.	*/
-	/* For correctness, the hash function must not depend upon the	*/
-	/* order of the terminals in the FST.  A simple checksum has	*/
-	/* this property and tends to avoid favoring any one bucket.	*/
-
-	/* Compute hash and prepare for rapid set comparison. */
-	k = 0;
-	for (i = 0; i < size; i++) {
-		j = terms [i];
-		rip -> term_check [j] = TRUE;
-		k += j;
-	}
-	k %= pts -> n;
-
-	hookp = &(rip -> hash [k]);
-	for (;;) {
-		rp = *hookp;
-		if (rp EQ NULL) break;
-		if (rp -> size EQ size) {
-			tlist = rp -> fst -> tlist;
-			for (i = 0; ; i++) {
-				if (i >= size) goto found_rfst;
-				if (NOT rip -> term_check [tlist [i]]) break;
-			}
-		}
-		hookp = &(rp -> next);
-	}
-
-found_rfst:
-
-	for (i = 0; i < size; i++) {
-		rip -> term_check [terms [i]] = FALSE;
-	}
+	hookp = find_rfst (rip, terms, size, &k);
 
-	if (rp NE NULL) {
+	if (hookp NE NULL) {
 		/* An FST for these terminals already exists. */
-		fsp = rp -> fst;
+		fsp = (*hookp) -> fst;
 		if (fsp -> tree_len <= length) {
 			return (fsp -> tree_len);
 		}
-		/* The new one is shorter!  Delete the old one. */
-		*hookp = rp -> next;
-		rp2 = rp -> forw;
-		rp1 = rp -> back;
-		rp2 -> back = rp1;
-		rp1 -> forw = rp2;
-		free ((char *) (fsp -> terminals));
-		free ((char *) (fsp -> steiners));
-		free ((char *) (fsp -> edges));
-		free ((char *) fsp);
-		free ((char *) rp);
 	}
 
 	/* Build FST graph in edge list form. */
@@ -1657,6 +1907,10 @@ found_rfst:
 	}
 
 	new_steiners = (nstein EQ 0) ? NULL : NEW_PSET (nstein);
+	for (i = 0; i < nstein; i++) {
+		/* Steiner points have no battery. */
+		new_steiners -> a [i].battery = 0.0;
+	}
 	edges = NEWA (nedges, struct edge);
 
 	nedges = build_rfst_graph (rip,
@@ -1682,32 +1936,124 @@ found_rfst:
 	fsp -> next		= NULL;
 	fsp -> tree_num		= 0;
 	fsp -> tree_len		= length;
-	fsp->battery_score = 0.0;
-	for (i = 0; i < fsp->terminals->n; i++) {
-		int idx = fsp->tlist[i] - 1;
-		fsp->battery_score += pts->a[idx].battery / 100.0;  /* Normalize battery by dividing by 100 */
-	}
 	fsp -> tlist		= new_tlist;
 	fsp -> terminals	= new_terms;
 	fsp -> steiners		= new_steiners;
 	fsp -> nedges		= nedges;
 	fsp -> edges		= edges;
+	fsp->battery_score = 0.0;
+	for (i = 0; i < size; i++) {
+		fsp->battery_score += pts->a[new_tlist[i]].battery / 100.0;  /* Normalize battery by dividing by 100 */
+	}
+
+	/* Save it, replacing any longer FST for the same terminals. */
+	insert_rfst (rip, hookp, fsp, k);
+
+	return (length);
+}
+
+/*
+ * Look for a saved FST having the given set of terminals.  Returns the
+ * hash table link that points to it, or NULL if there is none.  The
+ * hash bucket for this set of terminals is returned in *bucket.
+ */
 
-	rp = NEW (struct rlist);
+	static
+	struct rlist **
+find_rfst (
+
+struct rinfo *	rip,		/* IN - The global RFST info */
+int *		terms,		/* IN - terminals of FST */
+int		size,		/* IN - number of terminals */
+int *		bucket		/* OUT - hash bucket */
+)
+{
+int			i, j, k;
+struct rlist *		rp;
+struct rlist **		hookp;
+int *			tlist;
+
+	/* General duplicate test.  We use a hash table, for speed.	*/
+	/* For correctness, the hash function must not depend upon the	*/
+	/* order of the terminals in the FST.  A simple checksum has	*/
+	/* this property and tends to avoid favoring any one bucket.	*/
+
+	/* Compute hash and prepare for rapid set comparison. */
+	k = 0;
+	for (i = 0; i < size; i++) {
+		j = terms [i];
+		rip -> term_check [j] = TRUE;
+		k += j;
+	}
+	k %= rip -> pts -> n;
+	*bucket = k;
+
+	hookp = &(rip -> hash [k]);
+	for (;;) {
+		rp = *hookp;
+		if (rp EQ NULL) break;
+		if (rp -> size EQ size) {
+			tlist = rp -> fst -> tlist;
+			for (i = 0; ; i++) {
+				if (i >= size) goto found_rfst;
+				if (NOT rip -> term_check [tlist [i]]) break;
+			}
+		}
+		hookp = &(rp -> next);
+	}
+
+found_rfst:
+
+	for (i = 0; i < size; i++) {
+		rip -> term_check [terms [i]] = FALSE;
+	}
+
+	return ((rp EQ NULL) ? NULL : hookp);
+}
+
+/*
+ * Save the given FST, replacing the saved FST that hookp points to (if
+ * hookp is not NULL), which has the same terminals.
+ */
+
+	static
+	void
+insert_rfst (
+
+struct rinfo *		rip,		/* IN/OUT - The global RFST info */
+struct rlist **		hookp,		/* IN - link to FST to replace */
+struct full_set *	fsp,		/* IN - FST to save */
+int			k		/* IN - hash bucket of FST */
+)
+{
+struct rlist *		rp;
+struct rlist *		rp1;
+struct rlist *		rp2;
+
+	if (hookp NE NULL) {
+		/* Delete the old one. */
+		rp = *hookp;
+		*hookp = rp -> next;
+		rp2 = rp -> forw;
+		rp1 = rp -> back;
+		rp2 -> back = rp1;
+		rp1 -> forw = rp2;
+		_gst_free_full_set (rp -> fst);
+	}
+
+	rp = ARENA_NEW (&(rip -> list_mem), struct rlist);
 
 	rp2 = &(rip -> list);
 	rp1 = rp2 -> back;
 	rp -> back	= rp1;
 	rp -> forw	= rp2;
 	rp -> next	= rip -> hash [k];
-	rp -> size	= size;
+	rp -> size	= fsp -> terminals -> n;
 	rp -> fst	= fsp;
 
 	rp1 -> forw	= rp;
 	rp2 -> back	= rp;
 	rip -> hash [k] = rp;
-
-	return (length);
 }
 
 /*
@@ -2014,7 +2360,7 @@ int *			tlist;
 
 /*
  * Link all of the FSTs together into one long list and number them
- * each sequentially.  Free the doubly-linked rlists as we go.
+ * each sequentially.  The doubly-linked rlists are then freed.
  */
 
 	static
@@ -2027,7 +2373,6 @@ struct rinfo *		rip		/* IN - global RFST info */
 int			i;
 struct rlist *		rp1;
 struct rlist *		rp2;
-struct rlist *		rp3;
 struct full_set *	fsp;
 struct full_set **	hookp;
 
@@ -2035,19 +2380,17 @@ struct full_set **	hookp;
 
 	rp2 = &(rip -> list);
 	i = 0;
-	for (rp1 = rp2 -> forw; rp1 NE rp2; ) {
+	for (rp1 = rp2 -> forw; rp1 NE rp2; rp1 = rp1 -> forw) {
 		fsp = rp1 -> fst;
 		fsp -> tree_num = i++;
 		*hookp = fsp;
 		hookp = &(fsp -> next);
-		rp3 = rp1;
-		rp1 = rp1 -> forw;
-		free ((char *) rp3);
 	}
 	*hookp = NULL;
 
 	rip -> list.forw = rp2;
 	rip -> list.back = rp2;
+	_gst_arena_free (&(rip -> list_mem));
 
 	/* Make it easy to add zero-length FSTs onto the end. */
 	rip -> ntrees	= i;
@@ -2112,15 +2455,12 @@ struct full_set *	fsp;
 			fsp -> next	 = NULL;
 			fsp -> tree_num	 = (rip -> ntrees)++;
 			fsp -> tree_len	 = 0.0;
-			fsp->battery_score = 0.0; /* PSW */
-			for (i = 0; i < fsp->terminals->n; i++) {
-				fsp->battery_score += fsp->terminals->a[i].battery / 100.0;  /* Normalize battery by dividing by 100 */
-			}
 			fsp -> tlist	 = tlist;
 			fsp -> terminals = terms;
 			fsp -> steiners	 = NULL;
 			fsp -> nedges	 = 1;
 			fsp -> edges	 = edges;
+			fsp->battery_score = (pts->a[t].battery + pts->a[u].battery) / 100.0; /* PSW */
 
 			*(rip -> hookp) = fsp;
 			rip -> hookp	= &(fsp -> next);
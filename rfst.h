@@ -3,8 +3,8 @@
 	$Id: rfst.h,v 1.11 2022/11/19 13:45:54 warme Exp $
 
 	File:	rfst.h
-	Rev:	e-4
-	Date:	10/09/2016
+	Rev:	e-6
+	Date:	10/18/2026
 
 	Copyright (c) 1998, 2022 by Martin Zachariasen.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -33,6 +33,10 @@
 		: Reorganize include files.
 	e-4:	10/09/2016	warme
 		: Fix more -Wall issues.
+	e-5:	10/18/2026	warme
+		: Add FST size and time limits to rinfo.
+	e-6:	10/18/2026	warme
+		: Allocate the RFST list from an arena.
 
 ************************************************************************/
 
@@ -42,6 +46,8 @@
 #include "bitmaskmacros.h"
 #include "geomtypes.h"
 #include "gsttypes.h"
+#include "memory.h"
+#include "polltime.h"
 #include <stddef.h>
 
 struct bsd;
@@ -129,10 +135,18 @@ struct rinfo {
 
 	struct rlist **	hash;		/* FST hash table */
 	struct rlist	list;		/* Head of circular RFST list */
+	struct arena	list_mem;	/* Memory for the RFST list */
 
 	int		ntrees;		/* Final number of FSTs */
 	struct full_set * full_sets;	/* Final list of FSTs */
 	struct full_set ** hookp;	/* For adding to end of FST list */
+
+	int		max_size;	/* Largest FST to grow */
+	bool		size_limited;	/* Did max_size stop any growth? */
+
+	struct cpu_poll	fst_poll;	/* Time limit of FST generation */
+	int		complete_size;	/* Largest size of which all FSTs */
+					/* were generated (0 = every size) */
 };
 
 /*
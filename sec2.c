@@ -3,8 +3,8 @@
 	$Id: sec2.c,v 1.14 2023/04/03 17:06:05 warme Exp $
 
 	File:	sec2.c
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-7
+	Date:	10/18/2026
 
 	Copyright (c) 1997, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -36,6 +36,15 @@
 		: Fix -Wall issues.
 	e-5:	04/03/2023	warme
 		: Fix extra parens in disabled code.
+	e-6:	10/18/2026	warme
+		: Use the push-relabel flow solver.  Build one network
+		:  per component and force successive vertices by
+		:  changing sink capacities only, so that each flow
+		:  problem is warm-started from the previous preflow.
+	e-7:	10/18/2026	warme
+		: Solve the batch of flow sub-problems in parallel,
+		:  and discard duplicate violations before adding
+		:  them to the constraint list.
 
 ************************************************************************/
 
@@ -49,6 +58,7 @@
 #include "geosteiner.h"
 #include "logic.h"
 #include "memory.h"
+#include "parallel.h"
 #include "parmblk.h"
 #include "sec_comp.h"
 #include "sec_heur.h"
@@ -74,6 +84,16 @@ struct constraint *	_gst_sec_flow_separator (
 	/* None */
 
 
+/*
+ * Local Constants
+ */
+
+	/* Number of consecutive flow sub-problems solved (warm-started	*/
+	/* one from the next) by a single task.  The tasks do not	*/
+	/* depend upon the number of threads, so neither do the cuts.	*/
+#define	SEC_FLOW_CHUNK		8
+
+
 /*
  * Local Types
  */
@@ -81,9 +101,18 @@ struct constraint *	_gst_sec_flow_separator (
 struct sec_flow_info {
 
 	/* Data used by the flow solver... */
-	struct flow_prob	prob;	/* The network flow formulation */
-	struct flow_soln	soln;	/* The network flow solution */
-	struct flow_temp	temp;	/* Temporary data structures */
+	struct pr_network	net;	/* The network flow formulation */
+	bitmap_t *		cut;	/* Nodes on source side of cut */
+};
+
+struct sec_batch {
+	struct comp *		comp;	/* The congested component */
+	int			k;	/* Number of flow sub-problems */
+	int			nmasks;	/* Size of each vertex mask */
+	int *			order;	/* Vertex forced in each sub-problem */
+	double *		z;	/* f(S) of each sub-problem */
+	bitmap_t *		S;	/* Most violated S of each one */
+	struct sec_flow_info *	flows;	/* Flow formulation per thread */
 };
 
 
@@ -94,13 +123,32 @@ struct sec_flow_info {
 
 static void			build_SEC_flow_formulation (
 					struct comp *		comp,
-					int			t,
 					struct sec_flow_info *	flowp);
-static double			do_flow_problem (struct comp *	comp,
-						 int		t,
-						 bitmap_t *	S);
+static double			do_flow_problem (
+					struct sec_flow_info *	flowp,
+					struct comp *		comp,
+					int			t,
+					bitmap_t *		S);
+static void			exclude_vertex (
+					struct sec_flow_info *	flowp,
+					struct comp *		comp,
+					int			t);
+static struct constraint *	find_duplicate_constraint (
+					struct constraint *	newp,
+					struct constraint *	cp,
+					struct constraint *	endp,
+					int			kmasks);
 static void			free_SEC_flow_formulation (
 					struct sec_flow_info *	flowp);
+static struct constraint *	separate_component (
+					struct comp *		comp,
+					double *		x,
+					struct bbinfo *		bbip,
+					struct constraint *	cp);
+static void			solve_batch_task (
+					void *			arg,
+					int			task,
+					int			thread);
 
 
 /*
@@ -108,7 +156,7 @@ static void			free_SEC_flow_formulation (
  */
 
 	/* none */
-
+
 /*
  * This is the main routine for the NEW deterministic separation
  * procedure for the generalized Subtour Elimination Constraints.  This
@@ -129,16 +177,14 @@ struct bbinfo *		bbip,		/* IN - branch-and-bound info */
 struct constraint *	cp		/* IN - existing constraints */
 )
 {
-int			t;
 struct comp *		comp;
 struct gst_hypergraph *	cip;
-double			z;
-bitmap_t *		S;
 gst_channel_ptr		trace;
 
 	cip = bbip -> cip;
 	trace = bbip -> params -> print_solve_trace;
 	(void) trace;
+	(void) cip;
 
 #if 0
 	/* Two problems here:						*/
@@ -150,8 +196,6 @@ gst_channel_ptr		trace;
 	_gst_plot_lp_solution (trace, cip, "LP solution to separate", x, BIG_PLOT);
 #endif
 
-	S = NEWA (cip -> num_vert_masks, bitmap_t);
-
 	for (;;) {
 		comp = *comp_hookp;
 		if (comp EQ NULL) break;
@@ -181,74 +225,267 @@ gst_channel_ptr		trace;
 			continue;
 		}
 
-		/* Find the LEAST congested vertex.  this is the one	*/
-		/* we are going to try to force into the solution,	*/
-		/* since that is the one we would like to delete from	*/
-		/* the set afterward...					*/
-		t = _gst_find_least_congested_vertex (NULL, comp);
+		/* Force a batch of vertices, one at a time, finding	*/
+		/* the worst SEC violation involving each.  These	*/
+		/* vertices are then deleted from the component all at	*/
+		/* once, and we simplify whatever remains.		*/
+		cp = separate_component (comp, x, bbip, cp);
 
-#if 0
-		gst_channel_printf (trace,
-			" %% -------------------------"
-			    "-------------------------\n"
-			" %% separating comp with %d verts, %d edges,"
-			    " forcing vertex %d\n"
-			" %% -------------------------"
-			    "-------------------------\n",
-			comp -> num_verts, comp -> num_edges,
-			comp -> rverts [t] [0]);
-#endif
+		*comp_hookp = _gst_delete_vertex_from_component (-1, comp, bbip);
+	}
 
-		/* Find worst SEC violation involving vertex t. */
-		z = do_flow_problem (comp, t, S);
+	return (cp);
+}
+
+/*
+ * This routine separates a batch of flow sub-problems on a single
+ * congested component.  We repeatedly force the LEAST congested
+ * remaining vertex t into the solution, find the worst SEC violation
+ * involving t, and then exclude t from all subsequent sub-problems.
+ *
+ * Since the congestion of each vertex does not depend upon which
+ * vertices have been excluded, the entire sequence of forced vertices
+ * is known in advance.  The sub-problems are therefore independent of
+ * each other given the LP solution, and we solve them concurrently.
+ * Each task solves SEC_FLOW_CHUNK consecutive sub-problems, using the
+ * flow network of the thread executing it.  Within a task, these
+ * sub-problems differ only in their sink capacities, so that each max
+ * flow is warm-started from the preflow of the previous one.
+ *
+ * The violations are then checked (and strengthened) serially, in the
+ * order the vertices were forced, discarding any duplicates.  The
+ * constraints generated are therefore the same no matter how many
+ * threads are used.
+ *
+ * We stop once half of the vertices (or all but sec_enum_limit of them)
+ * have been excluded.  The excluded vertices are removed from the
+ * component's vertex mask so that the caller can delete them and
+ * re-simplify the (smaller) remainder.
+ */
 
-#if 0
-#if 0
-		{
-			int i, kmasks, *ip1, *ip2;
-			bitmap_t * RS;
-			kmasks = cip -> num_vert_masks;
-			RS = NEWA (kmasks, bitmap_t);
-			for (i = 0; i < kmasks; i++) {
-				RS [i] = 0;
-			}
-			for (i = 0; i < comp -> num_verts; i++) {
-				if (NOT BITON (S, i)) continue;
-				ip1 = comp -> rverts [i];
-				ip2 = comp -> rverts [i + 1];
-				while (ip1 < ip2) {
-					int j = *ip1++;
-					SETBIT (RS, j);
-				}
+	static
+	struct constraint *
+separate_component (
+
+struct comp *		comp,		/* IN/OUT - congested component */
+double *		x,		/* IN - the LP solution to separate */
+struct bbinfo *		bbip,		/* IN - branch-and-bound info */
+struct constraint *	cp		/* IN - existing constraints */
+)
+{
+int			i;
+int			j;
+int			k;
+int			nverts;
+int			nmasks;
+int			kmasks;
+int			limit;
+int			ntasks;
+int			nthreads;
+bitmap_t *		avail;
+struct constraint *	batch_end;
+struct constraint *	cp2;
+struct constraint *	prev;
+struct constraint **	hookp;
+struct sec_batch	batch;
+
+	nverts = comp -> num_verts;
+	nmasks = BMAP_ELTS (nverts);
+	kmasks = bbip -> cip -> num_vert_masks;
+
+	limit = nverts / 2;
+	if (limit < bbip -> params -> sec_enum_limit) {
+		limit = bbip -> params -> sec_enum_limit;
+	}
+	k = nverts - limit;
+	if (k < 1) {
+		k = 1;
+	}
+
+	avail = NEWA (nmasks, bitmap_t);
+	for (i = 0; i < nmasks; i++) {
+		avail [i] = 0;
+	}
+	for (i = 0; i < nverts; i++) {
+		SETBIT (avail, i);
+	}
+
+	batch.comp	= comp;
+	batch.k		= k;
+	batch.nmasks	= nmasks;
+	batch.order	= NEWA (k, int);
+	batch.z		= NEWA (k, double);
+	batch.S		= NEWA (k * nmasks, bitmap_t);
+
+	/* Find the order in which vertices are forced:  always the	*/
+	/* LEAST congested remaining vertex, since that is the one we	*/
+	/* would like to delete from the set afterward...		*/
+	for (j = 0; j < k; j++) {
+		i = _gst_find_least_congested_vertex (avail, comp);
+		batch.order [j] = i;
+		CLRBIT (avail, i);
+	}
+
+	ntasks = (k + SEC_FLOW_CHUNK - 1) / SEC_FLOW_CHUNK;
+	nthreads = _gst_resolve_num_threads (bbip -> params -> num_threads);
+	if (nthreads > ntasks) {
+		nthreads = ntasks;
+	}
+
+	batch.flows = NEWA (nthreads, struct sec_flow_info);
+	for (i = 0; i < nthreads; i++) {
+		batch.flows [i].cut = NULL;
+	}
+
+	(void) _gst_parallel_for (nthreads, ntasks, solve_batch_task, &batch);
+
+	for (i = 0; i < nthreads; i++) {
+		if (batch.flows [i].cut NE NULL) {
+			free_SEC_flow_formulation (&batch.flows [i]);
+		}
+	}
+	free ((char *) batch.flows);
+
+	/* Add the violations to the list, in order.  Discard any	*/
+	/* that duplicate one already found by this batch.		*/
+	batch_end = cp;
+	for (j = 0; j < k; j++) {
+		if (batch.z [j] >= (1.0 - FUZZ)) continue;
+
+		prev = cp;
+		cp = _gst_check_component_subtour (batch.S + j * nmasks,
+						   comp,
+						   cp,
+						   x,
+						   bbip);
+		hookp = &cp;
+		while ((cp2 = *hookp) NE prev) {
+			if (find_duplicate_constraint (cp2,
+						       cp2 -> next,
+						       batch_end,
+						       kmasks) NE NULL) {
+				*hookp = cp2 -> next;
+				free ((char *) (cp2 -> mask));
+				free ((char *) cp2);
+				continue;
 			}
-			_gst_print_mask (trace, " S =", RS, cip -> num_verts);
-			free (RS);
+			hookp = &(cp2 -> next);
 		}
-#else
-		_gst_print_mask (trace, " S =", S, comp -> num_verts);
-#endif
-		gst_channel_printf (trace, "	f(S) = %-24.15g\n", z);
-#endif
+	}
 
-		if (z < (1.0 - FUZZ)) {
-			/* Add new violated constraint to the list... */
-			cp = _gst_check_component_subtour (S,
-							   comp,
-							   cp,
-							   x,
-							   bbip);
+	/* Mark the excluded vertices for deletion. */
+	_gst_create_comp_masks (comp);
+	for (i = 0; i < nverts; i++) {
+		if (NOT BITON (avail, i)) {
+			CLRBIT (comp -> vert_mask, i);
 		}
+	}
+
+	free ((char *) batch.S);
+	free ((char *) batch.z);
+	free ((char *) batch.order);
+	free ((char *) avail);
+
+	return (cp);
+}
+
+/*
+ * Solve one chunk of the flow sub-problems of a batch, using the flow
+ * formulation belonging to the given thread.  Vertices forced in the
+ * earlier chunks are excluded first.  Each task writes only to its own
+ * portion of the batch results.
+ */
+
+	static
+	void
+solve_batch_task (
+
+void *			arg,		/* IN/OUT - the batch */
+int			task,		/* IN - chunk to solve */
+int			thread		/* IN - thread executing task */
+)
+{
+int			i;
+int			j;
+int			j1;
+int			j2;
+int			t;
+struct sec_batch *	bp;
+struct sec_flow_info *	flowp;
+struct comp *		comp;
+
+	bp	= (struct sec_batch *) arg;
+	comp	= bp -> comp;
+	flowp	= &(bp -> flows [thread]);
+
+	if (flowp -> cut EQ NULL) {
+		build_SEC_flow_formulation (comp, flowp);
+	}
+	else {
+		/* Re-use this thread's network from a previous task.	*/
+		/* Discard its preflow, and un-exclude every vertex.	*/
+		_gst_pr_reset (&(flowp -> net));
+		for (i = 0; i < comp -> num_verts; i++) {
+			_gst_pr_set_sink_cap (&(flowp -> net), i, 0.0);
+		}
+	}
+
+	j1 = task * SEC_FLOW_CHUNK;
+	j2 = j1 + SEC_FLOW_CHUNK;
+	if (j2 > bp -> k) {
+		j2 = bp -> k;
+	}
+
+	for (j = 0; j < j1; j++) {
+		exclude_vertex (flowp, comp, bp -> order [j]);
+	}
+
+	for (j = j1; j < j2; j++) {
+		t = bp -> order [j];
+
+		/* Find worst SEC violation involving vertex t. */
+		bp -> z [j] = do_flow_problem (flowp,
+					       comp,
+					       t,
+					       bp -> S + j * bp -> nmasks);
 
 		/* We have found the worst violation (if any) involving	*/
 		/* vertex t.  We can now eliminate t from further	*/
 		/* consideration...					*/
-
-		*comp_hookp = _gst_delete_vertex_from_component (t, comp, bbip);
+		exclude_vertex (flowp, comp, t);
 	}
+}
+
+/*
+ * Find a constraint in the list from cp up to (but not including) endp
+ * that is identical to the given subtour constraint.
+ */
 
-	free ((char *) S);
+	static
+	struct constraint *
+find_duplicate_constraint (
 
-	return (cp);
+struct constraint *	newp,		/* IN - constraint to look for */
+struct constraint *	cp,		/* IN - list to search */
+struct constraint *	endp,		/* IN - end of list to search */
+int			kmasks		/* IN - size of subtour masks */
+)
+{
+int			i;
+
+	if (newp -> type NE CT_SUBTOUR) return (NULL);
+
+	for (; cp NE endp; cp = cp -> next) {
+		if (cp -> type NE CT_SUBTOUR) continue;
+		for (i = 0; i < kmasks; i++) {
+			if (cp -> mask [i] NE newp -> mask [i]) break;
+		}
+		if (i >= kmasks) {
+			return (cp);
+		}
+	}
+
+	return (NULL);
 }
 
 /*
@@ -443,13 +680,14 @@ gst_channel_ptr		trace;
 /*
  * This routine performs a single flow sub-problem.  We are given a
  * vertex to FORCE into the solution.  We find the worst SEC violation
- * involving that vertex.
+ * involving that vertex (and none of the previously excluded vertices).
  */
 
 	static
 	double
 do_flow_problem (
 
+struct sec_flow_info *	flowp,		/* IN/OUT - SEC flow formulation */
 struct comp *		comp,		/* IN - congested component */
 int			t,		/* IN - vertex to force */
 bitmap_t *		S		/* OUT - a most-violated subtour */
@@ -458,35 +696,50 @@ bitmap_t *		S		/* OUT - a most-violated subtour */
 int			i;
 int			j;
 int			k;
+int			e;
 int			size;
+int			nverts;
 int *			ip1;
 int *			ip2;
 double			sum;
 double			z;
-struct sec_flow_info	flow_info;
 
-	build_SEC_flow_formulation (comp, t, &flow_info);
+	nverts = comp -> num_verts;
+
+	/* Force t into S by disconnecting every edge containing t	*/
+	/* from the sink.						*/
+	ip1 = comp -> vedges [t];
+	ip2 = comp -> vedges [t + 1];
+	while (ip1 < ip2) {
+		e = *ip1++;
+		_gst_pr_set_sink_cap (&(flowp -> net), nverts + e, 0.0);
+	}
 
-	_gst_compute_max_flow (&flow_info.prob,
-			       &flow_info.temp,
-			       &flow_info.soln);
+	(void) _gst_pr_max_flow (&(flowp -> net), flowp -> cut);
 
-	/* Construct the solution.  These are the vertices that are	*/
-	/* on the FAR side of the cut.  Also, compute the z = f(S)	*/
-	/* value to return to our caller.				*/
-	k = BMAP_ELTS (comp -> num_verts);
+	/* Restore the edges of t for the next sub-problem. */
+	ip1 = comp -> vedges [t];
+	ip2 = comp -> vedges [t + 1];
+	while (ip1 < ip2) {
+		e = *ip1++;
+		_gst_pr_set_sink_cap (&(flowp -> net), nverts + e, comp -> x [e]);
+	}
+
+	/* Construct the solution.  These are the vertices that cannot	*/
+	/* reach the sink -- the FAR side of the cut in the original	*/
+	/* (source to edges to vertices to sink) orientation.  Also,	*/
+	/* compute the z = f(S) value to return to our caller.		*/
+	k = BMAP_ELTS (nverts);
 	for (i = 0; i < k; i++) {
 		S [i] = 0;
 	}
 	size = 0;
-	for (i = 0; i < comp -> num_verts; i++) {
-		if (BITON (flow_info.soln.cut, i)) continue;
+	for (i = 0; i < nverts; i++) {
+		if (NOT BITON (flowp -> cut, i)) continue;
 		SETBIT (S, i);
 		++size;
 	}
 
-	free_SEC_flow_formulation (&flow_info);
-
 	sum = 0.0;
 	for (i = 0; i < comp -> num_edges; i++) {
 		ip1 = comp -> everts [i];
@@ -508,9 +761,34 @@ struct sec_flow_info	flow_info;
 	return (z);
 }
 
+/*
+ * Exclude vertex t from all subsequent flow sub-problems.  We give it
+ * an infinite capacity arc to the sink, which keeps it out of S.
+ */
+
+	static
+	void
+exclude_vertex (
+
+struct sec_flow_info *	flowp,		/* IN/OUT - SEC flow formulation */
+struct comp *		comp,		/* IN - congested component */
+int			t		/* IN - vertex to exclude */
+)
+{
+	(void) comp;
+
+	_gst_pr_set_sink_cap (&(flowp -> net), t, INFINITE_FLOW);
+}
+
 /*
  * This routine builds the network flow formulation for the
- * deterministic separation procedure.
+ * deterministic separation procedure.  We use the REVERSE of the
+ * classical bipartite network: there is one node per vertex and one
+ * node per edge.  Each vertex i has capacity (Bi - 1) from the source,
+ * where Bi is the congestion level of vertex i.  Each vertex has an
+ * essentially infinite arc to every edge containing it, and each edge e
+ * has capacity x[e] to the sink.  Vertices are forced into (or excluded
+ * from) S by changing sink capacities only.
  */
 
 	static
@@ -518,143 +796,69 @@ struct sec_flow_info	flow_info;
 build_SEC_flow_formulation (
 
 struct comp *		comp,		/* IN - congested component */
-int			t,		/* IN - vertex to force */
 struct sec_flow_info *	flowp		/* OUT - SEC flow formulation */
 )
 {
 int			i;
-int			j;
-int			k;
+int			e;
 int			nverts;
 int			nedges;
-int			nmasks;
 int			num_arcs;
 int			num_nodes;
-int			e;
-int			arc_num;
-int			num_used_edges;
-int			first_edge_node;
-int *			used_edges;
-bitmap_t *		unused_edge_mask;
-struct flow_prob *	prob;
-int *			ip1;
 int *			ep1;
 int *			ep2;
 int *			vp1;
 int *			vp2;
-int *			outlist;
-int *			inlist;
+int *			arc_src;
+int *			arc_dst;
+double *		capacity;
 int *			srcp;
 int *			dstp;
 double *		capp;
-int *			counts;
-int **			ptrs;
 double			sum;
 
 	nverts	= comp -> num_verts;
 	nedges	= comp -> num_edges;
 
-	/* Compute a list of all component edges that	*/
-	/* DO NOT contain the vertex "t".		*/
-	nmasks		 = BMAP_ELTS (nedges);
-	unused_edge_mask = NEWA (nmasks, bitmap_t);
-	for (i = 0; i < nmasks; i++) {
-		unused_edge_mask [i] = 0;
-	}
-	num_used_edges = nedges;
-	ep1 = comp -> vedges [t];
-	ep2 = comp -> vedges [t + 1];
-	while (ep1 < ep2) {
-		e = *ep1++;
-		SETBIT (unused_edge_mask, e);
-		--num_used_edges;
-	}
-
-	used_edges = NEWA (num_used_edges, int);
-	ep1 = used_edges;
-	for (i = 0; i < nedges; i++) {
-		if (BITON (unused_edge_mask, i)) continue;
-		*ep1++ = i;
-	}
-	free ((char *) unused_edge_mask);
-
-	if (ep1 NE (used_edges + num_used_edges)) {
-		/* lost count somewhere? */
-		FATAL_ERROR;
-	}
-
-	/* Tally up the total number of nodes and arcs needed	*/
-	/* for the flow graph.  For the sake of	simplicity, we	*/
-	/* include a node for t, but there will be no arcs	*/
-	/* associated with it...				*/
-
-	/* One node per vertex.  One source and one sink	*/
-	/* node.  One node per USED edge.			*/
-	num_nodes	= nverts + 2 + num_used_edges;
-
-	/* One arc per vertex, one arc per USED edge,		*/
-	/* plus one arc for each vertex of every USED edge.	*/
-	num_arcs	= nverts + num_used_edges;
-	for (i = 0; i < num_used_edges; i++) {
-		e = used_edges [i];
-		num_arcs += (comp -> everts [e + 1] - comp -> everts [e]);
-	}
-
-	/* Start filling in the flow problem instance... */
-	prob = &(flowp -> prob);
-	prob -> num_nodes	= num_nodes;
-	prob -> num_arcs	= num_arcs;
-
-	/* Assign node numbers for the source and sink nodes... */
-	prob -> source	= nverts;
-	prob -> sink	= nverts + 1;
-	first_edge_node	= nverts + 2;
-
-	/* Now that we know how big the directed flow graph is,	*/
-	/* allocate storage for the various data structures...	*/
-
-	prob -> out		= NEWA (num_nodes + 1, int *);
-	prob -> in		= NEWA (num_nodes + 1, int *);
-	prob -> arc_src		= NEWA (num_arcs, int);
-	prob -> arc_dst		= NEWA (num_arcs, int);
-	prob -> capacity	= NEWA (num_arcs, double);
-
-	outlist			= NEWA (num_arcs, int);
-	inlist			= NEWA (num_arcs, int);
-
-	/* Generate the arcs from the source node to each USED edge. */
-
-	srcp = prob -> arc_src;
-	dstp = prob -> arc_dst;
-	capp = prob -> capacity;
-	arc_num = 0;
-	for (i = 0; i < num_used_edges; i++) {
-		e = used_edges [i];
-		j = first_edge_node + i;
-		*srcp++		= prob -> source;
-		*dstp++		= j;
-		*capp++		= comp -> x [e];
-		++arc_num;
-
-		/* Generate the arcs from each edge node to the		*/
-		/* corresponding vertex nodes.  These all have weight	*/
-		/* 2, which is essentially infinite.			*/
+	/* One node per vertex, one node per edge.  One arc for each	*/
+	/* vertex of every edge.					*/
+	num_nodes = nverts + nedges;
+	num_arcs  = comp -> everts [nedges] - comp -> everts [0];
+
+	arc_src		= NEWA (num_arcs, int);
+	arc_dst		= NEWA (num_arcs, int);
+	capacity	= NEWA (num_arcs, double);
+
+	/* Generate the arcs from each vertex node to the	*/
+	/* corresponding edge nodes.  These all have weight	*/
+	/* 2, which is essentially infinite.			*/
+	srcp = arc_src;
+	dstp = arc_dst;
+	capp = capacity;
+	for (e = 0; e < nedges; e++) {
 		vp1 = comp -> everts [e];
 		vp2 = comp -> everts [e + 1];
 		while (vp1 < vp2) {
-			k = *vp1++;
-			*srcp++		= j;
-			*dstp++		= k;
-			*capp++		= 2.0;
-			++arc_num;
+			*srcp++ = *vp1++;
+			*dstp++ = nverts + e;
+			*capp++ = 2.0;
 		}
 	}
+	FATAL_ERROR_IF (srcp NE arc_src + num_arcs);
+
+	_gst_pr_create_network (&(flowp -> net),
+				num_nodes,
+				num_arcs,
+				arc_src,
+				arc_dst,
+				capacity);
 
-	free ((char *) used_edges);
+	free ((char *) capacity);
+	free ((char *) arc_dst);
+	free ((char *) arc_src);
 
-	/* Now generate one arc from each vertex node to the sink	*/
-	/* node.  These all have weight (Bi - 1), where Bi is the	*/
-	/* congestion level of vertex i.				*/
+	/* Source capacity of each vertex is (Bi - 1).  A negative	*/
+	/* capacity is unusable, just as if it were zero.		*/
 	for (i = 0; i < nverts; i++) {
 		sum = -1.0;
 		ep1 = comp -> vedges [i];
@@ -663,70 +867,18 @@ double			sum;
 			e = *ep1++;
 			sum += comp -> x [e];
 		}
-		*srcp++		= i;
-		*dstp++		= prob -> sink;
-		*capp++		= sum;
-		++arc_num;
-	}
-
-	FATAL_ERROR_IF (arc_num NE num_arcs);
-
-	/* We have now specified the directed flow graph as a	*/
-	/* list of directed arcs.  Time to construct the	*/
-	/* adjacency lists -- for each node we build a list of	*/
-	/* outgoing and incoming arc numbers.  Do the outgoing	*/
-	/* lists first...					*/
-
-	counts	= NEWA (num_nodes, int);
-	ptrs	= NEWA (num_nodes, int *);
-
-	for (i = 0; i < num_nodes; i++) {
-		counts [i] = 0;
-	}
-	for (i = 0; i < num_arcs; i++) {
-		++(counts [prob -> arc_src [i]]);
-	}
-	ip1 = outlist;
-	for (i = 0; i < num_nodes; i++) {
-		ptrs [i] = ip1;
-		prob -> out [i] = ip1;
-		ip1 += counts [i];
-	}
-	prob -> out [i] = ip1;
-	for (i = 0; i < num_arcs; i++) {
-		j = prob -> arc_src [i];
-		ip1 = ptrs [j]++;
-		*ip1 = i;
+		if (sum < 0.0) {
+			sum = 0.0;
+		}
+		_gst_pr_set_source_cap (&(flowp -> net), i, sum);
 	}
 
-	/* Now do the incoming arc lists... */
-	for (i = 0; i < num_nodes; i++) {
-		counts [i] = 0;
-	}
-	for (i = 0; i < num_arcs; i++) {
-		++(counts [prob -> arc_dst [i]]);
+	/* Sink capacity of each edge is its LP weight. */
+	for (e = 0; e < nedges; e++) {
+		_gst_pr_set_sink_cap (&(flowp -> net), nverts + e, comp -> x [e]);
 	}
-	ip1 = inlist;
-	for (i = 0; i < num_nodes; i++) {
-		ptrs [i] = ip1;
-		prob -> in [i] = ip1;
-		ip1 += counts [i];
-	}
-	prob -> in [i] = ip1;
-	for (i = 0; i < num_arcs; i++) {
-		k = prob -> arc_dst [i];
-		ip1 = ptrs [k]++;
-		*ip1 = i;
-	}
-
-	/* Free temporary memory used to build things... */
-	free ((char *) counts);
-	free ((char *) ptrs);
 
-	/* Initialize the buffers used to hold flow solutions */
-	/* and temporary data... */
-	_gst_create_flow_solution_data (prob, &(flowp -> soln));
-	_gst_create_flow_temp_data (prob, &(flowp -> temp));
+	flowp -> cut = NEWA (BMAP_ELTS (num_nodes), bitmap_t);
 }
 
 /*
@@ -741,18 +893,6 @@ free_SEC_flow_formulation (
 struct sec_flow_info *	flowp		/* IN - SEC flow formulation */
 )
 {
-	/* Free up the buffers used to hold flow solutions */
-	/* and temporary data... */
-	_gst_free_flow_temp_data (&(flowp -> temp));
-	_gst_free_flow_solution_data (&(flowp -> soln));
-
-	/* Free up the problem formulation... */
-	free ((char *) (flowp -> prob.in [0]));
-	free ((char *) (flowp -> prob.out [0]));
-
-	free ((char *) (flowp -> prob.capacity));
-	free ((char *) (flowp -> prob.arc_dst));
-	free ((char *) (flowp -> prob.arc_src));
-	free ((char *) (flowp -> prob.in));
-	free ((char *) (flowp -> prob.out));
+	free ((char *) (flowp -> cut));
+	_gst_pr_free_network (&(flowp -> net));
 }
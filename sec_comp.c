@@ -3,8 +3,8 @@
 	$Id: sec_comp.c,v 1.18 2022/11/19 13:45:54 warme Exp $
 
 	File:	sec_comp.c
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -58,6 +58,10 @@
 		: Rename create_masks() to _gst_create_comp_masks().
 		: Split off code into plot_significant_reductions().
 		: Fix -Wall issues.
+	e-5:	10/18/2026	warme
+		: Added _gst_separate_each_component(), which
+		:  separates the congested components on several
+		:  threads.
 
 ************************************************************************/
 
@@ -71,6 +75,7 @@
 #include "geosteiner.h"
 #include "logic.h"
 #include "memory.h"
+#include "parallel.h"
 #include "parmblk.h"
 #include "sec_heur.h"
 #include "steiner.h"
@@ -100,6 +105,10 @@ struct comp *	_gst_find_congested_components (double *	x,
 int		_gst_find_least_congested_vertex (bitmap_t *	S,
 						  struct comp *	comp);
 void		_gst_free_congested_component (struct comp *	p);
+void		_gst_separate_each_component (struct comp *		comp,
+					      gst_comp_sep_func_t	func,
+					      double *			x,
+					      struct bbinfo *		bbip);
 
 
 /*
@@ -112,6 +121,16 @@ void		_gst_free_congested_component (struct comp *	p);
  * Local Types
  */
 
+struct comp_batch {
+	struct comp **		comps;	/* Components, in list order */
+	int *			order;	/* Component to do in each task */
+	struct par_trace *	traces;	/* Trace output of each component */
+	gst_comp_sep_func_t	func;	/* Separation routine */
+	double *		x;	/* LP solution to separate */
+	struct bbinfo *		bbips;	/* Scratch copy of the branch-and- */
+					/* bound info for each thread */
+};
+
 struct bc {
 	struct comp *	comp;		/* component being split */
 	struct comp *	list;		/* output list of BCC's */
@@ -163,6 +182,9 @@ static void		plot_significant_reductions (
 					bitmap_t *		orig_stour,
 					struct bbinfo *		bbip);
 static void		reduce_component_in_place (struct comp *);
+static void		separate_component_task (void *	arg,
+						 int		task,
+						 int		thread);
 static struct comp *	simplify_one_component (struct comp *,
 						struct bbinfo *);
 static struct comp *	split_biconnected_components (struct comp *,
@@ -301,6 +323,144 @@ gst_channel_ptr		trace;
 	return (comp);
 }
 
+/*
+ * Apply the given separation routine to each component in the list,
+ * setting p -> cp = func (p, x, bbip, p -> cp) for every component p.
+ * The components are completely independent of each other, so they
+ * are handed out to a pool of threads -- largest first, so that one
+ * big component does not hold up all of the others.  Each thread
+ * gets its own copy of the branch-and-bound info, with its own
+ * parameters and constraint pool scratch buffer.  Each component
+ * gets its own buffered trace channel, and the output is emitted in
+ * list order, just as if the components were separated serially.
+ */
+
+	void
+_gst_separate_each_component (
+
+struct comp *		comp,		/* IN/OUT - list of components */
+gst_comp_sep_func_t	func,		/* IN - separation routine */
+double *		x,		/* IN - LP solution to separate */
+struct bbinfo *		bbip		/* IN - branch and bound info */
+)
+{
+int			i;
+int			j;
+int			k;
+int			ncomps;
+int			nthreads;
+struct comp *		p;
+struct bbinfo *		bbp;
+struct cpool *		pool;
+gst_channel_ptr		trace;
+struct comp_batch	batch;
+
+	ncomps = 0;
+	for (p = comp; p NE NULL; p = p -> next) {
+		++ncomps;
+	}
+
+	nthreads = _gst_resolve_num_threads (bbip -> params -> num_threads);
+	if (nthreads > ncomps) {
+		nthreads = ncomps;
+	}
+
+	if (nthreads <= 1) {
+		for (p = comp; p NE NULL; p = p -> next) {
+			p -> cp = (*func) (p, x, bbip, p -> cp);
+		}
+		return;
+	}
+
+	trace = bbip -> params -> print_solve_trace;
+
+	batch.comps	= NEWA (ncomps, struct comp *);
+	batch.traces	= NEWA (ncomps, struct par_trace);
+	i = 0;
+	for (p = comp; p NE NULL; p = p -> next) {
+		batch.comps [i] = p;
+		_gst_par_trace_init (&(batch.traces [i]), trace);
+		++i;
+	}
+
+	/* The separation routines only read the bbinfo, except for	*/
+	/* the trace channel and the pool's scratch constraint buffer.	*/
+	/* Give each thread a private copy of those.			*/
+	pool = bbip -> cpool;
+	batch.bbips = NEWA (nthreads, struct bbinfo);
+	for (i = 0; i < nthreads; i++) {
+		bbp = &(batch.bbips [i]);
+		*bbp = *bbip;
+		bbp -> params = gst_create_param (NULL);
+		gst_copy_param (bbp -> params, bbip -> params);
+		bbp -> cpool = NEW (struct cpool);
+		*(bbp -> cpool) = *pool;
+		bbp -> cpool -> cbuf = NEWA (pool -> nvars + 1, struct rcoef);
+	}
+
+	/* Hand out the components in order of decreasing size. */
+	batch.order = NEWA (ncomps, int);
+	for (i = 0; i < ncomps; i++) {
+		k = batch.comps [i] -> num_verts;
+		for (j = i; j > 0; j--) {
+			if (batch.comps [batch.order [j - 1]] -> num_verts >= k) break;
+			batch.order [j] = batch.order [j - 1];
+		}
+		batch.order [j] = i;
+	}
+	batch.func	= func;
+	batch.x		= x;
+
+	(void) _gst_parallel_for (nthreads,
+				  ncomps,
+				  separate_component_task,
+				  &batch);
+
+	for (i = 0; i < ncomps; i++) {
+		_gst_par_trace_flush (&(batch.traces [i]), trace);
+	}
+
+	for (i = 0; i < nthreads; i++) {
+		bbp = &(batch.bbips [i]);
+		free ((char *) (bbp -> cpool -> cbuf));
+		free ((char *) (bbp -> cpool));
+		gst_free_param (bbp -> params);
+	}
+
+	free ((char *) batch.order);
+	free ((char *) batch.bbips);
+	free ((char *) batch.traces);
+	free ((char *) batch.comps);
+}
+
+/*
+ * Separate one component on behalf of _gst_separate_each_component().
+ */
+
+	static
+	void
+separate_component_task (
+
+void *			arg,		/* IN/OUT - the batch */
+int			task,		/* IN - task to perform */
+int			thread		/* IN - thread executing task */
+)
+{
+int			i;
+struct comp_batch *	bp;
+struct comp *		p;
+struct bbinfo *		bbp;
+
+	bp  = (struct comp_batch *) arg;
+	i   = bp -> order [task];
+	p   = bp -> comps [i];
+	bbp = &(bp -> bbips [thread]);
+
+	bbp -> params -> print_solve_trace = bp -> traces [i].chan;
+
+	p -> cp = (*(bp -> func)) (p, bp -> x, bbp, p -> cp);
+}
+
 /*
  * This routine finds the initial component by iteratively applying
  * the delta(t) <= 1 rule.  This normally shrinks the problem down
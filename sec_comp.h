@@ -3,8 +3,8 @@
 	$Id: sec_comp.h,v 1.11 2022/11/19 13:45:54 warme Exp $
 
 	File:	sec_comp.h
-	Rev:	e-4
-	Date:	11/18/2022
+	Rev:	e-5
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -37,6 +37,8 @@
 		: Simplify calling convention.
 		: Added _gst_create_comp_masks() and
 		:  _gst_free_congested_component_list().
+	e-5:	10/18/2026	warme
+		: Added _gst_separate_each_component().
 
 ************************************************************************/
 
@@ -95,6 +97,18 @@ struct comp {
 
 #define CFLG_ALL	(CFLG_CONG | CFLG_CC | CFLG_BCC | CFLG_CHAIN)
 
+/*
+ * The type of a routine that separates a single congested component,
+ * returning the given list of constraints with any violations it
+ * finds added to it.
+ */
+
+typedef struct constraint *	(*gst_comp_sep_func_t) (
+					struct comp *		comp,
+					double *		x,
+					struct bbinfo *		bbip,
+					struct constraint *	cp);
+
 
 extern struct constraint * _gst_check_component_subtour (
 					bitmap_t *		S,
@@ -119,5 +133,10 @@ extern int		_gst_find_least_congested_vertex (
 					struct comp *		comp);
 extern void		_gst_free_congested_component (struct comp * p);
 extern void		_gst_free_congested_component_list (struct comp * p);
+extern void		_gst_separate_each_component (
+					struct comp *		comp,
+					gst_comp_sep_func_t	func,
+					double *		x,
+					struct bbinfo *		bbip);
 
 #endif
@@ -3,8 +3,8 @@
 	$Id: sec_heur.c,v 1.16 2023/04/03 17:03:50 warme Exp $
 
 	File:	sec_heur.c
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-7
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2023 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -51,6 +51,12 @@
 		:  _gst_branch_and_cut() when do_separations()
 		:  returns (cp NE NULL) but no constraints get
 		:  added to the LP.
+	e-6:	10/18/2026	warme
+		: Enumerate subtours of components having at most
+		:  64 vertices using one machine word per subset.
+	e-7:	10/18/2026	warme
+		: Use the adaptive size limit of the small subtour
+		:  separator.
 
 ************************************************************************/
 
@@ -117,6 +123,12 @@ struct constraint *	_gst_sec_flow_heuristic (struct comp *		comp,
 
 #define CYCLE_LIMIT	250
 
+	/* Components with at most this many vertices are enumerated	*/
+	/* by representing each subset as a single machine word.  This	*/
+	/* is an internal limit, well above that of SEC_ENUM_LIMIT:	*/
+	/* the partial enumeration of small subtours also uses it.	*/
+#define	WORD_ENUM_MAX_VERTS	((int) (8 * sizeof (int64u)))
+
 
 /*
  * Local Types
@@ -136,6 +148,21 @@ struct sec_heur_info {
 	int **		edge_lists;	/* edges for each arc */
 };
 
+/*
+ * Data used to enumerate the connected vertex subsets of a component
+ * having at most WORD_ENUM_MAX_VERTS vertices.  Each subset is a
+ * single machine word, with bit i representing component vertex i.
+ */
+
+struct word_enum {
+	int		limit;		/* Max num verts to choose */
+	bool		do_supersets;	/* Do supersets of violations? */
+	int64u *	emask;		/* Vertices of each edge */
+	int64u *	nmask;		/* Neighbors of each vertex */
+	struct comp *	comp;		/* Component being enumerated */
+	struct bbinfo *	bbip;		/* Branch-and-bound info */
+};
+
 
 
 /*
@@ -207,6 +234,12 @@ static struct constraint *	heuristically_find_violated_secs (
 					double *		x,
 					struct constraint *	clist);
 #ifndef OLD_ENUMERATION
+static struct constraint *	enum_connected_subsets (
+					struct comp *		comp,
+					int			limit,
+					bool			do_supersets,
+					struct constraint *	cp,
+					struct bbinfo *		bbip);
 static struct constraint *	recurse_enum (int	limit,
 					      int	navail,
 					      int *	avail,
@@ -221,6 +254,16 @@ static struct constraint *	recurse_enum (int	limit,
 					      struct comp *	comp,
 					      struct constraint * cp,
 					      struct bbinfo *	bbip);
+static struct constraint *	recurse_word_enum (
+					struct word_enum *	wp,
+					int64u			chosen,
+					int64u			avail,
+					int64u			excluded,
+					int			last,
+					double			lhs,
+					struct constraint *	cp);
+static int			word_lowbit (int64u w);
+static int			word_popcount (int64u w);
 #endif
 static void			set_arc_capacities (struct comp *,
 						    struct sec_heur_info *);
@@ -1639,7 +1682,9 @@ char			tbuf [32];
 
 	/* Determine cardinality limit for partial enumeration. */
 
-	senum_limit = bbip -> params -> sec_enum_limit;
+	senum_limit = _gst_separator_limit (bbip,
+					    SEP_SMALL_SUBTOURS,
+					    bbip -> params -> sec_enum_limit);
 	if (nverts <= senum_limit) {
 		klimit = nverts;
 	}
@@ -1841,57 +1886,17 @@ struct constraint *	cp,		/* IN - existing list of constraints */
 struct bbinfo *		bbip		/* IN - branch-and-bound info */
 )
 {
-int			i;
-int			nverts;
-int *			avail;
-int *			chosen;
-int *			excluded;
-int *			vstat;
-
-	nverts = comp -> num_verts;
-
 #if 0
 	gst_channel_printf (bbip -> params -> print_solve_trace,
 		" Exhaustively enumerating %d congested vertices.\n",
-		nverts);
+		comp -> num_verts);
 #endif
 
-	avail	 = NEWA (4 * nverts, int);
-	chosen	 = avail + nverts;
-	excluded = chosen + nverts;
-	vstat	 = excluded + nverts;
-
-	/* Each vertex is initially free... */
-	for (i = 0; i < nverts; i++) {
-		vstat [i] = -1;
-	}
-
-	for (i = 0; i < nverts; i++) {
-
-		chosen [0]	= i;
-		vstat [i]	= 1;
-
-		cp = recurse_enum (nverts,	/* limit */
-				   0,		/* navail */
-				   avail,
-				   1,		/* nchosen */
-				   chosen,
-				   i,		/* nexcl */
-				   excluded,
-				   vstat,
-				   0.0,		/* LHS */
-				   FUZZ,	/* RHS */
-				   TRUE,	/* do_supersets */
-				   comp,
-				   cp,
-				   bbip);
-		excluded [i] = i;
-		vstat [i] = 2;
-	}
-
-	free ((char *) avail);
-
-	return (cp);
+	return (enum_connected_subsets (comp,
+					comp -> num_verts,	/* limit */
+					TRUE,		/* do_supersets */
+					cp,
+					bbip));
 }
 
 /*
@@ -1909,7 +1914,6 @@ struct constraint *	cp,		/* IN - existing list of constraints */
 struct bbinfo *		bbip		/* IN - branch-and-bound info */
 )
 {
-int			i;
 int			k;
 int			nverts;
 int			klimit;
@@ -1917,19 +1921,10 @@ int			senum_limit;
 cpu_time_t		ticks_limit;
 cpu_time_t		t0;
 cpu_time_t		t1;
-int *			avail;
-int *			chosen;
-int *			excluded;
-int *			vstat;
 double			est;
 
 	nverts = comp -> num_verts;
 
-	avail	 = NEWA (4 * nverts, int);
-	chosen	 = avail + nverts;
-	excluded = chosen + nverts;
-	vstat	 = excluded + nverts;
-
 	gst_channel_printf (bbip -> params -> print_solve_trace,
 		"Enumerating %d congested vertices.\n", nverts);
 
@@ -1937,7 +1932,9 @@ double			est;
 
 	/* Determine cardinality limit for partial enumeration. */
 
-	senum_limit = bbip -> params -> sec_enum_limit;
+	senum_limit = _gst_separator_limit (bbip,
+					    SEP_SMALL_SUBTOURS,
+					    bbip -> params -> sec_enum_limit);
 	if (nverts <= senum_limit) {
 		klimit = nverts;
 	}
@@ -1964,33 +1961,11 @@ double			est;
 			" Checking %d subtours\n", k);
 #endif
 
-		/* Each vertex is initially free... */
-		for (i = 0; i < nverts; i++) {
-			vstat [i] = -1;
-		}
-
-		for (i = 0; i < nverts; i++) {
-
-			chosen [0]	= i;
-			vstat [i]	= 1;
-
-			cp = recurse_enum (k,		/* limit */
-					   0,		/* navail */
-					   avail,
-					   1,		/* nchosen */
-					   chosen,
-					   i,		/* nexcl */
-					   excluded,
-					   vstat,
-					   0.0,		/* LHS */
-					   FUZZ,	/* RHS */
-					   FALSE,	/* do_supersets */
-					   comp,
-					   cp,
-					   bbip);
-			excluded [i] = i;
-			vstat [i] = 2;
-		}
+		cp = enum_connected_subsets (comp,
+					     k,		/* limit */
+					     FALSE,	/* do_supersets */
+					     cp,
+					     bbip);
 
 		/* Determine how long this took... */
 		t1 = _gst_get_cpu_time ();
@@ -2016,6 +1991,128 @@ double			est;
 		t0 = t1;
 	}
 
+	return (cp);
+}
+
+/*
+ * Enumerate every connected subset of at most "limit" vertices of the
+ * given component, adding the violated SEC's found to the given list.
+ * Each subset is enumerated exactly once, by choosing its lowest
+ * numbered vertex first and then growing it one neighbor at a time.
+ * Small components use one machine word per subset, which turns most
+ * of the per-vertex bookkeeping into a handful of word operations.
+ */
+
+	static
+	struct constraint *
+enum_connected_subsets (
+
+struct comp *		comp,		/* IN - component to enumerate */
+int			limit,		/* IN - max num verts to choose */
+bool			do_supersets,	/* IN - do supersets of violations? */
+struct constraint *	cp,		/* IN - existing constraints */
+struct bbinfo *		bbip		/* IN - branch-and-bound info */
+)
+{
+int			i;
+int			e;
+int			nverts;
+int			nedges;
+int *			vp1;
+int *			vp2;
+int *			ep1;
+int *			ep2;
+int *			avail;
+int *			chosen;
+int *			excluded;
+int *			vstat;
+int64u			bit;
+int64u			mask;
+struct word_enum	wenum;
+
+	nverts = comp -> num_verts;
+	nedges = comp -> num_edges;
+
+	if (nverts <= WORD_ENUM_MAX_VERTS) {
+		wenum.limit		= limit;
+		wenum.do_supersets	= do_supersets;
+		wenum.emask		= NEWA (nedges + nverts, int64u);
+		wenum.nmask		= wenum.emask + nedges;
+		wenum.comp		= comp;
+		wenum.bbip		= bbip;
+
+		for (e = 0; e < nedges; e++) {
+			mask = 0;
+			vp1 = comp -> everts [e];
+			vp2 = comp -> everts [e + 1];
+			while (vp1 < vp2) {
+				mask |= ((int64u) 1) << *vp1++;
+			}
+			wenum.emask [e] = mask;
+		}
+		for (i = 0; i < nverts; i++) {
+			bit = ((int64u) 1) << i;
+			mask = 0;
+			ep1 = comp -> vedges [i];
+			ep2 = comp -> vedges [i + 1];
+			while (ep1 < ep2) {
+				mask |= wenum.emask [*ep1++];
+			}
+			wenum.nmask [i] = mask & ~bit;
+		}
+
+		/* Vertices 0 through i-1 are excluded when we start	*/
+		/* from vertex i.  Every subset containing them has	*/
+		/* already been enumerated.				*/
+		for (i = 0; i < nverts; i++) {
+			bit = ((int64u) 1) << i;
+			cp = recurse_word_enum (&wenum,
+						bit,		/* chosen */
+						0,		/* avail */
+						bit - 1,	/* excluded */
+						i,		/* last */
+						0.0,		/* LHS */
+						cp);
+		}
+
+		free ((char *) wenum.emask);
+
+		return (cp);
+	}
+
+	avail	 = NEWA (4 * nverts, int);
+	chosen	 = avail + nverts;
+	excluded = chosen + nverts;
+	vstat	 = excluded + nverts;
+
+	/* Each vertex is initially free... */
+	for (i = 0; i < nverts; i++) {
+		vstat [i] = -1;
+	}
+
+	for (i = 0; i < nverts; i++) {
+
+		chosen [0]	= i;
+		vstat [i]	= 1;
+
+		cp = recurse_enum (limit,
+				   0,		/* navail */
+				   avail,
+				   1,		/* nchosen */
+				   chosen,
+				   i,		/* nexcl */
+				   excluded,
+				   vstat,
+				   0.0,		/* LHS */
+				   FUZZ,	/* RHS */
+				   do_supersets,
+				   comp,
+				   cp,
+				   bbip);
+		excluded [i] = i;
+		vstat [i] = 2;
+	}
+
 	free ((char *) avail);
 
 	return (cp);
@@ -2193,6 +2290,181 @@ double			sum;
 
 	return (cp);
 }
+
+/*
+ * This routine is the same as recurse_enum(), except that the chosen,
+ * available and excluded vertices are each a single machine word.  The
+ * sets of the caller are passed by value, so there is nothing to undo
+ * upon return.  The LHS is the total weight of the edges restricted to
+ * the chosen vertices, sum (x[e] * (|e & chosen| - 1)) over all edges
+ * meeting the chosen vertices.  It is updated incrementally:  adding
+ * vertex t raises the LHS by x[e] for every edge e containing t that
+ * already meets a chosen vertex.
+ */
+
+	static
+	struct constraint *
+recurse_word_enum (
+
+struct word_enum *	wp,		/* IN - enumeration info */
+int64u			chosen,		/* IN - vertices chosen */
+int64u			avail,		/* IN - unchosen verts available */
+int64u			excluded,	/* IN - verts excluded from choice */
+int			last,		/* IN - vertex most recently chosen */
+double			lhs,		/* IN - LHS of constraint */
+struct constraint *	cp		/* IN - existing constraints */
+)
+{
+int			i;
+int			j;
+int			k;
+int			t;
+int			e;
+int			kmasks;
+int			nchosen;
+int *			vp1;
+int *			vp2;
+int *			ep1;
+int *			ep2;
+int64u			bit;
+int64u			w;
+bitmap_t *		bp1;
+struct comp *		comp;
+struct constraint *	newp;
+double			sum;
+
+	comp = wp -> comp;
+
+	nchosen = word_popcount (chosen);
+
+	/* Check if chosen vertices yield a violation: */
+	if (lhs > ((double) (nchosen - 1)) + FUZZ) {
+		kmasks = wp -> bbip -> cip -> num_vert_masks;
+		bp1 = NEWA (kmasks, bitmap_t);
+
+		for (i = 0; i < kmasks; i++) {
+			bp1 [i] = 0;
+		}
+		for (w = chosen; w NE 0; w &= (w - 1)) {
+			j = word_lowbit (w);
+			vp1 = comp -> rverts [j];
+			vp2 = comp -> rverts [j + 1];
+			while (vp1 < vp2) {
+				k = *vp1++;
+				SETBIT (bp1, k);
+			}
+		}
+
+		newp = NEW (struct constraint);
+		newp -> next		= cp;
+		newp -> iteration	= 0;
+		newp -> type		= CT_SUBTOUR;
+		newp -> mask		= bp1;
+
+		cp = newp;
+
+		if (NOT wp -> do_supersets) {
+			/* Don't enumerate supersets of any violation... */
+			return (cp);
+		}
+	}
+
+	if (nchosen >= wp -> limit) {
+		/* Don't recurse any deeper. */
+		return (cp);
+	}
+
+	/* All free vertices adjacent to the most-recently-chosen	*/
+	/* vertex now become available.					*/
+	avail |= wp -> nmask [last] & ~(chosen | excluded);
+
+	/* Choose each available vertex.  After recursing on	*/
+	/* this choice, exclude it from future consideration.	*/
+	while (avail NE 0) {
+		t = word_lowbit (avail);
+		bit = ((int64u) 1) << t;
+		avail &= ~bit;
+
+		/* Compute weight of edges connecting vertex t to all	*/
+		/* previously chosen vertices.				*/
+		sum = 0.0;
+		ep1 = comp -> vedges [t];
+		ep2 = comp -> vedges [t + 1];
+		while (ep1 < ep2) {
+			e = *ep1++;
+			if ((wp -> emask [e] & chosen) NE 0) {
+				sum += comp -> x [e];
+			}
+		}
+
+		cp = recurse_word_enum (wp,
+					chosen | bit,
+					avail,
+					excluded,
+					t,
+					lhs + sum,
+					cp);
+
+		/* Now exclude vertex t from further consideration. */
+		excluded |= bit;
+	}
+
+	return (cp);
+}
+
+/*
+ * Return the number of 1 bits in the given word.
+ */
+
+	static
+	int
+word_popcount (
+
+int64u		w		/* IN - word to count bits of */
+)
+{
+#ifdef __GNUC__
+	return (__builtin_popcountl (w));
+#else
+int		n;
+
+	n = 0;
+	while (w NE 0) {
+		n += NBITSON ((bitmap_t) w);
+		w >>= BPW;
+	}
+	return (n);
+#endif
+}
+
+/*
+ * Return the index of the lowest 1 bit in the given (non-zero) word.
+ */
+
+	static
+	int
+word_lowbit (
+
+int64u		w		/* IN - word to scan */
+)
+{
+#ifdef __GNUC__
+	return (__builtin_ctzl (w));
+#else
+int		i;
+
+	i = 0;
+	while ((w & 0xFFlu) EQ 0) {
+		w >>= 8;
+		i += 8;
+	}
+	while ((w & 1lu) EQ 0) {
+		w >>= 1;
+		++i;
+	}
+	return (i);
+#endif
+}
 
 #endif
 
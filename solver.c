@@ -3,8 +3,8 @@
 	$Id: solver.c,v 1.74 2023/04/03 16:55:49 warme Exp $
 
 	File:	solver.c
-	Rev:	e-6
-	Date:	04/03/2023
+	Rev:	e-7
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2023 by Pawel Winter, Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -43,6 +43,8 @@
 	e-6:	04/03/2023	warme
 		: Handle cases where the backtrack search rejects
 		:  instances having negative edge costs.
+	e-7:	10/18/2026	warme
+		: Added separation statistics properties.
 
 ************************************************************************/
 
@@ -988,6 +990,41 @@ gst_proplist_ptr	plist;
 		SETINT (GST_PROP_SOLVER_FINAL_PNZ,    statp -> cs_final.num_pnz);
 		SETINT (GST_PROP_SOLVER_FINAL_LPROWS, statp -> cs_final.num_lprows);
 		SETINT (GST_PROP_SOLVER_FINAL_LPNZ,   statp -> cs_final.num_lpnz);
+		SETINT (GST_PROP_SOLVER_SEP_ZWCUTSET_CUTS,
+			statp -> sep [SEP_ZERO_WEIGHT_CUTSETS].num_cuts);
+		SETINT (GST_PROP_SOLVER_SEP_INTCYCLE_CUTS,
+			statp -> sep [SEP_INTEGER_CYCLES].num_cuts);
+		SETINT (GST_PROP_SOLVER_SEP_ENUMSUBTOUR_CUTS,
+			statp -> sep [SEP_ENUM_SUBTOURS].num_cuts);
+		SETINT (GST_PROP_SOLVER_SEP_FLOWHEUR_CUTS,
+			statp -> sep [SEP_FLOW_HEURISTIC].num_cuts);
+		SETINT (GST_PROP_SOLVER_SEP_SMALLSUBTOUR_CUTS,
+			statp -> sep [SEP_SMALL_SUBTOURS].num_cuts);
+		SETINT (GST_PROP_SOLVER_SEP_SECFLOW_CUTS,
+			statp -> sep [SEP_SEC_FLOW].num_cuts);
+		SETINT (GST_PROP_SOLVER_SEP_LOCALCUT_CUTS,
+			statp -> sep [SEP_LOCAL_CUTS].num_cuts);
+		SETDBL (GST_PROP_SOLVER_SEP_ZWCUTSET_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_ZERO_WEIGHT_CUTSETS].time));
+		SETDBL (GST_PROP_SOLVER_SEP_INTCYCLE_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_INTEGER_CYCLES].time));
+		SETDBL (GST_PROP_SOLVER_SEP_ENUMSUBTOUR_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_ENUM_SUBTOURS].time));
+		SETDBL (GST_PROP_SOLVER_SEP_FLOWHEUR_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_FLOW_HEURISTIC].time));
+		SETDBL (GST_PROP_SOLVER_SEP_SMALLSUBTOUR_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_SMALL_SUBTOURS].time));
+		SETDBL (GST_PROP_SOLVER_SEP_SECFLOW_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_SEC_FLOW].time));
+		SETDBL (GST_PROP_SOLVER_SEP_LOCALCUT_TIME,
+			_gst_cpu_time_t_to_double_seconds (
+				statp -> sep [SEP_LOCAL_CUTS].time));
 	}
 }
 
@@ -1027,6 +1064,20 @@ static int ids [] = {
 	GST_PROP_SOLVER_FINAL_PNZ,
 	GST_PROP_SOLVER_FINAL_LPROWS,
 	GST_PROP_SOLVER_FINAL_LPNZ,
+	GST_PROP_SOLVER_SEP_ZWCUTSET_CUTS,
+	GST_PROP_SOLVER_SEP_INTCYCLE_CUTS,
+	GST_PROP_SOLVER_SEP_ENUMSUBTOUR_CUTS,
+	GST_PROP_SOLVER_SEP_FLOWHEUR_CUTS,
+	GST_PROP_SOLVER_SEP_SMALLSUBTOUR_CUTS,
+	GST_PROP_SOLVER_SEP_SECFLOW_CUTS,
+	GST_PROP_SOLVER_SEP_LOCALCUT_CUTS,
+	GST_PROP_SOLVER_SEP_ZWCUTSET_TIME,
+	GST_PROP_SOLVER_SEP_INTCYCLE_TIME,
+	GST_PROP_SOLVER_SEP_ENUMSUBTOUR_TIME,
+	GST_PROP_SOLVER_SEP_FLOWHEUR_TIME,
+	GST_PROP_SOLVER_SEP_SMALLSUBTOUR_TIME,
+	GST_PROP_SOLVER_SEP_SECFLOW_TIME,
+	GST_PROP_SOLVER_SEP_LOCALCUT_TIME,
 	-1
 };
 
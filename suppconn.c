@@ -0,0 +1,265 @@
+/***********************************************************************
+
+	$Id: suppconn.c,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	suppconn.c
+	Rev:	e-1
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Incrementally maintained connected components of the
+	support hypergraph of an LP solution.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+
+************************************************************************/
+
+#include "suppconn.h"
+
+#include "bb.h"
+#include "ddsuf.h"
+#include "fatal.h"
+#include "logic.h"
+#include "memory.h"
+#include "steiner.h"
+#include <stdlib.h>
+
+
+/*
+ * Global Routines
+ */
+
+struct suppconn *	_gst_create_support_conn (
+					struct gst_hypergraph *	cip);
+void			_gst_free_support_conn (struct suppconn * scp);
+void			_gst_update_support_conn (
+					struct suppconn *	scp,
+					double *		x,
+					bitmap_t *		edge_mask,
+					struct gst_hypergraph *	cip);
+
+
+/*
+ * Local Routines
+ */
+
+static void		push_support_edge (struct suppconn *		scp,
+					   int				e,
+					   struct gst_hypergraph *	cip);
+
+/*
+ * Create the connectivity structure for the given hypergraph.  The
+ * support is initially empty.
+ */
+
+	struct suppconn *
+_gst_create_support_conn (
+
+struct gst_hypergraph *	cip		/* IN - hypergraph */
+)
+{
+int			i;
+int			nverts;
+int			nedges;
+struct suppconn *	scp;
+
+	nverts = cip -> num_verts;
+	nedges = cip -> num_edges;
+
+	scp = NEW (struct suppconn);
+
+	_gst_ddsuf_create (&(scp -> sets), (nverts > 0) ? nverts : 1);
+	for (i = 0; i < nverts; i++) {
+		_gst_ddsuf_makeset (&(scp -> sets), i);
+	}
+
+	scp -> nverts	= nverts;
+	scp -> nedges	= nedges;
+	scp -> epos	= NEWA (nedges, int);
+	scp -> stack	= NEWA (nedges, int);
+	scp -> state	= NEWA (nedges, int);
+	scp -> nunions	= NEWA (nedges, int);
+	scp -> nstack	= 0;
+	scp -> top	= _gst_ddsuf_get_state (&(scp -> sets));
+	scp -> unions	= 0;
+	scp -> degree	= NEWA (nverts, int);
+	scp -> nactive	= 0;
+	scp -> ncomps	= 0;
+	scp -> added	= NEWA (nedges, int);
+
+	for (i = 0; i < nedges; i++) {
+		scp -> epos [i] = -1;
+	}
+	for (i = 0; i < nverts; i++) {
+		scp -> degree [i] = 0;
+	}
+
+	return (scp);
+}
+
+/*
+ * Free up the given connectivity structure.
+ */
+
+	void
+_gst_free_support_conn (
+
+struct suppconn *	scp		/* IN - structure to free */
+)
+{
+	if (scp EQ NULL) return;
+
+	free ((char *) (scp -> added));
+	free ((char *) (scp -> degree));
+	free ((char *) (scp -> nunions));
+	free ((char *) (scp -> state));
+	free ((char *) (scp -> stack));
+	free ((char *) (scp -> epos));
+	_gst_ddsuf_destroy (&(scp -> sets));
+	free ((char *) scp);
+}
+
+/*
+ * Bring the connected components up to date with the given LP
+ * solution.  A hyperedge is in the support if it is valid and has
+ * weight greater than FUZZ.  Identifying the hyperedges that crossed
+ * this threshold requires one pass over the hyperedges, but the
+ * components themselves are only updated for those that did (and
+ * for any support edges that were added after the earliest one to
+ * leave the support).
+ */
+
+	void
+_gst_update_support_conn (
+
+struct suppconn *	scp,		/* IN/OUT - connectivity structure */
+double *		x,		/* IN - LP solution */
+bitmap_t *		edge_mask,	/* IN - set of valid hyperedges */
+struct gst_hypergraph *	cip		/* IN - hypergraph */
+)
+{
+int			i;
+int			e;
+int			k;
+int			nedges;
+int			nadded;
+int			lowest;
+int			old_nstack;
+bool			in_soln;
+int *			vp1;
+int *			vp2;
+
+	nedges = scp -> nedges;
+
+	FATAL_ERROR_IF ((nedges NE cip -> num_edges) OR
+			(scp -> nverts NE cip -> num_verts));
+
+	/* Discard the path compressions done by queries since the	*/
+	/* last update, so that the rollback stack does not grow	*/
+	/* without bound.						*/
+	_gst_ddsuf_restore (&(scp -> sets), scp -> top);
+
+	/* Find the hyperedges that entered or left the support. */
+	lowest = scp -> nstack;
+	nadded = 0;
+	for (e = 0; e < nedges; e++) {
+		in_soln = BITON (edge_mask, e) AND (x [e] > FUZZ);
+		k = scp -> epos [e];
+		if (in_soln EQ (k >= 0)) continue;
+
+		vp1 = cip -> edge [e];
+		vp2 = cip -> edge [e + 1];
+		if (in_soln) {
+			scp -> added [nadded++] = e;
+			while (vp1 < vp2) {
+				i = *vp1++;
+				if ((scp -> degree [i])++ EQ 0) {
+					++(scp -> nactive);
+				}
+			}
+		}
+		else {
+			scp -> epos [e] = -1;
+			if (k < lowest) {
+				lowest = k;
+			}
+			while (vp1 < vp2) {
+				i = *vp1++;
+				if (--(scp -> degree [i]) EQ 0) {
+					--(scp -> nactive);
+				}
+			}
+		}
+	}
+
+	if (lowest < scp -> nstack) {
+		/* Undo everything from the lowest edge that left the	*/
+		/* support upward, then redo the edges above it that	*/
+		/* are still in the support.				*/
+		_gst_ddsuf_restore (&(scp -> sets), scp -> state [lowest]);
+		scp -> unions = scp -> nunions [lowest];
+		old_nstack = scp -> nstack;
+		scp -> nstack = lowest;
+		for (k = lowest; k < old_nstack; k++) {
+			e = scp -> stack [k];
+			if (scp -> epos [e] < 0) continue;
+			push_support_edge (scp, e, cip);
+		}
+	}
+
+	for (i = 0; i < nadded; i++) {
+		push_support_edge (scp, scp -> added [i], cip);
+	}
+
+	scp -> top	= _gst_ddsuf_get_state (&(scp -> sets));
+	scp -> ncomps	= scp -> nactive - scp -> unions;
+}
+
+/*
+ * Push the given hyperedge onto the stack of support edges, uniting
+ * all of its vertices into a single set.
+ */
+
+	static
+	void
+push_support_edge (
+
+struct suppconn *	scp,		/* IN/OUT - connectivity structure */
+int			e,		/* IN - hyperedge to add */
+struct gst_hypergraph *	cip		/* IN - hypergraph */
+)
+{
+int			k;
+int			r1;
+int			r2;
+int *			vp1;
+int *			vp2;
+
+	k = scp -> nstack++;
+	scp -> stack [k]	= e;
+	scp -> state [k]	= _gst_ddsuf_get_state (&(scp -> sets));
+	scp -> nunions [k]	= scp -> unions;
+	scp -> epos [e]		= k;
+
+	vp1 = cip -> edge [e];
+	vp2 = cip -> edge [e + 1];
+	FATAL_ERROR_IF (vp1 >= vp2);
+	r1 = _gst_ddsuf_find (&(scp -> sets), *vp1++);
+	while (vp1 < vp2) {
+		r2 = _gst_ddsuf_find (&(scp -> sets), *vp1++);
+		if (r1 EQ r2) continue;
+		_gst_ddsuf_unite (&(scp -> sets), r1, r2);
+		++(scp -> unions);
+		r1 = _gst_ddsuf_find (&(scp -> sets), r1);
+	}
+}
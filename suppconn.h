@@ -0,0 +1,92 @@
+/***********************************************************************
+
+	$Id: suppconn.h,v 1.1 2026/10/18 12:00:00 warme Exp $
+
+	File:	suppconn.h
+	Rev:	e-1
+	Date:	10/18/2026
+
+	Copyright (c) 2026, 2026 by David M. Warme.  This work is
+	licensed under a Creative Commons Attribution-NonCommercial
+	4.0 International License.
+
+************************************************************************
+
+	Incrementally maintained connected components of the
+	support hypergraph of an LP solution.
+
+************************************************************************
+
+	Modification Log:
+
+	e-1:	10/18/2026	warme
+		: Created.
+
+************************************************************************/
+
+#ifndef	SUPPCONN_H
+#define	SUPPCONN_H
+
+#include "bitmaskmacros.h"
+#include "ddsuf.h"
+
+struct gst_hypergraph;
+
+
+/*
+ * The connected components of the support hypergraph (the hyperedges
+ * having non-zero weight in the LP solution).  Successive LP solutions
+ * usually differ in only a few hyperedges, so rather than recomputing
+ * the components from scratch each time, we keep the support edges on
+ * a stack in the order they were united into the DDSUF.  A hyperedge
+ * leaving the support rolls the DDSUF back to the state just before
+ * that hyperedge was added, and only the support edges above it on
+ * the stack are united again.  Hyperedges entering the support are
+ * simply united on top.  Edges that stay in the support for a long
+ * time therefore sink to the bottom of the stack, where they are
+ * seldom touched.
+ */
+
+struct suppconn {
+	struct ddsuf	sets;		/* Vertex sets, with rollback */
+	int		nverts;		/* Number of vertices */
+	int		nedges;		/* Number of hyperedges */
+	int *		epos;		/* Position of each edge on stack, */
+					/* or -1 if not in the support */
+	int *		stack;		/* Support edges, in order added */
+	int *		state;		/* DDSUF state before each was added */
+	int *		nunions;	/* Unions done before each was added */
+	int		nstack;		/* Number of edges on the stack */
+	int		top;		/* DDSUF state after the last edge */
+	int		unions;		/* Number of unions done */
+	int *		degree;		/* Number of support edges */
+					/* containing each vertex */
+	int		nactive;	/* Vertices having degree > 0 */
+	int		ncomps;		/* Number of connected components */
+					/* among the vertices of degree > 0 */
+	int *		added;		/* Scratch list of edges to add */
+};
+
+/*
+ * Find the canonical vertex of the component containing vertex V.
+ * Only meaningful for vertices having degree > 0.
+ */
+
+#define	_gst_support_conn_find(scp, v)	\
+	(_gst_ddsuf_find (&((scp) -> sets), (v)))
+
+
+/*
+ * Global Routines
+ */
+
+extern struct suppconn * _gst_create_support_conn (
+					struct gst_hypergraph *	cip);
+extern void		_gst_free_support_conn (struct suppconn * scp);
+extern void		_gst_update_support_conn (
+					struct suppconn *	scp,
+					double *		x,
+					bitmap_t *		edge_mask,
+					struct gst_hypergraph *	cip);
+
+#endif
@@ -3,8 +3,8 @@
 	$Id: ufst.c,v 1.53 2023/04/03 16:54:06 warme Exp $
 
 	File:	ufst.c
-	Rev:	e-5
-	Date:	04/03/2023
+	Rev:	e-8
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2023 by Pawel Winter & Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -35,6 +35,18 @@
 	e-5:	04/03/2023	warme
 		: Fix handling of >= 64k terminals.  (Still
 		:  suffers from O(n^2) memory thrash.)
+	e-6:	10/18/2026	warme
+		: Combine the hFSTs of each size on several
+		:  threads, merging the results in a fixed order.
+		: Replace statistics timers with per-thread counts.
+		: Fix battery score of new FSTs, and give
+		:  Steiner points a zero battery level.
+	e-7:	10/18/2026	warme
+		: Added FST_TIME_LIMIT, a wall-clock limit that stops
+		:  generation after the last size that was completed
+		:  in time.
+	e-8:	10/18/2026	warme
+		: Allocate the UFST list from an arena.
 
 ************************************************************************/
 
@@ -52,7 +64,9 @@
 #include "memory.h"
 #include "metric.h"
 #include "mst.h"
+#include "parallel.h"
 #include "parmblk.h"
+#include "polltime.h"
 #include "prepostlude.h"
 #include "sortfuncs.h"
 #include "steiner.h"
@@ -77,6 +91,9 @@ gst_hg_ptr	gst_generate_ufsts (int,
  * Local functions
  */
 
+struct hcand;
+struct ufst_batch;
+
 static void		add_zero_length_fsts (struct uinfo *, int, int **);
 static void		build_fst_list (struct uinfo *);
 static double		closest_terminal (struct hFST *,
@@ -84,19 +101,35 @@ static double		closest_terminal (struct hFST *,
 					  struct point *);
 static void		compute_ufsts_for_unique_terminals (struct uinfo *,
 							    cpu_time_t *);
+static void		destroy_thread_uinfo (struct uinfo *,
+					      struct uinfo *);
 static void		destroy_uinfo (struct uinfo *);
 static bool		edge_lune_test (struct uinfo *,
 					struct hFST *,
 					struct hFST *,
 					struct hFST *,
 					double, double);
+static struct hcand **	extend_hfst (struct ufst_batch *,
+				     struct uinfo *,
+				     struct hFST *,
+				     struct hFST *,
+				     struct hcand **);
 static double		get_bsd (struct hFST *, struct hFST *, struct bsd *);
 static int		get_steiner_points (struct hFST *, struct point *, int *);
 static double		hfst_mst (struct uinfo *, struct hFST *, bool);
 static double		hfst_root_distance (struct uinfo *, struct hFST *, struct point *);
+static void		hfst_task (void *, int, int);
 static bool		identical_lists (const int *, const int *);
+static void		initialize_thread_uinfo (struct uinfo *,
+						 struct uinfo *);
 static void		initialize_uinfo (struct uinfo *);
 static bool		is_disjoint (struct hFST *, struct hFST *);
+static void		merge_hcands (struct uinfo *,
+				      struct hFST **,
+				      int,
+				      struct hcand *,
+				      int *);
+static struct hcand *	new_hcand (struct hFST *, bool, bool);
 static bool 		points_close (struct point *, struct point *, double);
 static void		renumber_terminals (struct uinfo *,
 					    struct pset *,
@@ -110,9 +143,10 @@ static void		update_terms (struct hFST *);
 static bool		upper_bound_tests (struct uinfo *, struct hFST *, bool);
 static bool		wedge_test (struct uinfo *, struct hFST *);
 
-static struct time_it *	create_time_it (char *);
-static void		start_timer (struct time_it *);
-static void		stop_timer (struct time_it *, bool);
+/*
+ * The screening tests (and other phases) of the generator, for which
+ * statistics are kept.
+ */
 
 enum
 {
@@ -139,17 +173,78 @@ enum
 	NUM_OF_COUNTERS
 };
 
-struct time_it
-{
-	char *		name;
-	int		elapsed_time;		/* Elapsed time in all subperiods */
-	int		queries;		/* Number of 'start_timer ()' */
-	int		pruned;			/* Number of 'stop_timer (true)' */
+static const char * const	counter_names [NUM_OF_COUNTERS] = {
+	"No bent edge",
+	"Wedge",
+	"Generator",
+	"SubPath",
+	"Disjoint",
+	"Angle test",
+	"Intersection",
+	"BSD",
+	"Lune",
+	"FST Check",
+	"Upperbound 1",
+	"Upperbound 2",
+	"Upperbound 3",
+	"Update UB",
+	"Add Time",
+	"Not MST Edge",
+	"Illegal flip",
+	"Length",
+	"Replaced",
+	"Added",
+};
+
+/*
+ * Number of times each phase was entered, and the number of times it
+ * pruned the hFST at hand.  Each thread has its own counts, which are
+ * summed when the generation is finished.
+ */
+
+struct ustats {
+	int		queries [NUM_OF_COUNTERS];
+	int		pruned [NUM_OF_COUNTERS];
+};
+
+/*
+ * The outcome of combining one pair of hFSTs: one new hFST (or two
+ * that differ only in their extension) to insert into the list of
+ * hFSTs, and/or an FST to save.  These are found in parallel, but
+ * must be merged into the global lists in the order of the serial
+ * algorithm, since the upper bound of each new hFST is tightened
+ * using those spanning the same terminals that came before it.
+ */
 
-	int		temp_time;
+struct hcand {
+	struct hcand *	next;		/* Next candidate of same task */
+	struct hFST *	hfst;		/* New hFST(s), linked by next */
+	bool		insert;		/* Insert hfst into the hFST list */
+	bool		save;		/* Save hfst as an FST */
 };
 
-static struct time_it *counters[NUM_OF_COUNTERS];
+/*
+ * Combining the hFSTs of one size is divided into tasks, each of which
+ * extends a range of hFSTs (the larger of each pair).
+ */
+
+struct ufst_task {
+	int		first;		/* First hFST to extend */
+	int		last;		/* Last hFST to extend + 1 */
+	struct hcand *	cands;		/* Candidates found, in order */
+	bool		timed_out;	/* Stopped early by the time limit */
+};
+
+struct ufst_batch {
+	struct uinfo *	uips;		/* Private UFST info per thread */
+	struct hFST **	lists;		/* hFSTs of each size */
+	struct hFST **	hfsts;		/* hFSTs to extend */
+	struct ufst_task * tasks;	/* The tasks */
+	struct hFST	proto;		/* Initial state of each new hFST */
+	int		size;		/* Size of the new hFSTs */
+	int *		meetAngles;	/* Meeting angle of each ray pair */
+	bool *		isLeftRight;	/* Left/right of each ray pair */
+};
 
 /*
  * Local Macros
@@ -166,6 +261,17 @@ static struct time_it *counters[NUM_OF_COUNTERS];
 #else
 #define Verbose FALSE
 #endif
+
+#define COUNT_QUERY(uip, c)	(++((uip) -> stats -> queries [c]))
+#define COUNT_PRUNED(uip, c)	(++((uip) -> stats -> pruned [c]))
+
+/*
+ * The hFSTs to be extended are divided into about TASKS_PER_THREAD
+ * tasks per thread, so that the threads stay busy even when some
+ * tasks take much longer than others.
+ */
+
+#define TASKS_PER_THREAD	8
 
 /*
  * An octilinear FST generator...
@@ -249,6 +355,9 @@ gst_proplist_ptr	plist;
 	T0 = _gst_get_cpu_time ();
 	Tn = T0;
 
+	_gst_start_wall_poll (&(uinfo.fst_poll), params -> fst_time_limit);
+	uinfo.complete_size = 0;
+
 	uinfo.x_order = _gst_heapsort_x (pts);
 
 	if (timing NE NULL) {
@@ -339,6 +448,11 @@ gst_proplist_ptr	plist;
 	gst_set_int_property (cip -> proplist,
 			      GST_PROP_HG_HALF_FST_COUNT,
 			      uinfo.hFSTCount);
+	if (uinfo.complete_size > 0) {
+		gst_set_int_property (cip -> proplist,
+				      GST_PROP_HG_COMPLETE_FST_SIZE,
+				      uinfo.complete_size);
+	}
 
 	count = 0;
 	for (i = 0; i < uinfo.ntrees; i++) {
@@ -398,7 +512,7 @@ struct uinfo *		uip,	/* IN - global UFST info */
 cpu_time_t *		Tn
 )
 {
-int			i, j, k, ti, tj;
+int			i, j, k;
 int			n;		/* Number of points */
 int			K;		/* 2 * lambda */
 int			lambda;
@@ -407,52 +521,34 @@ int			hFSTcount;	/* Number of generated hFSTs */
 int			max_fst_size;
 int			max_angle;
 int			min_angle;
-dist_t			eps_factor;
+int			nthreads;
+int			nhfsts;
+int			chunk;
+int			ntasks;
 int *			meetAngles;
 bool *			isLeftRight;
 char			buf1 [32];
-struct point		droot;
 struct point *		p;
-struct point		dp;
 struct pset *		pts;
-struct bsd *		BSD;
 struct hFST		hfstk;
-struct hFST *		tLeft;
-struct hFST *		tRight;
 struct hFST *		last;
 struct hFST **		hFST_Lists;
+struct hFST **		hfsts;
+struct ufst_task *	tasks;
+struct ufst_batch	batch;
+cpu_time_t		Tgen;
 gst_metric_ptr		metric;
 gst_param_ptr		params;
 gst_channel_ptr		timing;
 
-	if (Verbose) {
-		counters [NO_BENT_EDGE] = create_time_it("No bent edge");
-		counters [WEDGE]	= create_time_it("Wedge");
-		counters [GENERATOR]	= create_time_it("Generator");
-		counters [SUBPATH]	= create_time_it("SubPath");
-		counters [DISJOINT]	= create_time_it("Disjoint");
-		counters [ANGLE]	= create_time_it("Angle test");
-		counters [INTERSECT]	= create_time_it("Intersection");
-		counters [BSDTEST]	= create_time_it("BSD");
-		counters [LUNE]		= create_time_it("Lune");
-		counters [FSTCHECK]	= create_time_it("FST Check");
-		counters [UB1]		= create_time_it("Upperbound 1");
-		counters [UB2]		= create_time_it("Upperbound 2");
-		counters [UB3]		= create_time_it("Upperbound 3");
-		counters [UPDATE_UB]	= create_time_it("Update UB");
-		counters [ADDTIME]	= create_time_it("Add Time");
-		counters [MSTEDGE]	= create_time_it("Not MST Edge");
-		counters [LEGALFLIP]	= create_time_it("Illegal flip");
-		counters [LENGTH]	= create_time_it("Length");
-		counters [REPLACE]	= create_time_it("Replaced");
-		counters [ADDNEW]	= create_time_it("Added");
-	}
-
-	if (Verbose) start_timer(counters[GENERATOR]);
-
 	initialize_uinfo (uip);
 	hFSTcount = 0;
 
+	if (Verbose) {
+		COUNT_QUERY (uip, GENERATOR);
+		Tgen = _gst_get_cpu_time ();
+	}
+
 	/* Initialize various commonly used variables */
 	params		= uip -> params;
 	timing		= params -> detailed_timings_channel;
@@ -461,8 +557,6 @@ gst_channel_ptr		timing;
 	lambda		= metric -> lambda;
 	max_angle	= metric -> max_angle;
 	min_angle	= metric -> min_angle;
-	eps_factor	= 1.0 + uip -> eps;
-	BSD	= uip -> bsd;
 	pts	= uip -> pts;
 	n	= pts -> n;
 
@@ -596,513 +690,786 @@ gst_channel_ptr		timing;
 		}
 	}
 
-	/* The variable 'hfstk' is used repeatedly to generate new trees.
-	   It is copied whenever a tree needs to be saved for later use. */
+	/* The variable 'hfstk' is the initial state of every new hFST. */
 	hfstk.terms	= NULL;
 	hfstk.ext	= -1;
 
+	/* Set up the private UFST info of each thread. */
+	nthreads = _gst_resolve_num_threads (params -> num_threads);
+	batch.uips = NEWA (nthreads, struct uinfo);
+	for (i = 0; i < nthreads; i++) {
+		initialize_thread_uinfo (&(batch.uips [i]), uip);
+	}
+	batch.lists		= hFST_Lists;
+	batch.proto		= hfstk;
+	batch.meetAngles	= meetAngles;
+	batch.isLeftRight	= isLeftRight;
+
 	max_fst_size = params -> max_fst_size;
 	if (max_fst_size > n) max_fst_size = n;
 	for (size = 2; size <= max_fst_size; size++) {
-		int isize, jsize;
-		/* New terminal array size */
-		hfstk.terms = NEWA (size + 1, int);
-		hfstk.S	    = size;
+		int isize;
+
+		/* The FSTs of size 2 are always generated, so that	*/
+		/* the hypergraph is connected.  Larger sizes are only	*/
+		/* started while there is time left.			*/
+		if ((size > 2) AND
+		    TIME_LIMIT_REACHED (params -> fst_time_limit,
+					&(uip -> fst_poll))) {
+			uip -> complete_size = size - 1;
+			break;
+		}
 
 		if (Verbose) {
 			fprintf (stderr, "- starting hFST size %d (hFSTs: %d, FSTs: %d)\n",
 				size, hFSTcount, uip -> ntrees);
 		}
 
+		/* Every pair of hFSTs whose sizes add up to size is	*/
+		/* combined while extending the larger (or later) one.	*/
+		/* Only the lists of smaller hFSTs are read while doing	*/
+		/* so, which permits several threads to do it.		*/
+		nhfsts = 0;
+		hfsts = NEWA (hFSTcount + 1, struct hFST *);
 		isize = (size-1)/2 + 1;
 		for ( ; isize < size; isize++) {
 			struct hFST *hfsti;
 			for (hfsti = hFST_Lists[isize]; hfsti; hfsti = hfsti -> next) {
-				struct hFST *hfstj;
-				bool degree4possible;
-				bool hfsti_changed = TRUE;
-				bool bsd_reusable = FALSE;
-				jsize = size - isize;
-
-				/* Setup special degree 4 flag */
-				/* This might not be entirely correct... */
-				degree4possible = ( (isize EQ 2)
-						AND (jsize EQ 2)
-						AND ((K EQ 4) OR (K EQ 8)));
-
-
-				for (hfstj = hFST_Lists[jsize]; hfstj; hfstj = hfstj -> next) {
-					int ii, jj;
-					int meetangle;
-					double dist_ik, dist_jk;
-					struct point *iRoot, *jRoot;
-					int extensions;
-					double cachedMST;
-					bool disjoint;
-
-					bool size_condition;
+				hfsts [nhfsts++] = hfsti;
+			}
+		}
+
+		chunk = nhfsts / (TASKS_PER_THREAD * nthreads);
+		if (chunk < 1) {
+			chunk = 1;
+		}
+		ntasks = (nhfsts + chunk - 1) / chunk;
+		tasks = NEWA (ntasks + 1, struct ufst_task);
+		for (i = 0; i < ntasks; i++) {
+			tasks [i].first	= i * chunk;
+			tasks [i].last	= MIN ((i + 1) * chunk, nhfsts);
+			tasks [i].cands	= NULL;
+			tasks [i].timed_out = FALSE;
+		}
+
+		batch.size	= size;
+		batch.hfsts	= hfsts;
+		batch.tasks	= tasks;
+
+		(void) _gst_parallel_for (nthreads, ntasks, hfst_task, &batch);
+
+		/* Merge the results of the tasks, in order.  Those cut	*/
+		/* short by the time limit still found valid FSTs, but	*/
+		/* perhaps not all of this size.			*/
+		for (i = 0; i < ntasks; i++) {
+			merge_hcands (uip, hFST_Lists, size, tasks [i].cands, &hFSTcount);
+			if (tasks [i].timed_out) {
+				uip -> complete_size = size - 1;
+			}
+		}
+
+		free (tasks);
+		free (hfsts);
+
+		if (timing NE NULL) {
+			_gst_convert_delta_cpu_time (buf1, Tn);
+			gst_channel_printf (timing, "Size %3d generation:    %s\n", size, buf1);
+		}
+
+		if (uip -> complete_size > 0) break;
+	}
+
+	if ((timing NE NULL) AND (uip -> complete_size > 0)) {
+		gst_channel_printf (timing,
+				    "- time limit reached, FSTs complete"
+				    " up to size %d\n",
+				    uip -> complete_size);
+	}
+
+	for (i = 0; i < nthreads; i++) {
+		destroy_thread_uinfo (&(batch.uips [i]), uip);
+	}
+	free (batch.uips);
+
+	free (isLeftRight);
+	free (meetAngles);
+
+	if (Verbose) {
+		struct ustats *	sp = uip -> stats;
+		int iterations = sp -> queries[SUBPATH];
+
+		_gst_convert_cpu_time (_gst_get_cpu_time () - Tgen, buf1);
+		fprintf (stderr, "FST-count: %d, hFSTCount: %d, Time: %s\n",
+			uip -> ntrees, hFSTcount, buf1);
+
+		fprintf (stderr, "\n              Queries          Pruned                Left\n");
+		for (i=0; i<NUM_OF_COUNTERS; i++) {
+			/* Avoid dividing by zero (which might trap). */
+			int queries = MAX (sp -> queries[i], 1);
+			fprintf (stderr, "%-12s: %8d - %8d (%6.2f%%) = %8d (%6.2f%%)\n",
+			 counter_names[i],
+			 sp -> queries[i],
+			 sp -> pruned[i],
+			 100.0*sp -> pruned[i]
+			  / queries,
+			 sp -> queries[i] - sp -> pruned[i],
+			 100.0 * (sp -> queries[i] - sp -> pruned[i])
+			  / MAX (iterations, 1));
+		}
+		fprintf (stderr, "\n");
+	}
+
+	uip -> hFSTCount = hFSTcount;
+
+	for (i = 0; i <= n; i++) {
+		if (hFST_Lists[i]) {
+			struct hFST *hfst = hFST_Lists[i];
+			while (hfst) {
+				struct hFST *tmp = hfst -> next;
+				free (hfst -> terms);
+				free (hfst);
+				hfst = tmp;
+			}
+		}
+	}
+	free (hFST_Lists);
+
+	/* Translate terminals back */
+	for (k = 0; k < n; k++) {
+		pts -> a[k] = uip -> pts_org -> a[k];
+	}
+	free (uip -> pts_org);
+
+	destroy_uinfo (uip);
+}
+
+/*
+ * Combine the hFSTs of one task with every smaller (or earlier) hFST
+ * whose size adds up to the size being generated, on behalf of
+ * compute_ufsts_for_unique_terminals().  The results go into a list
+ * of candidates private to the task.
+ */
+
+	static
+	void
+hfst_task (
+
+void *		arg,		/* IN/OUT - the batch */
+int		task,		/* IN - task to perform */
+int		thread		/* IN - thread executing task */
+)
+{
+int			i;
+struct ufst_batch *	bp;
+struct ufst_task *	tp;
+struct uinfo *		uip;
+struct hcand **		tail;
+struct hFST		hfstk;
+
+	bp	= (struct ufst_batch *) arg;
+	tp	= &(bp -> tasks [task]);
+	uip	= &(bp -> uips [thread]);
+
+	hfstk.terms = NEWA (bp -> size + 1, int);
+
+	tail = &(tp -> cands);
+	for (i = tp -> first; i < tp -> last; i++) {
+		if ((bp -> size > 2) AND
+		    TIME_LIMIT_REACHED (uip -> params -> fst_time_limit,
+					&(uip -> fst_poll))) {
+			tp -> timed_out = TRUE;
+			break;
+		}
+		tail = extend_hfst (bp, uip, bp -> hfsts [i], &hfstk, tail);
+	}
+	*tail = NULL;
+
+	free (hfstk.terms);
+}
+
+/*
+ * Combine the given hFST with each hFST that completes it to the size
+ * being generated, and apply all of the tests that do not depend upon
+ * other hFSTs of this size.  Every new hFST, and every FST that passes
+ * the tests, is appended to the given list of candidates.  Returns the
+ * new tail of the list.
+ */
+
+	static
+	struct hcand **
+extend_hfst (
+
+struct ufst_batch *	bp,		/* IN - the batch */
+struct uinfo *		uip,		/* IN - private UFST info */
+struct hFST *		hfsti,		/* IN - hFST to extend */
+struct hFST *		hfstk,		/* IN/OUT - scratch hFST */
+struct hcand **		tail		/* IN/OUT - end of candidate list */
+)
+{
+int			ti, tj;
+int			K;		/* 2 * lambda */
+int			lambda;
+int			size;		/* Size of (h)FST */
+int			jsize;
+int			max_angle;
+dist_t			eps_factor;
+int *			meetAngles;
+int *			terms;
+bool *			isLeftRight;
+bool			degree4possible;
+bool			hfsti_changed;
+bool			bsd_reusable;
+struct point		droot;
+struct point		dp;
+struct pset *		pts;
+struct bsd *		BSD;
+struct hFST *		hfstj;
+struct hFST *		tLeft;
+struct hFST *		tRight;
+struct hcand *		cp;
+gst_metric_ptr		metric;
+
+	metric		= uip -> metric;
+	K		= metric -> K;
+	lambda		= metric -> lambda;
+	max_angle	= metric -> max_angle;
+	eps_factor	= 1.0 + uip -> eps;
+	BSD		= uip -> bsd;
+	pts		= uip -> pts;
+	meetAngles	= bp -> meetAngles;
+	isLeftRight	= bp -> isLeftRight;
+	size		= bp -> size;
+
+	/* Every hFST starts out the same, whichever thread makes it. */
+	terms		= hfstk -> terms;
+	*hfstk		= bp -> proto;
+	hfstk -> terms	= terms;
+	hfstk -> S	= size;
+
+	hfsti_changed = TRUE;
+	bsd_reusable = FALSE;
+	jsize = size - hfsti -> S;
+
+	/* Setup special degree 4 flag */
+	/* This might not be entirely correct... */
+	degree4possible = ( (hfsti -> S EQ 2)
+			AND (jsize EQ 2)
+			AND ((K EQ 4) OR (K EQ 8)));
+
+	for (hfstj = bp -> lists [jsize]; hfstj; hfstj = hfstj -> next) {
+		int ii, jj;
+		int meetangle;
+		double dist_ik, dist_jk;
+		struct point *iRoot, *jRoot;
+		int extensions;
+		double cachedMST;
+		bool disjoint;
+
+		bool size_condition;
 #if 1
-					size_condition = TRUE;
+		size_condition = TRUE;
 #else
-					size_condition = (jsize EQ isize);
+		size_condition = (jsize EQ hfsti -> S);
 #endif
-					if (size_condition AND (hfsti EQ hfstj)) {
-						break;
-					}
+		if (size_condition AND (hfsti EQ hfstj)) {
+			break;
+		}
 
-					if (bsd_reusable AND (NOT hfstj -> prev_identical)) {
-						bsd_reusable = FALSE;
-					}
+		if (bsd_reusable AND (NOT hfstj -> prev_identical)) {
+			bsd_reusable = FALSE;
+		}
 
-					/* This test works for any lambda-value:
-					   The subtree which does not contain the lowest
-					   index can be pruned if it is in a mixed state. */
-					if (SubpathTest) {
-						if (Verbose) start_timer(counters[SUBPATH]);
-						if (*hfsti -> terms < *hfstj -> terms) {
-							if (hfstj -> status EQ STATE_MIXED) {
-								if (Verbose) stop_timer (counters[SUBPATH], TRUE);
-								continue;
-							}
-						}
-						else {
-							if (hfsti -> status EQ STATE_MIXED) {
-								if (Verbose) stop_timer (counters[SUBPATH], TRUE);
-								continue;
-							}
-						}
-						if (Verbose) stop_timer (counters[SUBPATH], FALSE);
-					}
+		/* This test works for any lambda-value:
+		   The subtree which does not contain the lowest
+		   index can be pruned if it is in a mixed state. */
+		if (SubpathTest) {
+			if (Verbose) COUNT_QUERY (uip, SUBPATH);
+			if (*hfsti -> terms < *hfstj -> terms) {
+				if (hfstj -> status EQ STATE_MIXED) {
+					if (Verbose) COUNT_PRUNED (uip, SUBPATH);
+					continue;
+				}
+			}
+			else {
+				if (hfsti -> status EQ STATE_MIXED) {
+					if (Verbose) COUNT_PRUNED (uip, SUBPATH);
+					continue;
+				}
+			}
+		}
 
-					/* Check that the hFSTs are terminal disjoint */
-					disjoint = TRUE;
-					if (Verbose) start_timer(counters[DISJOINT]);
-					if (size EQ 2) { /* Two terminals */
-						if (hfsti -> index EQ hfstj -> index) {
-							disjoint = FALSE;
-						}
-					}
-					else {
-						if (NOT is_disjoint(hfsti, hfstj)) {
-							disjoint = FALSE;
-						}
-					}
+		/* Check that the hFSTs are terminal disjoint */
+		disjoint = TRUE;
+		if (Verbose) COUNT_QUERY (uip, DISJOINT);
+		if (size EQ 2) { /* Two terminals */
+			if (hfsti -> index EQ hfstj -> index) {
+				disjoint = FALSE;
+			}
+		}
+		else {
+			if (NOT is_disjoint(hfsti, hfstj)) {
+				disjoint = FALSE;
+			}
+		}
 
-					if (disjoint) {
-						if (Verbose) stop_timer (counters[DISJOINT], FALSE);
-					}
-					else {
-						/* Skip identical hFSTs - regarding terminals */
-						while (hfstj -> next AND hfstj -> next -> prev_identical) {
-							hfstj = hfstj -> next;
-							if (hfsti EQ hfstj) {
-								break;
-							}
-						}
-						if (Verbose) stop_timer (counters[DISJOINT], TRUE);
-						continue;
-					}
+		if (NOT disjoint) {
+			/* Skip identical hFSTs - regarding terminals */
+			while (hfstj -> next AND hfstj -> next -> prev_identical) {
+				hfstj = hfstj -> next;
+				if (hfsti EQ hfstj) {
+					break;
+				}
+			}
+			if (Verbose) COUNT_PRUNED (uip, DISJOINT);
+			continue;
+		}
 
-					/* Check that meeting angle is valid
-					   (might be a bending point on a non-straight edge!) */
-
-					ii = hfsti -> ext;
-					jj = hfstj -> ext;
-					iRoot = &hfsti -> root;
-					jRoot = &hfstj -> root;
-
-					/* Is it a legal angle? (This test could be better if
-					   it also considered the direction of the rays). */
-					if (Verbose) start_timer(counters[ANGLE]);
-					meetangle = meetAngles[ii*K + jj];
-					if (NOT meetangle) {
-						/* Illegal unless it is a degree 4
-						   Steiner point, not parallel and
-						   with (almost) identical Root
-						   points */
-						if (   degree4possible
-						   AND ((ii - jj) % lambda EQ 0)
-						   AND (points_close(iRoot, jRoot, uip -> eps)) ) {
-							/* Save it as an FST */
-							hfstk.length	 = hfsti -> length + hfstj -> length;
-							hfstk.left_tree	 = hfsti;
-							hfstk.right_tree = hfstj;
-							hfstk.type	 = TYPE_CROSS;
-							hfstk.root       = *iRoot;
-							update_terms(&hfstk); /* Update array of terminals. */
-							test_and_save_fst (uip, &hfstk);
-							continue;
-						}
-						else {
-							if (Verbose) stop_timer (counters[ANGLE], TRUE);
-							continue;
-						}
-					}
-					if (Verbose) stop_timer (counters[ANGLE], FALSE);
-
-					/* Roots should not be equal (but be careful with MST edges!) */
-					if (Verbose) start_timer(counters[INTERSECT]);
-					if ( (points_close(iRoot, jRoot, uip -> eps)) AND
-					     (NOT ((hfstk.S EQ 2) AND 
-						   (_gst_is_mst_edge(BSD, hfsti->index, hfstj->index)))) ) {
-						if (Verbose) stop_timer (counters[INTERSECT], TRUE);
-						continue;
-					}
+		/* Check that meeting angle is valid
+		   (might be a bending point on a non-straight edge!) */
+
+		ii = hfsti -> ext;
+		jj = hfstj -> ext;
+		iRoot = &hfsti -> root;
+		jRoot = &hfstj -> root;
+
+		/* Is it a legal angle? (This test could be better if
+		   it also considered the direction of the rays). */
+		if (Verbose) COUNT_QUERY (uip, ANGLE);
+		meetangle = meetAngles[ii*K + jj];
+		if (NOT meetangle) {
+			/* Illegal unless it is a degree 4
+			   Steiner point, not parallel and
+			   with (almost) identical Root
+			   points */
+			if (   degree4possible
+			   AND ((ii - jj) % lambda EQ 0)
+			   AND (points_close(iRoot, jRoot, uip -> eps)) ) {
+				/* Save it as an FST */
+				hfstk -> length	    = hfsti -> length + hfstj -> length;
+				hfstk -> left_tree  = hfsti;
+				hfstk -> right_tree = hfstj;
+				hfstk -> type	    = TYPE_CROSS;
+				hfstk -> root       = *iRoot;
+				update_terms(hfstk); /* Update array of terminals. */
+				*tail = new_hcand (hfstk, FALSE, TRUE);
+				tail = &((*tail) -> next);
+				continue;
+			}
+			else {
+				if (Verbose) COUNT_PRUNED (uip, ANGLE);
+				continue;
+			}
+		}
 
-					/* Compute root of combined hFST */
-					/* We do it carefully using displacements */
+		/* Roots should not be equal (but be careful with MST edges!) */
+		if (Verbose) COUNT_QUERY (uip, INTERSECT);
+		if ( (points_close(iRoot, jRoot, uip -> eps)) AND
+		     (NOT ((hfstk -> S EQ 2) AND
+			   (_gst_is_mst_edge(BSD, hfsti->index, hfstj->index)))) ) {
+			if (Verbose) COUNT_PRUNED (uip, INTERSECT);
+			continue;
+		}
 
-					ti = hfsti -> origin_term;
-					tj = hfstj -> origin_term;
+		/* Compute root of combined hFST */
+		/* We do it carefully using displacements */
 
-					dp.x = pts -> a[tj].x - pts -> a[ti].x;
-					dp.y = pts -> a[tj].y - pts -> a[ti].y;
+		ti = hfsti -> origin_term;
+		tj = hfstj -> origin_term;
 
-					/* Add displacements */
-					dp.x -= hfsti -> droot.x;
-					dp.y -= hfsti -> droot.y;
-					dp.x += hfstj -> droot.x;
-					dp.y += hfstj -> droot.y;
+		dp.x = pts -> a[tj].x - pts -> a[ti].x;
+		dp.y = pts -> a[tj].y - pts -> a[ti].y;
 
-					/* Compute intersection */
-					if (NOT _gst_ray_intersection(&metric -> dirs[ii],
-								      &dp,
-								      &metric -> dirs[jj],
-								      uip -> eps, &droot)) {
-						if (Verbose) stop_timer (counters[INTERSECT], TRUE);
-						continue;
-					}
+		/* Add displacements */
+		dp.x -= hfsti -> droot.x;
+		dp.y -= hfsti -> droot.y;
+		dp.x += hfstj -> droot.x;
+		dp.y += hfstj -> droot.y;
 
-					hfstk.droot.x = hfsti -> droot.x + droot.x; 
-					hfstk.droot.y = hfsti -> droot.y + droot.y; 
-					hfstk.origin_term = hfsti -> origin_term;
+		/* Compute intersection */
+		if (NOT _gst_ray_intersection(&metric -> dirs[ii],
+					      &dp,
+					      &metric -> dirs[jj],
+					      uip -> eps, &droot)) {
+			if (Verbose) COUNT_PRUNED (uip, INTERSECT);
+			continue;
+		}
 
-					/* Move new root to final position */
-					hfstk.root.x = pts -> a[ hfstk.origin_term ].x +
-						       hfstk.droot.x;
-					hfstk.root.y = pts -> a[ hfstk.origin_term ].y +
-						       hfstk.droot.y;
-					if (Verbose) stop_timer (counters[INTERSECT], FALSE);
+		hfstk -> droot.x = hfsti -> droot.x + droot.x;
+		hfstk -> droot.y = hfsti -> droot.y + droot.y;
+		hfstk -> origin_term = hfsti -> origin_term;
 
-					/* Bottleneck Steiner distances */
+		/* Move new root to final position */
+		hfstk -> root.x = pts -> a[ hfstk -> origin_term ].x +
+				  hfstk -> droot.x;
+		hfstk -> root.y = pts -> a[ hfstk -> origin_term ].y +
+				  hfstk -> droot.y;
 
-					if (Verbose) start_timer(counters[BSDTEST]);
-					if ((NOT bsd_reusable) OR (hfsti_changed)) {
-						hfstk.BS = get_bsd(hfsti, hfstj, BSD);
-						hfsti_changed = FALSE;
-						bsd_reusable = TRUE;
-					}
-					hfstk.UB = hfsti->UB + hfstj->UB + hfstk.BS;
+		/* Bottleneck Steiner distances */
 
-					dist_ik = sqrt(droot.x * droot.x + droot.y * droot.y);
-					if (dist_ik > eps_factor * hfstk.BS) {
-						if (Verbose) stop_timer (counters[BSDTEST], TRUE);
-						continue;
-					}
+		if (Verbose) COUNT_QUERY (uip, BSDTEST);
+		if ((NOT bsd_reusable) OR (hfsti_changed)) {
+			hfstk -> BS = get_bsd(hfsti, hfstj, BSD);
+			hfsti_changed = FALSE;
+			bsd_reusable = TRUE;
+		}
+		hfstk -> UB = hfsti->UB + hfstj->UB + hfstk -> BS;
 
-					dist_jk = sqrt(sqr_dist(&droot, &dp));
-					if (dist_jk > eps_factor * hfstk.BS) {
-						if (Verbose) stop_timer (counters[BSDTEST], TRUE);
-						continue;
-					}
-					if (Verbose) stop_timer (counters[BSDTEST], FALSE);
+		dist_ik = sqrt(droot.x * droot.x + droot.y * droot.y);
+		if (dist_ik > eps_factor * hfstk -> BS) {
+			if (Verbose) COUNT_PRUNED (uip, BSDTEST);
+			continue;
+		}
 
-					/* Edge Lune Test */
-					if (Verbose) start_timer(counters[LUNE]);
-					if (NOT edge_lune_test(uip, hfsti, hfstj, &hfstk,
-							       dist_ik, dist_jk)) {
-						if (Verbose) stop_timer (counters[LUNE], TRUE);
-						continue;
-					}
-					if (Verbose) stop_timer (counters[LUNE], FALSE);
+		dist_jk = sqrt(sqr_dist(&droot, &dp));
+		if (dist_jk > eps_factor * hfstk -> BS) {
+			if (Verbose) COUNT_PRUNED (uip, BSDTEST);
+			continue;
+		}
 
-					/* Figure out what is left and what is right */
-					if (isLeftRight[ii*K+jj]) {
-						tLeft = hfsti; tRight = hfstj;
-					}
-					else {
-						tLeft = hfstj; tRight = hfsti;
-					}
+		/* Edge Lune Test */
+		if (Verbose) COUNT_QUERY (uip, LUNE);
+		if (NOT edge_lune_test(uip, hfsti, hfstj, hfstk,
+				       dist_ik, dist_jk)) {
+			if (Verbose) COUNT_PRUNED (uip, LUNE);
+			continue;
+		}
 
-					hfstk.left_tree		= tLeft;
-					hfstk.right_tree	= tRight;
-					hfstk.ext_left		= tLeft -> ext;
-					hfstk.ext_right		= tRight -> ext;
+		/* Figure out what is left and what is right */
+		if (isLeftRight[ii*K+jj]) {
+			tLeft = hfsti; tRight = hfstj;
+		}
+		else {
+			tLeft = hfstj; tRight = hfsti;
+		}
 
-					update_terms(&hfstk); /* Update array of terminals. */
-					hfstk.length = hfsti -> length + hfstj -> length + dist_ik + dist_jk;
+		hfstk -> left_tree	= tLeft;
+		hfstk -> right_tree	= tRight;
+		hfstk -> ext_left	= tLeft -> ext;
+		hfstk -> ext_right	= tRight -> ext;
 
-					/* If the Steiner point is VERY close to one of the points then
-					   it is defined as overlapping and should not be extended */
-					hfstk.type = TYPE_CORNER;
+		update_terms(hfstk); /* Update array of terminals. */
+		hfstk -> length = hfsti -> length + hfstj -> length + dist_ik + dist_jk;
 
-					if ( (points_close(&hfstk.root, iRoot, uip -> eps)) OR 
-					     (points_close(&hfstk.root, jRoot, uip -> eps)) ) {
-						hfstk.type = TYPE_STRAIGHT;
-					}
+		/* If the Steiner point is VERY close to one of the points then
+		   it is defined as overlapping and should not be extended */
+		hfstk -> type = TYPE_CORNER;
 
-					/* Can this hFST be extended */
-					extensions = 0;
-
-					/* No need to extend if Steiner point overlaps with children
-					   or the meeting angle is not legal at Steiner points */
-					if ((meetangle <= max_angle) AND (hfstk.type == TYPE_CORNER)) {
-						/* Setup the extensions */
-						extensions = setup_extensions(&hfstk, metric, meetangle);
-
-						/* Can the wedge test remove the extension(s) */
-						if (DoWedgeTest AND extensions) {
-							/* Check the first extension */
-							if (wedge_test (uip, &hfstk)) {
-								extensions--;
-								if (extensions) {
-									/* Check the second extension */
-									hfstk.status = STATE_CLEAN;
-									hfstk.ext = (hfstk.ext + 1) % K;
-									if (wedge_test(uip, &hfstk)) {
-										extensions--;
-									}
-								}
-							}
+		if ( (points_close(&hfstk -> root, iRoot, uip -> eps)) OR
+		     (points_close(&hfstk -> root, jRoot, uip -> eps)) ) {
+			hfstk -> type = TYPE_STRAIGHT;
+		}
 
-						}
-					}
+		/* Can this hFST be extended */
+		extensions = 0;
 
-					cachedMST = 0;
+		/* No need to extend if Steiner point overlaps with children
+		   or the meeting angle is not legal at Steiner points */
+		if ((meetangle <= max_angle) AND (hfstk -> type == TYPE_CORNER)) {
+			/* Setup the extensions */
+			extensions = setup_extensions(hfstk, metric, meetangle);
 
+			/* Can the wedge test remove the extension(s) */
+			if (DoWedgeTest AND extensions) {
+				/* Check the first extension */
+				if (wedge_test (uip, hfstk)) {
+					extensions--;
 					if (extensions) {
-						struct hFST *tmp;
-						struct hFST *before = NULL, *after;
-						int *termsk = hfstk.terms;
-						if (NOT upper_bound_tests (uip, &hfstk, TRUE)) continue;
-						/* Length of hFST is UB for tree spanning terminals */
-						if (Verbose) start_timer(counters[UPDATE_UB]);
-						if (size > 2) {
-							bool first_found = FALSE;
-							struct hFST *hfstl;
-
-							if (hfstk.UB > eps_factor * hfstk.length) {
-								hfstk.UB = hfstk.length;
-							}
-
-							/* Heuristic upper bound */
-							if (NOT cachedMST) {
-								cachedMST = hfst_mst (uip, &hfstk, FALSE);
-							}
-							if (hfstk.UB > eps_factor * cachedMST) {
-								hfstk.UB = cachedMST;
-							}
-
-							/* Now check if there is another hFST spanning the same set of terminals */
-							for (hfstl = hFST_Lists[size]; hfstl; hfstl = hfstl -> next) {
-								int *terms = hfstl -> terms;
-								if (identical_lists(terms, termsk)) {
-									first_found = TRUE;
-									if (hfstl->UB <= hfstk.UB) {
-										hfstk.UB = hfstl->UB;
-										/* This is deliberate (and correct) */
-										break;
-									}
-									else {
-										hfstl->UB = hfstk.UB;
-									}
-								}
-								else if (first_found) {
-									break;
-								}
-							}
+						/* Check the second extension */
+						hfstk -> status = STATE_CLEAN;
+						hfstk -> ext = (hfstk -> ext + 1) % K;
+						if (wedge_test(uip, hfstk)) {
+							extensions--;
 						}
-						if (Verbose) stop_timer (counters[UPDATE_UB], FALSE);
+					}
+				}
 
-						/* Sorted insertion of the hFST */
+			}
+		}
 
-						for (after = hFST_Lists[size]; after; after = after -> next) {
-							int *terms = after -> terms;
-							if (identical_lists(terms, termsk)) {
-								after -> prev_identical = TRUE;
-								break;
-							}
-							before = after;
-						}
+		cachedMST = 0;
+		cp = NULL;
 
-						tmp = NEW (struct hFST);
-						*tmp = hfstk;
-						if (before) {
-							before -> next = tmp;
-						}
-						else {
-							hFST_Lists[size] = tmp;
-						}
+		if (extensions) {
+			struct hFST *tmp;
+			if (NOT upper_bound_tests (uip, hfstk, TRUE)) continue;
+			/* Length of hFST is UB for tree spanning terminals */
+			if (size > 2) {
+				if (hfstk -> UB > eps_factor * hfstk -> length) {
+					hfstk -> UB = hfstk -> length;
+				}
 
-						if (extensions EQ 2) {
-							hfstk.ext = (hfstk.ext + 1) % K;
-							hfstk.status = STATE_CLEAN;
-
-							if (NOT (DoWedgeTest AND wedge_test(uip, &hfstk))) {
-								struct hFST *tmp2 = NEW (struct hFST);
-								*tmp2 = hfstk;
-								tmp2 -> terms = NEWA (size+1, int);
-								memcpy (tmp2 -> terms, tmp -> terms, (size + 1)*sizeof (int));
-								tmp2 -> prev_identical = TRUE;
-								tmp -> next = tmp2;
-								tmp = tmp2;
-
-								hFSTcount++;
-							}
-						}
+				/* Heuristic upper bound */
+				if (NOT cachedMST) {
+					cachedMST = hfst_mst (uip, hfstk, FALSE);
+				}
+				if (hfstk -> UB > eps_factor * cachedMST) {
+					hfstk -> UB = cachedMST;
+				}
+
+				/* Any other hFST spanning the same	*/
+				/* terminals is dealt with when merging.	*/
+			}
 
-						tmp -> next = after;
+			tmp = NEW (struct hFST);
+			*tmp = *hfstk;
+			tmp -> next = NULL;
+			cp = new_hcand (tmp, TRUE, FALSE);
+			*tail = cp;
+			tail = &(cp -> next);
+
+			if (extensions EQ 2) {
+				hfstk -> ext = (hfstk -> ext + 1) % K;
+				hfstk -> status = STATE_CLEAN;
+
+				if (NOT (DoWedgeTest AND wedge_test(uip, hfstk))) {
+					struct hFST *tmp2 = NEW (struct hFST);
+					*tmp2 = *hfstk;
+					tmp2 -> terms = NEWA (size+1, int);
+					memcpy (tmp2 -> terms, tmp -> terms, (size + 1)*sizeof (int));
+					tmp2 -> prev_identical = TRUE;
+					tmp2 -> next = NULL;
+					tmp -> next = tmp2;
+				}
+			}
 
-						hfstk.terms = NEWA (size+1, int);
-						memcpy (hfstk.terms, tmp -> terms, (size + 1)*sizeof (int));
+			hfstk -> terms = NEWA (size+1, int);
+			memcpy (hfstk -> terms, tmp -> terms, (size + 1)*sizeof (int));
+		}
 
-						hFSTcount++;
-					}
+		if (Verbose) COUNT_QUERY (uip, FSTCHECK);
 
-					if (Verbose) start_timer(counters[FSTCHECK]);
+		/* Make sure the bent edge has an angle of \pi - \omega */
+		if (meetangle < lambda - 1) {
+			if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+			continue;
+		}
 
-					/* Make sure the bent edge has an angle of \pi - \omega */
-					if (meetangle < lambda - 1) {
-						if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-						continue;
-					}
+		/* A subtle restriction... :-)
+		   Gives us the correct primary/secondary shape
+		   of the bent edge. */
+		if (*tLeft -> terms < *tRight -> terms) {
+			if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+			continue;
+		}
 
-					/* A subtle restriction... :-)
-					   Gives us the correct primary/secondary shape
-					   of the bent edge. */
-					if (*tLeft -> terms < *tRight -> terms) {
-						if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
+		if (size EQ 2) {
+			if (Verbose) COUNT_QUERY (uip, MSTEDGE);
+			if (NOT _gst_is_mst_edge(BSD, tLeft->index, tRight->index)) {
+				if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+				if (Verbose) COUNT_PRUNED (uip, MSTEDGE);
+				continue;
+			}
+		}
+		else { /* size > 2 */
+			if (tRight -> status EQ STATE_CLEAN) {
+				/* The bent edge cannot appear
+				   in a tree to the right */
+				if (lambda % 3 EQ 0) {
+					if (NOT tRight -> mixable) {
+						if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
 						continue;
 					}
-
-					if (size EQ 2) {
-						if (Verbose) start_timer(counters[MSTEDGE]);
-						if (NOT _gst_is_mst_edge(BSD, tLeft->index, tRight->index)) {
-							if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-							if (Verbose) stop_timer (counters[MSTEDGE], TRUE);
-							continue;
-						}
-						if (Verbose) stop_timer (counters[MSTEDGE], FALSE);
+				}
+				else {
+					if (tRight -> right_legs[0]) {
+						if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+						continue;
 					}
-					else { /* size > 2 */
-						if (tRight -> status EQ STATE_CLEAN) {
-							/* The bent edge cannot appear
-							   in a tree to the right */
-							if (lambda % 3 EQ 0) {
-								if (NOT tRight -> mixable) {
-									if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-									continue;
-								}
-							}
-							else {
-								if (tRight -> right_legs[0]) {
-									if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-									continue;
-								}
-							}
-						}
-						else { /* tRight->Status EQ STATE_MIXED */
-							/* The mixed edge has to be the bent edge
-							   when lambda NE 3m */
-							if (lambda % 3 NE 0 AND tRight->mixed_index NE 0) {
-								if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-								continue;
-							}
-						}
-
-						if (Verbose) start_timer(counters[LENGTH]);
-						if (hfstk.length > eps_factor * hfstk.UB) {
-							if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-							if (Verbose) stop_timer (counters[LENGTH], TRUE);
-							continue;
-						}
-						if (Verbose) stop_timer (counters[LENGTH], FALSE);
+				}
+			}
+			else { /* tRight->Status EQ STATE_MIXED */
+				/* The mixed edge has to be the bent edge
+				   when lambda NE 3m */
+				if (lambda % 3 NE 0 AND tRight->mixed_index NE 0) {
+					if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+					continue;
+				}
+			}
 
-						if (dist_ik + dist_jk > eps_factor * hfstk.BS) {
-							if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-							continue;
-						}
+			/* The upper bound of a new hFST may yet be	*/
+			/* tightened, so its length test is done when	*/
+			/* merging.					*/
+			if (cp EQ NULL) {
+				if (Verbose) COUNT_QUERY (uip, LENGTH);
+				if (hfstk -> length > eps_factor * hfstk -> UB) {
+					if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+					if (Verbose) COUNT_PRUNED (uip, LENGTH);
+					continue;
+				}
+			}
 
-						if (NOT extensions) {
-							if (NOT upper_bound_tests (uip, &hfstk, FALSE)) continue;
-						}
+			if (dist_ik + dist_jk > eps_factor * hfstk -> BS) {
+				if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+				continue;
+			}
 
-						/* Compute MST for terminals and Steiner points */
-						if (NOT cachedMST) {
-							cachedMST = hfst_mst(uip, &hfstk, FALSE);
-						}
-						if (hfstk.length > eps_factor * cachedMST) {
-							if (Verbose) stop_timer (counters[FSTCHECK], TRUE);
-							continue;
-						}
-					}
-					if (Verbose) stop_timer (counters[FSTCHECK], FALSE);
+			if (NOT extensions) {
+				if (NOT upper_bound_tests (uip, hfstk, FALSE)) continue;
+			}
 
-					test_and_save_fst (uip, &hfstk);
-				}
+			/* Compute MST for terminals and Steiner points */
+			if (NOT cachedMST) {
+				cachedMST = hfst_mst(uip, hfstk, FALSE);
+			}
+			if (hfstk -> length > eps_factor * cachedMST) {
+				if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+				continue;
 			}
 		}
-		free (hfstk.terms);
 
-		if (timing NE NULL) {
-			_gst_convert_delta_cpu_time (buf1, Tn);
-			gst_channel_printf (timing, "Size %3d generation:    %s\n", size, buf1);
+		if (cp NE NULL) {
+			cp -> save = TRUE;
+		}
+		else {
+			*tail = new_hcand (hfstk, FALSE, TRUE);
+			tail = &((*tail) -> next);
 		}
 	}
 
-	free (isLeftRight);
-	free (meetAngles);
+	return (tail);
+}
+
+/*
+ * Make a new candidate.  An hFST that is only to be saved as an FST
+ * is copied, since the scratch hFST given is reused.
+ */
 
-	if (Verbose) {
-		int genTime;
-		int iterations = counters[SUBPATH] -> queries;
-		stop_timer (counters[GENERATOR], FALSE);
-		genTime = counters[GENERATOR] -> elapsed_time;
+	static
+	struct hcand *
+new_hcand (
 
-		fprintf (stderr, "FST-count: %d, hFSTCount: %d\n",
-			uip -> ntrees, hFSTcount);
+struct hFST *		hfst,		/* IN - hFST */
+bool			insert,		/* IN - insert into hFST list? */
+bool			save		/* IN - save as an FST? */
+)
+{
+struct hcand *		cp;
+struct hFST *		tmp;
 
-		fprintf (stderr, "\n              Queries          Pruned                Left               Time\n");
-		for (i=0; i<NUM_OF_COUNTERS; i++) {
-			fprintf (stderr, "%-12s: %8d - %8d (%6.2f%%) = %8d (%6.2f%%),\t%3d (%6.2f%%)\n",
-			 counters[i] -> name,
-			 counters[i] -> queries,
-			 counters[i] -> pruned,
-			 100.0*counters[i] -> pruned
-			  / counters[i] -> queries,
-			 counters[i] -> queries - counters[i] -> pruned,
-			 100.0 * (counters[i] -> queries - counters[i]->pruned)
-			  / iterations,
-			 counters[i] -> elapsed_time,
-			 100.0*counters[i] -> elapsed_time/genTime);
-
-			free (counters[i]);
-		}
-		fprintf (stderr, "\n");
+	if (NOT insert) {
+		tmp = NEW (struct hFST);
+		*tmp = *hfst;
+		tmp -> terms = NEWA (hfst -> S + 1, int);
+		memcpy (tmp -> terms, hfst -> terms, (hfst -> S + 1) * sizeof (int));
+		tmp -> next = NULL;
+		hfst = tmp;
 	}
 
-	uip -> hFSTCount = hFSTcount;
+	cp = NEW (struct hcand);
+	cp -> next	= NULL;
+	cp -> hfst	= hfst;
+	cp -> insert	= insert;
+	cp -> save	= save;
 
-	for (i = 0; i <= n; i++) {
-		if (hFST_Lists[i]) {
-			struct hFST *hfst = hFST_Lists[i];
-			while (hfst) {
-				struct hFST *tmp = hfst -> next;
-				free (hfst -> terms);
-				free (hfst);
-				hfst = tmp;
+	return (cp);
+}
+
+/*
+ * Merge the candidates found by one task into the list of hFSTs of the
+ * given size, and into the saved FSTs.  This is done exactly as the
+ * serial algorithm did, one candidate at a time.
+ */
+
+	static
+	void
+merge_hcands (
+
+struct uinfo *		uip,		/* IN/OUT - global UFST info */
+struct hFST **		hFST_Lists,	/* IN/OUT - hFSTs of each size */
+int			size,		/* IN - size of new hFSTs */
+struct hcand *		cands,		/* IN - candidates to merge */
+int *			hFSTcount	/* IN/OUT - number of hFSTs */
+)
+{
+dist_t			eps_factor;
+struct hcand *		cp;
+struct hFST *		hfstk;
+struct hFST *		tmp;
+int *			termsk;
+
+	eps_factor = 1.0 + uip -> eps;
+
+	while (cands NE NULL) {
+		cp = cands;
+		cands = cp -> next;
+		hfstk = cp -> hfst;
+
+		if (cp -> insert) {
+			struct hFST *before = NULL, *after;
+			termsk = hfstk -> terms;
+			if (Verbose) COUNT_QUERY (uip, UPDATE_UB);
+			if (size > 2) {
+				bool first_found = FALSE;
+				struct hFST *hfstl;
+
+				/* Now check if there is another hFST spanning the same set of terminals */
+				for (hfstl = hFST_Lists[size]; hfstl; hfstl = hfstl -> next) {
+					int *terms = hfstl -> terms;
+					if (identical_lists(terms, termsk)) {
+						first_found = TRUE;
+						if (hfstl->UB <= hfstk->UB) {
+							hfstk->UB = hfstl->UB;
+							/* This is deliberate (and correct) */
+							break;
+						}
+						else {
+							hfstl->UB = hfstk->UB;
+						}
+					}
+					else if (first_found) {
+						break;
+					}
+				}
+			}
+
+			/* Sorted insertion of the hFST */
+
+			for (after = hFST_Lists[size]; after; after = after -> next) {
+				int *terms = after -> terms;
+				if (identical_lists(terms, termsk)) {
+					after -> prev_identical = TRUE;
+					break;
+				}
+				before = after;
+			}
+
+			if (before) {
+				before -> next = hfstk;
+			}
+			else {
+				hFST_Lists[size] = hfstk;
+			}
+
+			tmp = hfstk;
+			++(*hFSTcount);
+			if (tmp -> next NE NULL) {
+				/* The second extension */
+				tmp = tmp -> next;
+				tmp -> UB = hfstk -> UB;
+				++(*hFSTcount);
+			}
+			tmp -> next = after;
+
+			if (cp -> save AND (size > 2)) {
+				if (Verbose) COUNT_QUERY (uip, LENGTH);
+				if (hfstk -> length > eps_factor * hfstk -> UB) {
+					if (Verbose) COUNT_PRUNED (uip, FSTCHECK);
+					if (Verbose) COUNT_PRUNED (uip, LENGTH);
+					cp -> save = FALSE;
+				}
 			}
 		}
-	}
-	free (hFST_Lists);
 
-	/* Translate terminals back */
-	for (k = 0; k < n; k++) {
-		pts -> a[k] = uip -> pts_org -> a[k];
-	}
-	free (uip -> pts_org);
+		if (cp -> save) {
+			test_and_save_fst (uip, hfstk);
+		}
 
-	destroy_uinfo (uip);
+		if (NOT cp -> insert) {
+			free (hfstk -> terms);
+			free (hfstk);
+		}
+		free (cp);
+	}
 }
 
 /*
@@ -1217,6 +1584,10 @@ gst_param_ptr	params;
 	}
 	uip -> list.forw	= &(uip -> list);
 	uip -> list.back	= &(uip -> list);
+	_gst_arena_init (&(uip -> list_mem), 1024 * sizeof (struct ulist));
+
+	uip -> stats		= NEW (struct ustats);
+	memset (uip -> stats, 0, sizeof (struct ustats));
 
 	free (mstedges);
 	free (edges);
@@ -1247,10 +1618,65 @@ struct ulist *	up;
 
 	free ((char *) (uip -> hash));		uip -> hash = NULL;
 	free ((char *) (uip -> term_check));	uip -> term_check = NULL;
+	free ((char *) (uip -> stats));		uip -> stats = NULL;
 
 	_gst_shutdown_bsd (uip -> bsd);
 }
 
+/*
+ * Initialize the private uinfo structure of one thread, which shares
+ * everything with the global one except the scratch arrays and the
+ * statistics counters.
+ */
+
+	static
+	void
+initialize_thread_uinfo (
+
+struct uinfo *		tip,		/* OUT - private UFST info */
+struct uinfo *		uip		/* IN - global UFST info */
+)
+{
+int		i;
+int		n;
+
+	n = uip -> pts -> n;
+
+	*tip = *uip;
+
+	tip -> term_check = NEWA (n, bool);
+	for (i = 0; i < n; i++) {
+		tip -> term_check [i] = FALSE;
+	}
+
+	tip -> stats = NEW (struct ustats);
+	memset (tip -> stats, 0, sizeof (struct ustats));
+}
+
+/*
+ * Free the private uinfo structure of one thread, adding its
+ * statistics counters to those of the global one.
+ */
+
+	static
+	void
+destroy_thread_uinfo (
+
+struct uinfo *		tip,		/* IN/OUT - private UFST info */
+struct uinfo *		uip		/* IN/OUT - global UFST info */
+)
+{
+int		i;
+
+	for (i = 0; i < NUM_OF_COUNTERS; i++) {
+		uip -> stats -> queries [i]	+= tip -> stats -> queries [i];
+		uip -> stats -> pruned [i]	+= tip -> stats -> pruned [i];
+	}
+
+	free ((char *) (tip -> stats));		tip -> stats = NULL;
+	free ((char *) (tip -> term_check));	tip -> term_check = NULL;
+}
+
 /*
  * Test if two points are very close to each other
  * (This test should be reasonably numerical robust.)
@@ -1412,37 +1838,34 @@ dist_t		eps_factor;
 
 	/* 1. upper bound */
 
-	if (Verbose) start_timer(counters[UB1]);
+	if (Verbose) COUNT_QUERY (uip, UB1);
 	distr = closest_terminal (hfst -> right_tree, uip -> metric, &hfst -> root);
 	distl = closest_terminal (hfst -> left_tree,  uip -> metric, &hfst -> root);
 	upper_bound = hfst -> right_tree -> UB + hfst -> left_tree -> UB + distr + distl;
 	if (eps_factor * upper_bound < hfst -> length) {
-		if (Verbose)	stop_timer (counters[UB1], TRUE);
+		if (Verbose) COUNT_PRUNED (uip, UB1);
 		return FALSE;
 	}
-	if (Verbose)	stop_timer (counters[UB1], FALSE);
 
 	/* 2. upper bound */
 
-	if (Verbose) start_timer(counters[UB2]);
+	if (Verbose) COUNT_QUERY (uip, UB2);
 	upper_bound = hfst -> right_tree -> UB + hfst -> left_tree -> UB
 			+ MIN(distr, distl) + hfst -> BS;
 	if (eps_factor * upper_bound < hfst -> length) {
-		if (Verbose) stop_timer (counters[UB2], TRUE);
+		if (Verbose) COUNT_PRUNED (uip, UB2);
 		return FALSE;
 	}
-	if (Verbose)	stop_timer (counters[UB2], FALSE);
 
 	/* 3. upper bound */
 
 	if (all_tests) {
-		if (Verbose) start_timer(counters[UB3]);
+		if (Verbose) COUNT_QUERY (uip, UB3);
 		upper_bound = hfst_mst (uip, hfst, TRUE);
 		if (eps_factor * upper_bound < hfst -> length) {
-			if (Verbose)	stop_timer (counters[UB3], TRUE);
+			if (Verbose) COUNT_PRUNED (uip, UB3);
 			return FALSE;
 		}
-		if (Verbose)	stop_timer (counters[UB3], FALSE);
 	}
 
 	return TRUE;
@@ -1477,7 +1900,7 @@ struct pset *	pts;
 		return 0;
 	}
 
-	if (Verbose)	start_timer(counters[WEDGE]);
+	if (Verbose) COUNT_QUERY (uip, WEDGE);
 
 	/* Mark all terminals which are members of this hFST */
 	set_member(hfst, uip -> term_check, TRUE);
@@ -1560,7 +1983,7 @@ struct pset *	pts;
 	}
 
 	set_member(hfst, uip->term_check, FALSE);
-	if (Verbose) stop_timer (counters[WEDGE], prunable);
+	if (Verbose AND prunable) COUNT_PRUNED (uip, WEDGE);
 
 	return (prunable);
 }
@@ -1726,7 +2149,7 @@ struct point *		p1;
 
 /*
  * Link all of the FSTs together into one long list and number them
- * each sequentially.  Free the doubly-linked ulists as we go.
+ * each sequentially.  The doubly-linked ulists are then freed.
  */
 
 	static
@@ -1739,7 +2162,6 @@ struct uinfo *		uip		/* IN - global RFST info */
 int			i;
 struct ulist *		up1;
 struct ulist *		up2;
-struct ulist *		up3;
 struct full_set *	fsp;
 struct full_set **	hookp;
 
@@ -1747,19 +2169,17 @@ struct full_set **	hookp;
 
 	up2 = &(uip -> list);
 	i = 0;
-	for (up1 = up2 -> forw; up1 NE up2; ) {
+	for (up1 = up2 -> forw; up1 NE up2; up1 = up1 -> forw) {
 		fsp = up1 -> fst;
 		fsp -> tree_num = i++;
 		*hookp = fsp;
 		hookp = &(fsp -> next);
-		up3 = up1;
-		up1 = up1 -> forw;
-		free ((char *) up3);
 	}
 	*hookp = NULL;
 
 	uip -> list.forw = up2;
 	uip -> list.back = up2;
+	_gst_arena_free (&(uip -> list_mem));
 
 	/* Make it easy to add zero-length FSTs onto the end. */
 	uip -> ntrees	= i;
@@ -1824,16 +2244,12 @@ struct full_set *	fsp;
 			fsp -> next	 = NULL;
 			fsp -> tree_num	 = (uip -> ntrees)++;
 			fsp -> tree_len	 = 0.0;
-			fsp->battery_score = 0.0;
-			for (i = 0; i < fsp->terminals->n; i++) {
-				int idx = fsp->tlist[i] - 1;
-				fsp->battery_score += pts->a[idx].battery / 100.0;  /* Normalize battery by dividing by 100 */
-			}
 			fsp -> tlist	 = tlist;
 			fsp -> terminals = terms;
 			fsp -> steiners	 = NULL;
 			fsp -> nedges	 = 1;
 			fsp -> edges	 = edges;
+			fsp->battery_score = (pts->a[t].battery + pts->a[u].battery) / 100.0;  /* Normalize battery by dividing by 100 */
 
 			*(uip -> hookp) = fsp;
 			uip -> hookp	= &(fsp -> next);
@@ -1992,7 +2408,6 @@ found_ufst:
 		free ((char *) (fsp -> steiners));
 		free ((char *) (fsp -> edges));
 		free ((char *) fsp);
-		free ((char *) up);
 	}
 
 	/* Build FST graph in edge list form. */
@@ -2019,6 +2434,10 @@ found_ufst:
 	}
 
 	new_steiners = (nstein EQ 0) ? NULL : NEW_PSET (nstein);
+	for (i = 0; i < nstein; i++) {
+		/* Steiner points have no battery. */
+		new_steiners -> a [i].battery = 0.0;
+	}
 	edges = NEWA (nedges, struct edge);
 
 	steiner_num = 0;
@@ -2094,17 +2513,17 @@ found_ufst:
 	fsp -> next		= NULL;
 	fsp -> tree_num		= 0;
 	fsp -> tree_len		= fst -> length;
-	fsp->battery_score = 0.0;
-	for (i = 0; i < fsp->terminals->n; i++) {
-		fsp->battery_score += fsp->terminals->a[i].battery / 100.0;  /* Normalize battery by dividing by 100 */
-	}
 	fsp -> tlist		= new_tlist;
 	fsp -> terminals	= new_terms;
 	fsp -> steiners		= new_steiners;
 	fsp -> nedges		= nedges;
 	fsp -> edges		= edges;
+	fsp->battery_score = 0.0;
+	for (i = 0; i < size; i++) {
+		fsp->battery_score += fsp->terminals->a[i].battery / 100.0;  /* Normalize battery by dividing by 100 */
+	}
 
-	up = NEW (struct ulist);
+	up = ARENA_NEW (&(uip -> list_mem), struct ulist);
 
 	up2 = &(uip -> list);
 	up1 = up2 -> back;
@@ -2643,59 +3062,6 @@ int			middleSpan
 	return 0;
 }
 
-/*
- *  Allocate and initialize a timer (used for statistics).
- */
-	static
-	struct time_it *
-create_time_it (
-
-char *		name		/* IN - name of timer */
-)
-{
-struct time_it *	ti;
-
-	ti = NEW (struct time_it);
-	ti -> name		= name;
-	ti -> queries		= 0;
-	ti -> pruned		= 0;
-	ti -> elapsed_time	= 0;
-
-	return (ti);
-}
-
-/*
- *  Start a timer subperiod (used for statistics).
- */
-	static
-	void
-start_timer (
-
-struct time_it *	ti	/* IN/OUT - timer information */
-)
-{
-	ti -> queries++;
-	ti -> temp_time = _gst_get_cpu_time ();
-}
-
-/*
- *  Stop a timer subperiod (used for statistics). A boolean value indicates success.
- */
-	static
-	void
-stop_timer (
-
-struct time_it *	ti,	/* IN/OUT - timer information */
-bool			pruned	/* IN - boolean to indicate success */
-)
-{
-	ti -> elapsed_time += _gst_get_cpu_time () - ti -> temp_time;
-
-	if(pruned) {
-		ti -> pruned++;
-	}
-}
-
 #if 0
 /*
  *  For debug purposes.
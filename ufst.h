@@ -3,8 +3,8 @@
 	$Id: ufst.h,v 1.27 2022/11/19 13:45:55 warme Exp $
 
 	File:	ufst.h
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-6
+	Date:	10/18/2026
 
 	Copyright (c) 2002, 2022 by PAwel Winter & Martin Zachariasen.
 	This work is licensed under a Creative Commons
@@ -26,6 +26,12 @@
 		: Change notices for 5.1 release.
 	e-3:	09/24/2016	warme
 		: Reorganize include files, apply prefixes.
+	e-4:	10/18/2026	warme
+		: Add statistics counters to uinfo.
+	e-5:	10/18/2026	warme
+		: Add FST generation time limit to uinfo.
+	e-6:	10/18/2026	warme
+		: Allocate the UFST list from an arena.
 
 ************************************************************************/
 
@@ -34,13 +40,16 @@
 
 #include "geomtypes.h"
 #include "gsttypes.h"
+#include "memory.h"
 #include "point.h"
+#include "polltime.h"
 
 struct bsd;
 struct full_set;
 struct gst_metric;
 struct point;
 struct pset;
+struct ustats;
 
 /*
  * A structure to keep track of one UFST.  They are kept in a hash table
@@ -70,6 +79,7 @@ struct uinfo {
 
 	struct ulist ** hash;		/* FST hash table */
 	struct ulist	list;		/* Head of circular UFST list */
+	struct arena	list_mem;	/* Memory for the UFST list */
 
 	int             num_term_masks; /* Size of terminal mask in each FST */
 
@@ -93,6 +103,12 @@ struct uinfo {
 
 	/* Concatenator related */
 	int hFSTCount;
+
+	struct ustats *	stats;		/* Statistics counters */
+
+	struct cpu_poll	fst_poll;	/* Time limit of FST generation */
+	int		complete_size;	/* Largest size of which all FSTs */
+					/* were generated (0 = every size) */
 };
 
 /*
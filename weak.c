@@ -3,8 +3,8 @@
 	$Id: weak.c,v 1.13 2022/11/19 13:45:55 warme Exp $
 
 	File:	weak.c
-	Rev:	e-3
-	Date:	09/24/2016
+	Rev:	e-4
+	Date:	10/18/2026
 
 	Copyright (c) 1996, 2022 by David M. Warme.  This work is
 	licensed under a Creative Commons Attribution-NonCommercial
@@ -31,6 +31,10 @@
 	e-3:	09/24/2016	warme
 		: Reorganize include files, apply prefixes,
 		:  upgrade fatals.
+	e-4:	10/18/2026	warme
+		: Use the incrementally maintained support
+		:  connectivity to skip vertices outside the
+		:  support.
 
 ************************************************************************/
 
@@ -45,6 +49,7 @@
 #include "parmblk.h"
 #include "sec_heur.h"
 #include "steiner.h"
+#include "suppconn.h"
 
 
 /*
@@ -155,6 +160,7 @@ int *			ip2;
 gst_channel_ptr		trace;
 struct constraint *	cp2;
 struct constraint *	cp3;
+struct suppconn *	scp;
 struct bc2		bc;
 
 	cip	  = bbip -> cip;
@@ -230,12 +236,23 @@ struct bc2		bc;
 		++num_vactive;
 	}
 
+	/* Bring the connected components of the support up to date.	*/
+	/* A vertex that is not in the support is a component all by	*/
+	/* itself, with no cuts to be found.				*/
+	scp = bbip -> suppconn;
+	if (scp EQ NULL) {
+		scp = _gst_create_support_conn (cip);
+		bbip -> suppconn = scp;
+	}
+	_gst_update_support_conn (scp, x, edge_mask, cip);
+
 	cp2 = NULL;
 
 	/* Traverse each connected component, identifying its BCC's as	*/
 	/* we go.							*/
 	for (i = 0; i < nverts; i++) {
 		if (NOT BITON (vert_mask, i)) continue;
+		if (scp -> degree [i] <= 0) continue;
 		if (bc.dfs [i] > 0) continue;
 
 		/* Prepare to traverse one connected component, finding	*/